@@ -0,0 +1,64 @@
+/**----------------------------------------------------------------------------
+; @file BenchUtils.cpp
+;
+; @brief
+;   The file implements the helpers shared by the benchmarks.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <chrono>
+
+#include "BenchUtils.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func get_time
+;
+; @brief
+;   Returns the current time.
+;
+; @params
+;   None
+;
+; @return
+;   double  | Time (in milliseconds) since an unspecified point.
+;
+----------------------------------------------------------------------------**/
+double get_time()
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_random
+;
+; @brief
+;   Returns a pseudo-random number (xorshift32), the same sequence on every
+;   run.
+;
+; @params
+;   state   | Generator state, updated by the call. Must not be 0.
+;
+; @return
+;   float   | A number in [0, 1).
+;
+----------------------------------------------------------------------------**/
+float get_random(std::uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) / 16777216.0f;
+}
@@ -0,0 +1,27 @@
+/**----------------------------------------------------------------------------
+; @file BenchUtils.hpp
+;
+; @brief
+;   The file contains the declaration of the helpers shared by the
+;   benchmarks: a wall-clock timer and a pseudo-random generator that gives
+;   the same sequence on every run, so runs can be compared.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+double get_time();
+float get_random(std::uint32_t& state);
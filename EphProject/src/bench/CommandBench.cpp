@@ -0,0 +1,270 @@
+/**----------------------------------------------------------------------------
+; @file CommandBench.cpp
+;
+; @brief
+;   The file implements the command buffer benchmark.
+;
+;   The sprites are spread over the window with a few of them outside, so
+;   the culling has some work to do. The recording is timed around the
+;   'CommandBuffer::draw_sprite' calls (and the 'WorkerPool::run' call that
+;   makes them), the replay from 'Renderer::begin' to the end of 'glFinish'.
+;   The direct scenario has no recording: its submission is part of the
+;   replay time.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "CommandBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/CommandBuffer.hpp"
+#include "../core/Core.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/Texture2dArray.hpp"
+#include "../core/Texture2dArrayLayer.hpp"
+#include "../core/WorkerPool.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define SPRITES_COUNT 200000
+#define SPRITE_TEXTURE_SIZE 16
+#define WARMUP_FRAMES_COUNT 10
+#define FRAMES_COUNT 100
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct BenchSprite
+{
+    glm::vec2 pos;
+    glm::vec2 size;
+    float rotation;
+};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func bench_direct
+;
+; @brief
+;   Submits the sprites to the renderer for a number of frames and prints
+;   the average frame time.
+;
+; @params
+;   renderer    | Renderer to draw with.
+;   layer       | Texture layer of the sprites.
+;   sprites     | Sprites drawn each frame.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_direct(Renderer& renderer, Texture2dArrayLayer const& layer,
+    std::vector<BenchSprite> const& sprites)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+    double draw_time = 0.0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        double start = get_time();
+        renderer.begin();
+        for (BenchSprite const& sprite : sprites)
+        {
+            renderer.submit_sprite(&layer, sprite.pos, sprite.size,
+                glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0, sprite.rotation,
+                glm::vec2(0.5f));
+        }
+        renderer.flush();
+        glFinish();                     /* Wait for the GPU as well          */
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            draw_time += get_time() - start;
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    std::printf("%-7s | %7u | %8.3f ms | %8.3f ms | %7s\n", "direct",
+        renderer.get_visible_sprites_count(), 0.0, draw_time / FRAMES_COUNT,
+        "-");
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_commands
+;
+; @brief
+;   Records the sprites into command buffers, each buffer taking an equal
+;   range of the sprites, replays the buffers for a number of frames and
+;   prints the average recording and replay times and the memory used by
+;   the buffers.
+;
+; @params
+;   name                | Scenario name to print.
+;   renderer            | Renderer to draw with.
+;   layer               | Texture layer of the sprites.
+;   sprites             | Sprites drawn each frame.
+;   buffers_count       | Number of command buffers.
+;   worker_pool_ptr     | Worker pool that records the buffers, nullptr -
+;                       | the calling thread.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_commands(char const* name, Renderer& renderer,
+    Texture2dArrayLayer const& layer, std::vector<BenchSprite> const& sprites,
+    std::size_t buffers_count, WorkerPool* worker_pool_ptr)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+    std::vector<std::unique_ptr<CommandBuffer>> command_buffers;
+    for (std::size_t i = 0; i < buffers_count; i++)
+    {
+        command_buffers.emplace_back(new CommandBuffer());
+    }
+    auto record = [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            CommandBuffer& command_buffer = *command_buffers[i];
+            command_buffer.begin(renderer.get_cull_rect());
+            std::size_t sprites_end = sprites.size() * (i + 1) / buffers_count;
+            for (std::size_t j = sprites.size() * i / buffers_count;
+                j < sprites_end; j++)
+            {
+                command_buffer.draw_sprite(&layer, sprites[j].pos,
+                    sprites[j].size, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0,
+                    sprites[j].rotation, glm::vec2(0.5f));
+            }
+        }
+    };
+    double record_time = 0.0;
+    double draw_time = 0.0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        double start = get_time();
+        if (worker_pool_ptr != nullptr)
+        {                               /* One buffer per slice              */
+            worker_pool_ptr->run(buffers_count, 1, record);
+        }
+        else
+        {
+            record(0, buffers_count);
+        }
+        double record_end = get_time();
+        renderer.begin();
+        for (std::unique_ptr<CommandBuffer> const& command_buffer :
+            command_buffers)
+        {
+            renderer.execute(*command_buffer);
+        }
+        glFinish();                     /* Wait for the GPU as well          */
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            record_time += record_end - start;
+            draw_time += get_time() - record_end;
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    std::size_t used_size = 0;
+    for (std::unique_ptr<CommandBuffer> const& command_buffer :
+        command_buffers)
+    {
+        used_size += command_buffer->get_used_size();
+    }
+    std::printf("%-7s | %7u | %8.3f ms | %8.3f ms | %4zu KB\n", name,
+        renderer.get_visible_sprites_count(), record_time / FRAMES_COUNT,
+        draw_time / FRAMES_COUNT, used_size / 1024);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_command_bench
+;
+; @brief
+;   Creates a window and a renderer, runs the direct scenario and the command
+;   buffer scenarios with and without a worker pool, and prints the results
+;   to stdout.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_command_bench()
+{
+    Core::instance().init_window("Eph Project - command bench",
+        { WINDOW_WIDTH, WINDOW_HEIGHT }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+
+    std::vector<BenchSprite> sprites(SPRITES_COUNT);
+    std::uint32_t random_state = 0x9E3779B9u;
+    for (BenchSprite& sprite : sprites)
+    {                                   /* About 10% outside the window      */
+        sprite.pos = glm::vec2((get_random(random_state) * 1.1f - 0.05f) *
+            WINDOW_WIDTH, (get_random(random_state) * 1.1f - 0.05f) *
+            WINDOW_HEIGHT);
+        sprite.size = glm::vec2(4.0f + get_random(random_state) * 12.0f);
+        sprite.rotation = get_random(random_state) * 6.2831853f;
+    }
+
+    {
+        Texture2dArray texture_2d_array(SPRITE_TEXTURE_SIZE,
+            SPRITE_TEXTURE_SIZE, 1);
+        Texture2dArrayLayer layer(&texture_2d_array, 0);
+        std::vector<unsigned char> pixels(SPRITE_TEXTURE_SIZE *
+            SPRITE_TEXTURE_SIZE * 4, 0xFF);
+        layer.add_subimage(0, 0, SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, 0,
+            0, pixels.data(), SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, 4);
+
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+        WorkerPool worker_pool;
+        std::size_t threads_count = worker_pool.get_threads_count() + 1;
+                                        /* The caller records too            */
+
+        std::printf("threads: %zu\n", threads_count);
+        std::printf("scene   | visible |    record   |    replay   "
+            "| memory\n");
+        bench_direct(renderer, layer, sprites);
+        bench_commands("single", renderer, layer, sprites, 1, nullptr);
+        bench_commands("pool", renderer, layer, sprites, threads_count,
+            &worker_pool);
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+}
@@ -0,0 +1,24 @@
+/**----------------------------------------------------------------------------
+; @file CommandBench.hpp
+;
+; @brief
+;   The file contains the declaration of the command buffer benchmark. The
+;   benchmark draws 200k rotated sprites per frame, submitted directly to the
+;   renderer, recorded into one 'CommandBuffer' on the calling thread, and
+;   recorded into one buffer per thread of a 'WorkerPool', and prints the
+;   recording time and the replay time per frame.
+;
+;   Run with: EphProject.exe --bench commands
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_command_bench();
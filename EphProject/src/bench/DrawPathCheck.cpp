@@ -0,0 +1,176 @@
+/**----------------------------------------------------------------------------
+; @file DrawPathCheck.cpp
+;
+; @brief
+;   The file implements the draw path regression check.
+;
+;   Three sprites of 16x16 pixels are drawn from one composition (a unit
+;   rectangle), in a frame of 64x64 pixels:
+;       - A, red, immediately, at (0, 0)
+;       - B, green, batched ('glMultiDrawElementsIndirect'), at (24, 0)
+;       - C, red, immediately after B, at (0, 32)
+;   The center of each sprite must have the color of its layer. If the
+;   batched draw left the per-instance arrays enabled, C ignores its generic
+;   values and is drawn with the stale instance of B instead.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdio>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/vec2.hpp>
+
+#include "DrawPathCheck.hpp"
+#include "../core/Core.hpp"
+#include "../core/IndicesData.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/Sprite.hpp"
+#include "../core/Texture2dArray.hpp"
+#include "../core/Texture2dArrayLayer.hpp"
+#include "../core/VertexArray.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define FRAME_SIZE 64
+#define SPRITE_SIZE 16
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct ExpectedPixel
+{
+    char const* name;
+    glm::ivec2 pos;                     /* In pixels, from the top left      */
+    bool is_red;                        /* Green otherwise                   */
+};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func check_pixel
+;
+; @brief
+;   Reads a pixel of the current framebuffer and checks that it is mostly
+;   red or mostly green. Prints the pixel if it is not.
+;
+; @params
+;   expected    | The pixel and its expected color.
+;
+; @return
+;   bool    | true if the pixel has the expected color.
+;
+----------------------------------------------------------------------------**/
+static bool check_pixel(ExpectedPixel const& expected)
+{
+    unsigned char pixel[4] = {};
+    glReadPixels(expected.pos.x, FRAME_SIZE - 1 - expected.pos.y, 1, 1,
+        GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+                                        /* The framebuffer is bottom-up      */
+    bool is_red = pixel[0] > 200 && pixel[1] < 50;
+    bool is_green = pixel[1] > 200 && pixel[0] < 50;
+    if (expected.is_red ? is_red : is_green)
+    {
+        return true;
+    }
+    std::fprintf(stderr, "draw_paths: sprite %s at (%d, %d) is (%u, %u, %u), "
+        "expected %s\n", expected.name, expected.pos.x, expected.pos.y,
+        pixel[0], pixel[1], pixel[2], expected.is_red ? "red" : "green");
+    return false;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_draw_path_check
+;
+; @brief
+;   Creates a window, a composition and a renderer, draws the sprites of the
+;   check and compares the pixels. Prints the result.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if the check passes.
+;
+----------------------------------------------------------------------------**/
+bool run_draw_path_check()
+{
+    Core::instance().init_window("Eph Project - draw path check",
+        { FRAME_SIZE, FRAME_SIZE }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+
+    bool is_passed = true;
+    {
+        Texture2dArray texture_2d_array(SPRITE_SIZE, SPRITE_SIZE, 2);
+        Texture2dArrayLayer red_layer(&texture_2d_array, 0);
+        Texture2dArrayLayer green_layer(&texture_2d_array, 1);
+        std::vector<unsigned char> pixels(SPRITE_SIZE * SPRITE_SIZE * 4);
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            pixels[i] = 255;
+            pixels[i + 3] = 255;
+        }
+        red_layer.add_subimage(0, 0, SPRITE_SIZE, SPRITE_SIZE, 0, 0,
+            pixels.data(), SPRITE_SIZE, SPRITE_SIZE, 4);
+        for (std::size_t i = 0; i < pixels.size(); i += 4)
+        {
+            pixels[i] = 0;
+            pixels[i + 1] = 255;
+        }
+        green_layer.add_subimage(0, 0, SPRITE_SIZE, SPRITE_SIZE, 0, 0,
+            pixels.data(), SPRITE_SIZE, SPRITE_SIZE, 4);
+
+        VertexArray vertex_array;
+        IndicesData* indices_data_ptr = vertex_array.add_unit_quad();
+        vertex_array.build();
+        Sprite red_sprite(indices_data_ptr, &red_layer);
+        Sprite green_sprite(indices_data_ptr, &green_layer);
+
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { FRAME_SIZE, FRAME_SIZE });
+        glm::vec2 const size(SPRITE_SIZE);
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        renderer.begin();
+        vertex_array.bind();
+        renderer.draw_sprite(&red_sprite, glm::vec2(0.0f, 0.0f), size);
+        renderer.set_mode(RENDER_MODE_MULTI_DRAW_INDIRECT);
+        renderer.draw_sprite(&green_sprite, glm::vec2(24.0f, 0.0f), size);
+        renderer.set_mode(RENDER_MODE_IMMEDIATE);
+                                        /* Flushes the batched sprite        */
+        vertex_array.bind();
+        renderer.draw_sprite(&red_sprite, glm::vec2(0.0f, 32.0f), size);
+        renderer.flush();
+        glFinish();
+
+        ExpectedPixel const expected_pixels[] =
+        {
+            { "A", { 8, 8 }, true },
+            { "B", { 32, 8 }, false },
+            { "C", { 8, 40 }, true },
+        };
+        for (ExpectedPixel const& expected : expected_pixels)
+        {
+            is_passed = check_pixel(expected) && is_passed;
+        }
+        std::printf("draw_paths: %s\n", is_passed ? "passed" : "FAILED");
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+    return is_passed;
+}
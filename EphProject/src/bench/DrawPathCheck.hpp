@@ -0,0 +1,27 @@
+/**----------------------------------------------------------------------------
+; @file DrawPathCheck.hpp
+;
+; @brief
+;   The file contains the declaration of the draw path regression check. The
+;   check draws one composition vertex array with 'Renderer::draw_sprite' in
+;   the immediate mode, then in the 'RENDER_MODE_MULTI_DRAW_INDIRECT' mode,
+;   then in the immediate mode again, all in one frame, and reads back a
+;   pixel of each sprite. A sprite drawn immediately after a batched draw
+;   must land at its own position with its own layer, i.e. the batched draw
+;   must not leave the per-instance arrays of the vertex array enabled.
+;
+;   Run with: EphProject.exe --check draw_paths --headless
+;   The exit code is 0 if the check passes.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+bool run_draw_path_check();
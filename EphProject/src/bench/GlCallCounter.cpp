@@ -0,0 +1,292 @@
+/**----------------------------------------------------------------------------
+; @file GlCallCounter.cpp
+;
+; @brief
+;   The file implements the OpenGL call counter of the benchmarks. Each
+;   wrapper counts its call and forwards it to the function GLAD loaded.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "GlCallCounter.hpp"
+
+
+
+/** @data_definitions  -----------------------------------------------------**/
+
+static GlCallCounts counts = {};
+static bool is_installed = false;
+
+static PFNGLDRAWELEMENTSPROC draw_elements_ptr = nullptr;
+static PFNGLDRAWELEMENTSINSTANCEDPROC draw_elements_instanced_ptr = nullptr;
+static PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC
+    draw_elements_instanced_base_instance_ptr = nullptr;
+static PFNGLDRAWELEMENTSINDIRECTPROC draw_elements_indirect_ptr = nullptr;
+static PFNGLMULTIDRAWELEMENTSINDIRECTPROC multi_draw_elements_indirect_ptr =
+    nullptr;
+static PFNGLDISPATCHCOMPUTEPROC dispatch_compute_ptr = nullptr;
+static PFNGLBINDTEXTUREPROC bind_texture_ptr = nullptr;
+static PFNGLUSEPROGRAMPROC use_program_ptr = nullptr;
+static PFNGLUNIFORM1IPROC uniform_1i_ptr = nullptr;
+static PFNGLUNIFORM1FPROC uniform_1f_ptr = nullptr;
+static PFNGLUNIFORM2IPROC uniform_2i_ptr = nullptr;
+static PFNGLUNIFORM2FPROC uniform_2f_ptr = nullptr;
+static PFNGLUNIFORM4FPROC uniform_4f_ptr = nullptr;
+static PFNGLUNIFORMMATRIX4FVPROC uniform_matrix_4fv_ptr = nullptr;
+static PFNGLBUFFERDATAPROC buffer_data_ptr = nullptr;
+static PFNGLBUFFERSUBDATAPROC buffer_sub_data_ptr = nullptr;
+static PFNGLTEXSUBIMAGE3DPROC tex_sub_image_3d_ptr = nullptr;
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+static void APIENTRY count_draw_elements(GLenum mode, GLsizei count,
+    GLenum type, void const* indices)
+{
+    counts.draw_calls++;
+    draw_elements_ptr(mode, count, type, indices);
+}
+
+
+static void APIENTRY count_draw_elements_instanced(GLenum mode,
+    GLsizei count, GLenum type, void const* indices, GLsizei instances_count)
+{
+    counts.draw_calls++;
+    draw_elements_instanced_ptr(mode, count, type, indices, instances_count);
+}
+
+
+static void APIENTRY count_draw_elements_instanced_base_instance(
+    GLenum mode, GLsizei count, GLenum type, void const* indices,
+    GLsizei instances_count, GLuint base_instance)
+{
+    counts.draw_calls++;
+    draw_elements_instanced_base_instance_ptr(mode, count, type, indices,
+        instances_count, base_instance);
+}
+
+
+static void APIENTRY count_draw_elements_indirect(GLenum mode, GLenum type,
+    void const* indirect)
+{
+    counts.draw_calls++;
+    draw_elements_indirect_ptr(mode, type, indirect);
+}
+
+
+static void APIENTRY count_multi_draw_elements_indirect(GLenum mode,
+    GLenum type, void const* indirect, GLsizei draws_count, GLsizei stride)
+{
+    counts.draw_calls++;
+    multi_draw_elements_indirect_ptr(mode, type, indirect, draws_count,
+        stride);
+}
+
+
+static void APIENTRY count_dispatch_compute(GLuint groups_count_x,
+    GLuint groups_count_y, GLuint groups_count_z)
+{
+    counts.dispatches++;
+    dispatch_compute_ptr(groups_count_x, groups_count_y, groups_count_z);
+}
+
+
+static void APIENTRY count_bind_texture(GLenum target, GLuint texture)
+{
+    counts.texture_binds++;
+    bind_texture_ptr(target, texture);
+}
+
+
+static void APIENTRY count_use_program(GLuint program)
+{
+    counts.program_switches++;
+    use_program_ptr(program);
+}
+
+
+static void APIENTRY count_uniform_1i(GLint location, GLint v0)
+{
+    counts.uniform_uploads++;
+    uniform_1i_ptr(location, v0);
+}
+
+
+static void APIENTRY count_uniform_1f(GLint location, GLfloat v0)
+{
+    counts.uniform_uploads++;
+    uniform_1f_ptr(location, v0);
+}
+
+
+static void APIENTRY count_uniform_2i(GLint location, GLint v0, GLint v1)
+{
+    counts.uniform_uploads++;
+    uniform_2i_ptr(location, v0, v1);
+}
+
+
+static void APIENTRY count_uniform_2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    counts.uniform_uploads++;
+    uniform_2f_ptr(location, v0, v1);
+}
+
+
+static void APIENTRY count_uniform_4f(GLint location, GLfloat v0, GLfloat v1,
+    GLfloat v2, GLfloat v3)
+{
+    counts.uniform_uploads++;
+    uniform_4f_ptr(location, v0, v1, v2, v3);
+}
+
+
+static void APIENTRY count_uniform_matrix_4fv(GLint location, GLsizei count,
+    GLboolean transpose, GLfloat const* value)
+{
+    counts.uniform_uploads++;
+    uniform_matrix_4fv_ptr(location, count, transpose, value);
+}
+
+
+static void APIENTRY count_buffer_data(GLenum target, GLsizeiptr size,
+    void const* data, GLenum usage)
+{
+    if (data != nullptr)
+    {                                   /* Allocation only otherwise         */
+        counts.buffer_bytes += static_cast<unsigned long long>(size);
+    }
+    buffer_data_ptr(target, size, data, usage);
+}
+
+
+static void APIENTRY count_buffer_sub_data(GLenum target, GLintptr offset,
+    GLsizeiptr size, void const* data)
+{
+    counts.buffer_bytes += static_cast<unsigned long long>(size);
+    buffer_sub_data_ptr(target, offset, size, data);
+}
+
+
+static void APIENTRY count_tex_sub_image_3d(GLenum target, GLint level,
+    GLint x_offset, GLint y_offset, GLint z_offset, GLsizei width,
+    GLsizei height, GLsizei depth, GLenum format, GLenum type,
+    void const* pixels)
+{
+    unsigned long long bytes_per_pixel = format == GL_RGBA ? 4 :
+        format == GL_RGB ? 3 : 1;       /* The formats of 'add_subimage',    */
+                                        /* GL_UNSIGNED_BYTE                  */
+    counts.texture_bytes += bytes_per_pixel * static_cast<unsigned long long>(
+        width) * height * depth;
+    tex_sub_image_3d_ptr(target, level, x_offset, y_offset, z_offset, width,
+        height, depth, format, type, pixels);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func install_gl_call_counter
+;
+; @brief
+;   Replaces the GLAD function pointers of the counted calls with the
+;   counting wrappers. Must be called after GLAD is loaded ('init_window');
+;   later calls do nothing.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void install_gl_call_counter()
+{
+    if (is_installed)
+    {
+        return;
+    }
+    is_installed = true;
+
+    draw_elements_ptr = glad_glDrawElements;
+    glad_glDrawElements = count_draw_elements;
+    draw_elements_instanced_ptr = glad_glDrawElementsInstanced;
+    glad_glDrawElementsInstanced = count_draw_elements_instanced;
+    draw_elements_instanced_base_instance_ptr =
+        glad_glDrawElementsInstancedBaseInstance;
+    glad_glDrawElementsInstancedBaseInstance =
+        count_draw_elements_instanced_base_instance;
+    draw_elements_indirect_ptr = glad_glDrawElementsIndirect;
+    glad_glDrawElementsIndirect = count_draw_elements_indirect;
+    multi_draw_elements_indirect_ptr = glad_glMultiDrawElementsIndirect;
+    glad_glMultiDrawElementsIndirect = count_multi_draw_elements_indirect;
+    dispatch_compute_ptr = glad_glDispatchCompute;
+    glad_glDispatchCompute = count_dispatch_compute;
+    bind_texture_ptr = glad_glBindTexture;
+    glad_glBindTexture = count_bind_texture;
+    use_program_ptr = glad_glUseProgram;
+    glad_glUseProgram = count_use_program;
+    uniform_1i_ptr = glad_glUniform1i;
+    glad_glUniform1i = count_uniform_1i;
+    uniform_1f_ptr = glad_glUniform1f;
+    glad_glUniform1f = count_uniform_1f;
+    uniform_2i_ptr = glad_glUniform2i;
+    glad_glUniform2i = count_uniform_2i;
+    uniform_2f_ptr = glad_glUniform2f;
+    glad_glUniform2f = count_uniform_2f;
+    uniform_4f_ptr = glad_glUniform4f;
+    glad_glUniform4f = count_uniform_4f;
+    uniform_matrix_4fv_ptr = glad_glUniformMatrix4fv;
+    glad_glUniformMatrix4fv = count_uniform_matrix_4fv;
+    buffer_data_ptr = glad_glBufferData;
+    glad_glBufferData = count_buffer_data;
+    buffer_sub_data_ptr = glad_glBufferSubData;
+    glad_glBufferSubData = count_buffer_sub_data;
+    tex_sub_image_3d_ptr = glad_glTexSubImage3D;
+    glad_glTexSubImage3D = count_tex_sub_image_3d;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_gl_call_counts
+;
+; @brief
+;   Sets all counters to zero, e.g. at the start of a frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void reset_gl_call_counts()
+{
+    counts = {};
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_gl_call_counts
+;
+; @brief
+;   Returns the calls counted since the last 'reset_gl_call_counts'.
+;
+; @params
+;   None
+;
+; @return
+;   GlCallCounts const& | The counters.
+;
+----------------------------------------------------------------------------**/
+GlCallCounts const& get_gl_call_counts()
+{
+    return counts;
+}
@@ -0,0 +1,45 @@
+/**----------------------------------------------------------------------------
+; @file GlCallCounter.hpp
+;
+; @brief
+;   The file contains the declaration of the OpenGL call counter of the
+;   benchmarks. The counter wraps the GLAD function pointers of the calls
+;   the renderer makes (draws, dispatches, texture binds, program switches,
+;   uniform uploads, buffer and texture uploads), so the benchmarks can
+;   report what actually reaches the driver, after the 'GlState' cache, with
+;   no change to the core classes.
+;
+;   Data written to persistently mapped buffers ('RingBuffer') does not go
+;   through any call and is not counted.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct GlCallCounts
+{
+    unsigned long long draw_calls;      /* Every 'glDraw*' and               */
+                                        /* 'glMultiDraw*' call               */
+    unsigned long long dispatches;
+    unsigned long long texture_binds;
+    unsigned long long program_switches;
+    unsigned long long uniform_uploads; /* 'glUniform*' calls                */
+    unsigned long long buffer_bytes;    /* 'glBufferData' with data and      */
+                                        /* 'glBufferSubData'                 */
+    unsigned long long texture_bytes;   /* 'glTexSubImage3D'                 */
+};
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void install_gl_call_counter();
+void reset_gl_call_counts();
+GlCallCounts const& get_gl_call_counts();
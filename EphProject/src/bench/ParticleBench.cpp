@@ -0,0 +1,273 @@
+/**----------------------------------------------------------------------------
+; @file ParticleBench.cpp
+;
+; @brief
+;   The file implements the particle benchmark.
+;
+;   The particles are sprayed from the center of the window with random
+;   velocities and lives, under gravity, with a fixed time step, so every
+;   scenario does the same work. The update is timed around
+;   'ParticleSystem::update' (integration and compaction), the draw from
+;   'Renderer::begin' to the end of 'glFinish'.
+;
+;   The GPU scenarios emit the expected number of deaths per frame instead,
+;   so the number of live particles only hovers around the target. Their
+;   update is the CPU time to submit the passes, their draw covers the whole
+;   GPU work (simulation and drawing).
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "ParticleBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/Core.hpp"
+#include "../core/GpuParticleSystem.hpp"
+#include "../core/ParticleSystem.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/Texture2dArray.hpp"
+#include "../core/Texture2dArrayLayer.hpp"
+#include "../core/WorkerPool.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define PARTICLE_TEXTURE_SIZE 16        /* A round soft dot                  */
+#define DELTA_TIME (1.0f / 60.0f)
+#define WARMUP_FRAMES_COUNT 120         /* Long enough for the first         */
+                                        /* particles to die                  */
+#define FRAMES_COUNT 300
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func fill_dot
+;
+; @brief
+;   Draws a white dot that fades out towards its edge and uploads it to a
+;   texture 2d array layer.
+;
+; @params
+;   layer   | Layer of PARTICLE_TEXTURE_SIZE texels per side.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void fill_dot(Texture2dArrayLayer& layer)
+{
+    int side = PARTICLE_TEXTURE_SIZE;
+    float radius = side * 0.5f;
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(side) * side *
+        4, 0xFF);
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            glm::vec2 offset(x + 0.5f - radius, y + 0.5f - radius);
+            float distance = glm::length(offset) / radius;
+            pixels[(static_cast<std::size_t>(y) * side + x) * 4 + 3] =
+                static_cast<unsigned char>(distance < 1.0f ?
+                    (1.0f - distance) * 255.0f : 0.0f);
+        }
+    }
+    layer.add_subimage(0, 0, side, side, 0, 0, pixels.data(), side, side, 4);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_particles
+;
+; @brief
+;   Runs a particle system for a number of frames, refilling it every frame,
+;   and prints the average update and draw times.
+;
+; @params
+;   name                | Scenario name to print.
+;   renderer            | Renderer to draw with.
+;   layer               | Texture layer of the particles.
+;   particles_count     | Number of particles kept alive.
+;   worker_pool_ptr     | Worker pool of the system, nullptr - none.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_particles(char const* name, Renderer& renderer,
+    Texture2dArrayLayer const& layer, unsigned int particles_count,
+    WorkerPool* worker_pool_ptr)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+    ParticleSystem particle_system(layer.get_texture_2d_array(),
+        particles_count, worker_pool_ptr);
+    particle_system.set_gravity({ 0.0f, 200.0f });
+    std::uint32_t random_state = 0x9E3779B9u;
+    glm::vec2 center(WINDOW_WIDTH * 0.5f, WINDOW_HEIGHT * 0.5f);
+    double update_time = 0.0;
+    double draw_time = 0.0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        while (particle_system.get_particles_count() < particles_count)
+        {                               /* Replace the dead particles        */
+            glm::vec2 velocity(get_random(random_state) - 0.5f,
+                get_random(random_state) - 0.7f);
+            particle_system.emit(&layer, center, velocity * 800.0f,
+                0.5f + get_random(random_state) * 1.5f,
+                2.0f + get_random(random_state) * 6.0f,
+                { 1.0f, get_random(random_state), 0.2f, 0.5f });
+        }
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        double start = get_time();
+        particle_system.update(DELTA_TIME);
+        double update_end = get_time();
+        renderer.begin();
+        renderer.draw_particles(&particle_system);
+        glFinish();                     /* Wait for the GPU as well          */
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            update_time += update_end - start;
+            draw_time += get_time() - update_end;
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    std::printf("%-7s | %9u | %8.3f ms | %8.3f ms\n", name, particles_count,
+        update_time / FRAMES_COUNT, draw_time / FRAMES_COUNT);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_gpu_particles
+;
+; @brief
+;   Runs a GPU particle system for a number of frames, emitting the expected
+;   number of deaths every frame, and prints the average update and draw
+;   times and the final number of live particles.
+;
+; @params
+;   renderer            | Renderer to draw with.
+;   layer               | Texture layer of the particles.
+;   particles_count     | Number of particles kept alive (on average).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_gpu_particles(Renderer& renderer,
+    Texture2dArrayLayer const& layer, unsigned int particles_count)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+    GpuParticleSystem particle_system(
+        Core::instance().get_particle_shader_ptr(),
+        layer.get_texture_2d_array(), particles_count);
+    particle_system.set_gravity({ 0.0f, 200.0f });
+    ParticleEmitter emitter = { &layer,
+        { WINDOW_WIDTH * 0.5f, WINDOW_HEIGHT * 0.5f }, { 4.0f, 4.0f },
+        { -400.0f, -560.0f }, { 400.0f, 240.0f }, { 0.5f, 2.0f },
+        { 2.0f, 8.0f }, { 1.0f, 0.6f, 0.2f, 0.5f } };
+                                        /* Same ranges as on the CPU         */
+    unsigned int emit_count = static_cast<unsigned int>(particles_count *
+        DELTA_TIME / 1.25f);            /* Capacity / average life in frames */
+    double update_time = 0.0;
+    double draw_time = 0.0;
+
+    particle_system.emit(emitter, particles_count);
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        particle_system.emit(emitter, emit_count);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        double start = get_time();
+        renderer.begin();
+        renderer.draw_particles(&particle_system);
+        double update_end = get_time();
+        glFinish();                     /* Wait for the GPU as well          */
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            update_time += update_end - start;
+            draw_time += get_time() - update_end;
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    std::printf("%-7s | %9u | %8.3f ms | %8.3f ms\n", "gpu",
+        particle_system.read_particles_count(), update_time / FRAMES_COUNT,
+        draw_time / FRAMES_COUNT);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_particle_bench
+;
+; @brief
+;   Creates a window and a renderer, runs the CPU scenarios with and without
+;   a worker pool, then the GPU scenarios, and prints the results to stdout.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_particle_bench()
+{
+    Core::instance().init_window("Eph Project - particle bench",
+        { WINDOW_WIDTH, WINDOW_HEIGHT }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+    Core::instance().init_particle_shader(
+        "src/core/shaders/particle_compute.shader");
+
+    {
+        Texture2dArray texture_2d_array(PARTICLE_TEXTURE_SIZE,
+            PARTICLE_TEXTURE_SIZE, 1);
+        Texture2dArrayLayer layer(&texture_2d_array, 0);
+        fill_dot(layer);
+
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+        WorkerPool worker_pool;
+
+        std::printf("workers: %u\n", worker_pool.get_threads_count());
+        std::printf("threads | particles |    update   |     draw\n");
+        for (unsigned int particles_count : { 10000u, 100000u, 250000u })
+        {
+            bench_particles("single", renderer, layer, particles_count,
+                nullptr);
+            bench_particles("pool", renderer, layer, particles_count,
+                &worker_pool);
+        }
+        for (unsigned int particles_count : { 250000u, 1000000u })
+        {
+            bench_gpu_particles(renderer, layer, particles_count);
+        }
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+}
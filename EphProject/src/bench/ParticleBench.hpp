@@ -0,0 +1,25 @@
+/**----------------------------------------------------------------------------
+; @file ParticleBench.hpp
+;
+; @brief
+;   The file contains the declaration of the particle benchmark. The
+;   benchmark keeps 10k, 100k and 250k particles alive in a 'ParticleSystem'
+;   (dead ones are replaced every frame) and prints the update time and the
+;   draw time per frame, on the calling thread only and with a
+;   'WorkerPool'. Then it keeps 250k and 1M particles alive in a
+;   'GpuParticleSystem'.
+;
+;   Run with: EphProject.exe --bench particles
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_particle_bench();
@@ -0,0 +1,351 @@
+/**----------------------------------------------------------------------------
+; @file SpatialIndexBench.cpp
+;
+; @brief
+;   The file implements the spatial index benchmark.
+;
+;   The world is a square whose area grows with the number of sprites, so the
+;   view (1920x1080) always sees roughly the same number of sprites, which is
+;   what a large scrolling world looks like. Times are wall-clock times of a
+;   single thread.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "SpatialIndexBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/SpatialIndex.hpp"
+#include "../core/LooseQuadtree.hpp"
+#include "../core/HashedGrid.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define SPRITE_SPACING 48.0f            /* World side = sqrt(count) * this   */
+#define MIN_SPRITE_SIZE 8.0f
+#define MAX_SPRITE_SIZE 64.0f
+#define GRID_CELL_SIZE 64.0f
+#define QUERIES_COUNT 200               /* Views per static run              */
+#define FRAMES_COUNT 60                 /* Frames per churn run              */
+#define MOVING_SPRITES_RATIO 10         /* Every 10-th sprite moves          */
+#define RESPAWNING_SPRITES_RATIO 100    /* Every 100-th sprite respawns      */
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct BenchSprite
+{
+    glm::vec2 pos;
+    glm::vec2 size;
+    glm::vec2 velocity;
+    unsigned int handle;
+};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func get_bounds
+;
+; @brief
+;   Returns the bounding rectangle of a sprite.
+;
+; @params
+;   sprite  | Sprite.
+;
+; @return
+;   glm::vec4   | Bounding rectangle (min x, min y, max x, max y).
+;
+----------------------------------------------------------------------------**/
+static glm::vec4 get_bounds(BenchSprite const& sprite)
+{
+    return glm::vec4(sprite.pos, sprite.pos + sprite.size);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func spawn_sprite
+;
+; @brief
+;   Places a sprite at a random position of the world with a random size and
+;   velocity.
+;
+; @params
+;   sprite      | Sprite to be (re)initialized.
+;   world_side  | Side of the world square.
+;   rng         | Random number generator.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void spawn_sprite(BenchSprite& sprite, float world_side,
+    std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> pos_dist(0.0f, world_side);
+    std::uniform_real_distribution<float> size_dist(MIN_SPRITE_SIZE,
+        MAX_SPRITE_SIZE);
+    std::uniform_real_distribution<float> velocity_dist(-4.0f, 4.0f);
+    sprite.pos = glm::vec2(pos_dist(rng), pos_dist(rng));
+    sprite.size = glm::vec2(size_dist(rng), size_dist(rng));
+    sprite.velocity = glm::vec2(velocity_dist(rng), velocity_dist(rng));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func make_view
+;
+; @brief
+;   Returns a 1920x1080 view rectangle at a random position of the world.
+;
+; @params
+;   world_side  | Side of the world square.
+;   rng         | Random number generator.
+;
+; @return
+;   glm::vec4   | View rectangle (min x, min y, max x, max y).
+;
+----------------------------------------------------------------------------**/
+static glm::vec4 make_view(float world_side, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> pos_dist(0.0f, world_side);
+    glm::vec2 pos(pos_dist(rng), pos_dist(rng));
+    return glm::vec4(pos, pos + glm::vec2(1920.0f, 1080.0f));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func scan
+;
+; @brief
+;   The baseline: tests every sprite against the view.
+;
+; @params
+;   sprites | All sprites.
+;   view    | View rectangle.
+;   handles | Output. Indices of the visible sprites.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void scan(std::vector<BenchSprite> const& sprites,
+    glm::vec4 const& view, std::vector<unsigned int>& handles)
+{
+    for (std::size_t i = 0; i < sprites.size(); i++)
+    {
+        glm::vec4 bounds = get_bounds(sprites[i]);
+        if (bounds.z >= view.x && bounds.x <= view.z &&
+            bounds.w >= view.y && bounds.y <= view.w)
+        {
+            handles.push_back(static_cast<unsigned int>(i));
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_static
+;
+; @brief
+;   Inserts all sprites and queries random views. Prints the insert time, the
+;   average query time and the average number of visible sprites.
+;
+; @params
+;   name        | Index name to print.
+;   index_ptr   | Index to measure. nullptr - the linear scan.
+;   sprites     | All sprites.
+;   world_side  | Side of the world square.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_static(char const* name, SpatialIndex* index_ptr,
+    std::vector<BenchSprite>& sprites, float world_side)
+{
+    std::mt19937 rng(1);
+    std::vector<unsigned int> handles;
+    double insert_time = 0.0;
+    double query_time = 0.0;
+    std::size_t visible_count = 0;
+
+    if (index_ptr != nullptr)
+    {
+        index_ptr->clear();
+        double start = get_time();
+        for (BenchSprite& sprite : sprites)
+        {
+            sprite.handle = index_ptr->insert(get_bounds(sprite));
+        }
+        insert_time = get_time() - start;
+    }
+
+    for (int i = 0; i < QUERIES_COUNT; i++)
+    {
+        glm::vec4 view = make_view(world_side, rng);
+        handles.clear();
+        double start = get_time();
+        if (index_ptr != nullptr)
+        {
+            index_ptr->query(view, handles);
+        }
+        else
+        {
+            scan(sprites, view, handles);
+        }
+        query_time += get_time() - start;
+        visible_count += handles.size();
+    }
+
+    std::printf("%-14s | static | %8zu | insert %10.3f ms | query %10.3f us"
+        " | visible %6zu\n", name, sprites.size(), insert_time,
+        query_time * 1000.0 / QUERIES_COUNT, visible_count / QUERIES_COUNT);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_churn
+;
+; @brief
+;   Simulates frames in which every 10-th sprite moves and every 100-th sprite
+;   despawns and spawns at a new position, followed by one view query. Prints
+;   the average update and query times per frame.
+;
+; @params
+;   name        | Index name to print.
+;   index_ptr   | Index to measure. nullptr - the linear scan.
+;   sprites     | All sprites.
+;   world_side  | Side of the world square.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_churn(char const* name, SpatialIndex* index_ptr,
+    std::vector<BenchSprite>& sprites, float world_side)
+{
+    std::mt19937 rng(2);
+    std::vector<unsigned int> handles;
+    double update_time = 0.0;
+    double query_time = 0.0;
+
+    if (index_ptr != nullptr)
+    {
+        index_ptr->clear();
+        for (BenchSprite& sprite : sprites)
+        {
+            sprite.handle = index_ptr->insert(get_bounds(sprite));
+        }
+    }
+
+    for (int frame = 0; frame < FRAMES_COUNT; frame++)
+    {
+        double start = get_time();
+        for (std::size_t i = frame % MOVING_SPRITES_RATIO; i < sprites.size();
+            i += MOVING_SPRITES_RATIO)
+        {
+            BenchSprite& sprite = sprites[i];
+            if (i % RESPAWNING_SPRITES_RATIO == 0)
+            {
+                spawn_sprite(sprite, world_side, rng);
+                if (index_ptr != nullptr)
+                {
+                    index_ptr->remove(sprite.handle);
+                    sprite.handle = index_ptr->insert(get_bounds(sprite));
+                }
+                continue;
+            }
+            sprite.pos += sprite.velocity;
+            if (index_ptr != nullptr)
+            {
+                index_ptr->move(sprite.handle, get_bounds(sprite));
+            }
+        }
+        update_time += get_time() - start;
+
+        glm::vec4 view = make_view(world_side, rng);
+        handles.clear();
+        start = get_time();
+        if (index_ptr != nullptr)
+        {
+            index_ptr->query(view, handles);
+        }
+        else
+        {
+            scan(sprites, view, handles);
+        }
+        query_time += get_time() - start;
+    }
+
+    std::printf("%-14s | churn  | %8zu | update %10.3f ms | query %10.3f us"
+        "\n", name, sprites.size(), update_time / FRAMES_COUNT,
+        query_time * 1000.0 / FRAMES_COUNT);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_spatial_index_bench
+;
+; @brief
+;   Runs the static and churn benchmarks for all indices and sprite counts
+;   and prints the results to stdout.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_spatial_index_bench()
+{
+    std::size_t const counts[] = { 10000, 100000, 1000000 };
+
+    for (std::size_t count : counts)
+    {
+        float world_side = std::sqrt(static_cast<float>(count)) *
+            SPRITE_SPACING;
+        unsigned int depth = static_cast<unsigned int>(std::ceil(std::log2(
+            world_side / MAX_SPRITE_SIZE)));
+                                        /* The deepest cells fit the biggest */
+                                        /* sprites                           */
+        std::vector<BenchSprite> sprites(count);
+        std::mt19937 rng(0);
+        for (BenchSprite& sprite : sprites)
+        {
+            spawn_sprite(sprite, world_side, rng);
+        }
+
+        LooseQuadtree quadtree(glm::vec4(0.0f, 0.0f, world_side, world_side),
+            depth);
+        HashedGrid grid(GRID_CELL_SIZE);
+
+        std::vector<BenchSprite> initial_sprites = sprites;
+        bench_static("linear scan", nullptr, sprites, world_side);
+        bench_static("loose quadtree", &quadtree, sprites, world_side);
+        bench_static("hashed grid", &grid, sprites, world_side);
+        bench_churn("linear scan", nullptr, sprites, world_side);
+        sprites = initial_sprites;
+        bench_churn("loose quadtree", &quadtree, sprites, world_side);
+        sprites = initial_sprites;
+        bench_churn("hashed grid", &grid, sprites, world_side);
+    }
+}
@@ -0,0 +1,24 @@
+/**----------------------------------------------------------------------------
+; @file SpatialIndexBench.hpp
+;
+; @brief
+;   The file contains the declaration of the spatial index benchmark. The
+;   benchmark measures 'LooseQuadtree' and 'HashedGrid' against a linear scan
+;   for 10k, 100k and 1M sprites, for a static world (insert once, query the
+;   view) and for a churn-heavy world (a part of the sprites moves, spawns
+;   and despawns every frame).
+;
+;   Run with: EphProject.exe --bench spatial_index
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_spatial_index_bench();
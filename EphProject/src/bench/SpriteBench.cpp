@@ -0,0 +1,354 @@
+/**----------------------------------------------------------------------------
+; @file SpriteBench.cpp
+;
+; @brief
+;   The file implements the sprite stress benchmark.
+;
+;   All texture layers are created once: 4 texture 2d arrays of 32 layers,
+;   the first 16 layers of each array opaque, the other 16 translucent. A
+;   scene of M layers over A arrays takes layer i from the array 'i % A', so
+;   the layers of a scene are spread evenly over its arrays.
+;
+;   The frame time is measured from 'Renderer::begin' to the end of
+;   'glFinish'. The GL calls are counted by 'GlCallCounter' over the same
+;   span. The instances of moving sprites are written to a persistently
+;   mapped ring buffer, which no GL call sees, so their bytes are reported
+;   separately as 'streamed_bytes' (visible sprites * 'SpriteInstance').
+;
+;   In opaque scenes, submission order only changes the work of the
+;   renderer's sort (and of the 'StaticLayer' build), since both group the
+;   sprites by state anyway. Translucent sprites of one depth are drawn in
+;   submission order, so a random order also costs draw calls.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "GlCallCounter.hpp"
+#include "SpriteBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/Core.hpp"
+#include "../core/FrameTimer.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/SpriteInstance.hpp"
+#include "../core/StaticLayer.hpp"
+#include "../core/Texture2dArray.hpp"
+#include "../core/Texture2dArrayLayer.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define SPRITE_TEXTURE_SIZE 16
+#define TEXTURE_ARRAYS_COUNT 4
+#define ARRAY_LAYERS_COUNT 32           /* Opaque layers, then translucent   */
+#define OPAQUE_LAYERS_COUNT 16
+#define WARMUP_FRAMES_COUNT 10
+#define FRAMES_COUNT 60
+#define STEP_TIME (1.0f / 60.0f)        /* Moving sprites advance this much  */
+                                        /* every frame (in seconds)          */
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct SpriteScene
+{
+    unsigned int sprites_count;
+    unsigned int layers_count;
+    unsigned int arrays_count;
+    bool is_sorted;
+    bool is_moving;
+    bool is_translucent;
+};
+
+struct BenchSprite
+{
+    unsigned int layer_index;           /* In 'SpriteScene::layers_count'    */
+    glm::vec2 pos;
+    glm::vec2 velocity;                 /* In pixels per second              */
+    glm::vec2 size;
+    float rotation;
+};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func get_scene_layer
+;
+; @brief
+;   Returns the texture layer a scene uses for one of its layer indices.
+;
+; @params
+;   layers  | All layers, 'ARRAY_LAYERS_COUNT' per texture 2d array.
+;   scene   | The scene.
+;   index   | Layer index, below 'SpriteScene::layers_count'.
+;
+; @return
+;   Texture2dArrayLayer const*  | The layer.
+;
+----------------------------------------------------------------------------**/
+static Texture2dArrayLayer const* get_scene_layer(
+    std::vector<std::unique_ptr<Texture2dArrayLayer>> const& layers,
+    SpriteScene const& scene, unsigned int index)
+{
+    unsigned int array_index = index % scene.arrays_count;
+    unsigned int z_offset = index / scene.arrays_count +
+        (scene.is_translucent ? OPAQUE_LAYERS_COUNT : 0);
+    return layers[array_index * ARRAY_LAYERS_COUNT + z_offset].get();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bench_scene
+;
+; @brief
+;   Draws a scene for a number of frames and prints its results as a JSON
+;   object.
+;
+; @params
+;   renderer    | Renderer to draw with.
+;   layers      | All layers, 'ARRAY_LAYERS_COUNT' per texture 2d array.
+;   scene       | The scene to draw.
+;   is_first    | Whether this is the first scene printed (no separator).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_scene(Renderer& renderer,
+    std::vector<std::unique_ptr<Texture2dArrayLayer>> const& layers,
+    SpriteScene const& scene, bool is_first)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+
+    std::vector<BenchSprite> sprites(scene.sprites_count);
+    std::uint32_t random_state = 0x9E3779B9u;
+    for (BenchSprite& sprite : sprites)
+    {
+        sprite.layer_index = std::min(static_cast<unsigned int>(
+            get_random(random_state) * scene.layers_count),
+            scene.layers_count - 1);
+        sprite.pos = glm::vec2(get_random(random_state) * WINDOW_WIDTH,
+            get_random(random_state) * WINDOW_HEIGHT);
+        sprite.velocity = glm::vec2(get_random(random_state) - 0.5f,
+            get_random(random_state) - 0.5f) * 200.0f;
+        sprite.size = glm::vec2(4.0f + get_random(random_state) * 12.0f);
+        sprite.rotation = get_random(random_state) * 6.2831853f;
+    }
+    if (scene.is_sorted)
+    {                                   /* Grouped by texture 2d array, then */
+                                        /* by layer                          */
+        std::stable_sort(sprites.begin(), sprites.end(),
+            [&scene](BenchSprite const& a, BenchSprite const& b)
+            {
+                return a.layer_index % scene.arrays_count <
+                    b.layer_index % scene.arrays_count ||
+                    (a.layer_index % scene.arrays_count ==
+                    b.layer_index % scene.arrays_count &&
+                    a.layer_index < b.layer_index);
+            });
+    }
+
+    std::unique_ptr<StaticLayer> static_layer_ptr;
+    if (!scene.is_moving)
+    {
+        static_layer_ptr.reset(new StaticLayer(scene.sprites_count));
+        for (BenchSprite const& sprite : sprites)
+        {
+            static_layer_ptr->add(get_scene_layer(layers, scene,
+                sprite.layer_index), sprite.pos, sprite.size,
+                glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0, sprite.rotation,
+                glm::vec2(0.5f));
+        }
+    }
+
+    FrameTimer frame_timer(FRAMES_COUNT);
+    GlCallCounts total_counts = {};
+    unsigned long long streamed_bytes = 0;
+    unsigned long long visible_sprites_count = 0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        reset_gl_call_counts();
+        double start = get_time();
+        renderer.begin();
+        if (scene.is_moving)
+        {
+            for (BenchSprite& sprite : sprites)
+            {
+                sprite.pos += sprite.velocity * STEP_TIME;
+                if (sprite.pos.x < 0.0f || sprite.pos.x >= WINDOW_WIDTH)
+                {
+                    sprite.pos.x -= static_cast<float>(WINDOW_WIDTH) *
+                        (sprite.pos.x < 0.0f ? -1.0f : 1.0f);
+                }
+                if (sprite.pos.y < 0.0f || sprite.pos.y >= WINDOW_HEIGHT)
+                {
+                    sprite.pos.y -= static_cast<float>(WINDOW_HEIGHT) *
+                        (sprite.pos.y < 0.0f ? -1.0f : 1.0f);
+                }
+                renderer.submit_sprite(get_scene_layer(layers, scene,
+                    sprite.layer_index), sprite.pos, sprite.size,
+                    glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0, sprite.rotation,
+                    glm::vec2(0.5f));
+            }
+        }
+        else
+        {
+            renderer.draw_static_layer(static_layer_ptr.get());
+        }
+        renderer.flush();
+        glFinish();                     /* Wait for the GPU as well          */
+        double frame_time = get_time() - start;
+
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            GlCallCounts const& counts = get_gl_call_counts();
+            frame_timer.add_frame_time(static_cast<float>(frame_time));
+            total_counts.draw_calls += counts.draw_calls;
+            total_counts.texture_binds += counts.texture_binds;
+            total_counts.program_switches += counts.program_switches;
+            total_counts.uniform_uploads += counts.uniform_uploads;
+            total_counts.buffer_bytes += counts.buffer_bytes;
+            total_counts.texture_bytes += counts.texture_bytes;
+            unsigned int visible_count = scene.is_moving ?
+                renderer.get_visible_sprites_count() : scene.sprites_count;
+            visible_sprites_count += visible_count;
+            if (scene.is_moving)
+            {
+                streamed_bytes += visible_count * sizeof(SpriteInstance);
+            }
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    FrameTimeStats stats = frame_timer.get_stats();
+    std::printf("%s\n    {\"sprites\": %u, \"layers\": %u, \"arrays\": %u, "
+        "\"order\": \"%s\", \"motion\": \"%s\", \"blend\": \"%s\",\n",
+        is_first ? "" : ",", scene.sprites_count, scene.layers_count,
+        scene.arrays_count, scene.is_sorted ? "sorted" : "random",
+        scene.is_moving ? "moving" : "static",
+        scene.is_translucent ? "translucent" : "opaque");
+    std::printf("     \"frame_time_ms\": {\"avg\": %.3f, \"p50\": %.3f, "
+        "\"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n", stats.average,
+        stats.p50, stats.p95, stats.p99, stats.max);
+    std::printf("     \"per_frame\": {\"draw_calls\": %.1f, "
+        "\"texture_binds\": %.1f, \"program_switches\": %.1f, "
+        "\"uniform_uploads\": %.1f, \"buffer_bytes\": %.0f, "
+        "\"texture_bytes\": %.0f, \"streamed_bytes\": %.0f, "
+        "\"visible_sprites\": %.0f}}",
+        static_cast<double>(total_counts.draw_calls) / FRAMES_COUNT,
+        static_cast<double>(total_counts.texture_binds) / FRAMES_COUNT,
+        static_cast<double>(total_counts.program_switches) / FRAMES_COUNT,
+        static_cast<double>(total_counts.uniform_uploads) / FRAMES_COUNT,
+        static_cast<double>(total_counts.buffer_bytes) / FRAMES_COUNT,
+        static_cast<double>(total_counts.texture_bytes) / FRAMES_COUNT,
+        static_cast<double>(streamed_bytes) / FRAMES_COUNT,
+        static_cast<double>(visible_sprites_count) / FRAMES_COUNT);
+    std::fflush(stdout);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_sprite_bench
+;
+; @brief
+;   Creates a window, the textures and a renderer, draws every scene of the
+;   matrix and prints the results to stdout as one JSON document.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_sprite_bench()
+{
+    Core::instance().init_window("Eph Project - sprite bench",
+        { WINDOW_WIDTH, WINDOW_HEIGHT }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+    install_gl_call_counter();
+
+    {
+        std::vector<std::unique_ptr<Texture2dArray>> texture_2d_arrays;
+        std::vector<std::unique_ptr<Texture2dArrayLayer>> layers;
+        std::vector<unsigned char> pixels(SPRITE_TEXTURE_SIZE *
+            SPRITE_TEXTURE_SIZE * 4);
+        for (unsigned int i = 0; i < TEXTURE_ARRAYS_COUNT; i++)
+        {
+            texture_2d_arrays.emplace_back(new Texture2dArray(
+                SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE,
+                ARRAY_LAYERS_COUNT));
+            for (unsigned int z = 0; z < ARRAY_LAYERS_COUNT; z++)
+            {
+                for (std::size_t j = 0; j < pixels.size(); j += 4)
+                {                       /* A color per layer                 */
+                    pixels[j] = static_cast<unsigned char>(64 + i * 48);
+                    pixels[j + 1] = static_cast<unsigned char>(z * 8);
+                    pixels[j + 2] = static_cast<unsigned char>(255 - z * 8);
+                    pixels[j + 3] = z < OPAQUE_LAYERS_COUNT ? 255 : 128;
+                }
+                layers.emplace_back(new Texture2dArrayLayer(
+                    texture_2d_arrays.back().get(), z));
+                layers.back()->add_subimage(0, 0, SPRITE_TEXTURE_SIZE,
+                    SPRITE_TEXTURE_SIZE, 0, 0, pixels.data(),
+                    SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, 4);
+            }
+        }
+
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+        renderer.set_depth_mode(DEPTH_MODE_TWO_PASS);
+
+        unsigned int const sprites_counts[] = { 10000, 100000 };
+        unsigned int const layouts[][2] = { { 1, 1 }, { 16, 1 }, { 16, 4 } };
+                                        /* Layers, texture 2d arrays         */
+        bool is_first = true;
+        std::printf("{\"bench\": \"sprites\", \"frames\": %d, "
+            "\"width\": %d, \"height\": %d, \"scenes\": [", FRAMES_COUNT,
+            WINDOW_WIDTH, WINDOW_HEIGHT);
+        for (unsigned int sprites_count : sprites_counts)
+        {
+            for (auto const& layout : layouts)
+            {
+                for (int flags = 0; flags < 8; flags++)
+                {
+                    SpriteScene scene = { sprites_count, layout[0], layout[1],
+                        (flags & 1) == 0, (flags & 2) != 0,
+                        (flags & 4) != 0 };
+                    bench_scene(renderer, layers, scene, is_first);
+                    is_first = false;
+                }
+            }
+        }
+        std::printf("\n]}\n");
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+}
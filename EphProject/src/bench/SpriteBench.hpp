@@ -0,0 +1,32 @@
+/**----------------------------------------------------------------------------
+; @file SpriteBench.hpp
+;
+; @brief
+;   The file contains the declaration of the sprite stress benchmark. The
+;   benchmark draws a matrix of sprite scenes:
+;       - 10k and 100k sprites
+;       - 1 texture layer, 16 layers of one texture 2d array, 16 layers
+;         spread over 4 texture 2d arrays
+;       - sorted (by texture) and random submission order
+;       - static (a 'StaticLayer' built once) and moving (submitted every
+;         frame) sprites
+;       - opaque and translucent textures
+;   and prints, for each scene, the frame time percentiles and the draw
+;   calls, texture binds, program switches, uniform uploads and uploaded
+;   bytes per frame as JSON to stdout, so renderer changes can be compared
+;   by a script.
+;
+;   Run with: EphProject.exe --bench sprites --headless
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_sprite_bench();
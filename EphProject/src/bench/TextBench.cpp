@@ -0,0 +1,157 @@
+/**----------------------------------------------------------------------------
+; @file TextBench.cpp
+;
+; @brief
+;   The file implements the text rendering benchmark.
+;
+;   The strings fill the window, so every glyph passes the culling and is
+;   drawn. A frame is timed from 'Renderer::begin' to the end of 'glFinish',
+;   so the time includes both the CPU work (lookups, rasterization, uploads,
+;   submission) and the GPU work.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "TextBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/Core.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/BitmapFontRasterizer.hpp"
+#include "../core/GlyphCache.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define STRINGS_COUNT 500
+#define STRING_LENGTH 100               /* 50k glyphs per frame              */
+#define WARMUP_FRAMES_COUNT 10
+#define FRAMES_COUNT 100
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func bench_text
+;
+; @brief
+;   Draws the strings for a number of frames and prints the average frame
+;   time and the glyph cache counters per frame.
+;
+; @params
+;   name            | Scenario name to print.
+;   renderer        | Renderer to draw with.
+;   glyph_cache     | Glyph cache to draw from.
+;   strings         | Strings drawn each frame.
+;   pixel_heights   | Glyph heights, cycled over the strings.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void bench_text(char const* name, Renderer& renderer,
+    GlyphCache& glyph_cache, std::vector<std::string> const& strings,
+    std::vector<int> const& pixel_heights)
+{
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+    double frame_time = 0.0;
+    unsigned int glyphs_count = 0;
+
+    for (int frame = 0; frame < WARMUP_FRAMES_COUNT + FRAMES_COUNT; frame++)
+    {
+        if (frame == WARMUP_FRAMES_COUNT)
+        {                               /* Count the measured frames only    */
+            glyph_cache.reset_stats();
+        }
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        double start = get_time();
+        renderer.begin();
+        for (std::size_t i = 0; i < strings.size(); i++)
+        {
+            glm::vec2 pos(static_cast<float>(i % 16) * 16.0f,
+                static_cast<float>(i * (WINDOW_HEIGHT - 16) / strings.size()));
+            renderer.draw_text(&glyph_cache, strings[i], pos,
+                pixel_heights[i % pixel_heights.size()]);
+        }
+        glFinish();                     /* Wait for the GPU as well          */
+        if (frame >= WARMUP_FRAMES_COUNT)
+        {
+            frame_time += get_time() - start;
+            glyphs_count = renderer.get_visible_sprites_count();
+        }
+
+        glfwSwapBuffers(window_ptr);
+        glfwPollEvents();
+    }
+
+    std::printf("%-6s | %6u glyphs | %8.3f ms/frame | hits %6u | misses %5u "
+        "| evictions %5u\n", name, glyphs_count, frame_time / FRAMES_COUNT,
+        glyph_cache.get_hits_count() / FRAMES_COUNT,
+        glyph_cache.get_misses_count() / FRAMES_COUNT,
+        glyph_cache.get_evictions_count() / FRAMES_COUNT);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_text_bench
+;
+; @brief
+;   Creates a window and a renderer, runs the warm and the churn scenarios
+;   and prints the results to stdout.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_text_bench()
+{
+    Core::instance().init_window("Eph Project - text bench",
+        { WINDOW_WIDTH, WINDOW_HEIGHT }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+
+    std::vector<std::string> strings(STRINGS_COUNT);
+    for (std::size_t i = 0; i < strings.size(); i++)
+    {
+        for (int j = 0; j < STRING_LENGTH; j++)
+        {                               /* All printable ASCII characters    */
+            strings[i] += static_cast<char>('!' + (i * 7 + j) % 94);
+        }
+    }
+
+    {
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+        BitmapFontRasterizer font;
+        GlyphCache warm_cache(&font);   /* 256 slots: every glyph fits       */
+        GlyphCache small_cache(&font, 16, 128, 1);
+                                        /* 64 slots for 188 glyphs (2 sizes) */
+
+        std::printf("scene  |    visible    |    frame time    | per frame\n");
+        bench_text("warm", renderer, warm_cache, strings, { 8 });
+        bench_text("churn", renderer, small_cache, strings, { 8, 16 });
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+}
@@ -0,0 +1,24 @@
+/**----------------------------------------------------------------------------
+; @file TextBench.hpp
+;
+; @brief
+;   The file contains the declaration of the text rendering benchmark. The
+;   benchmark draws 50k glyphs per frame (500 strings of 100 characters, one
+;   instanced draw call per string) through 'Renderer::draw_text', once with
+;   a warm glyph cache and once with a cache too small for the glyphs in use,
+;   so glyphs are evicted and rasterized again every frame.
+;
+;   Run with: EphProject.exe --bench text
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_text_bench();
@@ -0,0 +1,268 @@
+/**----------------------------------------------------------------------------
+; @file TilemapBench.cpp
+;
+; @brief
+;   The file implements the tilemap streaming benchmark.
+;
+;   The map is procedural terrain: blocks of 16x16 tiles of the same kind
+;   with every 7-th block left empty, so the file is small (run-length
+;   encoded) and the chunks have varying numbers of tiles. The tileset is a
+;   generated 8x8 grid of colored tiles. A frame is timed from
+;   'Renderer::begin' to the end of 'glFinish'.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/vec2.hpp>
+
+#include "TilemapBench.hpp"
+#include "BenchUtils.hpp"
+#include "../core/Core.hpp"
+#include "../core/Renderer.hpp"
+#include "../core/Texture2dArray.hpp"
+#include "../core/Texture2dArrayLayer.hpp"
+#include "../core/Tilemap.hpp"
+#include "../core/TilemapFile.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define MAP_FILE_PATH "tilemap_bench.tilemap"
+#define MAP_SIZE 10000                  /* In tiles                          */
+#define CHUNK_SIZE 32                   /* In tiles                          */
+#define TILE_SIZE 32                    /* In pixels, on the screen and in   */
+                                        /* the tileset                       */
+#define TILESET_SIZE 8                  /* Tiles per side of the tileset     */
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define SCROLL_SPEED 24.0f              /* Pixels per frame, per axis        */
+#define FRAMES_COUNT 3000
+#define REPORT_FRAMES_COUNT 300         /* Frames per printed line           */
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func get_terrain_tile
+;
+; @brief
+;   Returns the tile of the procedural terrain at a map position.
+;
+; @params
+;   x   | Column (in tiles).
+;   y   | Row (in tiles).
+;
+; @return
+;   std::uint16_t   | Tile, 0 if empty.
+;
+----------------------------------------------------------------------------**/
+static std::uint16_t get_terrain_tile(int x, int y)
+{
+    std::uint32_t hash = static_cast<std::uint32_t>(x / 16) * 73856093u ^
+        static_cast<std::uint32_t>(y / 16) * 19349663u;
+    hash ^= hash >> 13;
+    hash *= 0x5BD1E995u;
+    hash ^= hash >> 15;
+    if (hash % 7 == 0)
+    {
+        return 0;
+    }
+    return static_cast<std::uint16_t>(1 + hash % (TILESET_SIZE *
+        TILESET_SIZE));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func generate_map
+;
+; @brief
+;   Writes the procedural terrain to the map file, chunk by chunk.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | false if the file cannot be written.
+;
+----------------------------------------------------------------------------**/
+static bool generate_map()
+{
+    TilemapFile file;
+    if (!file.create(MAP_FILE_PATH, { MAP_SIZE, MAP_SIZE }, CHUNK_SIZE))
+    {
+        return false;
+    }
+
+    double start = get_time();
+    std::vector<std::uint16_t> tiles(CHUNK_SIZE * CHUNK_SIZE);
+    glm::ivec2 chunks_count = file.get_chunks_count();
+    for (int chunk_y = 0; chunk_y < chunks_count.y; chunk_y++)
+    {
+        for (int chunk_x = 0; chunk_x < chunks_count.x; chunk_x++)
+        {
+            for (int y = 0; y < CHUNK_SIZE; y++)
+            {
+                for (int x = 0; x < CHUNK_SIZE; x++)
+                {
+                    int map_x = chunk_x * CHUNK_SIZE + x;
+                    int map_y = chunk_y * CHUNK_SIZE + y;
+                    tiles[y * CHUNK_SIZE + x] = map_x < MAP_SIZE &&
+                        map_y < MAP_SIZE ? get_terrain_tile(map_x, map_y) : 0;
+                }
+            }
+            if (!file.write_chunk({ chunk_x, chunk_y }, tiles))
+            {
+                return false;
+            }
+        }
+    }
+    file.close();
+    std::printf("generated %s (%dx%d tiles) in %.0f ms\n", MAP_FILE_PATH,
+        MAP_SIZE, MAP_SIZE, get_time() - start);
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func fill_tileset
+;
+; @brief
+;   Draws the tileset: a grid of tiles of distinct colors with a darker
+;   border, and uploads it to a texture 2d array layer.
+;
+; @params
+;   layer   | Layer of TILESET_SIZE x TILE_SIZE texels per side.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void fill_tileset(Texture2dArrayLayer& layer)
+{
+    int side = TILESET_SIZE * TILE_SIZE;
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(side) * side *
+        4);
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            int tile = (y / TILE_SIZE) * TILESET_SIZE + x / TILE_SIZE;
+            bool is_border = x % TILE_SIZE == 0 || y % TILE_SIZE == 0;
+            unsigned char* pixel_ptr = &pixels[(static_cast<std::size_t>(y) *
+                side + x) * 4];
+            pixel_ptr[0] = static_cast<unsigned char>(64 + tile * 37 % 192);
+            pixel_ptr[1] = static_cast<unsigned char>(64 + tile * 71 % 192);
+            pixel_ptr[2] = static_cast<unsigned char>(64 + tile * 113 % 192);
+            if (is_border)
+            {
+                pixel_ptr[0] /= 2;
+                pixel_ptr[1] /= 2;
+                pixel_ptr[2] /= 2;
+            }
+            pixel_ptr[3] = 0xFF;
+        }
+    }
+    layer.add_subimage(0, 0, side, side, 0, 0, pixels.data(), side, side, 4);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_tilemap_bench
+;
+; @brief
+;   Generates the map file if it does not exist, scrolls the view across the
+;   map and prints the results to stdout every REPORT_FRAMES_COUNT frames.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void run_tilemap_bench()
+{
+    {
+        TilemapFile file;               /* Generate the map on the first run */
+        if (!file.open(MAP_FILE_PATH) && !generate_map())
+        {
+            std::fprintf(stderr, "Unable to generate %s\n", MAP_FILE_PATH);
+            return;
+        }
+    }
+
+    Core::instance().init_window("Eph Project - tilemap bench",
+        { WINDOW_WIDTH, WINDOW_HEIGHT }, false, 0);
+    Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
+        "src/core/shaders/txd_array_fragment.shader");
+    GLFWwindow* window_ptr = Core::instance().get_window_ptr();
+
+    {
+        Texture2dArray texture_2d_array(TILESET_SIZE * TILE_SIZE,
+            TILESET_SIZE * TILE_SIZE, 1);
+        Texture2dArrayLayer layer(&texture_2d_array, 0);
+        fill_tileset(layer);
+
+        Renderer renderer(Core::instance().get_shader_ptr(),
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+        Tilemap tilemap(MAP_FILE_PATH, { &layer, { 0.0f, 0.0f, 1.0f, 1.0f },
+            { TILESET_SIZE, TILESET_SIZE } }, { TILE_SIZE, TILE_SIZE },
+            { WINDOW_WIDTH, WINDOW_HEIGHT });
+
+        std::printf("frames      | avg ms | max ms | resident chunks | "
+            "uploads\n");
+        double total_time = 0.0;
+        double max_time = 0.0;
+        unsigned int max_resident_count = 0;
+        glm::vec2 camera(0.0f);
+        for (int frame = 1; frame <= FRAMES_COUNT; frame++)
+        {
+            renderer.set_view(glm::translate(glm::mat4(1.0f),
+                glm::vec3(-camera, 0.0f)));
+            camera += SCROLL_SPEED;
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            double start = get_time();
+            renderer.begin();
+            renderer.draw_tilemap(&tilemap);
+            glFinish();                 /* Wait for the GPU as well          */
+            double frame_time = get_time() - start;
+            total_time += frame_time;
+            max_time = std::max(max_time, frame_time);
+            max_resident_count = std::max(max_resident_count,
+                tilemap.get_resident_chunks_count());
+
+            if (frame % REPORT_FRAMES_COUNT == 0)
+            {
+                std::printf("%5d-%5d | %6.3f | %6.3f | %15u | %7u\n",
+                    frame - REPORT_FRAMES_COUNT + 1, frame,
+                    total_time / REPORT_FRAMES_COUNT, max_time,
+                    max_resident_count, tilemap.get_loads_count());
+                total_time = 0.0;
+                max_time = 0.0;
+                max_resident_count = 0;
+                tilemap.reset_stats();
+            }
+
+            glfwSwapBuffers(window_ptr);
+            glfwPollEvents();
+        }
+    }                                   /* Free the GL objects before the    */
+    glfwTerminate();                    /* context is destroyed              */
+}
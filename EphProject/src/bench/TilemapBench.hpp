@@ -0,0 +1,24 @@
+/**----------------------------------------------------------------------------
+; @file TilemapBench.hpp
+;
+; @brief
+;   The file contains the declaration of the tilemap streaming benchmark. The
+;   benchmark scrolls the view across a 10000x10000-tile map streamed from
+;   disk ('Tilemap') and prints the frame time, the resident chunks and the
+;   chunk uploads over the run, which should all stay flat. The map file is
+;   generated on the first run.
+;
+;   Run with: EphProject.exe --bench tilemap
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void run_tilemap_bench();
@@ -0,0 +1,40 @@
+/**----------------------------------------------------------------------------
+; @file BitmapFontRasterizer.hpp
+;
+; @brief
+;   This file describes the 'BitmapFontRasterizer' class. This class is the
+;   built-in 'GlyphRasterizer': it rasterizes the printable ASCII characters
+;   (0x20 - 0x7E) of an embedded 8x8 bitmap font (the public domain
+;   'font8x8_basic' by Daniel Hepper), scaled by an integer factor to the
+;   requested pixel height. It needs no font files, so text can be drawn
+;   out of the box.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include "GlyphRasterizer.hpp"
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class BitmapFontRasterizer : public GlyphRasterizer
+{
+public:
+    bool rasterize(unsigned int codepoint, int pixel_height,
+        GlyphBitmap& glyph_bitmap) const override;
+    int get_line_height(int pixel_height) const override;
+
+    static constexpr int CELL_SIZE = 8; /* Glyph cell of the font (pixels)   */
+
+private:
+    static int get_scale(int pixel_height);
+};
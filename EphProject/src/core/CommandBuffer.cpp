@@ -0,0 +1,406 @@
+/**----------------------------------------------------------------------------
+; @file CommandBuffer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'CommandBuffer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+
+#include <glm/common.hpp>
+
+#include "CommandBuffer.hpp"
+#include "DrawQueue.hpp"
+#include "Log.hpp"
+#include "SpriteCuller.hpp"
+#include "SpriteInstance.hpp"
+#include "SpriteTransforms.hpp"
+#include "Texture2dArrayLayer.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func CommandBuffer
+;
+; @brief
+;   Constructor. Nothing is allocated until the first command is recorded.
+;
+; @params
+;   block_size  | Size of a block of the linear allocator (in bytes). Must
+;               | hold the largest command (a run with one instance).
+;
+----------------------------------------------------------------------------**/
+CommandBuffer::CommandBuffer(std::size_t block_size)
+    :allocator_(block_size), cull_rect_(0.0f), texture_2d_array_ptr_(nullptr),
+    draw_command_ptr_(nullptr), commands_count_(0), culled_sprites_count_(0)
+{
+    std::size_t max_command_size = std::max({
+        sizeof(BindTexture2dArrayCommand),
+        sizeof(DrawInstancesCommand) + sizeof(SpriteInstance),
+        sizeof(SetTintCommand), sizeof(DrawStaticLayerCommand),
+        sizeof(DrawTilemapCommand) });
+    max_command_size = (max_command_size + LinearAllocator::ALIGNMENT - 1) /
+        LinearAllocator::ALIGNMENT * LinearAllocator::ALIGNMENT;
+    if (block_size < max_command_size)
+    {                                   /* 'add_command' would get nullptr   */
+        LOG_ERROR("The block size of the command buffer is too small.");
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin
+;
+; @brief
+;   Discards all recorded commands and starts recording. The memory of the
+;   linear allocator is kept and reused.
+;
+; @params
+;   cull_rect   | The view rectangle in world space (min x, min y, max x,
+;               | max y), see 'Renderer::get_cull_rect'. Sprites outside it
+;               | are not recorded.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::begin(glm::vec4 const& cull_rect)
+{
+    this->allocator_.reset();
+    this->cull_rect_ = cull_rect;
+    this->texture_2d_array_ptr_ = nullptr;
+    this->draw_command_ptr_ = nullptr;
+    this->commands_count_ = 0;
+    this->culled_sprites_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_texture_2d_array
+;
+; @brief
+;   Records a texture 2d array bind. 'draw_sprite' does it on its own when
+;   the texture 2d array of the sprite changes.
+;
+; @params
+;   texture_2d_array_ptr    | Texture 2d array the following sprites are
+;                           | taken from.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::bind_texture_2d_array(
+    Texture2dArray const* texture_2d_array_ptr)
+{
+    BindTexture2dArrayCommand* command_ptr =
+        static_cast<BindTexture2dArrayCommand*>(this->add_command(
+            COMMAND_BIND_TEXTURE_2D_ARRAY,
+            sizeof(BindTexture2dArrayCommand)));
+    command_ptr->texture_2d_array_ptr = texture_2d_array_ptr;
+    this->texture_2d_array_ptr_ = texture_2d_array_ptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_sprite
+;
+; @brief
+;   Records a sprite: computes its transform (see
+;   'SpriteTransforms::compute_transform'), culls it and appends its instance
+;   to the current run. The parameters have the same meaning as for
+;   'Renderer::submit_sprite', but the sprites are drawn in recording order
+;   (not sorted by depth).
+;
+; @params
+;   texture_2d_array_layer_ptr  | Texture layer the sprite is taken from.
+;   pos                         | Position of the pivot (in pixels).
+;   size                        | Sprite size (in pixels).
+;   txd_rect                    | xy - offset, zw - size of the sprite region
+;                               | on the layer (in normalized texture
+;                               | coordinates). The whole layer by default.
+;   depth                       | Depth of the sprite (see
+;                               | 'DrawQueue::get_clip_depth').
+;   rotation                    | Clockwise rotation around the pivot (in
+;                               | radians).
+;   pivot                       | The pivot relative to the size.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::draw_sprite(
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec2 const& pos, glm::vec2 const& size, glm::vec4 const& txd_rect,
+    int depth, float rotation, glm::vec2 const& pivot)
+{
+    glm::vec4 transform;
+    glm::vec2 translation;
+    SpriteTransforms::compute_transform(pos, size, rotation, pivot, transform,
+        translation);
+    glm::vec2 bounds_min = translation + glm::min(glm::vec2(transform.x,
+        transform.y), 0.0f) + glm::min(glm::vec2(transform.z, transform.w),
+        0.0f);
+    glm::vec2 bounds_max = translation + glm::max(glm::vec2(transform.x,
+        transform.y), 0.0f) + glm::max(glm::vec2(transform.z, transform.w),
+        0.0f);                          /* Bounds of the transformed quad    */
+    if (!SpriteCuller::is_visible(this->cull_rect_, bounds_min,
+        bounds_max - bounds_min))
+    {
+        this->culled_sprites_count_++;
+        return;
+    }
+
+    Texture2dArray const* texture_2d_array_ptr =
+        texture_2d_array_layer_ptr->get_texture_2d_array();
+    if (texture_2d_array_ptr != this->texture_2d_array_ptr_)
+    {
+        this->bind_texture_2d_array(texture_2d_array_ptr);
+    }
+
+    SpriteInstance* instance_ptr = nullptr;
+    if (this->draw_command_ptr_ != nullptr &&
+        this->allocator_.fits(sizeof(SpriteInstance)))
+    {                                   /* Right after the previous instance */
+        instance_ptr = static_cast<SpriteInstance*>(
+            this->allocator_.allocate(sizeof(SpriteInstance)));
+        this->draw_command_ptr_->header.size += sizeof(SpriteInstance);
+        this->draw_command_ptr_->instances_count++;
+    }
+    else
+    {                                   /* Start a run, in the next block if */
+                                        /* this one is full                  */
+        DrawInstancesCommand* command_ptr = static_cast<DrawInstancesCommand*>(
+            this->add_command(COMMAND_DRAW_INSTANCES,
+                sizeof(DrawInstancesCommand) + sizeof(SpriteInstance)));
+        command_ptr->instances_count = 1;
+        command_ptr->reserved = 0;
+        instance_ptr = reinterpret_cast<SpriteInstance*>(command_ptr + 1);
+        this->draw_command_ptr_ = command_ptr;
+    }
+
+    instance_ptr->transform = transform;
+    instance_ptr->translation = translation;
+    instance_ptr->txd_rect = txd_rect;
+    instance_ptr->z_offset = texture_2d_array_layer_ptr->get_z_offset();
+    instance_ptr->depth = DrawQueue::get_clip_depth(depth);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_tint
+;
+; @brief
+;   Records a tint change. The sprites recorded after it are multiplied by
+;   the tint. The tint is reset to white after each replayed buffer.
+;
+; @params
+;   tint    | The color the texels are multiplied by.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::set_tint(glm::vec4 const& tint)
+{
+    SetTintCommand* command_ptr = static_cast<SetTintCommand*>(
+        this->add_command(COMMAND_SET_TINT, sizeof(SetTintCommand)));
+    command_ptr->tint = tint;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_static_layer
+;
+; @brief
+;   Records a static layer draw (see 'Renderer::draw_static_layer'). The
+;   layer is only referenced: it must stay alive and must not be changed
+;   until the buffer is replayed.
+;
+; @params
+;   static_layer_ptr    | Static layer to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::draw_static_layer(StaticLayer* static_layer_ptr)
+{
+    DrawStaticLayerCommand* command_ptr = static_cast<DrawStaticLayerCommand*>(
+        this->add_command(COMMAND_DRAW_STATIC_LAYER,
+            sizeof(DrawStaticLayerCommand)));
+    command_ptr->static_layer_ptr = static_layer_ptr;
+    this->texture_2d_array_ptr_ = nullptr;
+                                        /* The layer binds its own arrays    */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_tilemap
+;
+; @brief
+;   Records a tilemap draw (see 'Renderer::draw_tilemap'). The tilemap is
+;   only referenced: it must stay alive until the buffer is replayed.
+;
+; @params
+;   tilemap_ptr | Tilemap to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CommandBuffer::draw_tilemap(Tilemap* tilemap_ptr)
+{
+    DrawTilemapCommand* command_ptr = static_cast<DrawTilemapCommand*>(
+        this->add_command(COMMAND_DRAW_TILEMAP, sizeof(DrawTilemapCommand)));
+    command_ptr->tilemap_ptr = tilemap_ptr;
+    this->texture_2d_array_ptr_ = nullptr;
+                                        /* The tilemap binds its own array   */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_blocks_count
+;
+; @brief
+;   Returns the number of memory blocks that hold the recorded commands.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of blocks.
+;
+----------------------------------------------------------------------------**/
+std::size_t CommandBuffer::get_blocks_count() const
+{
+    return this->allocator_.get_blocks_count();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_block
+;
+; @brief
+;   Returns a memory block of recorded commands. The block holds whole
+;   commands, one after another ('CommandHeader::size' bytes each), and the
+;   blocks are in recording order.
+;
+; @params
+;   index       | Index of the block, below 'get_blocks_count'.
+;   used_size   | Output: the size of the commands in the block (in bytes).
+;
+; @return
+;   unsigned char const*    | The first command of the block.
+;
+----------------------------------------------------------------------------**/
+unsigned char const* CommandBuffer::get_block(std::size_t index,
+    std::size_t& used_size) const
+{
+    return this->allocator_.get_block(index, used_size);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_commands_count
+;
+; @brief
+;   Returns the number of commands recorded since the last 'begin' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of commands.
+;
+----------------------------------------------------------------------------**/
+unsigned int CommandBuffer::get_commands_count() const
+{
+    return this->commands_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_culled_sprites_count
+;
+; @brief
+;   Returns the number of sprites that were culled, i.e. not recorded, since
+;   the last 'begin' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of culled sprites.
+;
+----------------------------------------------------------------------------**/
+unsigned int CommandBuffer::get_culled_sprites_count() const
+{
+    return this->culled_sprites_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_used_size
+;
+; @brief
+;   Returns the size of the recorded commands.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The size of the commands (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::size_t CommandBuffer::get_used_size() const
+{
+    return this->allocator_.get_used_size();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add_command
+;
+; @brief
+;   Allocates a command and fills in its header. Ends the current run of
+;   instances: the next sprite starts a new one.
+;
+; @params
+;   type    | Type of the command.
+;   size    | Size of the command including the header (in bytes).
+;
+; @return
+;   void*   | The command (its header).
+;
+----------------------------------------------------------------------------**/
+void* CommandBuffer::add_command(enCommandType type, std::size_t size)
+{
+    size = (size + LinearAllocator::ALIGNMENT - 1) /
+        LinearAllocator::ALIGNMENT * LinearAllocator::ALIGNMENT;
+                                        /* What the allocator really takes,  */
+                                        /* so the commands are contiguous    */
+    CommandHeader* header_ptr = static_cast<CommandHeader*>(
+        this->allocator_.allocate(size));
+    if (header_ptr == nullptr)
+    {                                   /* Larger than a block, see the      */
+                                        /* constructor                       */
+        LOG_ERROR("Failed to allocate a command.");
+        return nullptr;
+    }
+    header_ptr->type = type;
+    header_ptr->size = static_cast<std::uint32_t>(size);
+    this->draw_command_ptr_ = nullptr;
+    this->commands_count_++;
+    return header_ptr;
+}
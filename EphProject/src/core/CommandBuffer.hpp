@@ -0,0 +1,160 @@
+/**----------------------------------------------------------------------------
+; @file CommandBuffer.hpp
+;
+; @brief
+;   This file describes the 'CommandBuffer' class. This class records draw
+;   commands without touching OpenGL, so command buffers can be recorded on
+;   any thread (e.g. one per worker of a 'WorkerPool') and replayed later on
+;   the thread that owns the context ('Renderer::execute').
+;
+;   A command is a 'CommandHeader' (type and size) followed by its data, in
+;   the memory of a 'LinearAllocator' owned by the buffer:
+;       - 'COMMAND_BIND_TEXTURE_2D_ARRAY' - sprites that follow are taken
+;         from this texture 2d array
+;       - 'COMMAND_DRAW_INSTANCES' - 'SpriteInstance' elements, ready to be
+;         copied to the GPU as they are
+;       - 'COMMAND_SET_TINT' - color the following sprites are multiplied by
+;       - 'COMMAND_DRAW_STATIC_LAYER', 'COMMAND_DRAW_TILEMAP' - draw an
+;         object that keeps its data on the GPU
+;
+;   All per-sprite work happens while recording: 'draw_sprite' computes the
+;   2d affine transform, culls the sprite against the view and writes the
+;   instance right after the previous one of the same texture 2d array, so a
+;   run of sprites becomes one 'COMMAND_DRAW_INSTANCES' command. Replaying
+;   is then a copy of the instances into the sprite batch and one instanced
+;   draw call per run.
+;
+;   The commands are replayed in recording order, and several buffers in the
+;   order they are passed to the renderer, so the result does not depend on
+;   which thread recorded what. The allocator keeps its memory on 'begin':
+;   recording allocates nothing once the buffer has grown to its largest
+;   frame.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "LinearAllocator.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class StaticLayer;
+class Texture2dArray;
+class Texture2dArrayLayer;
+class Tilemap;
+struct SpriteInstance;
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enCommandType
+{
+    COMMAND_BIND_TEXTURE_2D_ARRAY = 0,
+    COMMAND_DRAW_INSTANCES = 1,
+    COMMAND_SET_TINT = 2,
+    COMMAND_DRAW_STATIC_LAYER = 3,
+    COMMAND_DRAW_TILEMAP = 4,
+};
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct CommandHeader
+{
+    std::uint32_t type;                 /* See 'enCommandType'               */
+    std::uint32_t size;                 /* In bytes, including the header    */
+                                        /* and the data that follows         */
+};
+
+struct BindTexture2dArrayCommand
+{
+    CommandHeader header;
+    Texture2dArray const* texture_2d_array_ptr;
+};
+
+struct DrawInstancesCommand
+{
+    CommandHeader header;
+    std::uint32_t instances_count;      /* 'SpriteInstance' elements follow  */
+    std::uint32_t reserved;             /* the command                       */
+};
+
+struct SetTintCommand
+{
+    CommandHeader header;
+    glm::vec4 tint;
+};
+
+struct DrawStaticLayerCommand
+{
+    CommandHeader header;
+    StaticLayer* static_layer_ptr;
+};
+
+struct DrawTilemapCommand
+{
+    CommandHeader header;
+    Tilemap* tilemap_ptr;
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class CommandBuffer
+{
+public:
+    CommandBuffer(std::size_t block_size =
+        LinearAllocator::DEFAULT_BLOCK_SIZE);
+
+    void begin(glm::vec4 const& cull_rect);
+    void bind_texture_2d_array(Texture2dArray const* texture_2d_array_ptr);
+    void draw_sprite(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec2 const& pos, glm::vec2 const& size,
+        glm::vec4 const& txd_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+        int depth = 0, float rotation = 0.0f,
+        glm::vec2 const& pivot = glm::vec2(0.0f));
+    void set_tint(glm::vec4 const& tint);
+    void draw_static_layer(StaticLayer* static_layer_ptr);
+    void draw_tilemap(Tilemap* tilemap_ptr);
+
+    std::size_t get_blocks_count() const;
+    unsigned char const* get_block(std::size_t index,
+        std::size_t& used_size) const;
+    unsigned int get_commands_count() const;
+    unsigned int get_culled_sprites_count() const;
+    std::size_t get_used_size() const;
+
+private:
+    LinearAllocator allocator_;
+    glm::vec4 cull_rect_;               /* min x, min y, max x, max y        */
+    Texture2dArray const* texture_2d_array_ptr_;
+                                        /* The last bound texture 2d array   */
+    DrawInstancesCommand* draw_command_ptr_;
+                                        /* The command new instances are     */
+                                        /* appended to, nullptr if none      */
+    unsigned int commands_count_;
+    unsigned int culled_sprites_count_;
+
+    void* add_command(enCommandType type, std::size_t size);
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+};
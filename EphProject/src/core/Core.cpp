@@ -13,6 +13,8 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 #include <vector>
@@ -22,7 +24,10 @@
 
 #include "Core.hpp"
 #include "Log.hpp"
+#include "CpuProfiler.hpp"
+#include "GlState.hpp"
 #include "Shader.hpp"
+#include "Framebuffer.hpp"
 #include "Image.hpp"
 #include "Texture2dArray.hpp"
 #include "Texture2dArrayLayer.hpp"
@@ -30,6 +35,11 @@
 #include "IndicesData.hpp"
 #include "Sprite.hpp"
 #include "Renderer.hpp"
+#include "StaticLayer.hpp"
+#include "BitmapFontRasterizer.hpp"
+#include "GlyphCache.hpp"
+#include "GpuProfiler.hpp"
+#include "ParticleSystem.hpp"
 
 
 
@@ -55,11 +65,37 @@ Core& Core::instance()
 }
 
 
+/**----------------------------------------------------------------------------
+; @func set_headless
+;
+; @brief
+;   Selects the headless mode for the next 'init_window' call: the window is
+;   created hidden, without vsync, and everything is rendered into an
+;   offscreen framebuffer of the window size ('get_framebuffer_ptr'). Lets
+;   the renderer run on machines without a display (e.g. under Xvfb with
+;   Mesa llvmpipe) for benchmarks and regression runs.
+;
+; @params
+;   is_headless | Whether to render offscreen.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::set_headless(bool is_headless)
+{
+    this->is_headless_ = is_headless;
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func init_window
 ;
 ; @brief
 ;   Initialize GLFW, GLAD. Create a window.
+;   In the headless mode (see 'set_headless') the window is hidden, the
+;   full screen and swap interval parameters are ignored (no vsync), and an
+;   offscreen framebuffer of the window size is created and bound.
 ;
 ; @params
 ;   window_title    | Title of the window to be created.
@@ -85,6 +121,15 @@ void Core::init_window(char const* window_title, glm::ivec2 const& window_size,
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_DEPTH_BITS, 24);
+                                        /* Request a depth attachment for    */
+                                        /* the opaque pass of the renderer   */
+    if (this->is_headless_)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        is_full_screen = false;
+        swap_interval = 0;              /* Measure frames, not the display   */
+    }
     if (is_full_screen)
     {
         monitor_ptr = glfwGetPrimaryMonitor();
@@ -109,10 +154,20 @@ void Core::init_window(char const* window_title, glm::ivec2 const& window_size,
         LOG_ERROR("Failed to initialize GLAD");
         exit(-1);
     }
+    this->gl_state_ptr_ = new GlState();
+    GlState::make_current(this->gl_state_ptr_);
+                                        /* All core classes change the       */
+                                        /* OpenGL state through this cache   */
     glViewport(0, 0, window_size.x, window_size.y);
-    glEnable(GL_BLEND);                 /* Enable GL_BLEND to support        */
+    this->gl_state_ptr_->set_blend(true);
+                                        /* Enable GL_BLEND to support        */
                                         /* transparent textures              */
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    this->gl_state_ptr_->set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (this->is_headless_)
+    {
+        this->framebuffer_ptr_ = new Framebuffer(window_size);
+        this->framebuffer_ptr_->bind();
+    }
 }
 
 
@@ -121,7 +176,8 @@ void Core::init_window(char const* window_title, glm::ivec2 const& window_size,
 ;
 ; @brief
 ;   Reads the contents of the vertex and fragment shader files and passes it to
-;   the constructor of the 'Shader' class. Binds the created shader.
+;   the constructor of the 'Shader' class. Binds the created shader. A program
+;   created by a previous call is deleted.
 ;   For more details, see the description of the 'Shader' class constructor.
 ;
 ; @params
@@ -137,58 +193,126 @@ void Core::init_window(char const* window_title, glm::ivec2 const& window_size,
 void Core::init_shaders(const char* vertex_shader_file_path,
                         const char* fragment_shader_file_path)
 {
-    std::ifstream vertex_shader_file;
-    std::ifstream fragment_shader_file;
-    std::stringstream vertex_shader_lines;
-    std::stringstream fragment_shader_lines;
+    std::string vertex_shader_source = Core::read_shader_file(
+        vertex_shader_file_path);
+    std::string fragment_shader_source = Core::read_shader_file(
+        fragment_shader_file_path);
+    delete this->shader_ptr_;           /* Replace the previous program      */
+    this->shader_ptr_ = new Shader(vertex_shader_source.c_str(),
+        fragment_shader_source.c_str());
+    this->shader_ptr_->use();           /* Bind created shader               */
+}
 
-    vertex_shader_file.exceptions(std::ifstream::failbit |
-        std::ifstream::badbit);         /* Set exception mask to detect      */
-                                        /* failbit and badbit errors while   */
-                                        /* opening a vertex shader file      */
-    fragment_shader_file.exceptions(std::ifstream::failbit |
-        std::ifstream::badbit);         /* Set exception mask to detect      */
-                                        /* failbit and badbit errors while   */
-                                        /* opening a fragment shader file    */
-    try
-    {
-        vertex_shader_file.open(vertex_shader_file_path);
-                                        /* Open vertex shader file           */
-        vertex_shader_lines << vertex_shader_file.rdbuf();
-                                        /* Read vertex shader file's buffer  */
-                                        /* Content into stream               */
-        vertex_shader_file.close();     /* Close vertex shader file handler  */
-    }
-    catch (std::ifstream::failure& e)
-    {
-        std::string error_msg = "Failed to read a file: " +
-            std::string(vertex_shader_file_path) + ". Error code: " +
-            std::to_string(e.code().value()) +  ". " + std::string(e.what());
-        LOG_ERROR(error_msg.c_str());
-    }
-    try
-    {
-        fragment_shader_file.open(fragment_shader_file_path);
-                                        /* Open fragment shader file         */
-        fragment_shader_lines << fragment_shader_file.rdbuf();
-                                        /* Read fragment shader file's       */
-                                        /* buffer                            */
-        fragment_shader_file.close();   /* Close fragment shader file        */
-                                        /* handler                           */
-    }
-    catch (std::ifstream::failure& e)
+
+/**----------------------------------------------------------------------------
+; @func init_cull_shader
+;
+; @brief
+;   Reads the contents of the compute shader file that culls static layers on
+;   the GPU and creates a compute shader program from it. The renderer of the
+;   main loop uses it (see 'Renderer::set_cull_shader'). Without the call the
+;   static layers are not culled. A program created by a previous call is
+;   deleted.
+;
+; @params
+;   compute_shader_file_path  | The path to the compute shader source file.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::init_cull_shader(const char* compute_shader_file_path)
+{
+    std::string compute_shader_source = Core::read_shader_file(
+        compute_shader_file_path);
+    delete this->cull_shader_ptr_;      /* Replace the previous program      */
+    this->cull_shader_ptr_ = new Shader(compute_shader_source.c_str());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func init_particle_shader
+;
+; @brief
+;   Reads the contents of the compute shader file that simulates GPU particle
+;   systems and creates a compute shader program from it. The program is
+;   passed to the 'GpuParticleSystem' objects (see 'get_particle_shader_ptr').
+;   A program created by a previous call is deleted.
+;
+; @params
+;   compute_shader_file_path  | The path to the compute shader source file.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::init_particle_shader(const char* compute_shader_file_path)
+{
+    std::string compute_shader_source = Core::read_shader_file(
+        compute_shader_file_path);
+    delete this->particle_shader_ptr_;  /* Replace the previous program      */
+    this->particle_shader_ptr_ = new Shader(compute_shader_source.c_str());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_fixed_update
+;
+; @brief
+;   Switches the main loop to a fixed simulation step: every iteration the
+;   fixed update function is called as many times as whole steps fit into
+;   the time elapsed (zero, one or more), then the render callback is called
+;   once. The render callback gets the fraction of a step left over from
+;   'get_interpolation_alpha', to interpolate between the last two
+;   simulated states.
+;   After a long frame (e.g. a breakpoint or loading) at most
+;   'max_steps_count' steps are run and the rest of the time is dropped, so
+;   a slow simulation cannot fall further behind every frame (the spiral of
+;   death). The dropped steps are counted, see 'get_dropped_steps_count'.
+;
+; @params
+;   fixed_update_func   | Simulation step, gets the step time (in seconds).
+;                       | nullptr - back to update and render in lockstep.
+;   step_time           | Simulated time per step (in seconds).
+;   max_steps_count     | Maximum number of steps per frame.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::set_fixed_update(void(*fixed_update_func)(float), float step_time,
+                            unsigned int max_steps_count)
+{
+    if (step_time <= 0.0f || max_steps_count == 0)
     {
-        std::string error_msg = "Failed to read a file: " +
-            std::string(vertex_shader_file_path) + ". Error code: " +
-            std::to_string(e.code().value()) + ". " + std::string(e.what());
-        LOG_ERROR(error_msg.c_str());
+        LOG_ERROR("Invalid fixed step parameters.");
+        return;
     }
-    this->shader_ptr_ = new Shader(vertex_shader_lines.str().c_str(),
-        fragment_shader_lines.str().c_str());
-                                        /* Convert stream into c-string and  */
-                                        /* pass them to the constructor of   */
-                                        /* 'Shader' class                    */
-    this->shader_ptr_->use();           /* Bind created shader               */
+    this->fixed_update_func_ = fixed_update_func;
+    this->fixed_step_time_ = step_time;
+    this->max_steps_count_ = max_steps_count;
+    this->accumulated_time_ = 0.0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_frames_limit
+;
+; @brief
+;   Makes the main loop exit after a fixed number of iterations, e.g. for
+;   benchmarks and regression runs (in the headless mode the window is never
+;   closed by the user).
+;
+; @params
+;   frames_limit    | Number of iterations, 0 - until the window is closed.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::set_frames_limit(unsigned int frames_limit)
+{
+    this->frames_limit_ = frames_limit;
 }
 
 
@@ -196,10 +320,16 @@ void Core::init_shaders(const char* vertex_shader_file_path,
 ; @func start_main_loop
 ;
 ; @brief
-;   Runs the render loop. Each iteration of the render loop clears the screen,
-;   calls a custom function (to draw/compute logic, etc.), and swaps the front
-;   and back buffers. After exiting the render loop, the GLFW windows will be
-;   destroyed, the allocated resources will be freed.
+;   Runs the render loop. Each iteration of the render loop measures the
+;   frame time (see 'get_frame_timer'), resets the render statistics of the
+;   frame (see 'get_frame_stats'), runs the fixed simulation steps if
+;   any (see 'set_fixed_update'), clears the screen, calls a custom function
+;   (to draw/compute logic, etc.), and swaps the front and back buffers.
+;   In the headless mode the buffers are not swapped; the iteration waits
+;   for the GPU instead ('glFinish'), so the frame time covers its work.
+;   The loop ends when the window is closed or after the frames limit (see
+;   'set_frames_limit'). After exiting the render loop, the GLFW windows
+;   will be destroyed, the allocated resources will be freed.
 ;
 ; @params
 ;   main_loop_iteration_func
@@ -207,7 +337,6 @@ void Core::init_shaders(const char* vertex_shader_file_path,
 ; @return
 ;   None
 ;
-; // TODO: Sync, calc FPS.
 ; // TODO: This function should only start the loop. So, move initialization
 ;          'main_loop_iteration_func_' to another function and add
 ;          is-main-loop-iteration-func-nullptr check before starting the loop.
@@ -321,17 +450,62 @@ void Core::start_main_loop(void(*main_loop_iteration_func)())
     Sprite sprite_2(indices_data_2, &layer_1);
     Renderer renderer(this->shader_ptr_, this->window_size_);
                                         /* Init renderer                     */
+    renderer.set_cull_shader(this->cull_shader_ptr_);
+                                        /* Cull the static layer on the GPU  */
+    renderer.set_mode(RENDER_MODE_MULTI_DRAW_INDIRECT);
+                                        /* Record 'draw_sprite' calls and    */
+                                        /* submit them on 'flush'            */
+    renderer.set_depth_mode(DEPTH_MODE_TWO_PASS);
+                                        /* Draw opaque submitted sprites     */
+                                        /* without blending                  */
+
+    StaticLayer static_layer;           /* Frame of the scene: uploaded once */
+    for (int i = 0; i < 8; i++)         /* and redrawn with one call         */
+    {
+        static_layer.add(&layer_1, { 32.0f * i, 0.0f }, { 32.0f, 32.0f },
+            { 0.0f, 0.0f, 0.25f, 0.25f });
+    }
+
+    BitmapFontRasterizer font;          /* Built-in font, glyphs rasterized  */
+    GlyphCache glyph_cache(&font);      /* on the first use                  */
+
+    ParticleSystem particle_system(&texture_2d_array, 4096);
+    particle_system.set_gravity({ 0.0f, 400.0f });
+    particle_system.set_txd_rect({ 0.0f, 0.0f, 0.25f, 0.25f });
+    unsigned int emitted_count = 0;     /* A fountain: one draw call for all */
+                                        /* of its particles                  */
+    GpuProfiler gpu_profiler;           /* GPU time of the clear and of the  */
+                                        /* renderer passes                   */
 
     // TODO: TEMPORARY CODE END
 
 
-    while (!glfwWindowShouldClose(this->window_ptr_))
+    CPU_PROFILE_THREAD("main");
+    this->frame_timer_.reset();
+    this->cpu_frame_timer_.reset();
+    unsigned int frames_count = 0;
+    while (!glfwWindowShouldClose(this->window_ptr_) &&
+        (this->frames_limit_ == 0 || frames_count++ < this->frames_limit_))
     {
+        CPU_PROFILE_SCOPE("frame");
+        float delta_time = this->frame_timer_.tick();
+        std::chrono::steady_clock::time_point frame_start =
+            std::chrono::steady_clock::now();
+                                        /* Time since the previous frame     */
+        this->frame_stats_ = FrameStats::current();
+        FrameStats::current().reset();  /* Count this iteration from here    */
+        this->run_fixed_steps(delta_time);
+        gpu_profiler.begin_frame();     /* Results of 4 frames ago are read  */
+
+        gpu_profiler.begin_scope("clear");
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
                                         /* Specify clear values for the      */
                                         /* color buffer                      */
-        glClear(GL_COLOR_BUFFER_BIT);   /* Clear the 'GL_COLOR_BUFFER_BIT'   */
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                                        /* Clear the 'GL_COLOR_BUFFER_BIT'   */
                                         /* buffer using the selected color   */
+                                        /* and the depth buffer              */
+        gpu_profiler.end_scope();
 
 
         // TODO: The code between this and the next 'TODO' is for testing the
@@ -341,6 +515,9 @@ void Core::start_main_loop(void(*main_loop_iteration_func)())
         //       'main_loop_iteration_func'.
         // TEMPORARY CODE START
 
+        renderer.begin();               /* Start recording the frame         */
+        renderer.draw_static_layer(&static_layer);
+                                        /* Draw the static sprites first     */
         renderer.draw_sprite(&sprite_1, { 0,0 }, { 256,256 });
                                         /* Draw the 1-st sprite              */ 
         renderer.draw_sprite(&sprite_2, { 260,50 }, { 512,512 });
@@ -348,21 +525,167 @@ void Core::start_main_loop(void(*main_loop_iteration_func)())
         renderer.draw_sprite(&sprite_2, { 20,300 }, { 200,200 });
                                         /* Draw the 2-nd sprite again        */
 
+        renderer.submit_sprite(&layer_0, { 600,400 }, { 64,64 },
+            { 0.0f, 0.75f, 0.25f, 0.25f });
+        renderer.submit_sprite(&layer_0, { 700,400 }, { 64,64 },
+            { 0.75f, 0.75f, 0.25f, 0.25f });
+        renderer.submit_sprite(&layer_0, { 600,500 }, { 64,64 },
+            { 0.0f, 0.0f, 0.25f, 0.25f });
+        renderer.submit_sprite(&layer_0, { 700,500 }, { 64,64 },
+            { 0.75f, 0.0f, 0.25f, 0.25f });
+                                        /* Add the corners of the 1-st layer */
+                                        /* to the batch                      */
+        renderer.submit_sprite(&layer_0, { 620,420 }, { 128,128 },
+            { 0.25f, 0.25f, 0.5f, 0.5f }, 1);
+                                        /* The JPEG part of the 1-st layer   */
+                                        /* is opaque: it goes to the opaque  */
+                                        /* pass and covers the corners       */
+        renderer.submit_sprite(&layer_1, { 400,300 }, { 96,64 },
+            { 0.0f, 0.0f, 1.0f, 1.0f }, 2,
+            static_cast<float>(glfwGetTime()), { 0.5f, 0.5f });
+                                        /* Spin a sprite around its center   */
+        renderer.flush();               /* Draw the recorded compositions    */
+                                        /* (one multi-draw call) and the     */
+                                        /* batch (one instanced draw call)   */
+        for (int i = 0; i < 16; i++, emitted_count++)
+        {                               /* Spray upwards in a fan            */
+            float angle = 3.6f + static_cast<float>(emitted_count % 37) *
+                0.061f;
+            particle_system.emit(&layer_1, { 150,560 },
+                { 160.0f * std::cos(angle), 420.0f * std::sin(angle) }, 1.5f,
+                8.0f, { 1.0f, 0.4f + (emitted_count % 7) * 0.1f, 0.2f, 1.0f });
+        }
+        particle_system.update(delta_time);
+        renderer.draw_particles(&particle_system, 3);
+                                        /* Draw the fountain                 */
+        renderer.draw_text(&glyph_cache, "Eph Project\nText: one draw call",
+            { 520,560 }, 16, { 1.0f, 0.8f, 0.2f, 1.0f });
+                                        /* Draw a string on top              */
 
-        // TODO: TEMPORARY CODE END
 
-        main_loop_iteration_func();     /* Call a custom callback            */
+        // TODO: TEMPORARY CODE END
 
-        glfwSwapBuffers(this->window_ptr_);
+        {
+            CPU_PROFILE_SCOPE("main loop callback");
+            main_loop_iteration_func(); /* Call a custom callback            */
+        }
+        gpu_profiler.end_frame();       /* The callback can add scopes too   */
+        this->cpu_frame_timer_.add_frame_time(std::chrono::duration<float,
+            std::milli>(std::chrono::steady_clock::now() -
+                frame_start).count());
+
+        if (this->is_headless_)
+        {
+            glFinish();                 /* Nothing is presented: wait for    */
+        }                               /* the GPU to keep frames apart      */
+        else
+        {
+            glfwSwapBuffers(this->window_ptr_);
                                         /* Swap the front and back buffers   */
+        }
         glfwPollEvents();               /* Process all pending events        */
     }
 
+#if defined(EPH_PROFILE)
+    CpuProfiler::write_chrome_trace("cpu_trace.json");
+                                        /* Open with 'about:tracing'         */
+#endif
+    delete this->framebuffer_ptr_;
+    this->framebuffer_ptr_ = nullptr;
     glfwTerminate();                    /* Destroy all windows, free         */
                                         /* allocated resources               */
 }
 
 
+/**----------------------------------------------------------------------------
+; @func run_fixed_steps
+;
+; @brief
+;   Adds the frame time to the time not yet simulated, runs the fixed
+;   simulation steps it holds (at most 'max_steps_count_', the rest is
+;   dropped) and updates the interpolation alpha. Does nothing but set the
+;   alpha to 1 in lockstep mode.
+;
+; @params
+;   delta_time  | The frame time (in seconds).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Core::run_fixed_steps(float delta_time)
+{
+    if (this->fixed_update_func_ == nullptr)
+    {
+        this->interpolation_alpha_ = 1.0f;
+        return;
+    }
+
+    this->accumulated_time_ += delta_time;
+    unsigned int steps_count = 0;
+    while (this->accumulated_time_ >= this->fixed_step_time_)
+    {
+        if (steps_count == this->max_steps_count_)
+        {                               /* Too far behind: catching up would */
+                                        /* only make the next frame longer   */
+            unsigned long long dropped_steps_count =
+                static_cast<unsigned long long>(this->accumulated_time_ /
+                    this->fixed_step_time_);
+            this->dropped_steps_count_ += dropped_steps_count;
+            this->accumulated_time_ -= static_cast<double>(
+                dropped_steps_count) * this->fixed_step_time_;
+            break;
+        }
+        CPU_PROFILE_SCOPE("fixed update");
+        this->fixed_update_func_(this->fixed_step_time_);
+        this->accumulated_time_ -= this->fixed_step_time_;
+        steps_count++;
+    }
+    this->interpolation_alpha_ = static_cast<float>(this->accumulated_time_ /
+        this->fixed_step_time_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func read_shader_file
+;
+; @brief
+;   Reads the whole contents of a shader source file. Terminates the program
+;   with an error message if the file cannot be read.
+;
+; @params
+;   file_path   | The path to the shader source file.
+;
+; @return
+;   std::string | The shader source.
+;
+----------------------------------------------------------------------------**/
+std::string Core::read_shader_file(const char* file_path)
+{
+    std::ifstream shader_file;
+    std::stringstream shader_lines;
+
+    shader_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+                                        /* Set exception mask to detect      */
+                                        /* failbit and badbit errors while   */
+                                        /* opening a shader file             */
+    try
+    {
+        shader_file.open(file_path);
+        shader_lines << shader_file.rdbuf();
+        shader_file.close();
+    }
+    catch (std::ifstream::failure& e)
+    {
+        std::string error_msg = "Failed to read a file: " +
+            std::string(file_path) + ". Error code: " +
+            std::to_string(e.code().value()) + ". " + std::string(e.what());
+        LOG_ERROR(error_msg.c_str());
+    }
+    return shader_lines.str();
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func get_window_ptr
 ;
@@ -382,6 +705,188 @@ GLFWwindow* Core::get_window_ptr() const
 }
 
 
+/**----------------------------------------------------------------------------
+; @func get_shader_ptr
+;
+; @brief
+;   Returns a pointer to the shader program created by 'init_shaders'.
+;
+; @params
+;   None
+;
+; @return
+;   Shader *    | Shader program, nullptr if not initialized.
+;
+----------------------------------------------------------------------------**/
+Shader* Core::get_shader_ptr() const
+{
+    return this->shader_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_particle_shader_ptr
+;
+; @brief
+;   Returns a pointer to the compute shader program of the GPU particle
+;   systems.
+;
+; @params
+;   None
+;
+; @return
+;   Shader *    | nullptr if 'init_particle_shader' was not called.
+;
+----------------------------------------------------------------------------**/
+Shader* Core::get_particle_shader_ptr() const
+{
+    return this->particle_shader_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_framebuffer_ptr
+;
+; @brief
+;   Returns the offscreen framebuffer of the headless mode.
+;
+; @params
+;   None
+;
+; @return
+;   Framebuffer *   | The framebuffer, nullptr if not in the headless mode.
+;
+----------------------------------------------------------------------------**/
+Framebuffer* Core::get_framebuffer_ptr() const
+{
+    return this->framebuffer_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_headless
+;
+; @brief
+;   Returns whether the headless mode is selected (see 'set_headless').
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if rendering offscreen.
+;
+----------------------------------------------------------------------------**/
+bool Core::is_headless() const
+{
+    return this->is_headless_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_frame_timer
+;
+; @brief
+;   Returns the timer of the main loop, e.g. to query the frame time
+;   percentiles and hitches from the custom callback.
+;
+; @params
+;   None
+;
+; @return
+;   FrameTimer const&   | The timer, ticked at the start of each iteration.
+;
+----------------------------------------------------------------------------**/
+FrameTimer const& Core::get_frame_timer() const
+{
+    return this->frame_timer_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_cpu_frame_timer
+;
+; @brief
+;   Returns the timer of the CPU time of the main loop iterations: from the
+;   start of an iteration to the swap (or to the GPU wait in the headless
+;   mode). Unlike 'get_frame_timer' it does not include vsync or GPU waits.
+;
+; @params
+;   None
+;
+; @return
+;   FrameTimer const&   | The timer.
+;
+----------------------------------------------------------------------------**/
+FrameTimer const& Core::get_cpu_frame_timer() const
+{
+    return this->cpu_frame_timer_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_frame_stats
+;
+; @brief
+;   Returns the render statistics of the previous whole iteration of the main
+;   loop. The counts of the current iteration so far are
+;   'FrameStats::current()'. All counts are zero in the builds with NDEBUG
+;   (see 'FrameStats.hpp').
+;
+; @params
+;   None
+;
+; @return
+;   FrameStats const&   | The statistics.
+;
+----------------------------------------------------------------------------**/
+FrameStats const& Core::get_frame_stats() const
+{
+    return this->frame_stats_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_interpolation_alpha
+;
+; @brief
+;   Returns the time not simulated yet in the current iteration, as a
+;   fraction of the fixed step. The render callback can draw the state
+;   'previous + (current - previous) * alpha' of the last two simulated
+;   states.
+;
+; @params
+;   None
+;
+; @return
+;   float   | Alpha in [0, 1), 1 in lockstep mode.
+;
+----------------------------------------------------------------------------**/
+float Core::get_interpolation_alpha() const
+{
+    return this->interpolation_alpha_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_dropped_steps_count
+;
+; @brief
+;   Returns the number of fixed steps skipped because a frame took longer
+;   than 'max_steps_count' steps (see 'set_fixed_update').
+;
+; @params
+;   None
+;
+; @return
+;   unsigned long long  | The number of skipped steps.
+;
+----------------------------------------------------------------------------**/
+unsigned long long Core::get_dropped_steps_count() const
+{
+    return this->dropped_steps_count_;
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func Core
 ;
@@ -397,6 +902,12 @@ GLFWwindow* Core::get_window_ptr() const
 ----------------------------------------------------------------------------**/
 Core::Core()
     :window_ptr_(nullptr), window_size_(0), shader_ptr_(nullptr),
-    main_loop_iteration_func_(nullptr)
+    cull_shader_ptr_(nullptr), particle_shader_ptr_(nullptr),
+    gl_state_ptr_(nullptr), main_loop_iteration_func_(nullptr),
+    is_headless_(false), framebuffer_ptr_(nullptr), frames_limit_(0),
+    frame_stats_(), fixed_update_func_(nullptr),
+    fixed_step_time_(1.0f / 60.0f), max_steps_count_(5),
+    accumulated_time_(0.0), interpolation_alpha_(1.0f),
+    dropped_steps_count_(0)
 {
 }
@@ -16,14 +16,21 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <string>
+
 #include <glm/vec2.hpp>
 
+#include "FrameStats.hpp"
+#include "FrameTimer.hpp"
+
 
 
 /** @type_declarations -----------------------------------------------------**/
 
 struct GLFWwindow;
+class Framebuffer;
 class Shader;
+class GlState;
 
 
 
@@ -34,21 +41,63 @@ class Core
 public:
     static Core& instance();
 
+    void set_headless(bool is_headless);
+
     void init_window(char const* window_title, glm::ivec2 const& window_size,
                      bool is_full_screen, int swap_interval);
 
     void init_shaders(const char* vertex_shader_file_path,
                       const char* fragment_shader_file_path);
 
+    void init_cull_shader(const char* compute_shader_file_path);
+
+    void init_particle_shader(const char* compute_shader_file_path);
+
+    void set_fixed_update(void(*fixed_update_func)(float),
+                          float step_time = 1.0f / 60.0f,
+                          unsigned int max_steps_count = 5);
+
+    void set_frames_limit(unsigned int frames_limit);
+
     void start_main_loop(void(*main_loop_iteration_func)());
 
     GLFWwindow* get_window_ptr() const;
+    Shader* get_shader_ptr() const;
+    Shader* get_particle_shader_ptr() const;
+    Framebuffer* get_framebuffer_ptr() const;
+    bool is_headless() const;
+    FrameTimer const& get_frame_timer() const;
+    FrameTimer const& get_cpu_frame_timer() const;
+    FrameStats const& get_frame_stats() const;
+    float get_interpolation_alpha() const;
+    unsigned long long get_dropped_steps_count() const;
 
 private:
     GLFWwindow* window_ptr_;
     glm::ivec2 window_size_;
     Shader* shader_ptr_;
+    Shader* cull_shader_ptr_;           /* nullptr if not initialized        */
+    Shader* particle_shader_ptr_;       /* nullptr if not initialized        */
+    GlState* gl_state_ptr_;
     void(*main_loop_iteration_func_)();
+    bool is_headless_;
+    Framebuffer* framebuffer_ptr_;      /* The draw target in the headless   */
+                                        /* mode, nullptr otherwise           */
+    unsigned int frames_limit_;         /* 0 - until the window is closed    */
+
+    FrameTimer frame_timer_;
+    FrameTimer cpu_frame_timer_;        /* Without waiting for the GPU       */
+    FrameStats frame_stats_;            /* Of the previous iteration         */
+    void(*fixed_update_func_)(float);   /* nullptr - update and render in    */
+                                        /* lockstep                          */
+    float fixed_step_time_;             /* In seconds                        */
+    unsigned int max_steps_count_;      /* Per frame                         */
+    double accumulated_time_;           /* Not yet simulated (in seconds)    */
+    float interpolation_alpha_;
+    unsigned long long dropped_steps_count_;
+
+    void run_fixed_steps(float delta_time);
+    static std::string read_shader_file(const char* file_path);
 
     Core();
     Core(const Core& root) = delete;
@@ -0,0 +1,352 @@
+/**----------------------------------------------------------------------------
+; @file CpuProfiler.cpp
+;
+; @brief
+;   The file implements the functionality of the 'CpuProfiler' and
+;   'CpuProfileScope' classes.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdio>
+#include <utility>
+
+#include "CpuProfiler.hpp"
+#include "Log.hpp"
+
+
+
+/** @data_definitions  -----------------------------------------------------**/
+
+std::chrono::steady_clock::time_point const CpuProfiler::epoch_ =
+    std::chrono::steady_clock::now();
+std::atomic<bool> CpuProfiler::is_running_(true);
+std::atomic<unsigned int> CpuProfiler::generation_(0);
+std::atomic<unsigned long long> CpuProfiler::dropped_events_count_(0);
+std::mutex CpuProfiler::buffers_mutex_;
+std::vector<std::unique_ptr<CpuProfiler::ThreadBuffer>>
+    CpuProfiler::buffers_;
+thread_local CpuProfiler::ThreadBuffer* CpuProfiler::thread_buffer_ptr_ =
+    nullptr;
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func start
+;
+; @brief
+;   Discards the recorded events and starts recording. The profiler records
+;   from the program start, so this is only needed after 'stop'. Safe while
+;   other threads record: the buffers are only written by their owners, so
+;   this bumps the generation, and every thread empties its buffer on its
+;   next scope. Until then the dumps skip the buffers of older generations.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CpuProfiler::start()
+{
+    std::lock_guard<std::mutex> lock(CpuProfiler::buffers_mutex_);
+    CpuProfiler::generation_.fetch_add(1, std::memory_order_release);
+    CpuProfiler::dropped_events_count_.store(0, std::memory_order_relaxed);
+    CpuProfiler::is_running_.store(true, std::memory_order_release);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func stop
+;
+; @brief
+;   Stops recording. The recorded events are kept for
+;   'write_chrome_trace'.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CpuProfiler::stop()
+{
+    CpuProfiler::is_running_.store(false, std::memory_order_release);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_running
+;
+; @brief
+;   Returns whether the scopes are recorded.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true between 'start' and 'stop'.
+;
+----------------------------------------------------------------------------**/
+bool CpuProfiler::is_running()
+{
+    return CpuProfiler::is_running_.load(std::memory_order_relaxed);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_thread_name
+;
+; @brief
+;   Names the calling thread in the trace.
+;
+; @params
+;   name    | Name of the thread (a string literal).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CpuProfiler::set_thread_name(char const* name)
+{
+    CpuProfiler::get_thread_buffer()->thread_name.store(name,
+        std::memory_order_release);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func record
+;
+; @brief
+;   Appends a finished scope to the buffer of the calling thread. Does
+;   nothing if the profiler is stopped; drops the scope if the buffer is
+;   full. Empties the buffer first if 'start' was called since the last
+;   scope of the thread.
+;
+; @params
+;   name        | Name of the scope (a string literal).
+;   begin_time  | Start of the scope, see 'get_time'.
+;   end_time    | End of the scope, see 'get_time'.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void CpuProfiler::record(char const* name, long long begin_time,
+    long long end_time)
+{
+    if (!CpuProfiler::is_running())
+    {
+        return;
+    }
+
+    ThreadBuffer* buffer_ptr = CpuProfiler::get_thread_buffer();
+    unsigned int generation = CpuProfiler::generation_.load(
+        std::memory_order_acquire);
+    if (buffer_ptr->generation.load(std::memory_order_relaxed) != generation)
+    {
+        buffer_ptr->events_count.store(0, std::memory_order_relaxed);
+        buffer_ptr->generation.store(generation,
+            std::memory_order_release); /* Dumps see the empty buffer       */
+    }
+    std::size_t events_count = buffer_ptr->events_count.load(
+        std::memory_order_relaxed);     /* Only this thread writes it        */
+    if (events_count == buffer_ptr->events.size())
+    {
+        CpuProfiler::dropped_events_count_.fetch_add(1,
+            std::memory_order_relaxed);
+        return;
+    }
+    buffer_ptr->events[events_count] = { name, begin_time, end_time };
+    buffer_ptr->events_count.store(events_count + 1,
+        std::memory_order_release);     /* The event is complete for dumps   */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_time
+;
+; @brief
+;   Returns the current time of the profiler clock.
+;
+; @params
+;   None
+;
+; @return
+;   long long   | Time (in nanoseconds) since the program start.
+;
+----------------------------------------------------------------------------**/
+long long CpuProfiler::get_time()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - CpuProfiler::epoch_).count();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func write_chrome_trace
+;
+; @brief
+;   Writes the events recorded by all threads so far as a Chrome trace: one
+;   complete ('X') event per scope and the names of the threads. Threads
+;   may keep recording during the call; their newer events are not written.
+;   The events of the threads that have not recorded since the last 'start'
+;   are outdated and skipped ('start' waits for the call to end, so no
+;   buffer is emptied while it is written).
+;
+; @params
+;   file_path   | Path of the JSON file. An existing file is overwritten.
+;
+; @return
+;   bool    | false if the file cannot be created.
+;
+----------------------------------------------------------------------------**/
+bool CpuProfiler::write_chrome_trace(char const* file_path)
+{
+    std::FILE* file_ptr = std::fopen(file_path, "w");
+    if (file_ptr == nullptr)
+    {
+        LOG_WARNING("Failed to create the CPU profiler trace file.");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(CpuProfiler::buffers_mutex_);
+    char const* separator = "";
+    std::fprintf(file_ptr, "{\"traceEvents\":[");
+    for (std::unique_ptr<ThreadBuffer> const& buffer_ptr :
+        CpuProfiler::buffers_)
+    {
+        char const* thread_name = buffer_ptr->thread_name.load(
+            std::memory_order_acquire);
+        if (thread_name != nullptr)
+        {
+            std::fprintf(file_ptr, "%s\n{\"name\":\"thread_name\","
+                "\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                "\"args\":{\"name\":\"%s\"}}", separator,
+                buffer_ptr->thread_index, thread_name);
+            separator = ",";
+        }
+
+        std::size_t events_count = 0;
+        if (buffer_ptr->generation.load(std::memory_order_acquire) ==
+            CpuProfiler::generation_.load(std::memory_order_relaxed))
+        {
+            events_count = buffer_ptr->events_count.load(
+                std::memory_order_acquire);
+        }
+        for (std::size_t i = 0; i < events_count; i++)
+        {
+            Event const& event = buffer_ptr->events[i];
+            std::fprintf(file_ptr, "%s\n{\"name\":\"%s\",\"ph\":\"X\","
+                "\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", separator,
+                event.name, buffer_ptr->thread_index,
+                static_cast<double>(event.begin_time) * 1e-3,
+                static_cast<double>(event.end_time - event.begin_time) *
+                1e-3);                  /* Nanoseconds to microseconds       */
+            separator = ",";
+        }
+    }
+    std::fprintf(file_ptr, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    std::fclose(file_ptr);
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_dropped_events_count
+;
+; @brief
+;   Returns the number of scopes that were not recorded because the buffer
+;   of their thread was full.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned long long  | The number of dropped scopes.
+;
+----------------------------------------------------------------------------**/
+unsigned long long CpuProfiler::get_dropped_events_count()
+{
+    return CpuProfiler::dropped_events_count_.load(
+        std::memory_order_relaxed);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_thread_buffer
+;
+; @brief
+;   Returns the buffer of the calling thread, creating and registering it on
+;   the first call (the only time the mutex is taken while recording).
+;
+; @params
+;   None
+;
+; @return
+;   ThreadBuffer*   | The buffer of the calling thread.
+;
+----------------------------------------------------------------------------**/
+CpuProfiler::ThreadBuffer* CpuProfiler::get_thread_buffer()
+{
+    if (CpuProfiler::thread_buffer_ptr_ == nullptr)
+    {
+        std::unique_ptr<ThreadBuffer> buffer_ptr(new ThreadBuffer());
+        buffer_ptr->events.resize(THREAD_EVENTS_CAPACITY);
+        buffer_ptr->events_count.store(0, std::memory_order_relaxed);
+        buffer_ptr->thread_name.store(nullptr, std::memory_order_relaxed);
+        buffer_ptr->generation.store(CpuProfiler::generation_.load(
+            std::memory_order_acquire), std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(CpuProfiler::buffers_mutex_);
+        buffer_ptr->thread_index = static_cast<unsigned int>(
+            CpuProfiler::buffers_.size() + 1);
+        CpuProfiler::thread_buffer_ptr_ = buffer_ptr.get();
+        CpuProfiler::buffers_.push_back(std::move(buffer_ptr));
+    }
+    return CpuProfiler::thread_buffer_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func CpuProfileScope
+;
+; @brief
+;   Constructor. Starts timing the scope if the profiler is running.
+;
+; @params
+;   name    | Name of the scope (a string literal).
+;
+----------------------------------------------------------------------------**/
+CpuProfileScope::CpuProfileScope(char const* name)
+    :name_(name),
+    begin_time_(CpuProfiler::is_running() ? CpuProfiler::get_time() : -1)
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~CpuProfileScope
+;
+; @brief
+;   Destructor. Records the scope.
+;
+----------------------------------------------------------------------------**/
+CpuProfileScope::~CpuProfileScope()
+{
+    if (this->begin_time_ >= 0)
+    {
+        CpuProfiler::record(this->name_, this->begin_time_,
+            CpuProfiler::get_time());
+    }
+}
@@ -0,0 +1,360 @@
+/**----------------------------------------------------------------------------
+; @file DrawQueue.cpp
+;
+; @brief
+;   The file implements the functionality of the 'DrawQueue' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include "DrawQueue.hpp"
+#include "Texture2dArray.hpp"
+#include "Texture2dArrayLayer.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func DrawQueue
+;
+; @brief
+;   Constructor.
+;
+----------------------------------------------------------------------------**/
+DrawQueue::DrawQueue()
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all items from the queue. The allocated memory is kept.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void DrawQueue::clear()
+{
+    this->items_.clear();
+    this->keys_.clear();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func push
+;
+; @brief
+;   Adds an item to the queue and builds its sort key. The caller must check
+;   'is_full' before the call.
+;
+; @params
+;   item            | Sprite submission. Its depth is clamped to
+;                   | [0, 65535] in the key.
+;   is_translucent  | Whether the sprite needs blending.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void DrawQueue::push(Item const& item, bool is_translucent)
+{
+    this->keys_.push_back(DrawQueue::make_key(item.depth, is_translucent,
+        item.texture_2d_array_layer_ptr->get_texture_2d_array()->get_id(),
+        item.texture_2d_array_layer_ptr->get_z_offset(),
+        static_cast<std::uint32_t>(this->items_.size())));
+    this->items_.push_back(item);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func retain
+;
+; @brief
+;   Keeps only the items with the given submission indices (e.g. the visible
+;   ones). Only the keys are compacted, the items stay where they are. Must be
+;   called before 'sort'.
+;
+; @params
+;   indices | Submission indices of the items to keep, in ascending order.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void DrawQueue::retain(std::vector<unsigned int> const& indices)
+{
+    for (std::size_t i = 0; i < indices.size(); i++)
+    {                                   /* 'indices[i] >= i', so the keys    */
+                                        /* can be compacted in place         */
+        this->keys_[i] = this->keys_[indices[i]];
+    }
+    this->keys_.resize(indices.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func sort
+;
+; @brief
+;   Sorts the keys with an LSD radix sort. Histograms of all digits are built
+;   in a single pass over the keys. A pass is skipped if all keys fall into a
+;   single bucket (e.g. all sprites have the same depth).
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void DrawQueue::sort()
+{
+    std::size_t keys_count = this->keys_.size();
+    std::size_t histograms[RADIX_PASSES][RADIX_SIZE] = {};
+
+    if (keys_count < 2)
+    {
+        return;
+    }
+    this->scratch_keys_.resize(keys_count);
+                                        /* Does not allocate once the        */
+                                        /* capacity is reached               */
+
+    for (std::uint64_t key : this->keys_)
+    {                                   /* Count the digits of all passes at */
+                                        /* once                              */
+        for (int pass = 0; pass < RADIX_PASSES; pass++)
+        {
+            histograms[pass][(key >> (pass * RADIX_BITS)) &
+                (RADIX_SIZE - 1)]++;
+        }
+    }
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++)
+    {
+        std::size_t* histogram = histograms[pass];
+        int shift = pass * RADIX_BITS;
+        std::uint64_t const* src = this->keys_.data();
+        std::uint64_t* dst = this->scratch_keys_.data();
+        std::size_t offset = 0;
+
+        if (histogram[(src[0] >> shift) & (RADIX_SIZE - 1)] == keys_count)
+        {
+            continue;                   /* All keys have the same digit      */
+        }
+
+        for (int digit = 0; digit < RADIX_SIZE; digit++)
+        {                               /* Turn the counts into the offsets  */
+                                        /* of the buckets                    */
+            std::size_t count = histogram[digit];
+            histogram[digit] = offset;
+            offset += count;
+        }
+
+        for (std::size_t i = 0; i < keys_count; i++)
+        {                               /* Scatter the keys into the         */
+                                        /* buckets. Keys with equal digits   */
+                                        /* keep their order                  */
+            dst[histogram[(src[i] >> shift) & (RADIX_SIZE - 1)]++] = src[i];
+        }
+        this->keys_.swap(this->scratch_keys_);
+                                        /* The sorted keys become the source */
+                                        /* of the next pass                  */
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_full
+;
+; @brief
+;   Checks whether the sequence numbers are exhausted.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if no more items can be pushed.
+;
+----------------------------------------------------------------------------**/
+bool DrawQueue::is_full() const
+{
+    return this->items_.size() >= DrawQueue::MAX_ITEMS_COUNT;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_items_count
+;
+; @brief
+;   Returns the number of items to be drawn (the items removed by 'retain'
+;   are not counted).
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | Number of items.
+;
+----------------------------------------------------------------------------**/
+std::size_t DrawQueue::get_items_count() const
+{
+    return this->keys_.size();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_sorted_item
+;
+; @brief
+;   Returns an item by its position in the sorted order. 'sort' must be called
+;   before.
+;
+; @params
+;   index   | Position in the sorted order.
+;
+; @return
+;   Item const& | The item.
+;
+----------------------------------------------------------------------------**/
+DrawQueue::Item const& DrawQueue::get_sorted_item(std::size_t index) const
+{
+    return this->items_[this->get_sorted_item_index(index)];
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_sorted_item_index
+;
+; @brief
+;   Returns the submission index of an item by its position in the sorted
+;   order. 'sort' must be called before.
+;
+; @params
+;   index   | Position in the sorted order.
+;
+; @return
+;   std::size_t | The number of items pushed before the item.
+;
+----------------------------------------------------------------------------**/
+std::size_t DrawQueue::get_sorted_item_index(std::size_t index) const
+{
+    return static_cast<std::size_t>(this->keys_[index] &
+        ((std::uint64_t(1) << DrawQueue::SEQUENCE_BITS) - 1));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_sorted_item_translucent
+;
+; @brief
+;   Returns whether an item was submitted as translucent, by its position in
+;   the sorted order. All opaque items precede all translucent ones.
+;
+; @params
+;   index   | Position in the sorted order.
+;
+; @return
+;   bool    | true if the item needs blending.
+;
+----------------------------------------------------------------------------**/
+bool DrawQueue::is_sorted_item_translucent(std::size_t index) const
+{
+    return (this->keys_[index] >> 63) != 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func make_key
+;
+; @brief
+;   Packs the sort criteria into a 64-bit key (see the layout in the header).
+;   The depth of opaque sprites is inverted to sort them front-to-back. The
+;   texture fields are only filled in for opaque sprites: translucent ones
+;   are not reordered at equal depth (painter's order). Values that do not
+;   fit into their fields are clamped (depth) or truncated (texture id,
+;   z-offset). Truncation only affects the grouping, not the correctness of
+;   rendering.
+;
+; @params
+;   depth           | Draw layer. Clamped to [0, 65535].
+;   is_translucent  | Whether the sprite needs blending.
+;   texture_id      | Texture 2d array id.
+;   z_offset        | Texture 2d array layer number.
+;   sequence        | Submission index.
+;
+; @return
+;   std::uint64_t   | Sort key.
+;
+----------------------------------------------------------------------------**/
+std::uint64_t DrawQueue::make_key(int depth, bool is_translucent,
+    unsigned int texture_id, int z_offset, std::uint32_t sequence)
+{
+    std::uint64_t max_depth = (std::uint64_t(1) << DEPTH_BITS) - 1;
+    std::uint64_t key_depth = depth < 0 ? 0 :
+        (static_cast<std::uint64_t>(depth) > max_depth ? max_depth :
+            static_cast<std::uint64_t>(depth));
+    std::uint64_t key = is_translucent ? 1 : 0;
+
+    key = (key << DEPTH_BITS) | (is_translucent ? key_depth :
+        max_depth - key_depth);
+    if (is_translucent)
+    {
+        texture_id = 0;
+        z_offset = 0;
+    }
+    key = (key << TEXTURE_ID_BITS) |
+        (texture_id & ((1u << TEXTURE_ID_BITS) - 1));
+    key = (key << Z_OFFSET_BITS) |
+        (static_cast<std::uint32_t>(z_offset) & ((1u << Z_OFFSET_BITS) - 1));
+    key = (key << SEQUENCE_BITS) |
+        (sequence & ((1u << SEQUENCE_BITS) - 1));
+    return key;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_clip_depth
+;
+; @brief
+;   Converts a draw layer into the clip space z used by the shaders. Greater
+;   layers are closer to the viewer; each layer gets its own depth value in a
+;   24-bit depth buffer.
+;
+; @params
+;   depth   | Draw layer. Clamped to [0, 65535].
+;
+; @return
+;   float   | Clip space z in [-1, 1): layer 65535 is exactly -1
+;           | (the near plane, still drawn).
+;
+----------------------------------------------------------------------------**/
+float DrawQueue::get_clip_depth(int depth)
+{
+    int max_depth = (1 << DEPTH_BITS) - 1;
+    int clamped_depth = depth < 0 ? 0 : (depth > max_depth ? max_depth :
+        depth);
+    return 1.0f - static_cast<float>(clamped_depth + 1) /
+        static_cast<float>(1 << (DEPTH_BITS - 1));
+}
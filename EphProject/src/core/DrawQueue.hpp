@@ -0,0 +1,102 @@
+/**----------------------------------------------------------------------------
+; @file DrawQueue.hpp
+;
+; @brief
+;   This file describes the 'DrawQueue' class. This class collects sprite
+;   submissions and sorts them by a 64-bit key before they are drawn, so that
+;   sprites which share the rendering state end up next to each other.
+;
+;   Key layout (from the most significant bit):
+;        1 bit  | translucency, all opaque sprites are drawn first
+;       16 bits | depth (draw layer). Translucent sprites: smaller values are
+;               | drawn first (back-to-front). Opaque sprites: the field is
+;               | inverted, greater values are drawn first (front-to-back), so
+;               | the depth test rejects the hidden fragments early
+;       12 bits | texture 2d array id (opaque sprites only, 0 otherwise)
+;       11 bits | texture 2d array z-offset (opaque sprites only, 0
+;               | otherwise)
+;       24 bits | sequence number (the submission index)
+;
+;   Opaque sprites rely on the depth test for the correct result, so their
+;   order only matters for performance and they are grouped by texture.
+;   Translucent sprites are blended, so at equal depth they must keep the
+;   order of submission: their texture fields are left empty and the
+;   sequence number decides right after the depth. If every sprite is
+;   submitted as translucent, the order is the plain painter's order by
+;   depth.
+;
+;   The sequence number makes keys unique and the sort stable. Since it is the
+;   index of the submission, the sorted keys are also the sorted item indices.
+;   The placement of a sprite is not stored in the item: it lives at the same
+;   index in the renderer's 'SpriteTransforms' ('get_sorted_item_index').
+;   The keys are sorted with an LSD radix sort (8 passes of 8 bits). Passes in
+;   which all keys have the same digit are skipped. All buffers are kept
+;   between frames, so a queue of a steady size does not allocate.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class Texture2dArrayLayer;
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class DrawQueue
+{
+public:
+    struct Item
+    {
+        Texture2dArrayLayer const* texture_2d_array_layer_ptr;
+        glm::vec4 txd_rect;
+        int depth;
+    };
+
+    static constexpr unsigned int DEPTH_BITS = 16;
+    static constexpr unsigned int TRANSLUCENCY_BITS = 1;
+    static constexpr unsigned int TEXTURE_ID_BITS = 12;
+    static constexpr unsigned int Z_OFFSET_BITS = 11;
+    static constexpr unsigned int SEQUENCE_BITS = 24;
+    static constexpr std::size_t MAX_ITEMS_COUNT =
+        std::size_t(1) << SEQUENCE_BITS;
+
+    DrawQueue();
+
+    void clear();
+    void push(Item const& item, bool is_translucent);
+    void retain(std::vector<unsigned int> const& indices);
+    void sort();
+
+    bool is_full() const;
+    std::size_t get_items_count() const;
+    Item const& get_sorted_item(std::size_t index) const;
+    std::size_t get_sorted_item_index(std::size_t index) const;
+    bool is_sorted_item_translucent(std::size_t index) const;
+
+    static std::uint64_t make_key(int depth, bool is_translucent,
+        unsigned int texture_id, int z_offset, std::uint32_t sequence);
+    static float get_clip_depth(int depth);
+
+private:
+    std::vector<Item> items_;
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint64_t> scratch_keys_;
+};
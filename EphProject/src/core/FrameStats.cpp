@@ -0,0 +1,146 @@
+/**----------------------------------------------------------------------------
+; @file FrameStats.cpp
+;
+; @brief
+;   The file implements the functionality of the 'FrameStats' structure.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "FrameStats.hpp"
+
+
+
+/** @data_definitions  -----------------------------------------------------**/
+
+static thread_local FrameStats thread_frame_stats = {};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func reset
+;
+; @brief
+;   Sets all counters to zero.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void FrameStats::reset()
+{
+    *this = {};
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add_draw
+;
+; @brief
+;   Counts a draw call with its instances and triangles.
+;
+; @params
+;   mode            | Primitive mode of the draw (GL_TRIANGLES, ...).
+;   indices_count   | Indices (or vertices) drawn per instance.
+;   instances_count | Instances drawn, 0 if unknown on the CPU.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void FrameStats::add_draw(unsigned int mode, unsigned int indices_count,
+    unsigned int instances_count)
+{
+    this->draw_calls++;
+    this->instances += instances_count;
+    this->triangles += static_cast<unsigned long long>(
+        FrameStats::get_triangles_count(mode, indices_count)) *
+        instances_count;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_uniform_uploads_count
+;
+; @brief
+;   Returns the number of uniform uploads of all types.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of uploads.
+;
+----------------------------------------------------------------------------**/
+unsigned int FrameStats::get_uniform_uploads_count() const
+{
+    unsigned int count = 0;
+    for (unsigned int uploads_count : this->uniform_uploads)
+    {
+        count += uploads_count;
+    }
+    return count;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func current
+;
+; @brief
+;   Returns the counters of the calling thread, i.e. of the context that is
+;   current on it.
+;
+; @params
+;   None
+;
+; @return
+;   FrameStats& | The counters.
+;
+----------------------------------------------------------------------------**/
+FrameStats& FrameStats::current()
+{
+    return thread_frame_stats;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_triangles_count
+;
+; @brief
+;   Returns the number of triangles a number of indices forms.
+;
+; @params
+;   mode            | Primitive mode (GL_TRIANGLES, ...).
+;   indices_count   | Number of indices (or vertices).
+;
+; @return
+;   unsigned int    | The number of triangles, 0 for points and lines.
+;
+----------------------------------------------------------------------------**/
+unsigned int FrameStats::get_triangles_count(unsigned int mode,
+    unsigned int indices_count)
+{
+    switch (mode)
+    {
+    case GL_TRIANGLES:
+        return indices_count / 3;
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+        return indices_count > 2 ? indices_count - 2 : 0;
+    default:                            /* Points and lines                  */
+        return 0;
+    }
+}
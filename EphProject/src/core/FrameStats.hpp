@@ -0,0 +1,106 @@
+/**----------------------------------------------------------------------------
+; @file FrameStats.hpp
+;
+; @brief
+;   This file describes the 'FrameStats' structure and the counting macros.
+;   The structure holds what the engine asked of OpenGL since the last reset:
+;   draw calls with their instances and triangles, compute dispatches,
+;   texture binds, program switches, uniform uploads by type, the bytes
+;   uploaded to buffers and textures, and the state changes 'GlState'
+;   dropped because they would not have changed anything.
+;
+;   The counters of the calling thread are returned by
+;   'FrameStats::current()'. 'Core' resets them at the start of every frame,
+;   so the main loop callback sees the frame so far, and 'Core' keeps the
+;   counters of the previous whole frame ('Core::get_frame_stats').
+;
+;   The macros expand to nothing when NDEBUG is defined (the Release
+;   configurations), so the counting costs nothing there and all counters
+;   stay zero. Otherwise a count is an add to a thread-local counter.
+;
+;   Instances and triangles of indirect draws whose commands are written by
+;   the GPU ('GpuCuller', 'GpuParticleSystem') are not known on the CPU: only
+;   their draw calls are counted. Writes to persistently mapped buffers are
+;   counted as buffer bytes where they are made.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#if !defined(NDEBUG)
+
+#define FRAME_STATS_ADD(counter, value) \
+(FrameStats::current().counter += (value))
+
+#define FRAME_STATS_ADD_DRAW(mode, indices_count, instances_count) \
+FrameStats::current().add_draw(mode, indices_count, instances_count)
+
+#define FRAME_STATS_ADD_UNIFORM(type) \
+(FrameStats::current().uniform_uploads[type]++)
+
+#else
+
+#define FRAME_STATS_ADD(counter, value)
+#define FRAME_STATS_ADD_DRAW(mode, indices_count, instances_count)
+#define FRAME_STATS_ADD_UNIFORM(type)
+
+#endif
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enUniformType
+{
+    UNIFORM_TYPE_INT = 0,
+    UNIFORM_TYPE_FLOAT = 1,
+    UNIFORM_TYPE_VEC2 = 2,
+    UNIFORM_TYPE_IVEC2 = 3,
+    UNIFORM_TYPE_VEC4 = 4,
+    UNIFORM_TYPE_MAT4 = 5,
+    UNIFORM_TYPES_COUNT = 6,
+};
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct FrameStats
+{
+    unsigned int draw_calls;
+    unsigned long long instances;       /* A non-instanced draw counts as    */
+                                        /* one instance                      */
+    unsigned long long triangles;
+    unsigned int dispatches;
+    unsigned int texture_binds;         /* Calls that reached OpenGL         */
+    unsigned int program_switches;
+    unsigned int uniform_uploads[UNIFORM_TYPES_COUNT];
+                                        /* Indexed by 'enUniformType'        */
+    unsigned long long buffer_bytes;
+    unsigned long long texture_bytes;
+    unsigned int redundant_state_changes;
+                                        /* Dropped by 'GlState'              */
+
+    void reset();
+    void add_draw(unsigned int mode, unsigned int indices_count,
+        unsigned int instances_count);
+    unsigned int get_uniform_uploads_count() const;
+
+    static FrameStats& current();
+    static unsigned int get_triangles_count(unsigned int mode,
+        unsigned int indices_count);
+
+    static constexpr bool IS_ENABLED =
+#if !defined(NDEBUG)
+        true;
+#else
+        false;
+#endif
+};
@@ -0,0 +1,214 @@
+/**----------------------------------------------------------------------------
+; @file FrameTimer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'FrameTimer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cmath>
+
+#include "FrameTimer.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func FrameTimer
+;
+; @brief
+;   Constructor.
+;
+; @params
+;   window_size | Number of the last frames the statistics cover.
+;
+----------------------------------------------------------------------------**/
+FrameTimer::FrameTimer(std::size_t window_size)
+    :frame_times_(std::max<std::size_t>(window_size, 1), 0.0f),
+    next_index_(0), frames_count_(0), total_frames_count_(0),
+    last_frame_time_(0.0f), is_started_(false)
+{
+    this->sorted_frame_times_.reserve(this->frame_times_.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func tick
+;
+; @brief
+;   Marks the start of a frame and records the time since the previous
+;   call. The first call only starts the measurement.
+;
+; @params
+;   None
+;
+; @return
+;   float   | The frame time (in seconds), 0 on the first call.
+;
+----------------------------------------------------------------------------**/
+float FrameTimer::tick()
+{
+    std::chrono::steady_clock::time_point time =
+        std::chrono::steady_clock::now();
+    if (!this->is_started_)
+    {
+        this->prev_time_ = time;
+        this->is_started_ = true;
+        return 0.0f;
+    }
+
+    float frame_time = std::chrono::duration<float>(time -
+        this->prev_time_).count();
+    this->prev_time_ = time;
+    this->add_frame_time(frame_time * 1000.0f);
+    return frame_time;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add_frame_time
+;
+; @brief
+;   Records a frame time measured elsewhere, e.g. on the GPU. Must not be
+;   mixed with 'tick' on the same timer.
+;
+; @params
+;   frame_time  | The frame time (in milliseconds).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void FrameTimer::add_frame_time(float frame_time)
+{
+    this->frame_times_[this->next_index_] = frame_time;
+    this->next_index_ = (this->next_index_ + 1) % this->frame_times_.size();
+    this->frames_count_ = std::min(this->frames_count_ + 1,
+        this->frame_times_.size());
+    this->total_frames_count_++;
+    this->last_frame_time_ = frame_time;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset
+;
+; @brief
+;   Clears the window. The next 'tick' starts a new measurement, so a pause
+;   (e.g. loading) is not recorded as a hitch.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void FrameTimer::reset()
+{
+    this->next_index_ = 0;
+    this->frames_count_ = 0;
+    this->last_frame_time_ = 0.0f;
+    this->is_started_ = false;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_stats
+;
+; @brief
+;   Computes the statistics of the frames in the window. The percentiles use
+;   the nearest-rank method.
+;
+; @params
+;   None
+;
+; @return
+;   FrameTimeStats  | The statistics, all zeros if no frame was recorded.
+;
+----------------------------------------------------------------------------**/
+FrameTimeStats FrameTimer::get_stats() const
+{
+    FrameTimeStats stats = {};
+    std::size_t count = this->frames_count_;
+    if (count == 0)
+    {
+        return stats;
+    }
+
+    this->sorted_frame_times_.assign(this->frame_times_.begin(),
+        this->frame_times_.begin() + count);
+    std::sort(this->sorted_frame_times_.begin(),
+        this->sorted_frame_times_.end());
+    auto get_percentile = [&](float percent)
+    {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(percent *
+            static_cast<float>(count) / 100.0f));
+        return this->sorted_frame_times_[std::max<std::size_t>(rank, 1) - 1];
+    };
+
+    stats.p50 = get_percentile(50.0f);
+    stats.p95 = get_percentile(95.0f);
+    stats.p99 = get_percentile(99.0f);
+    stats.max = this->sorted_frame_times_.back();
+    double sum = 0.0;
+    for (float frame_time : this->sorted_frame_times_)
+    {
+        sum += frame_time;
+    }
+    stats.average = static_cast<float>(sum / static_cast<double>(count));
+    stats.hitches_count = static_cast<unsigned int>(
+        this->sorted_frame_times_.end() - std::upper_bound(
+            this->sorted_frame_times_.begin(),
+            this->sorted_frame_times_.end(), stats.p50 * HITCH_FACTOR));
+    stats.frames_count = static_cast<unsigned int>(count);
+    return stats;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_last_frame_time
+;
+; @brief
+;   Returns the time of the last recorded frame.
+;
+; @params
+;   None
+;
+; @return
+;   float   | The frame time (in milliseconds), 0 if none.
+;
+----------------------------------------------------------------------------**/
+float FrameTimer::get_last_frame_time() const
+{
+    return this->last_frame_time_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_total_frames_count
+;
+; @brief
+;   Returns the number of frames recorded since the timer was created,
+;   'reset' calls included.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned long long  | The number of frames.
+;
+----------------------------------------------------------------------------**/
+unsigned long long FrameTimer::get_total_frames_count() const
+{
+    return this->total_frames_count_;
+}
@@ -0,0 +1,82 @@
+/**----------------------------------------------------------------------------
+; @file FrameTimer.hpp
+;
+; @brief
+;   This file describes the 'FrameTimer' class. This class measures the time
+;   between frames and keeps the last frame times in a rolling window, so
+;   stutter can be told apart from a merely slow frame rate: 'get_stats'
+;   returns the median, the 95th and 99th percentiles, the maximum and the
+;   number of hitches in the window.
+;
+;   A hitch is a frame that took more than 'HITCH_FACTOR' times the median
+;   of the window, so the count means the same at any frame rate.
+;
+;   'tick' costs a clock read and a store. The percentiles are computed only
+;   when queried, by sorting a copy of the window (no allocation once the
+;   window is full).
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct FrameTimeStats                   /* All times in milliseconds         */
+{
+    float p50;
+    float p95;
+    float p99;
+    float max;
+    float average;
+    unsigned int hitches_count;
+    unsigned int frames_count;          /* Frames in the window              */
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class FrameTimer
+{
+public:
+    FrameTimer(std::size_t window_size = DEFAULT_WINDOW_SIZE);
+
+    float tick();
+    void add_frame_time(float frame_time);
+    void reset();
+
+    FrameTimeStats get_stats() const;
+    float get_last_frame_time() const;
+    unsigned long long get_total_frames_count() const;
+
+    static constexpr std::size_t DEFAULT_WINDOW_SIZE = 600;
+                                        /* 10 seconds at 60 fps              */
+    static constexpr float HITCH_FACTOR = 2.0f;
+
+private:
+    std::vector<float> frame_times_;    /* Ring buffer (in milliseconds)     */
+    std::size_t next_index_;
+    std::size_t frames_count_;          /* Filled elements of the ring       */
+    unsigned long long total_frames_count_;
+    float last_frame_time_;
+    std::chrono::steady_clock::time_point prev_time_;
+    bool is_started_;                   /* 'prev_time_' is valid             */
+    mutable std::vector<float> sorted_frame_times_;
+                                        /* Scratch memory of 'get_stats'     */
+
+    FrameTimer(const FrameTimer&) = delete;
+    FrameTimer& operator=(const FrameTimer&) = delete;
+};
@@ -0,0 +1,165 @@
+/**----------------------------------------------------------------------------
+; @file Framebuffer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'Framebuffer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include "Framebuffer.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func Framebuffer
+;
+; @brief
+;   Constructor. Creates the framebuffer object and its attachments. The
+;   framebuffer is left bound.
+;
+; @params
+;   size    | Width and height (in pixels).
+;
+----------------------------------------------------------------------------**/
+Framebuffer::Framebuffer(glm::ivec2 const& size)
+    :id_(0), color_renderbuffer_id_(0), depth_renderbuffer_id_(0),
+    size_(size)
+{
+    glGenRenderbuffers(1, &this->color_renderbuffer_id_);
+    glBindRenderbuffer(GL_RENDERBUFFER, this->color_renderbuffer_id_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size.x, size.y);
+    glGenRenderbuffers(1, &this->depth_renderbuffer_id_);
+    glBindRenderbuffer(GL_RENDERBUFFER, this->depth_renderbuffer_id_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size.x,
+        size.y);                        /* For the opaque pass of the        */
+                                        /* renderer, like the window         */
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &this->id_);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->id_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_RENDERBUFFER, this->color_renderbuffer_id_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+        GL_RENDERBUFFER, this->depth_renderbuffer_id_);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LOG_ERROR("The offscreen framebuffer is incomplete.");
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~Framebuffer
+;
+; @brief
+;   Destructor. Deletes the framebuffer object and its attachments. The
+;   window is the draw target again.
+;
+----------------------------------------------------------------------------**/
+Framebuffer::~Framebuffer()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &this->id_);
+    glDeleteRenderbuffers(1, &this->color_renderbuffer_id_);
+    glDeleteRenderbuffers(1, &this->depth_renderbuffer_id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Makes the framebuffer the draw and read target and sets the viewport to
+;   its size.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Framebuffer::bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, this->id_);
+    glViewport(0, 0, this->size_.x, this->size_.y);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func read_pixels
+;
+; @brief
+;   Reads the color attachment back. Waits for the GPU to finish the
+;   rendering, so it is meant for regression checks, not for every frame.
+;
+; @params
+;   pixels  | Output: RGBA8 pixels, bottom row first.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Framebuffer::read_pixels(std::vector<unsigned char>& pixels) const
+{
+    pixels.resize(static_cast<std::size_t>(this->size_.x) * this->size_.y *
+        4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, this->id_);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, this->size_.x, this->size_.y, GL_RGBA,
+        GL_UNSIGNED_BYTE, pixels.data());
+                                        /* RGBA rows are 4-byte aligned, as  */
+                                        /* GL_PACK_ALIGNMENT expects         */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_id
+;
+; @brief
+;   Returns the name of the framebuffer object.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Framebuffer object name.
+;
+----------------------------------------------------------------------------**/
+unsigned int Framebuffer::get_id() const
+{
+    return this->id_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_size
+;
+; @brief
+;   Returns the size of the framebuffer.
+;
+; @params
+;   None
+;
+; @return
+;   glm::ivec2 const&   | Width and height (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::ivec2 const& Framebuffer::get_size() const
+{
+    return this->size_;
+}
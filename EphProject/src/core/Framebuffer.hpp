@@ -0,0 +1,50 @@
+/**----------------------------------------------------------------------------
+; @file Framebuffer.hpp
+;
+; @brief
+;   This file describes the 'Framebuffer' class. This class owns an
+;   offscreen framebuffer object of a fixed size with an RGBA8 color and a
+;   24-bit depth renderbuffer, i.e. the same attachments as the window. The
+;   headless mode of 'Core' renders into it instead of a visible window, and
+;   'read_pixels' returns the rendered image, e.g. for regression runs.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class Framebuffer
+{
+public:
+    Framebuffer(glm::ivec2 const& size);
+    ~Framebuffer();
+
+    void bind() const;
+    void read_pixels(std::vector<unsigned char>& pixels) const;
+
+    unsigned int get_id() const;
+    glm::ivec2 const& get_size() const;
+
+private:
+    unsigned int id_;
+    unsigned int color_renderbuffer_id_;
+    unsigned int depth_renderbuffer_id_;
+    glm::ivec2 size_;
+
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+};
@@ -0,0 +1,891 @@
+/**----------------------------------------------------------------------------
+; @file GlState.cpp
+;
+; @brief
+;   The file implements the functionality of the 'GlState' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "Log.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define UNKNOWN_BINDING 0xFFFFFFFF      /* The binding is unknown, the next  */
+                                        /* bind call is always passed to GL  */
+#define BUFFER_SLOTS_COUNT 10
+
+
+
+/** @data_definitions  -----------------------------------------------------**/
+
+thread_local GlState* GlState::current_ptr_ = nullptr;
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func GlState
+;
+; @brief
+;   Constructor. Initializes the shadow state with the default values of a
+;   newly created context and queries the implementation limits. The context
+;   must be current.
+;
+----------------------------------------------------------------------------**/
+GlState::GlState()
+    :program_(0), vertex_array_(0), buffers_(BUFFER_SLOTS_COUNT, 0),
+    active_texture_unit_(GL_TEXTURE0), is_blend_enabled_(false),
+    blend_src_factor_(GL_ONE), blend_dst_factor_(GL_ZERO),
+    is_depth_test_enabled_(false), is_depth_mask_enabled_(true),
+    depth_func_(GL_LESS),
+    unpack_row_length_(0), unpack_skip_pixels_(0), unpack_skip_rows_(0),
+    unpack_alignment_(4), max_texture_image_units_(0),
+    max_3d_texture_size_(0), max_array_texture_layers_(0)
+{
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &this->max_texture_image_units_);
+    glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &this->max_3d_texture_size_);
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS,
+        &this->max_array_texture_layers_);
+                                        /* The limits never change, so they  */
+                                        /* are queried only once             */
+    this->texture_units_.resize(this->max_texture_image_units_, { 0, 0 });
+
+    int max_uniform_buffer_bindings = 0;
+    int max_shader_storage_buffer_bindings = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS,
+        &max_uniform_buffer_bindings);
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
+        &max_shader_storage_buffer_bindings);
+    this->uniform_buffer_bases_.resize(max_uniform_buffer_bindings, 0);
+    this->shader_storage_buffer_bases_.resize(
+        max_shader_storage_buffer_bindings, 0);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func current
+;
+; @brief
+;   Returns the state object of the context that is current on the calling
+;   thread.
+;
+; @params
+;   None
+;
+; @return
+;   GlState&    | State of the current context.
+;
+----------------------------------------------------------------------------**/
+GlState& GlState::current()
+{
+    if (GlState::current_ptr_ == nullptr)
+    {
+        LOG_ERROR("No OpenGL state object is current on this thread.");
+    }
+    return *GlState::current_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func make_current
+;
+; @brief
+;   Registers the state object of the context that has been made current on
+;   the calling thread.
+;
+; @params
+;   gl_state_ptr    | State object of the current context.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::make_current(GlState* gl_state_ptr)
+{
+    GlState::current_ptr_ = gl_state_ptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func use_program
+;
+; @brief
+;   Installs the program as part of the current rendering state if it is not
+;   installed yet.
+;
+; @params
+;   program_id  | Program object id.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::use_program(unsigned int program_id)
+{
+    if (this->program_ != program_id)
+    {
+        glUseProgram(program_id);
+        FRAME_STATS_ADD(program_switches, 1);
+        this->program_ = program_id;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_vertex_array
+;
+; @brief
+;   Binds the vertex array if it is not bound yet. The element array buffer
+;   binding is a part of the vertex array state, so it becomes unknown.
+;
+; @params
+;   vertex_array_id | Vertex array object id.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::bind_vertex_array(unsigned int vertex_array_id)
+{
+    if (this->vertex_array_ != vertex_array_id)
+    {
+        glBindVertexArray(vertex_array_id);
+        this->vertex_array_ = vertex_array_id;
+        this->buffers_[GlState::get_buffer_slot(GL_ELEMENT_ARRAY_BUFFER)] =
+            UNKNOWN_BINDING;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_buffer
+;
+; @brief
+;   Binds the buffer to the target if it is not bound yet. Targets that are
+;   not tracked are always passed to OpenGL.
+;
+; @params
+;   target      | Buffer binding target.
+;   buffer_id   | Buffer object id.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::bind_buffer(unsigned int target, unsigned int buffer_id)
+{
+    int slot = GlState::get_buffer_slot(target);
+    if (slot < 0)
+    {
+        glBindBuffer(target, buffer_id);
+        return;
+    }
+    if (this->buffers_[slot] != buffer_id)
+    {
+        glBindBuffer(target, buffer_id);
+        this->buffers_[slot] = buffer_id;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_buffer_base
+;
+; @brief
+;   Binds the buffer to the indexed binding point of the target if it is not
+;   bound there yet. Like 'glBindBufferBase', a bind also binds the buffer to
+;   the generic target, so both cache entries are updated. Targets other than
+;   GL_UNIFORM_BUFFER and GL_SHADER_STORAGE_BUFFER are always passed to
+;   OpenGL.
+;
+; @params
+;   target      | Buffer binding target.
+;   index       | Binding point of the target.
+;   buffer_id   | Buffer object id.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::bind_buffer_base(unsigned int target, unsigned int index,
+    unsigned int buffer_id)
+{
+    unsigned int* binding_ptr = this->get_buffer_base_binding(target, index);
+    if (binding_ptr != nullptr && *binding_ptr == buffer_id)
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+        return;
+    }
+    glBindBufferBase(target, index, buffer_id);
+    if (binding_ptr != nullptr)
+    {
+        *binding_ptr = buffer_id;
+    }
+    int slot = GlState::get_buffer_slot(target);
+    if (slot >= 0)
+    {
+        this->buffers_[slot] = buffer_id;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func active_texture
+;
+; @brief
+;   Selects the active texture unit if it is not selected yet.
+;
+; @params
+;   texture_unit    | Texture unit (GL_TEXTURE0 + i).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::active_texture(unsigned int texture_unit)
+{
+    if (this->active_texture_unit_ != texture_unit)
+    {
+        glActiveTexture(texture_unit);
+        this->active_texture_unit_ = texture_unit;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_texture
+;
+; @brief
+;   Binds the texture to the target of the texture unit if it is not bound
+;   yet. The active texture unit is switched only if a bind is needed.
+;
+; @params
+;   texture_unit    | Texture unit (GL_TEXTURE0 + i).
+;   target          | Texture target (GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY).
+;   texture_id      | Texture object id.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::bind_texture(unsigned int texture_unit, unsigned int target,
+    unsigned int texture_id)
+{
+    unsigned int* binding_ptr = this->get_texture_binding(texture_unit,
+        target);
+    if (binding_ptr != nullptr && *binding_ptr == texture_id)
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+        return;
+    }
+    this->active_texture(texture_unit);
+    glBindTexture(target, texture_id);
+    FRAME_STATS_ADD(texture_binds, 1);
+    if (binding_ptr != nullptr)
+    {
+        *binding_ptr = texture_id;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_blend
+;
+; @brief
+;   Enables or disables blending if it is not in the requested state yet.
+;
+; @params
+;   is_enabled  | Whether blending should be enabled.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_blend(bool is_enabled)
+{
+    if (this->is_blend_enabled_ != is_enabled)
+    {
+        if (is_enabled)
+        {
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            glDisable(GL_BLEND);
+        }
+        this->is_blend_enabled_ = is_enabled;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_blend_func
+;
+; @brief
+;   Sets the blend factors if they differ from the current ones.
+;
+; @params
+;   src_factor  | Source blend factor.
+;   dst_factor  | Destination blend factor.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_blend_func(unsigned int src_factor, unsigned int dst_factor)
+{
+    if (this->blend_src_factor_ != src_factor ||
+        this->blend_dst_factor_ != dst_factor)
+    {
+        glBlendFunc(src_factor, dst_factor);
+        this->blend_src_factor_ = src_factor;
+        this->blend_dst_factor_ = dst_factor;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_depth_test
+;
+; @brief
+;   Enables or disables the depth test if it is not in the requested state
+;   yet.
+;
+; @params
+;   is_enabled  | Whether the depth test should be enabled.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_depth_test(bool is_enabled)
+{
+    if (this->is_depth_test_enabled_ != is_enabled)
+    {
+        if (is_enabled)
+        {
+            glEnable(GL_DEPTH_TEST);
+        }
+        else
+        {
+            glDisable(GL_DEPTH_TEST);
+        }
+        this->is_depth_test_enabled_ = is_enabled;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_depth_mask
+;
+; @brief
+;   Enables or disables depth writes if they are not in the requested state
+;   yet. Note that 'glClear' does not clear the depth buffer while depth
+;   writes are disabled.
+;
+; @params
+;   is_enabled  | Whether depth writes should be enabled.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_depth_mask(bool is_enabled)
+{
+    if (this->is_depth_mask_enabled_ != is_enabled)
+    {
+        glDepthMask(is_enabled ? GL_TRUE : GL_FALSE);
+        this->is_depth_mask_enabled_ = is_enabled;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_depth_func
+;
+; @brief
+;   Sets the depth comparison function if it differs from the current one.
+;
+; @params
+;   func    | GL_LESS, GL_LEQUAL, etc.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_depth_func(unsigned int func)
+{
+    if (this->depth_func_ != func)
+    {
+        glDepthFunc(func);
+        this->depth_func_ = func;
+    }
+    else
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_pixel_store
+;
+; @brief
+;   Sets a pixel unpack parameter if it differs from the current value.
+;   Parameters that are not tracked are always passed to OpenGL.
+;
+; @params
+;   parameter   | GL_UNPACK_ROW_LENGTH, GL_UNPACK_SKIP_PIXELS,
+;               | GL_UNPACK_SKIP_ROWS, GL_UNPACK_ALIGNMENT, etc.
+;   value       | The new value.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::set_pixel_store(unsigned int parameter, int value)
+{
+    int* value_ptr = this->get_pixel_store_parameter(parameter);
+    if (value_ptr != nullptr && *value_ptr == value)
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+        return;
+    }
+    glPixelStorei(parameter, value);
+    if (value_ptr != nullptr)
+    {
+        *value_ptr = value;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func on_program_deleted
+;
+; @brief
+;   Must be called when a program object is deleted, so that a new object
+;   that gets the same id is not considered installed.
+;
+; @params
+;   program_id  | Id of the deleted program.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::on_program_deleted(unsigned int program_id)
+{
+    if (this->program_ == program_id)
+    {
+        this->program_ = UNKNOWN_BINDING;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func on_vertex_array_deleted
+;
+; @brief
+;   Must be called when a vertex array object is deleted. Deleting a bound
+;   vertex array reverts the binding to 0.
+;
+; @params
+;   vertex_array_id | Id of the deleted vertex array.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::on_vertex_array_deleted(unsigned int vertex_array_id)
+{
+    if (this->vertex_array_ == vertex_array_id)
+    {
+        this->vertex_array_ = 0;
+        this->buffers_[GlState::get_buffer_slot(GL_ELEMENT_ARRAY_BUFFER)] =
+            UNKNOWN_BINDING;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func on_buffer_deleted
+;
+; @brief
+;   Must be called when a buffer object is deleted. Deleting a bound buffer
+;   reverts the binding to 0.
+;
+; @params
+;   buffer_id   | Id of the deleted buffer.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::on_buffer_deleted(unsigned int buffer_id)
+{
+    for (unsigned int& binding : this->buffers_)
+    {
+        if (binding == buffer_id)
+        {
+            binding = 0;
+        }
+    }
+    for (unsigned int& binding : this->uniform_buffer_bases_)
+    {
+        if (binding == buffer_id)
+        {
+            binding = 0;
+        }
+    }
+    for (unsigned int& binding : this->shader_storage_buffer_bases_)
+    {
+        if (binding == buffer_id)
+        {
+            binding = 0;
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func on_texture_deleted
+;
+; @brief
+;   Must be called when a texture object is deleted. Deleting a bound texture
+;   reverts the binding to 0.
+;
+; @params
+;   texture_id  | Id of the deleted texture.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlState::on_texture_deleted(unsigned int texture_id)
+{
+    for (TextureUnit& texture_unit : this->texture_units_)
+    {
+        if (texture_unit.texture_2d == texture_id)
+        {
+            texture_unit.texture_2d = 0;
+        }
+        if (texture_unit.texture_2d_array == texture_id)
+        {
+            texture_unit.texture_2d_array = 0;
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_program
+;
+; @brief
+;   Returns the installed program.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Program object id.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlState::get_program() const
+{
+    return this->program_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_vertex_array
+;
+; @brief
+;   Returns the bound vertex array. Replaces the
+;   'glGetIntegerv(GL_VERTEX_ARRAY_BINDING)' query.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Vertex array object id.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlState::get_vertex_array() const
+{
+    return this->vertex_array_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_buffer
+;
+; @brief
+;   Returns the buffer bound to the target.
+;
+; @params
+;   target  | Buffer binding target.
+;
+; @return
+;   unsigned int    | Buffer object id. 0xFFFFFFFF if the binding is unknown
+;                   | or the target is not tracked.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlState::get_buffer(unsigned int target) const
+{
+    int slot = GlState::get_buffer_slot(target);
+    return slot < 0 ? UNKNOWN_BINDING : this->buffers_[slot];
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_buffer_base
+;
+; @brief
+;   Returns the buffer bound to the indexed binding point of the target.
+;
+; @params
+;   target  | Buffer binding target.
+;   index   | Binding point of the target.
+;
+; @return
+;   unsigned int    | Buffer object id. 0xFFFFFFFF if the target is not
+;                   | tracked or the index is out of range.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlState::get_buffer_base(unsigned int target,
+    unsigned int index) const
+{
+    unsigned int const* binding_ptr =
+        const_cast<GlState*>(this)->get_buffer_base_binding(target, index);
+    return binding_ptr == nullptr ? UNKNOWN_BINDING : *binding_ptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_max_texture_image_units
+;
+; @brief
+;   Returns GL_MAX_TEXTURE_IMAGE_UNITS.
+;
+; @params
+;   None
+;
+; @return
+;   int | The number of texture units available to the fragment shader.
+;
+----------------------------------------------------------------------------**/
+int GlState::get_max_texture_image_units() const
+{
+    return this->max_texture_image_units_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_max_3d_texture_size
+;
+; @brief
+;   Returns GL_MAX_3D_TEXTURE_SIZE.
+;
+; @params
+;   None
+;
+; @return
+;   int | The maximum width/height of a texture 2d array.
+;
+----------------------------------------------------------------------------**/
+int GlState::get_max_3d_texture_size() const
+{
+    return this->max_3d_texture_size_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_max_array_texture_layers
+;
+; @brief
+;   Returns GL_MAX_ARRAY_TEXTURE_LAYERS.
+;
+; @params
+;   None
+;
+; @return
+;   int | The maximum depth of a texture 2d array.
+;
+----------------------------------------------------------------------------**/
+int GlState::get_max_array_texture_layers() const
+{
+    return this->max_array_texture_layers_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_buffer_slot
+;
+; @brief
+;   Maps a buffer binding target to an index in 'buffers_'.
+;
+; @params
+;   target  | Buffer binding target.
+;
+; @return
+;   int | Index in 'buffers_'. -1 if the target is not tracked.
+;
+----------------------------------------------------------------------------**/
+int GlState::get_buffer_slot(unsigned int target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:           return 0;
+    case GL_ELEMENT_ARRAY_BUFFER:   return 1;
+    case GL_DRAW_INDIRECT_BUFFER:   return 2;
+    case GL_DISPATCH_INDIRECT_BUFFER:
+                                    return 3;
+    case GL_UNIFORM_BUFFER:         return 4;
+    case GL_SHADER_STORAGE_BUFFER:  return 5;
+    case GL_PIXEL_UNPACK_BUFFER:    return 6;
+    case GL_PIXEL_PACK_BUFFER:      return 7;
+    case GL_COPY_READ_BUFFER:       return 8;
+    case GL_COPY_WRITE_BUFFER:      return 9;
+    default:                        return -1;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_buffer_base_binding
+;
+; @brief
+;   Returns a pointer to the tracked indexed binding of the target.
+;
+; @params
+;   target  | Buffer binding target.
+;   index   | Binding point of the target.
+;
+; @return
+;   unsigned int*   | The tracked binding. nullptr if the target is not
+;                   | tracked or the index is out of range.
+;
+----------------------------------------------------------------------------**/
+unsigned int* GlState::get_buffer_base_binding(unsigned int target,
+    unsigned int index)
+{
+    std::vector<unsigned int>* bases_ptr = nullptr;
+    switch (target)
+    {
+    case GL_UNIFORM_BUFFER:
+        bases_ptr = &this->uniform_buffer_bases_;
+        break;
+    case GL_SHADER_STORAGE_BUFFER:
+        bases_ptr = &this->shader_storage_buffer_bases_;
+        break;
+    default:
+        return nullptr;
+    }
+    return index < bases_ptr->size() ? &(*bases_ptr)[index] : nullptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_texture_binding
+;
+; @brief
+;   Returns a pointer to the tracked binding of the target of the unit.
+;
+; @params
+;   texture_unit    | Texture unit (GL_TEXTURE0 + i).
+;   target          | Texture target.
+;
+; @return
+;   unsigned int*   | Tracked binding. nullptr if it is not tracked.
+;
+----------------------------------------------------------------------------**/
+unsigned int* GlState::get_texture_binding(unsigned int texture_unit,
+    unsigned int target)
+{
+    unsigned int unit_index = texture_unit - GL_TEXTURE0;
+    if (unit_index >= this->texture_units_.size())
+    {
+        return nullptr;
+    }
+    switch (target)
+    {
+    case GL_TEXTURE_2D:
+        return &this->texture_units_[unit_index].texture_2d;
+    case GL_TEXTURE_2D_ARRAY:
+        return &this->texture_units_[unit_index].texture_2d_array;
+    default:
+        return nullptr;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_pixel_store_parameter
+;
+; @brief
+;   Returns a pointer to the tracked value of the pixel-store parameter.
+;
+; @params
+;   parameter   | Pixel-store parameter name.
+;
+; @return
+;   int*    | Tracked value. nullptr if the parameter is not tracked.
+;
+----------------------------------------------------------------------------**/
+int* GlState::get_pixel_store_parameter(unsigned int parameter)
+{
+    switch (parameter)
+    {
+    case GL_UNPACK_ROW_LENGTH:  return &this->unpack_row_length_;
+    case GL_UNPACK_SKIP_PIXELS: return &this->unpack_skip_pixels_;
+    case GL_UNPACK_SKIP_ROWS:   return &this->unpack_skip_rows_;
+    case GL_UNPACK_ALIGNMENT:   return &this->unpack_alignment_;
+    default:                    return nullptr;
+    }
+}
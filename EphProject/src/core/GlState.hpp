@@ -0,0 +1,115 @@
+/**----------------------------------------------------------------------------
+; @file GlState.hpp
+;
+; @brief
+;   This file describes the 'GlState' class. An object of this class is a
+;   shadow copy of the OpenGL context state that the engine changes: the bound
+;   program, vertex array, buffers (generic and indexed uniform/shader
+;   storage bindings), the active texture unit, the per-unit texture
+;   bindings, the blend and depth state and the pixel-store parameters. It
+;   also keeps the implementation limits that are queried once.
+;
+;   All classes change the context state through the object of the current
+;   context ('GlState::current()'). A call that would not change the state is
+;   not passed to OpenGL, and the state is never read back with 'glGet*'.
+;
+;   One object must be created per context, right after the context is made
+;   current (i.e. while the context is in its default state), and registered
+;   with 'make_current' on the thread that uses the context.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GlState
+{
+public:
+    GlState();
+
+    static GlState& current();
+    static void make_current(GlState* gl_state_ptr);
+
+    void use_program(unsigned int program_id);
+    void bind_vertex_array(unsigned int vertex_array_id);
+    void bind_buffer(unsigned int target, unsigned int buffer_id);
+    void bind_buffer_base(unsigned int target, unsigned int index,
+        unsigned int buffer_id);
+    void active_texture(unsigned int texture_unit);
+    void bind_texture(unsigned int texture_unit, unsigned int target,
+        unsigned int texture_id);
+    void set_blend(bool is_enabled);
+    void set_blend_func(unsigned int src_factor, unsigned int dst_factor);
+    void set_depth_test(bool is_enabled);
+    void set_depth_mask(bool is_enabled);
+    void set_depth_func(unsigned int func);
+    void set_pixel_store(unsigned int parameter, int value);
+
+    void on_program_deleted(unsigned int program_id);
+    void on_vertex_array_deleted(unsigned int vertex_array_id);
+    void on_buffer_deleted(unsigned int buffer_id);
+    void on_texture_deleted(unsigned int texture_id);
+
+    unsigned int get_program() const;
+    unsigned int get_vertex_array() const;
+    unsigned int get_buffer(unsigned int target) const;
+    unsigned int get_buffer_base(unsigned int target,
+        unsigned int index) const;
+
+    int get_max_texture_image_units() const;
+    int get_max_3d_texture_size() const;
+    int get_max_array_texture_layers() const;
+
+private:
+    struct TextureUnit
+    {
+        unsigned int texture_2d;
+        unsigned int texture_2d_array;
+    };
+
+    unsigned int program_;
+    unsigned int vertex_array_;
+    std::vector<unsigned int> buffers_; /* Indexed by 'get_buffer_slot'      */
+    std::vector<unsigned int> uniform_buffer_bases_;
+    std::vector<unsigned int> shader_storage_buffer_bases_;
+    unsigned int active_texture_unit_;
+    std::vector<TextureUnit> texture_units_;
+    bool is_blend_enabled_;
+    unsigned int blend_src_factor_;
+    unsigned int blend_dst_factor_;
+    bool is_depth_test_enabled_;
+    bool is_depth_mask_enabled_;
+    unsigned int depth_func_;
+    int unpack_row_length_;
+    int unpack_skip_pixels_;
+    int unpack_skip_rows_;
+    int unpack_alignment_;
+
+    int max_texture_image_units_;
+    int max_3d_texture_size_;
+    int max_array_texture_layers_;
+
+    static thread_local GlState* current_ptr_;
+
+    static int get_buffer_slot(unsigned int target);
+    unsigned int* get_buffer_base_binding(unsigned int target,
+        unsigned int index);
+    unsigned int* get_texture_binding(unsigned int texture_unit,
+        unsigned int target);
+    int* get_pixel_store_parameter(unsigned int parameter);
+
+    GlState(const GlState&) = delete;
+    GlState& operator=(const GlState&) = delete;
+};
@@ -0,0 +1,428 @@
+/**----------------------------------------------------------------------------
+; @file GlyphCache.cpp
+;
+; @brief
+;   The file implements the functionality of the 'GlyphCache' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+
+#include "GlyphCache.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func GlyphCache
+;
+; @brief
+;   Constructor. Creates the single-channel texture 2d array of the cache and
+;   its layers. All slots are free.
+;
+; @params
+;   rasterizer_ptr  | Rasterizer of the glyphs (the font).
+;   slot_size       | Side of a slot (in pixels). Glyphs larger than a slot
+;                   | are not cached and count as missing.
+;   layer_size      | Side of a layer of the texture 2d array (in pixels).
+;   layers_count    | Number of layers of the texture 2d array.
+;
+----------------------------------------------------------------------------**/
+GlyphCache::GlyphCache(GlyphRasterizer const* rasterizer_ptr, int slot_size,
+    int layer_size, int layers_count)
+    :rasterizer_ptr_(rasterizer_ptr), slot_size_(slot_size),
+    slots_per_row_(layer_size / slot_size),
+    slots_per_layer_(static_cast<unsigned int>(
+        (layer_size / slot_size) * (layer_size / slot_size))),
+    texture_2d_array_(layer_size, layer_size, layers_count,
+        TEXTURE_FORMAT_R8),
+    used_slots_count_(0), lru_head_(NO_SLOT), lru_tail_(NO_SLOT),
+    generation_(1), hits_count_(0), misses_count_(0), evictions_count_(0)
+{
+    this->layers_.reserve(static_cast<std::size_t>(layers_count));
+    for (int z = 0; z < layers_count; z++)
+    {                                   /* Reserved: the glyphs keep         */
+        this->layers_.emplace_back(&this->texture_2d_array_, z);
+    }                                   /* pointers to the layers            */
+    this->slots_.resize(static_cast<std::size_t>(this->slots_per_layer_) *
+        layers_count, { 0, NO_SLOT, NO_SLOT, 0 });
+}
+
+
+/**----------------------------------------------------------------------------
+; @func find
+;
+; @brief
+;   Looks up a glyph and pins it until the next 'release' call. A glyph that
+;   is not cached yet is rasterized and uploaded into a free slot, or into
+;   the slot of the least recently used glyph that is not pinned.
+;
+; @params
+;   codepoint       | Unicode codepoint of the glyph.
+;   pixel_height    | Glyph height (in pixels).
+;   glyph           | Receives the placement of the glyph on success.
+;
+; @return
+;   enGlyphLookup   | GLYPH_LOOKUP_FOUND if 'glyph' is set.
+;
+----------------------------------------------------------------------------**/
+enGlyphLookup GlyphCache::find(unsigned int codepoint, int pixel_height,
+    Glyph& glyph)
+{
+    std::uint64_t key = (static_cast<std::uint64_t>(pixel_height) << 32) |
+        codepoint;
+    std::unordered_map<std::uint64_t, Entry>::iterator it =
+        this->entries_.find(key);
+    if (it != this->entries_.end())
+    {
+        if (it->second.is_missing)
+        {
+            return GLYPH_LOOKUP_MISSING;
+        }
+        unsigned int slot_index = it->second.slot_index;
+        if (slot_index != NO_SLOT)
+        {                               /* Make it the most recently used    */
+            this->unlink(slot_index);
+            this->link_front(slot_index);
+            this->slots_[slot_index].generation = this->generation_;
+        }
+        this->hits_count_++;
+        glyph = it->second.glyph;
+        return GLYPH_LOOKUP_FOUND;
+    }
+
+    Entry entry = { NO_SLOT, false, { nullptr, glm::vec4(0.0f),
+        glm::vec2(0.0f), glm::vec2(0.0f), 0.0f } };
+    if (!this->rasterizer_ptr_->rasterize(codepoint, pixel_height,
+        this->bitmap_))
+    {
+        entry.is_missing = true;        /* Do not ask the rasterizer again   */
+        this->entries_.emplace(key, entry);
+        return GLYPH_LOOKUP_MISSING;
+    }
+    if (this->bitmap_.width > this->slot_size_ ||
+        this->bitmap_.height > this->slot_size_)
+    {
+        LOG_WARNING("The glyph does not fit in a slot of the glyph cache.");
+        entry.is_missing = true;
+        this->entries_.emplace(key, entry);
+        return GLYPH_LOOKUP_MISSING;
+    }
+
+    entry.glyph.offset = glm::vec2(static_cast<float>(this->bitmap_.offset_x),
+        static_cast<float>(this->bitmap_.offset_y));
+    entry.glyph.size = glm::vec2(static_cast<float>(this->bitmap_.width),
+        static_cast<float>(this->bitmap_.height));
+    entry.glyph.advance = static_cast<float>(this->bitmap_.advance);
+    if (this->bitmap_.width > 0 && this->bitmap_.height > 0)
+    {
+        entry.slot_index = this->acquire_slot();
+        if (entry.slot_index == NO_SLOT)
+        {
+            return GLYPH_LOOKUP_CACHE_BUSY;
+        }
+        this->upload(entry.slot_index, entry.glyph);
+        this->slots_[entry.slot_index].key = key;
+        this->slots_[entry.slot_index].generation = this->generation_;
+        this->link_front(entry.slot_index);
+    }
+    this->misses_count_++;
+    this->entries_.emplace(key, entry);
+    glyph = entry.glyph;
+    return GLYPH_LOOKUP_FOUND;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func release
+;
+; @brief
+;   Unpins all glyphs. Must be called once the draws that use the glyphs
+;   found so far have been issued: their slots may be reused after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlyphCache::release()
+{
+    this->generation_++;                /* Stale generations are unpinned    */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_line_height
+;
+; @brief
+;   Returns the distance between the tops of two consecutive lines of text.
+;
+; @params
+;   pixel_height    | Glyph height (in pixels).
+;
+; @return
+;   int | Line height (in pixels).
+;
+----------------------------------------------------------------------------**/
+int GlyphCache::get_line_height(int pixel_height) const
+{
+    return this->rasterizer_ptr_->get_line_height(pixel_height);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_slots_count
+;
+; @brief
+;   Returns the number of slots of the cache, i.e. the maximum number of
+;   glyphs that can be drawn with one 'release' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of slots.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlyphCache::get_slots_count() const
+{
+    return static_cast<unsigned int>(this->slots_.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_hits_count
+;
+; @brief
+;   Returns the number of lookups of cached glyphs since the last
+;   'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of hits.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlyphCache::get_hits_count() const
+{
+    return this->hits_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_misses_count
+;
+; @brief
+;   Returns the number of glyphs rasterized and cached since the last
+;   'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of misses.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlyphCache::get_misses_count() const
+{
+    return this->misses_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_evictions_count
+;
+; @brief
+;   Returns the number of glyphs evicted since the last 'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of evictions.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlyphCache::get_evictions_count() const
+{
+    return this->evictions_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the hits, misses and evictions counters.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlyphCache::reset_stats()
+{
+    this->hits_count_ = 0;
+    this->misses_count_ = 0;
+    this->evictions_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func acquire_slot
+;
+; @brief
+;   Returns a slot for a new glyph: a free one if any, otherwise the least
+;   recently used one, whose glyph is evicted. The returned slot is not in
+;   the LRU list.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Slot index, or NO_SLOT if every slot is pinned.
+;
+----------------------------------------------------------------------------**/
+unsigned int GlyphCache::acquire_slot()
+{
+    if (this->used_slots_count_ < this->slots_.size())
+    {
+        return this->used_slots_count_++;
+    }
+
+    unsigned int slot_index = this->lru_tail_;
+    if (this->slots_[slot_index].generation == this->generation_)
+    {                                   /* The least recently used glyph is  */
+        return NO_SLOT;                 /* pinned, so are all the others     */
+    }
+    this->entries_.erase(this->slots_[slot_index].key);
+    this->unlink(slot_index);
+    this->evictions_count_++;
+    return slot_index;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func upload
+;
+; @brief
+;   Uploads the rasterized glyph into a slot and sets its texture region.
+;   The rows are flipped: the bitmap starts with the top row, the texture
+;   with the bottom one.
+;
+; @params
+;   slot_index  | Slot of the glyph.
+;   glyph       | The glyph. Receives its layer and texture region.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlyphCache::upload(unsigned int slot_index, Glyph& glyph)
+{
+    int width = this->bitmap_.width;
+    int height = this->bitmap_.height;
+    this->flipped_pixels_.resize(this->bitmap_.pixels.size());
+    for (int y = 0; y < height; y++)
+    {
+        std::copy_n(this->bitmap_.pixels.begin() + static_cast<std::ptrdiff_t>(
+            y * width), width, this->flipped_pixels_.begin() +
+            static_cast<std::ptrdiff_t>((height - 1 - y) * width));
+    }
+
+    Texture2dArrayLayer& layer = this->layers_[slot_index /
+        this->slots_per_layer_];
+    unsigned int layer_slot_index = slot_index % this->slots_per_layer_;
+    int x = static_cast<int>(layer_slot_index % this->slots_per_row_) *
+        this->slot_size_;
+    int y = static_cast<int>(layer_slot_index / this->slots_per_row_) *
+        this->slot_size_;
+    layer.add_subimage(x, y, width, height, 0, 0,
+        this->flipped_pixels_.data(), width, height, 1);
+
+    float layer_size = static_cast<float>(this->texture_2d_array_.get_width());
+    glyph.texture_2d_array_layer_ptr = &layer;
+    glyph.txd_rect = glm::vec4(x / layer_size, y / layer_size,
+        width / layer_size, height / layer_size);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func unlink
+;
+; @brief
+;   Removes a slot from the LRU list.
+;
+; @params
+;   slot_index  | Slot in the list.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlyphCache::unlink(unsigned int slot_index)
+{
+    Slot& slot = this->slots_[slot_index];
+    if (slot.prev != NO_SLOT)
+    {
+        this->slots_[slot.prev].next = slot.next;
+    }
+    else
+    {
+        this->lru_head_ = slot.next;
+    }
+    if (slot.next != NO_SLOT)
+    {
+        this->slots_[slot.next].prev = slot.prev;
+    }
+    else
+    {
+        this->lru_tail_ = slot.prev;
+    }
+    slot.prev = NO_SLOT;
+    slot.next = NO_SLOT;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func link_front
+;
+; @brief
+;   Inserts a slot at the head of the LRU list (the most recently used
+;   end).
+;
+; @params
+;   slot_index  | Slot that is not in the list.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GlyphCache::link_front(unsigned int slot_index)
+{
+    Slot& slot = this->slots_[slot_index];
+    slot.prev = NO_SLOT;
+    slot.next = this->lru_head_;
+    if (this->lru_head_ != NO_SLOT)
+    {
+        this->slots_[this->lru_head_].prev = slot_index;
+    }
+    else
+    {
+        this->lru_tail_ = slot_index;
+    }
+    this->lru_head_ = slot_index;
+}
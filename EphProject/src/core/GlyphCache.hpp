@@ -0,0 +1,137 @@
+/**----------------------------------------------------------------------------
+; @file GlyphCache.hpp
+;
+; @brief
+;   This file describes the 'GlyphCache' class. This class keeps rasterized
+;   glyphs in a single-channel 'Texture2dArray', so a string is drawn from
+;   one texture with one instanced draw call (see 'Renderer::draw_text').
+;
+;   A glyph is rasterized on demand, the first time it is looked up
+;   ('GlyphRasterizer'), and uploaded into a slot. The layers of the texture
+;   array are cut into square slots of the same size, so any free slot fits
+;   any glyph and a slot is reused without packing. When all slots are used,
+;   the least recently used glyph is evicted.
+;
+;   The glyphs looked up since the last 'release' call are pinned: the draw
+;   that uses them has not been issued yet, so their slots cannot be reused.
+;   If every slot is pinned, the lookup fails with 'GLYPH_LOOKUP_CACHE_BUSY',
+;   and the caller draws what it has collected, calls 'release' and looks the
+;   glyph up again.
+;
+;   Glyphs are cached per codepoint and pixel height. Blank glyphs (e.g.
+;   space) and codepoints the font does not have take no slot.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "GlyphRasterizer.hpp"
+#include "Texture2dArray.hpp"
+#include "Texture2dArrayLayer.hpp"
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enGlyphLookup
+{
+    GLYPH_LOOKUP_FOUND = 0,             /* The glyph is cached (or blank)    */
+    GLYPH_LOOKUP_MISSING = 1,           /* The font has no such glyph        */
+    GLYPH_LOOKUP_CACHE_BUSY = 2,        /* No slot can be evicted until      */
+                                        /* 'release' is called               */
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GlyphCache
+{
+public:
+    struct Glyph
+    {
+        Texture2dArrayLayer const* texture_2d_array_layer_ptr;
+                                        /* nullptr for blank glyphs          */
+        glm::vec4 txd_rect;             /* Region of the slot on the layer   */
+        glm::vec2 offset;               /* Top left corner relative to the   */
+                                        /* pen (in pixels)                   */
+        glm::vec2 size;                 /* In pixels                         */
+        float advance;                  /* In pixels                         */
+    };
+
+    GlyphCache(GlyphRasterizer const* rasterizer_ptr, int slot_size = 64,
+        int layer_size = 1024, int layers_count = 1);
+
+    enGlyphLookup find(unsigned int codepoint, int pixel_height,
+        Glyph& glyph);
+    void release();
+    int get_line_height(int pixel_height) const;
+
+    unsigned int get_slots_count() const;
+    unsigned int get_hits_count() const;
+    unsigned int get_misses_count() const;
+    unsigned int get_evictions_count() const;
+    void reset_stats();
+
+    static constexpr unsigned int NO_SLOT = 0xFFFFFFFF;
+
+private:
+    struct Slot
+    {
+        std::uint64_t key;              /* Key of the glyph in the slot      */
+        unsigned int prev;              /* Neighbours in the LRU list        */
+        unsigned int next;
+        unsigned int generation;        /* Pinned if equal to 'generation_'  */
+    };
+
+    struct Entry
+    {
+        unsigned int slot_index;        /* NO_SLOT if the glyph takes none   */
+        bool is_missing;                /* The font has no such glyph        */
+        Glyph glyph;
+    };
+
+    GlyphRasterizer const* rasterizer_ptr_;
+    int slot_size_;
+    int slots_per_row_;
+    unsigned int slots_per_layer_;
+    Texture2dArray texture_2d_array_;
+    std::vector<Texture2dArrayLayer> layers_;
+
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::vector<Slot> slots_;
+    unsigned int used_slots_count_;     /* Slots [0, count) hold glyphs      */
+    unsigned int lru_head_;             /* The most recently used slot       */
+    unsigned int lru_tail_;             /* The least recently used slot      */
+    unsigned int generation_;
+
+    GlyphBitmap bitmap_;                /* Scratch buffers of the            */
+    std::vector<unsigned char> flipped_pixels_;
+                                        /* rasterization                     */
+
+    unsigned int hits_count_;
+    unsigned int misses_count_;
+    unsigned int evictions_count_;
+
+    unsigned int acquire_slot();
+    void upload(unsigned int slot_index, Glyph& glyph);
+    void unlink(unsigned int slot_index);
+    void link_front(unsigned int slot_index);
+
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+};
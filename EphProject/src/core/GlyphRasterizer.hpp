@@ -0,0 +1,58 @@
+/**----------------------------------------------------------------------------
+; @file GlyphRasterizer.hpp
+;
+; @brief
+;   This file describes the 'GlyphRasterizer' interface. A rasterizer turns
+;   a codepoint at a pixel height into an 8-bit coverage bitmap and the
+;   metrics needed to place it, the way 'stbtt_GetCodepointBitmap' and
+;   'stbtt_GetCodepointHMetrics' of stb_truetype do. The 'GlyphCache' calls
+;   it only when a glyph is not cached yet.
+;
+;   'BitmapFontRasterizer' is the built-in implementation. A TrueType
+;   rasterizer (stb_truetype, FreeType) plugs in by implementing the same
+;   two functions.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct GlyphBitmap
+{
+    int width;                          /* Size of the bitmap (in pixels),   */
+    int height;                         /* 0 for blank glyphs (e.g. space)   */
+    int offset_x;                       /* Top left corner of the bitmap     */
+    int offset_y;                       /* relative to the pen position on   */
+                                        /* the top of the line (y down)      */
+    int advance;                        /* Pen advance (in pixels)           */
+    std::vector<unsigned char> pixels;  /* Coverage, one byte per pixel, the */
+                                        /* top row first                     */
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GlyphRasterizer
+{
+public:
+    virtual ~GlyphRasterizer() {}
+
+    virtual bool rasterize(unsigned int codepoint, int pixel_height,
+        GlyphBitmap& glyph_bitmap) const = 0;
+                                        /* false if the font has no glyph    */
+                                        /* for the codepoint                 */
+    virtual int get_line_height(int pixel_height) const = 0;
+};
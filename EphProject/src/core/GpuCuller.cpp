@@ -0,0 +1,251 @@
+/**----------------------------------------------------------------------------
+; @file GpuCuller.cpp
+;
+; @brief
+;   The file implements the functionality of the 'GpuCuller' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "GpuCuller.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "IndicesData.hpp"
+#include "Shader.hpp"
+#include "SpriteInstance.hpp"
+#include "StaticLayer.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func GpuCuller
+;
+; @brief
+;   Constructor. Builds the unit quad shared by all instances and creates the
+;   output and draw command buffers. The buffers are allocated on the first
+;   'cull' call and grow with the culled layers.
+;
+; @params
+;   shader_ptr  | Compute shader program that implements the culling
+;               | ('shaders/sprite_cull_compute.shader').
+;
+----------------------------------------------------------------------------**/
+GpuCuller::GpuCuller(Shader const* shader_ptr)
+    :shader_ptr_(shader_ptr), unit_quad_indices_ptr_(nullptr),
+    output_buffer_id_(0), output_capacity_(0), commands_buffer_id_(0),
+    commands_capacity_(0), dispatches_count_(0)
+{
+    this->unit_quad_indices_ptr_ = this->unit_quad_.add_unit_quad();
+    this->unit_quad_.build();           /* Send the unit quad to the GPU     */
+
+    glGenBuffers(1, &this->output_buffer_id_);
+    glGenBuffers(1, &this->commands_buffer_id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~GpuCuller
+;
+; @brief
+;   Destructor. Deletes the buffer objects and the unit quad indices data.
+;
+----------------------------------------------------------------------------**/
+GpuCuller::~GpuCuller()
+{
+    glDeleteBuffers(1, &this->output_buffer_id_);
+    GlState::current().on_buffer_deleted(this->output_buffer_id_);
+    glDeleteBuffers(1, &this->commands_buffer_id_);
+    GlState::current().on_buffer_deleted(this->commands_buffer_id_);
+    delete this->unit_quad_indices_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func cull
+;
+; @brief
+;   Dispatches the cull shader over all instances of a static layer. After the
+;   call the output buffer holds the visible instances of each run at the
+;   beginning of the run's range, and the draw commands hold their numbers.
+;   Nothing is read back to the CPU. The layer must be updated before the
+;   call (see 'StaticLayer::update'). The cull shader program stays in use
+;   after the call.
+;
+; @params
+;   static_layer    | Static layer to be culled.
+;   cull_rect       | The view rectangle in world space (min x, min y, max x,
+;                   | max y).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuCuller::cull(StaticLayer const& static_layer,
+    glm::vec4 const& cull_rect)
+{
+    GlState& gl_state = GlState::current();
+    unsigned int instances_count = static_layer.get_sprites_count();
+    std::vector<StaticLayer::Run> const& runs = static_layer.get_runs();
+
+    if (instances_count > this->output_capacity_)
+    {                                   /* Grow the output buffer            */
+        this->output_capacity_ = instances_count;
+        gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER,
+            this->output_buffer_id_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(
+            this->output_capacity_ * sizeof(SpriteInstance)), nullptr,
+            GL_DYNAMIC_COPY);           /* Written and read by the GPU only  */
+    }
+
+    this->commands_.clear();            /* Reset the instance counters       */
+    for (StaticLayer::Run const& run : runs)
+    {
+        this->commands_.push_back({ this->unit_quad_indices_ptr_->count, 0,
+            static_cast<unsigned int>(reinterpret_cast<std::uintptr_t>(
+                this->unit_quad_indices_ptr_->offset) / sizeof(unsigned int)),
+            0, run.first_instance });
+    }
+    gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, this->commands_buffer_id_);
+    GLsizeiptr commands_size = static_cast<GLsizeiptr>(
+        this->commands_.size() * sizeof(DrawElementsIndirectCommand));
+    if (this->commands_.size() > this->commands_capacity_)
+    {
+        this->commands_capacity_ = static_cast<unsigned int>(
+            this->commands_.size());
+        glBufferData(GL_SHADER_STORAGE_BUFFER, commands_size,
+            this->commands_.data(), GL_DYNAMIC_DRAW);
+    }
+    else
+    {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commands_size,
+            this->commands_.data());
+    }
+    FRAME_STATS_ADD(buffer_bytes, commands_size);
+
+    if (instances_count == 0)
+    {
+        return;
+    }
+
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        CULL_BUFFER_INPUT_INSTANCES, static_layer.get_buffer_id());
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        CULL_BUFFER_OUTPUT_INSTANCES, this->output_buffer_id_);
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        CULL_BUFFER_DRAW_COMMANDS, this->commands_buffer_id_);
+
+    this->shader_ptr_->use();
+    this->shader_ptr_->set_vec4("uf_cull_rect", cull_rect);
+    this->shader_ptr_->set_int("uf_instances_count",
+        static_cast<int>(instances_count));
+    this->shader_ptr_->set_int("uf_runs_count",
+        static_cast<int>(runs.size()));
+    glDispatchCompute((instances_count + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+    FRAME_STATS_ADD(dispatches, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT |
+        GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+                                        /* Make the writes visible to the    */
+                                        /* indirect draws, the vertex fetch  */
+                                        /* and the next counters reset       */
+    this->dispatches_count_++;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Binds the unit quad vertex array with the output buffer attached to it as
+;   the per-instance buffer, and the draw commands as the indirect buffer.
+;   Both stay bound after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuCuller::bind() const
+{
+    this->unit_quad_.bind_instance_buffer(this->output_buffer_id_, 0);
+    GlState::current().bind_buffer(GL_DRAW_INDIRECT_BUFFER,
+        this->commands_buffer_id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_run
+;
+; @brief
+;   Draws the visible instances of a run of the last culled layer with a
+;   single indirect call. The texture 2d array of the run and a drawing shader
+;   program must be in use, and 'bind' must be called before.
+;
+; @params
+;   run_index   | Index of the run in 'StaticLayer::get_runs'.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuCuller::draw_run(unsigned int run_index) const
+{
+    glDrawElementsIndirect(this->unit_quad_indices_ptr_->mode,
+        GL_UNSIGNED_INT, reinterpret_cast<void const*>(
+            static_cast<std::uintptr_t>(run_index *
+            sizeof(DrawElementsIndirectCommand))));
+    FRAME_STATS_ADD(draw_calls, 1);     /* The instances are counted on the  */
+                                        /* GPU                               */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_dispatches_count
+;
+; @brief
+;   Returns the number of compute dispatches since the last 'reset_stats'
+;   call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of dispatches.
+;
+----------------------------------------------------------------------------**/
+unsigned int GpuCuller::get_dispatches_count() const
+{
+    return this->dispatches_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the dispatches counter.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuCuller::reset_stats()
+{
+    this->dispatches_count_ = 0;
+}
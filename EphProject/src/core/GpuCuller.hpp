@@ -0,0 +1,101 @@
+/**----------------------------------------------------------------------------
+; @file GpuCuller.hpp
+;
+; @brief
+;   This file describes the 'GpuCuller' class. This class culls the sprites of
+;   a 'StaticLayer' on the GPU and draws the survivors without reading
+;   anything back.
+;
+;   The instance buffer of the layer is read by a compute shader as a shader
+;   storage buffer ('shaders/sprite_cull_compute.shader'). Each invocation
+;   tests one instance against the view rectangle and appends the visible
+;   ones to the range of their run in the output buffer. The number of
+;   survivors is accumulated straight into the 'instance_count' field of the
+;   'DrawElementsIndirectCommand' of the run. The output buffer is then
+;   attached to the unit quad as the per-instance buffer and each run is
+;   drawn with 'glDrawElementsIndirect'.
+;
+;   A frame costs one dispatch and one indirect draw per run (i.e. per texture
+;   2d array), no matter how many sprites the layer has. Only core OpenGL 4.3
+;   is used, so the pass also works on software implementations (e.g. Mesa
+;   llvmpipe).
+;
+;   The appends are unordered: the survivors of a run are drawn in an
+;   arbitrary order. Overlapping translucent sprites of the layer should have
+;   distinct depths and be drawn with the depth test on, or not be culled on
+;   the GPU.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "IndirectBatch.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Shader;
+class StaticLayer;
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enCullBufferBinding                /* Shader storage buffer binding     */
+{                                       /* points of the cull shader         */
+    CULL_BUFFER_INPUT_INSTANCES = 0,
+    CULL_BUFFER_OUTPUT_INSTANCES = 1,
+    CULL_BUFFER_DRAW_COMMANDS = 2,
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GpuCuller
+{
+public:
+    GpuCuller(Shader const* shader_ptr);
+    ~GpuCuller();
+
+    void cull(StaticLayer const& static_layer, glm::vec4 const& cull_rect);
+    void bind() const;
+    void draw_run(unsigned int run_index) const;
+
+    unsigned int get_dispatches_count() const;
+    void reset_stats();
+
+    static constexpr unsigned int GROUP_SIZE = 64;
+                                        /* 'local_size_x' of the shader      */
+
+private:
+    Shader const* shader_ptr_;
+    VertexArray unit_quad_;
+    IndicesData* unit_quad_indices_ptr_;
+
+    unsigned int output_buffer_id_;
+    unsigned int output_capacity_;      /* In instances                      */
+    unsigned int commands_buffer_id_;
+    unsigned int commands_capacity_;    /* In commands                       */
+    std::vector<DrawElementsIndirectCommand> commands_;
+                                        /* Initial commands (no instances)   */
+
+    unsigned int dispatches_count_;
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+};
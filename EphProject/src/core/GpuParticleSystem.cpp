@@ -0,0 +1,384 @@
+/**----------------------------------------------------------------------------
+; @file GpuParticleSystem.cpp
+;
+; @brief
+;   The file implements the functionality of the 'GpuParticleSystem' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "GpuParticleSystem.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "IndicesData.hpp"
+#include "IndirectBatch.hpp"
+#include "Log.hpp"
+#include "Shader.hpp"
+#include "SpriteInstance.hpp"
+#include "Texture2dArrayLayer.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func GpuParticleSystem
+;
+; @brief
+;   Constructor. Builds the unit quad the particles are instances of and
+;   allocates the particle, instance, color and draw command buffers for the
+;   capacity of the system. The buffers are written and read by the GPU only.
+;
+; @params
+;   shader_ptr              | Compute shader program that implements the
+;                           | simulation ('shaders/particle_compute.shader').
+;   texture_2d_array_ptr    | Texture 2d array all particles are taken from.
+;   capacity                | The maximum number of live particles.
+;
+----------------------------------------------------------------------------**/
+GpuParticleSystem::GpuParticleSystem(Shader const* shader_ptr,
+    Texture2dArray const* texture_2d_array_ptr, unsigned int capacity)
+    :shader_ptr_(shader_ptr), texture_2d_array_ptr_(texture_2d_array_ptr),
+    capacity_(capacity), gravity_(0.0f), txd_rect_(0.0f, 0.0f, 1.0f, 1.0f),
+    seed_(0), particle_buffer_ids_{ 0, 0 }, source_(0),
+    commands_buffer_id_(0), instance_buffer_id_(0), color_buffer_id_(0),
+    unit_quad_indices_ptr_(nullptr)
+{
+    this->unit_quad_indices_ptr_ = this->unit_quad_.add_unit_quad();
+    this->unit_quad_.build();           /* Send the unit quad to the GPU     */
+
+    GlState& gl_state = GlState::current();
+    glGenBuffers(2, this->particle_buffer_ids_);
+    for (unsigned int buffer_id : this->particle_buffer_ids_)
+    {
+        gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, buffer_id);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(
+            this->capacity_ * sizeof(GpuParticle)), nullptr, GL_DYNAMIC_COPY);
+    }
+    glGenBuffers(1, &this->instance_buffer_id_);
+    gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, this->instance_buffer_id_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(
+        this->capacity_ * sizeof(SpriteInstance)), nullptr, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &this->color_buffer_id_);
+    gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, this->color_buffer_id_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(
+        this->capacity_ * sizeof(std::uint32_t)), nullptr, GL_DYNAMIC_COPY);
+
+    DrawElementsIndirectCommand command = { this->unit_quad_indices_ptr_->
+        count, 0, static_cast<unsigned int>(reinterpret_cast<std::uintptr_t>(
+            this->unit_quad_indices_ptr_->offset) / sizeof(unsigned int)), 0,
+        0 };                            /* No live particles yet             */
+    DrawElementsIndirectCommand commands[2] = { command, command };
+    glGenBuffers(1, &this->commands_buffer_id_);
+    gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, this->commands_buffer_id_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(commands), commands,
+        GL_DYNAMIC_COPY);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~GpuParticleSystem
+;
+; @brief
+;   Destructor. Deletes the buffer objects and the unit quad indices data.
+;
+----------------------------------------------------------------------------**/
+GpuParticleSystem::~GpuParticleSystem()
+{
+    GlState& gl_state = GlState::current();
+    for (unsigned int buffer_id : { this->particle_buffer_ids_[0],
+        this->particle_buffer_ids_[1], this->commands_buffer_id_,
+        this->instance_buffer_id_, this->color_buffer_id_ })
+    {
+        glDeleteBuffers(1, &buffer_id);
+        gl_state.on_buffer_deleted(buffer_id);
+    }
+    delete this->unit_quad_indices_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func emit
+;
+; @brief
+;   Queues new particles. They are created on the GPU by the next 'update'.
+;   Particles that do not fit into the capacity are dropped.
+;
+; @params
+;   emitter | Ranges the particles are drawn from. The layer must belong to
+;           | the texture 2d array of the system.
+;   count   | Number of particles to be created.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::emit(ParticleEmitter const& emitter,
+    unsigned int count)
+{
+    if (emitter.texture_2d_array_layer_ptr->get_texture_2d_array() !=
+        this->texture_2d_array_ptr_)
+    {
+        LOG_WARNING("The emitter layer belongs to another texture 2d array.");
+        return;
+    }
+    if (count > 0)
+    {
+        this->emissions_.push_back({ emitter, count });
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update
+;
+; @brief
+;   Advances the particles by a time step and creates the queued ones: one
+;   simulate dispatch, then one emit dispatch per queued emission. After the
+;   call the target buffer holds the live particles, their instances and
+;   colors, and its draw command holds their number. Nothing is read back to
+;   the CPU. The particle shader program stays in use after the call.
+;
+; @params
+;   delta_time  | Time step (in seconds).
+;   depth       | Clip space z of the particles.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::update(float delta_time, float depth)
+{
+    GlState& gl_state = GlState::current();
+    unsigned int target = 1 - this->source_;
+
+    gl_state.bind_buffer(GL_SHADER_STORAGE_BUFFER, this->commands_buffer_id_);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI,
+        target * sizeof(DrawElementsIndirectCommand) +
+        offsetof(DrawElementsIndirectCommand, instance_count),
+        sizeof(unsigned int), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+                                        /* Empty the target buffer           */
+
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        PARTICLE_BUFFER_SOURCE, this->particle_buffer_ids_[this->source_]);
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        PARTICLE_BUFFER_TARGET, this->particle_buffer_ids_[target]);
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        PARTICLE_BUFFER_DRAW_COMMANDS, this->commands_buffer_id_);
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        PARTICLE_BUFFER_INSTANCES, this->instance_buffer_id_);
+    gl_state.bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+        PARTICLE_BUFFER_COLORS, this->color_buffer_id_);
+
+    this->shader_ptr_->use();
+    this->shader_ptr_->set_int("uf_pass", PARTICLE_PASS_SIMULATE);
+    this->shader_ptr_->set_int("uf_source",
+        static_cast<int>(this->source_));
+    this->shader_ptr_->set_int("uf_capacity",
+        static_cast<int>(this->capacity_));
+    this->shader_ptr_->set_float("uf_delta_time", delta_time);
+    this->shader_ptr_->set_vec2("uf_gravity", this->gravity_);
+    this->shader_ptr_->set_vec4("uf_txd_rect", this->txd_rect_);
+    this->shader_ptr_->set_float("uf_depth", depth);
+    glDispatchCompute((this->capacity_ + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+    FRAME_STATS_ADD(dispatches, 1);
+
+    this->shader_ptr_->set_int("uf_pass", PARTICLE_PASS_EMIT);
+    for (Emission const& emission : this->emissions_)
+    {
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+                                        /* Append after the previous pass    */
+        ParticleEmitter const& emitter = emission.emitter;
+        this->shader_ptr_->set_int("uf_emit_count",
+            static_cast<int>(emission.count));
+        this->shader_ptr_->set_int("uf_seed", static_cast<int>(
+            this->seed_++));
+        this->shader_ptr_->set_vec2("uf_emit_pos", emitter.pos);
+        this->shader_ptr_->set_vec2("uf_emit_spread", emitter.spread);
+        this->shader_ptr_->set_vec2("uf_velocity_min", emitter.velocity_min);
+        this->shader_ptr_->set_vec2("uf_velocity_max", emitter.velocity_max);
+        this->shader_ptr_->set_vec2("uf_life_range", emitter.life_range);
+        this->shader_ptr_->set_vec2("uf_size_range", emitter.size_range);
+        this->shader_ptr_->set_vec4("uf_color", emitter.color);
+        this->shader_ptr_->set_int("uf_z_offset",
+            emitter.texture_2d_array_layer_ptr->get_z_offset());
+        glDispatchCompute((emission.count + GROUP_SIZE - 1) / GROUP_SIZE, 1,
+            1);
+        FRAME_STATS_ADD(dispatches, 1);
+    }
+    this->emissions_.clear();
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT |
+        GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+                                        /* Make the writes visible to the    */
+                                        /* next update, the indirect draw,   */
+                                        /* the vertex fetch and the next     */
+                                        /* counter reset                     */
+    this->source_ = target;             /* The live particles are there now  */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Binds the unit quad vertex array with the instance and color buffers
+;   attached to it, and the draw commands as the indirect buffer. Both stay
+;   bound after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::bind() const
+{
+    this->unit_quad_.bind_instance_buffer(this->instance_buffer_id_, 0);
+    this->unit_quad_.bind_color_buffer(this->color_buffer_id_, 0);
+    GlState::current().bind_buffer(GL_DRAW_INDIRECT_BUFFER,
+        this->commands_buffer_id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw
+;
+; @brief
+;   Draws the live particles with a single indirect call. The texture 2d
+;   array of the system and a drawing shader program must be in use, and
+;   'bind' must be called before.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::draw() const
+{
+    glDrawElementsIndirect(this->unit_quad_indices_ptr_->mode,
+        GL_UNSIGNED_INT, reinterpret_cast<void const*>(
+            static_cast<std::uintptr_t>(this->source_ *
+            sizeof(DrawElementsIndirectCommand))));
+    FRAME_STATS_ADD(draw_calls, 1);     /* The instances are counted on the  */
+                                        /* GPU                               */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_gravity
+;
+; @brief
+;   Sets the acceleration applied to all particles. None by default.
+;
+; @params
+;   gravity | Acceleration (in pixels per second squared).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::set_gravity(glm::vec2 const& gravity)
+{
+    this->gravity_ = gravity;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_txd_rect
+;
+; @brief
+;   Sets the region of the layers the particles show. The whole layer by
+;   default. Applies from the next 'update'.
+;
+; @params
+;   txd_rect    | xy - offset, zw - size of the region (in normalized texture
+;               | coordinates).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuParticleSystem::set_txd_rect(glm::vec4 const& txd_rect)
+{
+    this->txd_rect_ = txd_rect;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_texture_2d_array
+;
+; @brief
+;   Returns the texture 2d array all particles are taken from.
+;
+; @params
+;   None
+;
+; @return
+;   Texture2dArray const*   | The texture 2d array.
+;
+----------------------------------------------------------------------------**/
+Texture2dArray const* GpuParticleSystem::get_texture_2d_array() const
+{
+    return this->texture_2d_array_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_capacity
+;
+; @brief
+;   Returns the maximum number of live particles.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The capacity of the system.
+;
+----------------------------------------------------------------------------**/
+std::size_t GpuParticleSystem::get_capacity() const
+{
+    return this->capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func read_particles_count
+;
+; @brief
+;   Reads the number of live particles back from the GPU. Waits for the GPU
+;   to finish the last update, so it is meant for statistics and debugging
+;   only.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of live particles.
+;
+----------------------------------------------------------------------------**/
+unsigned int GpuParticleSystem::read_particles_count() const
+{
+    DrawElementsIndirectCommand command = {};
+    GlState::current().bind_buffer(GL_SHADER_STORAGE_BUFFER,
+        this->commands_buffer_id_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(
+        this->source_ * sizeof(DrawElementsIndirectCommand)),
+        sizeof(DrawElementsIndirectCommand), &command);
+    return command.instance_count;
+}
@@ -0,0 +1,163 @@
+/**----------------------------------------------------------------------------
+; @file GpuParticleSystem.hpp
+;
+; @brief
+;   This file describes the 'GpuParticleSystem' class. This class simulates
+;   and draws particles entirely on the GPU, for effects too large for
+;   'ParticleSystem' (a million particles and more).
+;
+;   The particles live in two shader storage buffers used in turn
+;   ('shaders/particle_compute.shader'). Each 'update' runs a simulate pass
+;   that integrates the particles of the source buffer and appends the
+;   survivors to the target buffer, then one emit pass per queued emission
+;   that appends new particles there too, with random positions, velocities,
+;   lives and sizes drawn from the ranges of the emitter. The number of live
+;   particles is accumulated straight into the 'instance_count' field of the
+;   'DrawElementsIndirectCommand' of the target buffer, and every append also
+;   writes the 'SpriteInstance' and the color of the particle, so the draw is
+;   a single 'glDrawElementsIndirect' call against the texture 2d array of
+;   the system, with the usual drawing shader.
+;
+;   Nothing is read back and no particle data is sent by the CPU: a frame
+;   costs a few uniform uploads per emitter, a 4-byte buffer clear and
+;   '1 + emissions' dispatches. The simulate pass is dispatched over the
+;   whole capacity; the invocations past the live particles return at once.
+;
+;   Like in 'ParticleSystem', the particles are appended in an arbitrary
+;   order, so they should be blended in an order-independent way.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Shader;
+class Texture2dArray;
+class Texture2dArrayLayer;
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enParticleBufferBinding            /* Shader storage buffer binding     */
+{                                       /* points of the particle shader     */
+    PARTICLE_BUFFER_SOURCE = 0,
+    PARTICLE_BUFFER_TARGET = 1,
+    PARTICLE_BUFFER_DRAW_COMMANDS = 2,
+    PARTICLE_BUFFER_INSTANCES = 3,
+    PARTICLE_BUFFER_COLORS = 4,
+};
+
+enum enParticlePass                     /* 'uf_pass' of the particle shader  */
+{
+    PARTICLE_PASS_SIMULATE = 0,
+    PARTICLE_PASS_EMIT = 1,
+};
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct GpuParticle                      /* Matches the std430 layout of the  */
+{                                       /* particle shader                   */
+    glm::vec2 pos;                      /* Center (in pixels)                */
+    glm::vec2 velocity;                 /* In pixels per second              */
+    float life;                         /* Time to live (in seconds)         */
+    float size;                         /* Side (in pixels)                  */
+    int z_offset;                       /* Texture 2d array layer number     */
+    std::uint32_t color;                /* RGBA8, R in the lowest byte       */
+};
+
+struct ParticleEmitter                  /* Ranges new particles are drawn    */
+{                                       /* from, uniformly                   */
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr;
+    glm::vec2 pos;                      /* Center of the spawn area          */
+    glm::vec2 spread;                   /* Half size of the spawn area       */
+    glm::vec2 velocity_min;             /* In pixels per second              */
+    glm::vec2 velocity_max;
+    glm::vec2 life_range;               /* min, max (in seconds)             */
+    glm::vec2 size_range;               /* min, max (in pixels)              */
+    glm::vec4 color;
+};
+
+
+
+/** @static_asserts --------------------------------------------------------**/
+
+static_assert(sizeof(GpuParticle) == 32,
+    "'GpuParticle' does not match the std430 layout of the particle shader");
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GpuParticleSystem
+{
+public:
+    GpuParticleSystem(Shader const* shader_ptr,
+        Texture2dArray const* texture_2d_array_ptr, unsigned int capacity);
+    ~GpuParticleSystem();
+
+    void emit(ParticleEmitter const& emitter, unsigned int count);
+    void update(float delta_time, float depth);
+    void bind() const;
+    void draw() const;
+
+    void set_gravity(glm::vec2 const& gravity);
+    void set_txd_rect(glm::vec4 const& txd_rect);
+
+    Texture2dArray const* get_texture_2d_array() const;
+    std::size_t get_capacity() const;
+    unsigned int read_particles_count() const;
+
+    static constexpr unsigned int GROUP_SIZE = 64;
+                                        /* 'local_size_x' of the shader      */
+
+private:
+    struct Emission
+    {
+        ParticleEmitter emitter;
+        unsigned int count;
+    };
+
+    Shader const* shader_ptr_;
+    Texture2dArray const* texture_2d_array_ptr_;
+    unsigned int capacity_;
+    glm::vec2 gravity_;                 /* In pixels per second squared      */
+    glm::vec4 txd_rect_;                /* The region of the layers drawn    */
+    std::vector<Emission> emissions_;   /* Queued until the next 'update'    */
+    unsigned int seed_;                 /* Differs for every emission        */
+
+    unsigned int particle_buffer_ids_[2];
+    unsigned int source_;               /* Index of the buffer that holds    */
+                                        /* the live particles                */
+    unsigned int commands_buffer_id_;   /* One command per particle buffer   */
+    unsigned int instance_buffer_id_;
+    unsigned int color_buffer_id_;
+
+    VertexArray unit_quad_;
+    IndicesData* unit_quad_indices_ptr_;
+
+    GpuParticleSystem(const GpuParticleSystem&) = delete;
+    GpuParticleSystem& operator=(const GpuParticleSystem&) = delete;
+};
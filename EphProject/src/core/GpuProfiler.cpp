@@ -0,0 +1,509 @@
+/**----------------------------------------------------------------------------
+; @file GpuProfiler.cpp
+;
+; @brief
+;   The file implements the functionality of the 'GpuProfiler' and
+;   'GpuProfileScope' classes.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "GpuProfiler.hpp"
+#include "Log.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define DROPPED_SCOPE 0xFFFFFFFF        /* An open scope that has no queries */
+                                        /* (the frame ran out of them)       */
+
+
+
+/** @data_definitions  -----------------------------------------------------**/
+
+thread_local GpuProfiler* GpuProfiler::current_ptr_ = nullptr;
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func GpuProfiler
+;
+; @brief
+;   Constructor. Creates the query objects of all frames in flight.
+;
+; @params
+;   max_scopes_count    | The maximum number of scopes per frame. The scopes
+;                       | past it are not measured.
+;
+----------------------------------------------------------------------------**/
+GpuProfiler::GpuProfiler(unsigned int max_scopes_count)
+    :max_scopes_count_(max_scopes_count), frame_index_(0), frames_count_(0),
+    is_recording_(false), frame_time_(0.0), results_frame_number_(0),
+    skipped_frames_count_(0), dropped_scopes_count_(0)
+{
+    for (Frame& frame : this->frames_)
+    {
+        frame.query_ids.resize(static_cast<std::size_t>(max_scopes_count) *
+            2 + 2);
+        glGenQueries(static_cast<GLsizei>(frame.query_ids.size()),
+            frame.query_ids.data());
+        frame.scopes.reserve(max_scopes_count);
+        frame.number = 0;
+        frame.is_pending = false;
+    }
+    this->results_.reserve(max_scopes_count);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~GpuProfiler
+;
+; @brief
+;   Destructor. Deletes the query objects.
+;
+----------------------------------------------------------------------------**/
+GpuProfiler::~GpuProfiler()
+{
+    if (GpuProfiler::current_ptr_ == this)
+    {
+        GpuProfiler::current_ptr_ = nullptr;
+    }
+    for (Frame& frame : this->frames_)
+    {
+        glDeleteQueries(static_cast<GLsizei>(frame.query_ids.size()),
+            frame.query_ids.data());
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin_frame
+;
+; @brief
+;   Reads the results of the oldest frame in flight if the GPU has finished
+;   it, and starts measuring a new frame. If the GPU has not finished the
+;   oldest frame yet, the new frame is not measured (its scopes do nothing)
+;   instead of waiting. Makes the profiler current on the calling thread
+;   until 'end_frame' if the frame is measured.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::begin_frame()
+{
+    Frame& frame = this->frames_[this->frame_index_];
+    if (frame.is_pending)
+    {
+        GLint is_available = GL_FALSE;
+        glGetQueryObjectiv(frame.query_ids.back(),
+            GL_QUERY_RESULT_AVAILABLE, &is_available);
+                                        /* The frame end is the last query:  */
+                                        /* all others are done before it     */
+        if (is_available == GL_FALSE)
+        {
+            this->is_recording_ = false;
+            this->skipped_frames_count_++;
+            this->frames_count_++;
+            return;
+        }
+        this->read_results(frame);
+    }
+
+    frame.scopes.clear();
+    frame.number = this->frames_count_++;
+    glQueryCounter(frame.query_ids[frame.query_ids.size() - 2],
+        GL_TIMESTAMP);
+    this->open_scopes_.clear();
+    this->is_recording_ = true;
+    GpuProfiler::current_ptr_ = this;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func end_frame
+;
+; @brief
+;   Ends the measured frame. Scopes left open are closed here (with a
+;   warning).
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::end_frame()
+{
+    if (!this->is_recording_)
+    {
+        return;
+    }
+
+    if (!this->open_scopes_.empty())
+    {
+        LOG_WARNING("GPU profiler scopes were left open at the frame end.");
+        while (!this->open_scopes_.empty())
+        {
+            this->end_scope();
+        }
+    }
+    Frame& frame = this->frames_[this->frame_index_];
+    glQueryCounter(frame.query_ids.back(), GL_TIMESTAMP);
+    frame.is_pending = true;
+    this->frame_index_ = (this->frame_index_ + 1) % FRAMES_IN_FLIGHT;
+    this->is_recording_ = false;
+    GpuProfiler::current_ptr_ = nullptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin_scope
+;
+; @brief
+;   Opens a scope: the GPU time of the commands issued until the matching
+;   'end_scope' is measured. Scopes can be nested. Does nothing but count
+;   the scope if the frame is not measured or has no queries left.
+;
+; @params
+;   name    | Name of the scope. Only the pointer is kept: it must stay
+;           | valid while the results are used (e.g. a string literal).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::begin_scope(char const* name)
+{
+    if (!this->is_recording_)
+    {
+        return;
+    }
+
+    Frame& frame = this->frames_[this->frame_index_];
+    if (frame.scopes.size() == this->max_scopes_count_)
+    {
+        this->open_scopes_.push_back(DROPPED_SCOPE);
+        this->dropped_scopes_count_++;
+        return;
+    }
+    unsigned int scope_index = static_cast<unsigned int>(frame.scopes.size());
+    frame.scopes.push_back({ name,
+        static_cast<unsigned int>(this->open_scopes_.size()) });
+    glQueryCounter(frame.query_ids[scope_index * 2], GL_TIMESTAMP);
+    this->open_scopes_.push_back(scope_index);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func end_scope
+;
+; @brief
+;   Closes the innermost open scope.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::end_scope()
+{
+    if (!this->is_recording_ || this->open_scopes_.empty())
+    {
+        return;
+    }
+
+    unsigned int scope_index = this->open_scopes_.back();
+    this->open_scopes_.pop_back();
+    if (scope_index != DROPPED_SCOPE)
+    {
+        glQueryCounter(this->frames_[this->frame_index_].query_ids[
+            scope_index * 2 + 1], GL_TIMESTAMP);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func open_csv
+;
+; @brief
+;   Creates a CSV file the results of every measured frame are appended to
+;   as soon as they are read, one row per scope:
+;   'frame,scope,depth,start_ms,time_ms'. Each frame starts with a row of
+;   the whole frame (scope 'frame', depth 0); its scopes follow with their
+;   depth plus 1.
+;
+; @params
+;   file_path   | Path of the file. An existing file is overwritten.
+;
+; @return
+;   bool    | false if the file cannot be created.
+;
+----------------------------------------------------------------------------**/
+bool GpuProfiler::open_csv(char const* file_path)
+{
+    this->close_csv();
+    this->csv_file_.open(file_path, std::ios::out | std::ios::trunc);
+    if (!this->csv_file_.is_open())
+    {
+        LOG_ERROR("Failed to create the GPU profiler CSV file.");
+        return false;
+    }
+    this->csv_file_ << "frame,scope,depth,start_ms,time_ms\n";
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func close_csv
+;
+; @brief
+;   Closes the CSV file, if any. The frames still in flight are not written.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::close_csv()
+{
+    if (this->csv_file_.is_open())
+    {
+        this->csv_file_.close();
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_results
+;
+; @brief
+;   Returns the scopes of the last frame whose results were read, in the
+;   order they were opened. The frame is 'FRAMES_IN_FLIGHT' or more frames
+;   old (see 'get_results_frame_number').
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<ScopeTiming> const& | The scopes, empty before the first
+;                                   | results.
+;
+----------------------------------------------------------------------------**/
+std::vector<GpuProfiler::ScopeTiming> const& GpuProfiler::get_results() const
+{
+    return this->results_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_frame_time
+;
+; @brief
+;   Returns the GPU time between 'begin_frame' and 'end_frame' of the frame
+;   returned by 'get_results'.
+;
+; @params
+;   None
+;
+; @return
+;   double  | The frame time (in milliseconds).
+;
+----------------------------------------------------------------------------**/
+double GpuProfiler::get_frame_time() const
+{
+    return this->frame_time_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_results_frame_number
+;
+; @brief
+;   Returns the number of the frame returned by 'get_results' (the frames
+;   are numbered from 0 by 'begin_frame', skipped ones included).
+;
+; @params
+;   None
+;
+; @return
+;   unsigned long long  | The frame number.
+;
+----------------------------------------------------------------------------**/
+unsigned long long GpuProfiler::get_results_frame_number() const
+{
+    return this->results_frame_number_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_skipped_frames_count
+;
+; @brief
+;   Returns the number of frames that were not measured because the GPU was
+;   more than 'FRAMES_IN_FLIGHT' frames behind.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of skipped frames.
+;
+----------------------------------------------------------------------------**/
+unsigned int GpuProfiler::get_skipped_frames_count() const
+{
+    return this->skipped_frames_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_dropped_scopes_count
+;
+; @brief
+;   Returns the number of scopes that were not measured because their frame
+;   had more scopes than the maximum.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of dropped scopes.
+;
+----------------------------------------------------------------------------**/
+unsigned int GpuProfiler::get_dropped_scopes_count() const
+{
+    return this->dropped_scopes_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func current
+;
+; @brief
+;   Returns the profiler that is measuring a frame on the calling thread.
+;
+; @params
+;   None
+;
+; @return
+;   GpuProfiler*    | The profiler, nullptr if no frame is measured.
+;
+----------------------------------------------------------------------------**/
+GpuProfiler* GpuProfiler::current()
+{
+    return GpuProfiler::current_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func read_results
+;
+; @brief
+;   Reads the timestamps of a finished frame into the results and appends
+;   them to the CSV file, if any. All queries of the frame must be
+;   available.
+;
+; @params
+;   frame   | The finished frame.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void GpuProfiler::read_results(Frame& frame)
+{
+    std::size_t queries_count = frame.query_ids.size();
+    GLuint64 frame_begin = 0;
+    GLuint64 frame_end = 0;
+    glGetQueryObjectui64v(frame.query_ids[queries_count - 2],
+        GL_QUERY_RESULT, &frame_begin);
+    glGetQueryObjectui64v(frame.query_ids[queries_count - 1],
+        GL_QUERY_RESULT, &frame_end);
+    this->frame_time_ = static_cast<double>(frame_end - frame_begin) * 1e-6;
+                                        /* Nanoseconds to milliseconds       */
+
+    this->results_.clear();
+    for (std::size_t i = 0; i < frame.scopes.size(); i++)
+    {
+        GLuint64 scope_begin = 0;
+        GLuint64 scope_end = 0;
+        glGetQueryObjectui64v(frame.query_ids[i * 2], GL_QUERY_RESULT,
+            &scope_begin);
+        glGetQueryObjectui64v(frame.query_ids[i * 2 + 1], GL_QUERY_RESULT,
+            &scope_end);
+        this->results_.push_back({ frame.scopes[i].name,
+            frame.scopes[i].depth,
+            static_cast<double>(scope_begin - frame_begin) * 1e-6,
+            static_cast<double>(scope_end - scope_begin) * 1e-6 });
+    }
+    this->results_frame_number_ = frame.number;
+    frame.is_pending = false;
+
+    if (this->csv_file_.is_open())
+    {
+        this->csv_file_ << frame.number << ",frame,0,0," <<
+            this->frame_time_ << '\n';
+        for (ScopeTiming const& scope : this->results_)
+        {
+            this->csv_file_ << frame.number << ",\"" << scope.name << "\"," <<
+                scope.depth + 1 << ',' << scope.start_time << ',' <<
+                scope.time << '\n';
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func GpuProfileScope
+;
+; @brief
+;   Constructor. Opens a scope of the current profiler, if any (see
+;   'GpuProfiler::current').
+;
+; @params
+;   name    | Name of the scope (a string literal).
+;
+----------------------------------------------------------------------------**/
+GpuProfileScope::GpuProfileScope(char const* name)
+    :profiler_ptr_(GpuProfiler::current())
+{
+    if (this->profiler_ptr_ != nullptr)
+    {
+        this->profiler_ptr_->begin_scope(name);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~GpuProfileScope
+;
+; @brief
+;   Destructor. Closes the scope.
+;
+----------------------------------------------------------------------------**/
+GpuProfileScope::~GpuProfileScope()
+{
+    if (this->profiler_ptr_ != nullptr)
+    {
+        this->profiler_ptr_->end_scope();
+    }
+}
@@ -0,0 +1,128 @@
+/**----------------------------------------------------------------------------
+; @file GpuProfiler.hpp
+;
+; @brief
+;   This file describes the 'GpuProfiler' class. This class measures how
+;   long the GPU spends in named scopes of a frame (e.g. the clear, the
+;   passes of the renderer, texture uploads).
+;
+;   Each scope is delimited by two 'GL_TIMESTAMP' queries ('glQueryCounter')
+;   rather than a 'GL_TIME_ELAPSED' query, because elapsed time queries
+;   cannot nest. The queries of a frame are read 'FRAMES_IN_FLIGHT' frames
+;   later, when the GPU has long finished them: 'begin_frame' checks that
+;   the results of the oldest frame are available before reading them, and
+;   if they are not (the GPU is more frames behind), the new frame is not
+;   measured rather than waited for. Reading the results never stalls.
+;
+;   The renderer and 'Texture2dArrayLayer::add_subimage' open their scopes
+;   with 'GpuProfileScope', which measures with the profiler that is
+;   recording a frame on the calling thread ('current'), so they cost
+;   nothing when no frame is profiled. The results of the last finished
+;   frame are returned by 'get_results', and every finished frame can be
+;   appended to a CSV file ('open_csv').
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <fstream>
+#include <vector>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class GpuProfiler
+{
+public:
+    struct ScopeTiming
+    {
+        char const* name;
+        unsigned int depth;             /* 0 - not nested                    */
+        double start_time;              /* Since the frame began (in ms)     */
+        double time;                    /* In milliseconds                   */
+    };
+
+    GpuProfiler(unsigned int max_scopes_count = DEFAULT_MAX_SCOPES_COUNT);
+    ~GpuProfiler();
+
+    void begin_frame();
+    void end_frame();
+    void begin_scope(char const* name);
+    void end_scope();
+
+    bool open_csv(char const* file_path);
+    void close_csv();
+
+    std::vector<ScopeTiming> const& get_results() const;
+    double get_frame_time() const;
+    unsigned long long get_results_frame_number() const;
+    unsigned int get_skipped_frames_count() const;
+    unsigned int get_dropped_scopes_count() const;
+
+    static GpuProfiler* current();
+
+    static constexpr unsigned int FRAMES_IN_FLIGHT = 4;
+    static constexpr unsigned int DEFAULT_MAX_SCOPES_COUNT = 64;
+
+private:
+    struct Scope
+    {
+        char const* name;               /* Not copied: must outlive the      */
+        unsigned int depth;             /* frame results (a literal)         */
+    };
+
+    struct Frame
+    {
+        std::vector<unsigned int> query_ids;
+                                        /* Begin and end of each scope, then */
+                                        /* of the frame                      */
+        std::vector<Scope> scopes;
+        unsigned long long number;
+        bool is_pending;                /* Queried, results not read yet     */
+    };
+
+    unsigned int max_scopes_count_;
+    Frame frames_[FRAMES_IN_FLIGHT];
+    unsigned int frame_index_;          /* The frame recorded next           */
+    unsigned long long frames_count_;
+    bool is_recording_;
+    std::vector<unsigned int> open_scopes_;
+                                        /* Indices of the open scopes, the   */
+                                        /* innermost last                    */
+
+    std::vector<ScopeTiming> results_;
+    double frame_time_;
+    unsigned long long results_frame_number_;
+    unsigned int skipped_frames_count_;
+    unsigned int dropped_scopes_count_;
+    std::ofstream csv_file_;
+
+    static thread_local GpuProfiler* current_ptr_;
+
+    void read_results(Frame& frame);
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+};
+
+
+class GpuProfileScope
+{
+public:
+    GpuProfileScope(char const* name);
+    ~GpuProfileScope();
+
+private:
+    GpuProfiler* profiler_ptr_;         /* nullptr if no frame is profiled   */
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+};
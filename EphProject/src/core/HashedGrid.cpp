@@ -0,0 +1,396 @@
+/**----------------------------------------------------------------------------
+; @file HashedGrid.cpp
+;
+; @brief
+;   The file implements the functionality of the 'HashedGrid' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cmath>
+
+#include "HashedGrid.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func HashedGrid
+;
+; @brief
+;   Constructor.
+;
+; @params
+;   cell_size   | Width and height of a cell (in world units).
+;
+----------------------------------------------------------------------------**/
+HashedGrid::HashedGrid(float cell_size)
+    :cell_size_(cell_size), objects_count_(0)
+{
+    if (cell_size <= 0.0f)
+    {
+        LOG_ERROR("Hashed grid cell size must be positive.");
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func insert
+;
+; @brief
+;   Adds an object.
+;
+; @params
+;   bounds  | Bounding rectangle of the object.
+;
+; @return
+;   unsigned int    | Handle of the object.
+;
+----------------------------------------------------------------------------**/
+unsigned int HashedGrid::insert(glm::vec4 const& bounds)
+{
+    unsigned int handle = 0;
+    Object object = { bounds, this->get_cell_range(bounds), true };
+    if (this->free_handles_.empty())
+    {
+        handle = static_cast<unsigned int>(this->objects_.size());
+        this->objects_.push_back(object);
+    }
+    else
+    {
+        handle = this->free_handles_.back();
+        this->free_handles_.pop_back();
+        this->objects_[handle] = object;
+    }
+    this->add_to_cells(handle);
+    this->objects_count_++;
+    return handle;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func move
+;
+; @brief
+;   Changes the bounding rectangle of an object. If the object overlaps the
+;   same cells, only the rectangle is updated.
+;
+; @params
+;   handle  | Handle of the object.
+;   bounds  | The new bounding rectangle.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::move(unsigned int handle, glm::vec4 const& bounds)
+{
+    Object& object = this->objects_[handle];
+    CellRange range = this->get_cell_range(bounds);
+    object.bounds = bounds;
+    if (range.min_x != object.cells.min_x ||
+        range.min_y != object.cells.min_y ||
+        range.max_x != object.cells.max_x ||
+        range.max_y != object.cells.max_y)
+    {
+        this->remove_from_cells(handle);
+        object.cells = range;
+        this->add_to_cells(handle);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func remove
+;
+; @brief
+;   Removes an object. The handle may be returned by a later 'insert'.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::remove(unsigned int handle)
+{
+    if (!this->objects_[handle].is_alive)
+    {
+        LOG_WARNING("The object has already been removed from the grid.");
+        return;
+    }
+    this->remove_from_cells(handle);
+    this->objects_[handle].is_alive = false;
+    this->free_handles_.push_back(handle);
+    this->objects_count_--;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func query
+;
+; @brief
+;   Appends the handles of all objects that intersect the rectangle. If the
+;   rectangle covers more cells than there are occupied cells, the occupied
+;   cells are scanned instead, so a huge query rectangle is never slower than
+;   a scan of the whole grid.
+;
+; @params
+;   rect    | Query rectangle (min x, min y, max x, max y).
+;   handles | Output. The handles are appended in no particular order.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::query(glm::vec4 const& rect,
+    std::vector<unsigned int>& handles) const
+{
+    CellRange range = this->get_cell_range(rect);
+    double cells_count = (static_cast<double>(range.max_x) - range.min_x + 1) *
+        (static_cast<double>(range.max_y) - range.min_y + 1);
+
+    if (cells_count > static_cast<double>(this->cells_.size()))
+    {
+        for (auto const& cell : this->cells_)
+        {
+            int x = static_cast<std::int32_t>(cell.first >> 32);
+            int y = static_cast<std::int32_t>(cell.first & 0xFFFFFFFF);
+            if (x >= range.min_x && x <= range.max_x &&
+                y >= range.min_y && y <= range.max_y)
+            {
+                this->query_cell(x, y, cell.second, rect, range, handles);
+            }
+        }
+        return;
+    }
+
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            auto cell = this->cells_.find(HashedGrid::make_cell_key(x, y));
+            if (cell != this->cells_.end())
+            {
+                this->query_cell(x, y, cell->second, rect, range, handles);
+            }
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all objects and cells.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::clear()
+{
+    this->cells_.clear();
+    this->objects_.clear();
+    this->free_handles_.clear();
+    this->objects_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_objects_count
+;
+; @brief
+;   Returns the number of objects in the grid.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of objects.
+;
+----------------------------------------------------------------------------**/
+std::size_t HashedGrid::get_objects_count() const
+{
+    return this->objects_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_bounds
+;
+; @brief
+;   Returns the bounding rectangle of an object.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   glm::vec4 const&    | Bounding rectangle.
+;
+----------------------------------------------------------------------------**/
+glm::vec4 const& HashedGrid::get_bounds(unsigned int handle) const
+{
+    return this->objects_[handle].bounds;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_cell_range
+;
+; @brief
+;   Returns the range of cells a rectangle overlaps.
+;
+; @params
+;   bounds  | Rectangle (min x, min y, max x, max y).
+;
+; @return
+;   CellRange   | Inclusive range of cell coordinates.
+;
+----------------------------------------------------------------------------**/
+HashedGrid::CellRange HashedGrid::get_cell_range(glm::vec4 const& bounds) const
+{
+    return {
+        static_cast<int>(std::floor(bounds.x / this->cell_size_)),
+        static_cast<int>(std::floor(bounds.y / this->cell_size_)),
+        static_cast<int>(std::floor(bounds.z / this->cell_size_)),
+        static_cast<int>(std::floor(bounds.w / this->cell_size_))
+    };
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add_to_cells
+;
+; @brief
+;   Registers an object in all cells of its cell range.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::add_to_cells(unsigned int handle)
+{
+    CellRange const& range = this->objects_[handle].cells;
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            this->cells_[HashedGrid::make_cell_key(x, y)].push_back(handle);
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func remove_from_cells
+;
+; @brief
+;   Unregisters an object from all cells of its cell range. Cells that become
+;   empty are erased, so the memory follows the occupied area.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::remove_from_cells(unsigned int handle)
+{
+    CellRange const& range = this->objects_[handle].cells;
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            auto cell = this->cells_.find(HashedGrid::make_cell_key(x, y));
+            std::vector<unsigned int>& handles = cell->second;
+            auto i = std::find(handles.begin(), handles.end(), handle);
+            *i = handles.back();        /* Order in a cell does not matter   */
+            handles.pop_back();
+            if (handles.empty())
+            {
+                this->cells_.erase(cell);
+            }
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func query_cell
+;
+; @brief
+;   Appends the objects of a cell that intersect the query rectangle. An
+;   object is reported only by the first cell (in both axes) where its cell
+;   range and the query range overlap.
+;
+; @params
+;   x       | Cell column.
+;   y       | Cell row.
+;   cell    | Handles registered in the cell.
+;   rect    | Query rectangle.
+;   range   | Cell range of the query rectangle.
+;   handles | Output.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void HashedGrid::query_cell(int x, int y,
+    std::vector<unsigned int> const& cell, glm::vec4 const& rect,
+    CellRange const& range, std::vector<unsigned int>& handles) const
+{
+    for (unsigned int handle : cell)
+    {
+        Object const& object = this->objects_[handle];
+        if (x != std::max(object.cells.min_x, range.min_x) ||
+            y != std::max(object.cells.min_y, range.min_y))
+        {
+            continue;                   /* Reported by another cell          */
+        }
+        if (object.bounds.z >= rect.x && object.bounds.x <= rect.z &&
+            object.bounds.w >= rect.y && object.bounds.y <= rect.w)
+        {
+            handles.push_back(handle);
+        }
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func make_cell_key
+;
+; @brief
+;   Packs cell coordinates into a hash map key.
+;
+; @params
+;   x   | Cell column.
+;   y   | Cell row.
+;
+; @return
+;   std::uint64_t   | Key: x in the high 32 bits, y in the low 32 bits.
+;
+----------------------------------------------------------------------------**/
+std::uint64_t HashedGrid::make_cell_key(int x, int y)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+        static_cast<std::uint32_t>(y);
+}
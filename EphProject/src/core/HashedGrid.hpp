@@ -0,0 +1,88 @@
+/**----------------------------------------------------------------------------
+; @file HashedGrid.hpp
+;
+; @brief
+;   This file describes the 'HashedGrid' class, a 'SpatialIndex' built as an
+;   unbounded uniform grid. Only the cells that contain objects exist; they
+;   are stored in a hash map keyed by the cell coordinates.
+;
+;   An object is registered in every cell its bounding rectangle overlaps.
+;   Moving an object within the same range of cells only updates its
+;   rectangle. A query visits the cells under the query rectangle (or all
+;   occupied cells, if there are fewer of them). An object that spans several
+;   cells is reported only by the first cell of the overlap, so the result has
+;   no duplicates without any per-query bookkeeping.
+;
+;   The grid works best when the cell size is close to the typical object
+;   size (objects much bigger than a cell are registered in many cells).
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "SpatialIndex.hpp"
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class HashedGrid : public SpatialIndex
+{
+public:
+    HashedGrid(float cell_size);
+
+    unsigned int insert(glm::vec4 const& bounds) override;
+    void move(unsigned int handle, glm::vec4 const& bounds) override;
+    void remove(unsigned int handle) override;
+    void query(glm::vec4 const& rect,
+        std::vector<unsigned int>& handles) const override;
+    void clear() override;
+
+    std::size_t get_objects_count() const override;
+    glm::vec4 const& get_bounds(unsigned int handle) const override;
+
+private:
+    struct CellRange
+    {
+        int min_x;
+        int min_y;
+        int max_x;
+        int max_y;
+    };
+
+    struct Object
+    {
+        glm::vec4 bounds;
+        CellRange cells;
+        bool is_alive;
+    };
+
+    float cell_size_;
+    std::unordered_map<std::uint64_t, std::vector<unsigned int>> cells_;
+    std::vector<Object> objects_;
+    std::vector<unsigned int> free_handles_;
+    std::size_t objects_count_;
+
+    CellRange get_cell_range(glm::vec4 const& bounds) const;
+    void add_to_cells(unsigned int handle);
+    void remove_from_cells(unsigned int handle);
+    void query_cell(int x, int y, std::vector<unsigned int> const& cell,
+        glm::vec4 const& rect, CellRange const& range,
+        std::vector<unsigned int>& handles) const;
+
+    static std::uint64_t make_cell_key(int x, int y);
+};
@@ -22,6 +22,7 @@
 #include <stb_image.h>
 
 #include "Image.hpp"
+#include "CpuProfiler.hpp"
 
 
 
@@ -41,6 +42,7 @@
 Image::Image(char const* image_path)
     :width_(0), height_(0), channels_count_(0), data_(nullptr)
 {
+    CPU_PROFILE_SCOPE("Image::Image");
     // TODO: use std::filesystem
     stbi_set_flip_vertically_on_load(true);
                                         /* To flip loaded image's on the     */
@@ -26,16 +26,20 @@
 ;   Constructor.
 ;
 ; @params
-;   mode    | Specifies what kind of primitives to render. Symbolic constants
-;           | GL_POINTS, GL_LINE_STRIP, GL_LINE_LOOP, GL_LINES,
-;           | GL_LINE_STRIP_ADJACENCY, GL_LINES_ADJACENCY, GL_TRIANGLE_STRIP,
-;           | GL_TRIANGLE_FAN, GL_TRIANGLES, GL_TRIANGLE_STRIP_ADJACENCY,
-;           | GL_TRIANGLES_ADJACENCY and GL_PATCHES are accepted. 
-;   count   | Number of elements to be rendered.
-;   offset  | Offset to the first index of this(these) primitive(s).
+;   mode             | Specifies what kind of primitives to render. Symbolic
+;                    | constants GL_POINTS, GL_LINE_STRIP, GL_LINE_LOOP,
+;                    | GL_LINES, GL_LINE_STRIP_ADJACENCY, GL_LINES_ADJACENCY,
+;                    | GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_TRIANGLES,
+;                    | GL_TRIANGLE_STRIP_ADJACENCY, GL_TRIANGLES_ADJACENCY and
+;                    | GL_PATCHES are accepted.
+;   count            | Number of elements to be rendered.
+;   offset           | Offset to the first index of this(these) primitive(s).
+;   vertex_array_ptr | Vertex array the indices belong to.
 ;
 ----------------------------------------------------------------------------**/
-IndicesData::IndicesData(unsigned int mode, unsigned int count, void* offset)
-    :mode(mode), count(count), offset(offset)
+IndicesData::IndicesData(unsigned int mode, unsigned int count, void* offset,
+    VertexArray const* vertex_array_ptr)
+    :mode(mode), count(count), offset(offset),
+    vertex_array_ptr(vertex_array_ptr)
 {
 }
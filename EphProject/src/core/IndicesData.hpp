@@ -22,15 +22,25 @@
 
 
 
+/** @type_declarations -----------------------------------------------------**/
+
+class VertexArray;
+
+
+
 /** @classes ---------------------------------------------------------------**/
 
 class IndicesData
 {
 public:
-    IndicesData(unsigned int mode, unsigned int count, void* offset);
+    IndicesData(unsigned int mode, unsigned int count, void* offset,
+        VertexArray const* vertex_array_ptr);
 
     const unsigned int mode;            /* Vertices connection mode          */
     const unsigned int count;           /* Number of elements to be rendered */
     const void* offset;                 /* Offset to the first index of      */
                                         /* shape(s)                          */
+    VertexArray const* const vertex_array_ptr;
+                                        /* Vertex array the indices belong   */
+                                        /* to                                */
 };
@@ -0,0 +1,400 @@
+/**----------------------------------------------------------------------------
+; @file IndirectBatch.cpp
+;
+; @brief
+;   The file implements the functionality of the 'IndirectBatch' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "IndirectBatch.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "IndicesData.hpp"
+#include "Texture2dArray.hpp"
+#include "Texture2dArrayLayer.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func IndirectBatch
+;
+; @brief
+;   Constructor. Allocates the ring buffers for the indirect commands and the
+;   per-draw data. A frame region holds one full batch.
+;
+; @params
+;   capacity    | The maximum number of draws collected before the batch must
+;               | be flushed.
+;
+----------------------------------------------------------------------------**/
+IndirectBatch::IndirectBatch(unsigned int capacity)
+    :capacity_(capacity),
+    command_buffer_(GL_DRAW_INDIRECT_BUFFER,
+        capacity * sizeof(DrawElementsIndirectCommand)),
+    instance_buffer_(GL_ARRAY_BUFFER, capacity * sizeof(SpriteInstance)),
+    commands_ptr_(nullptr), instances_ptr_(nullptr), commands_count_(0),
+    acquired_capacity_(capacity)
+{
+    this->runs_.reserve(this->capacity_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~IndirectBatch
+;
+; @brief
+;   Destructor.
+;
+----------------------------------------------------------------------------**/
+IndirectBatch::~IndirectBatch()
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin_frame
+;
+; @brief
+;   Starts a new frame: discards all collected commands and runs, with the
+;   space acquired for them, and moves both ring buffers to the regions of
+;   the frame (see 'RingBuffer::begin_frame').
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::begin_frame()
+{
+    this->begin();
+    this->commands_ptr_ = nullptr;
+    this->instances_ptr_ = nullptr;
+    this->acquired_capacity_ = this->capacity_;
+    this->command_buffer_.begin_frame();
+    this->instance_buffer_.begin_frame();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin
+;
+; @brief
+;   Discards all collected commands and runs. Acquired ring buffer space is
+;   kept and reused.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::begin()
+{
+    this->commands_count_ = 0;
+    this->runs_.clear();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func submit
+;
+; @brief
+;   Builds an indirect command that draws the composition described by
+;   'indices_data_ptr' and stores the per-draw data for it. Starts a new run if
+;   the command can not be submitted together with the previous one.
+;   The caller must check 'is_full' before the call.
+;
+; @params
+;   indices_data_ptr            | Indices of the composition to be drawn.
+;   texture_2d_array_layer_ptr  | Texture layer the composition is taken from.
+;   pos                         | Position (in pixels).
+;   size                        | Size (in pixels).
+;   depth                       | Clip space z of the composition.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::submit(IndicesData const* indices_data_ptr,
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec2 const& pos, glm::vec2 const& size, float depth)
+{
+    Texture2dArray const* texture_2d_array_ptr =
+        texture_2d_array_layer_ptr->get_texture_2d_array();
+    unsigned int command_index = this->commands_count_++;
+
+    if (this->commands_ptr_ == nullptr)
+    {                                   /* Acquire space on the first        */
+                                        /* submission after a flush          */
+        this->acquire();
+    }
+
+    if (this->runs_.empty() ||
+        this->runs_.back().texture_2d_array_ptr != texture_2d_array_ptr ||
+        this->runs_.back().vertex_array_ptr !=
+            indices_data_ptr->vertex_array_ptr ||
+        this->runs_.back().mode != indices_data_ptr->mode)
+    {                                   /* Start a new run if the state      */
+                                        /* required by the command has       */
+                                        /* changed                           */
+        this->runs_.push_back({ texture_2d_array_ptr,
+            indices_data_ptr->vertex_array_ptr, indices_data_ptr->mode,
+            command_index, 0 });
+    }
+    this->runs_.back().commands_count++;
+
+    DrawElementsIndirectCommand& command =
+        this->commands_ptr_[command_index];
+                                        /* Write straight into the mapped    */
+                                        /* memory                            */
+    command.count = indices_data_ptr->count;
+    command.instance_count = 1;         /* One instance per command          */
+    command.first_index = static_cast<unsigned int>(
+        reinterpret_cast<std::uintptr_t>(indices_data_ptr->offset) /
+        sizeof(unsigned int));          /* Byte offset -> index offset       */
+    command.base_vertex = 0;
+    command.base_instance = command_index;
+                                        /* The per-draw data is fetched from */
+                                        /* the instance with this index      */
+
+    SpriteInstance& instance = this->instances_ptr_[command_index];
+    instance.transform = glm::vec4(size.x, 0.0f, 0.0f, size.y);
+    instance.translation = pos;         /* Axis-aligned                      */
+    instance.txd_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    instance.z_offset = texture_2d_array_layer_ptr->get_z_offset();
+    instance.depth = depth;
+    FRAME_STATS_ADD(instances, 1);
+    FRAME_STATS_ADD(triangles, FrameStats::get_triangles_count(
+        indices_data_ptr->mode, indices_data_ptr->count));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Commits the submitted commands and per-draw data to the ring buffers
+;   (see 'RingBuffer::commit') and binds the command ring buffer to
+;   'GL_DRAW_INDIRECT_BUFFER'. No draws can be submitted until 'finish'.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::bind()
+{
+    this->command_buffer_.commit(this->commands_count_ *
+        sizeof(DrawElementsIndirectCommand));
+    this->instance_buffer_.commit(this->commands_count_ *
+        sizeof(SpriteInstance));
+    GlState::current().bind_buffer(GL_DRAW_INDIRECT_BUFFER,
+        this->command_buffer_.get_id());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_run
+;
+; @brief
+;   Attaches the per-draw data to the vertex array of the run and
+;   submits all commands of the run with a single call. The texture 2d array
+;   of the run must be bound and 'bind' must be called before. The data is
+;   detached after the call: the vertex array is the caller's composition,
+;   which 'Renderer::draw_sprite' may also draw with generic per-draw
+;   values. The vertex array of the run stays bound after the call.
+;
+; @params
+;   run | The run to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::draw_run(Run const& run) const
+{
+    run.vertex_array_ptr->bind_instance_buffer(this->instance_buffer_.get_id(),
+        this->instance_buffer_.get_acquired_offset());
+    glMultiDrawElementsIndirect(run.mode, GL_UNSIGNED_INT,
+        reinterpret_cast<void const*>(static_cast<std::uintptr_t>(
+            this->command_buffer_.get_acquired_offset() +
+            run.first_command * sizeof(DrawElementsIndirectCommand))),
+        run.commands_count, 0);
+    run.vertex_array_ptr->detach_instance_buffer();
+    FRAME_STATS_ADD(draw_calls, 1);     /* Instances and triangles are       */
+                                        /* counted by 'submit'               */
+    FRAME_STATS_ADD(buffer_bytes, run.commands_count *
+        (sizeof(DrawElementsIndirectCommand) + sizeof(SpriteInstance)));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func finish
+;
+; @brief
+;   Ends the batch. Must be called after all runs are drawn. The next
+;   submission acquires the space after the drawn commands. The commands
+;   are fenced with the rest of the frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::finish()
+{
+    this->commands_ptr_ = nullptr;
+    this->instances_ptr_ = nullptr;
+    this->acquired_capacity_ = this->capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_full
+;
+; @brief
+;   Checks whether the batch has reached its capacity, or the free space of
+;   the frame regions it has acquired.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if no more draws can be submitted.
+;
+----------------------------------------------------------------------------**/
+bool IndirectBatch::is_full() const
+{
+    return this->commands_count_ >= this->acquired_capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_empty
+;
+; @brief
+;   Checks whether there are no submitted draws in the batch.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if nothing was submitted since the last 'begin' call.
+;
+----------------------------------------------------------------------------**/
+bool IndirectBatch::is_empty() const
+{
+    return this->commands_count_ == 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_runs
+;
+; @brief
+;   Returns the runs of the submitted commands.
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<Run> const& | Runs in the order of submission.
+;
+----------------------------------------------------------------------------**/
+std::vector<IndirectBatch::Run> const& IndirectBatch::get_runs() const
+{
+    return this->runs_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_fence_wait_time
+;
+; @brief
+;   Returns the time spent waiting for the fences of both ring buffers since
+;   the last 'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   double  | Fence wait time (in milliseconds).
+;
+----------------------------------------------------------------------------**/
+double IndirectBatch::get_fence_wait_time() const
+{
+    return this->command_buffer_.get_fence_wait_time() +
+        this->instance_buffer_.get_fence_wait_time();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the fence wait stats of both ring buffers.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::reset_stats()
+{
+    this->command_buffer_.reset_stats();
+    this->instance_buffer_.reset_stats();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func acquire
+;
+; @brief
+;   Acquires the free space of the frame regions for up to 'capacity'
+;   commands and their per-draw data (at least one) and limits the batch to
+;   what both hold.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void IndirectBatch::acquire()
+{
+    this->commands_ptr_ = static_cast<DrawElementsIndirectCommand*>(
+        this->command_buffer_.acquire(sizeof(DrawElementsIndirectCommand),
+            this->capacity_ * sizeof(DrawElementsIndirectCommand)));
+    this->instances_ptr_ = static_cast<SpriteInstance*>(
+        this->instance_buffer_.acquire(sizeof(SpriteInstance),
+            this->capacity_ * sizeof(SpriteInstance)));
+    this->acquired_capacity_ = static_cast<unsigned int>(std::min(
+        this->command_buffer_.get_acquired_size() /
+            sizeof(DrawElementsIndirectCommand),
+        this->instance_buffer_.get_acquired_size() / sizeof(SpriteInstance)));
+}
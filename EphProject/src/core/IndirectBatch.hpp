@@ -0,0 +1,111 @@
+/**----------------------------------------------------------------------------
+; @file IndirectBatch.hpp
+;
+; @brief
+;   This file describes the 'IndirectBatch' class. This class collects draws of
+;   arbitrary compositions (see 'VertexArray::add_textured_rects') into a
+;   buffer of 'DrawElementsIndirectCommand' elements and submits them with
+;   'glMultiDrawElementsIndirect'.
+;
+;   Each command draws one instance whose 'baseInstance' is the index of the
+;   command. So the per-draw data (position, size, layer) is fetched from the
+;   per-instance buffer by the same attributes the 'SpriteBatch' uses.
+;
+;   Commands are split into runs. A run is a sequence of consecutive commands
+;   that share the texture 2d array, the vertex array and the primitive mode.
+;   Each run is submitted with a single call.
+;
+;   Commands and per-draw data are written straight into the frame regions
+;   of two persistently mapped 'RingBuffer' objects (see 'SpriteBatch'),
+;   which are fenced once per frame.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "RingBuffer.hpp"
+#include "SpriteInstance.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Texture2dArray;
+class Texture2dArrayLayer;
+class VertexArray;
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct DrawElementsIndirectCommand      /* Layout is defined by OpenGL       */
+{
+    unsigned int count;
+    unsigned int instance_count;
+    unsigned int first_index;
+    int base_vertex;
+    unsigned int base_instance;
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class IndirectBatch
+{
+public:
+    struct Run
+    {
+        Texture2dArray const* texture_2d_array_ptr;
+        VertexArray const* vertex_array_ptr;
+        unsigned int mode;
+        unsigned int first_command;
+        unsigned int commands_count;
+    };
+
+    IndirectBatch(unsigned int capacity);
+    ~IndirectBatch();
+
+    void begin_frame();
+    void begin();
+    void submit(IndicesData const* indices_data_ptr,
+        Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec2 const& pos, glm::vec2 const& size, float depth);
+    void bind();
+    void draw_run(Run const& run) const;
+    void finish();
+
+    bool is_full() const;
+    bool is_empty() const;
+    std::vector<Run> const& get_runs() const;
+    double get_fence_wait_time() const;
+    void reset_stats();
+
+private:
+    unsigned int capacity_;
+    RingBuffer command_buffer_;
+    RingBuffer instance_buffer_;
+
+    DrawElementsIndirectCommand* commands_ptr_;
+    SpriteInstance* instances_ptr_;     /* Mapped memory of the acquired     */
+                                        /* space. nullptr if no space is     */
+                                        /* acquired                          */
+    unsigned int commands_count_;
+    unsigned int acquired_capacity_;    /* Commands that fit into the        */
+                                        /* acquired space                    */
+    std::vector<Run> runs_;
+
+    void acquire();
+};
@@ -0,0 +1,241 @@
+/**----------------------------------------------------------------------------
+; @file LinearAllocator.cpp
+;
+; @brief
+;   The file implements the functionality of the 'LinearAllocator' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <new>
+
+#include "LinearAllocator.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func LinearAllocator
+;
+; @brief
+;   Constructor. The first block is allocated on the first 'allocate' call.
+;
+; @params
+;   block_size  | Size of a block (in bytes), i.e. the largest allocation.
+;               | Rounded up to 'ALIGNMENT'.
+;
+----------------------------------------------------------------------------**/
+LinearAllocator::LinearAllocator(std::size_t block_size)
+    :block_size_((block_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT),
+    current_block_(0)
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~LinearAllocator
+;
+; @brief
+;   Destructor. Frees the blocks.
+;
+----------------------------------------------------------------------------**/
+LinearAllocator::~LinearAllocator()
+{
+    for (Block& block : this->blocks_)
+    {
+        ::operator delete(block.data_ptr);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func allocate
+;
+; @brief
+;   Allocates memory from the current block, or from the next one if the
+;   current block has no room left. A new block is only created when all
+;   blocks are used.
+;
+; @params
+;   size    | Size of the memory (in bytes). Rounded up to 'ALIGNMENT'.
+;
+; @return
+;   void*   | Memory aligned to 'ALIGNMENT', valid until 'reset'. nullptr if
+;           | the size exceeds the block size.
+;
+----------------------------------------------------------------------------**/
+void* LinearAllocator::allocate(std::size_t size)
+{
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (size > this->block_size_)
+    {
+        LOG_ERROR("The allocation does not fit into a block.");
+        return nullptr;
+    }
+
+    if (!this->fits(size))
+    {
+        if (!this->blocks_.empty())
+        {
+            this->current_block_++;
+        }
+        if (this->current_block_ == this->blocks_.size())
+        {                               /* The only allocation of memory     */
+            this->blocks_.push_back({ static_cast<unsigned char*>(
+                ::operator new(this->block_size_)), 0 });
+        }
+    }
+
+    Block& block = this->blocks_[this->current_block_];
+    void* ptr = block.data_ptr + block.used_size;
+    block.used_size += size;
+    return ptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func fits
+;
+; @brief
+;   Checks whether an allocation fits into the rest of the current block,
+;   i.e. whether it will follow the previous allocation in memory.
+;
+; @params
+;   size    | Size of the memory (in bytes). Rounded up to 'ALIGNMENT'.
+;
+; @return
+;   bool    | true if the allocation fits into the current block.
+;
+----------------------------------------------------------------------------**/
+bool LinearAllocator::fits(std::size_t size) const
+{
+    if (this->blocks_.empty())
+    {
+        return false;
+    }
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    return this->blocks_[this->current_block_].used_size + size <=
+        this->block_size_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset
+;
+; @brief
+;   Frees all allocations at once. The blocks are kept for reuse.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LinearAllocator::reset()
+{
+    for (Block& block : this->blocks_)
+    {
+        block.used_size = 0;
+    }
+    this->current_block_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_blocks_count
+;
+; @brief
+;   Returns the number of blocks that hold allocations.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of blocks in use (0 if nothing is allocated).
+;
+----------------------------------------------------------------------------**/
+std::size_t LinearAllocator::get_blocks_count() const
+{
+    if (this->blocks_.empty() || this->blocks_[0].used_size == 0)
+    {
+        return 0;
+    }
+    return this->current_block_ + 1;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_block
+;
+; @brief
+;   Returns a block in use. The allocations of a block are contiguous and in
+;   allocation order, and the blocks are in allocation order too.
+;
+; @params
+;   index       | Index of the block, below 'get_blocks_count'.
+;   used_size   | Output: the number of allocated bytes of the block.
+;
+; @return
+;   unsigned char const*    | The beginning of the block.
+;
+----------------------------------------------------------------------------**/
+unsigned char const* LinearAllocator::get_block(std::size_t index,
+    std::size_t& used_size) const
+{
+    used_size = this->blocks_[index].used_size;
+    return this->blocks_[index].data_ptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_used_size
+;
+; @brief
+;   Returns the number of allocated bytes since the last 'reset' (including
+;   the rounding to 'ALIGNMENT').
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of allocated bytes.
+;
+----------------------------------------------------------------------------**/
+std::size_t LinearAllocator::get_used_size() const
+{
+    std::size_t used_size = 0;
+    for (std::size_t i = 0; i < this->get_blocks_count(); i++)
+    {
+        used_size += this->blocks_[i].used_size;
+    }
+    return used_size;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_capacity
+;
+; @brief
+;   Returns the total size of the blocks, i.e. the memory held by the
+;   allocator.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The size of all blocks (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::size_t LinearAllocator::get_capacity() const
+{
+    return this->blocks_.size() * this->block_size_;
+}
@@ -0,0 +1,69 @@
+/**----------------------------------------------------------------------------
+; @file LinearAllocator.hpp
+;
+; @brief
+;   This file describes the 'LinearAllocator' class. This class hands out
+;   memory by bumping an offset in a chain of fixed-size blocks, and frees
+;   everything at once ('reset').
+;
+;   An allocation never spans two blocks: if it does not fit into the rest of
+;   the current block, it goes to the beginning of the next one. The blocks
+;   are kept on 'reset', so an allocator reused every frame stops allocating
+;   once it has grown to the largest frame. The blocks can be walked in
+;   allocation order ('get_block'), e.g. to read back what was written.
+;
+;   Not thread safe: meant to be owned by one thread at a time (e.g. one per
+;   worker, see 'CommandBuffer').
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class LinearAllocator
+{
+public:
+    LinearAllocator(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+    ~LinearAllocator();
+
+    void* allocate(std::size_t size);
+    bool fits(std::size_t size) const;
+    void reset();
+
+    std::size_t get_blocks_count() const;
+    unsigned char const* get_block(std::size_t index,
+        std::size_t& used_size) const;
+    std::size_t get_used_size() const;
+    std::size_t get_capacity() const;
+
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+    static constexpr std::size_t ALIGNMENT = 8;
+                                        /* Sizes are rounded up to it        */
+
+private:
+    struct Block
+    {
+        unsigned char* data_ptr;
+        std::size_t used_size;
+    };
+
+    std::size_t block_size_;
+    std::vector<Block> blocks_;
+    std::size_t current_block_;         /* Index of the block being filled   */
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+};
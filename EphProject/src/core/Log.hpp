@@ -37,6 +37,9 @@ __FILE__, __LINE__);
 #define LOG_WARNING(message) \
 log(enLogFlags::WARNING, message, __FILE__, __LINE__);
 
+#define LOG_MESSAGE(message) \
+log(enLogFlags::MSG, message, __FILE__, __LINE__);
+
 
 
 /** @function_prototypes ---------------------------------------------------**/
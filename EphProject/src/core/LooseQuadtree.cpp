@@ -0,0 +1,459 @@
+/**----------------------------------------------------------------------------
+; @file LooseQuadtree.cpp
+;
+; @brief
+;   The file implements the functionality of the 'LooseQuadtree' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+
+#include "LooseQuadtree.hpp"
+#include "Log.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define NONE 0xFFFFFFFF
+#define MAX_DEPTH 12
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func LooseQuadtree
+;
+; @brief
+;   Constructor. Allocates all nodes of the tree.
+;
+; @params
+;   world_bounds    | Area covered by the tree (min x, min y, max x, max y).
+;                   | Objects outside it are still indexed, but slower.
+;   depth           | The number of levels below the root (at most 12). The
+;                   | deepest cells are 'world size / 2^depth'. Objects
+;                   | smaller than that share the deepest nodes.
+;
+----------------------------------------------------------------------------**/
+LooseQuadtree::LooseQuadtree(glm::vec4 const& world_bounds,
+    unsigned int depth)
+    :world_bounds_(world_bounds),
+    world_size_(world_bounds.z - world_bounds.x,
+        world_bounds.w - world_bounds.y),
+    depth_(depth), objects_count_(0)
+{
+    if (this->depth_ > MAX_DEPTH)
+    {
+        LOG_WARNING("Loose quadtree depth is clamped to 12.");
+        this->depth_ = MAX_DEPTH;
+    }
+    if (this->world_size_.x <= 0.0f || this->world_size_.y <= 0.0f)
+    {
+        LOG_ERROR("Loose quadtree world bounds are empty.");
+    }
+
+    unsigned int nodes_count = 0;
+    for (unsigned int level = 0; level <= this->depth_; level++)
+    {
+        this->level_offsets_.push_back(nodes_count);
+        nodes_count += 1u << (2 * level);
+    }
+    this->nodes_.resize(nodes_count, { NONE, 0 });
+}
+
+
+/**----------------------------------------------------------------------------
+; @func insert
+;
+; @brief
+;   Adds an object.
+;
+; @params
+;   bounds  | Bounding rectangle of the object.
+;
+; @return
+;   unsigned int    | Handle of the object.
+;
+----------------------------------------------------------------------------**/
+unsigned int LooseQuadtree::insert(glm::vec4 const& bounds)
+{
+    unsigned int handle = 0;
+    if (this->free_handles_.empty())
+    {
+        handle = static_cast<unsigned int>(this->objects_.size());
+        this->objects_.push_back({ bounds, NONE, NONE, NONE });
+    }
+    else
+    {
+        handle = this->free_handles_.back();
+        this->free_handles_.pop_back();
+        this->objects_[handle].bounds = bounds;
+    }
+    this->link(handle, this->find_node(bounds));
+    this->objects_count_++;
+    return handle;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func move
+;
+; @brief
+;   Changes the bounding rectangle of an object. If the object stays in the
+;   same node, only the rectangle is updated.
+;
+; @params
+;   handle  | Handle of the object.
+;   bounds  | The new bounding rectangle.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::move(unsigned int handle, glm::vec4 const& bounds)
+{
+    Object& object = this->objects_[handle];
+    object.bounds = bounds;
+    unsigned int node = this->find_node(bounds);
+    if (node != object.node)
+    {
+        this->unlink(handle);
+        this->link(handle, node);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func remove
+;
+; @brief
+;   Removes an object. The handle may be returned by a later 'insert'.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::remove(unsigned int handle)
+{
+    if (this->objects_[handle].node == NONE)
+    {
+        LOG_WARNING("The object has already been removed from the quadtree.");
+        return;
+    }
+    this->unlink(handle);
+    this->free_handles_.push_back(handle);
+    this->objects_count_--;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func query
+;
+; @brief
+;   Appends the handles of all objects that intersect the rectangle.
+;
+; @params
+;   rect    | Query rectangle (min x, min y, max x, max y).
+;   handles | Output. The handles are appended in no particular order.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::query(glm::vec4 const& rect,
+    std::vector<unsigned int>& handles) const
+{
+    this->query_node(0, 0, 0, rect, handles);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all objects. The nodes stay allocated.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::clear()
+{
+    std::fill(this->nodes_.begin(), this->nodes_.end(), Node{ NONE, 0 });
+    this->objects_.clear();
+    this->free_handles_.clear();
+    this->objects_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_objects_count
+;
+; @brief
+;   Returns the number of objects in the tree.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of objects.
+;
+----------------------------------------------------------------------------**/
+std::size_t LooseQuadtree::get_objects_count() const
+{
+    return this->objects_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_bounds
+;
+; @brief
+;   Returns the bounding rectangle of an object.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   glm::vec4 const&    | Bounding rectangle.
+;
+----------------------------------------------------------------------------**/
+glm::vec4 const& LooseQuadtree::get_bounds(unsigned int handle) const
+{
+    return this->objects_[handle].bounds;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func find_node
+;
+; @brief
+;   Finds the node for a bounding rectangle. The level is chosen by the size
+;   of the rectangle, the cell by its center. The loose bounds of that node
+;   always contain the rectangle.
+;
+; @params
+;   bounds  | Bounding rectangle.
+;
+; @return
+;   unsigned int    | Node index in 'nodes_'.
+;
+----------------------------------------------------------------------------**/
+unsigned int LooseQuadtree::find_node(glm::vec4 const& bounds) const
+{
+    float center_x = ((bounds.x + bounds.z) * 0.5f - this->world_bounds_.x) /
+        this->world_size_.x;            /* Normalized to [0, 1)              */
+    float center_y = ((bounds.y + bounds.w) * 0.5f - this->world_bounds_.y) /
+        this->world_size_.y;
+    if (!(center_x >= 0.0f && center_x < 1.0f && center_y >= 0.0f &&
+        center_y < 1.0f))
+    {
+        return 0;                       /* Outside the world: the root       */
+    }
+
+    float extent = std::max((bounds.z - bounds.x) / this->world_size_.x,
+        (bounds.w - bounds.y) / this->world_size_.y);
+    unsigned int level = this->depth_;
+    while (level > 0 && extent > 1.0f / static_cast<float>(1u << level))
+    {                                   /* Go up until the cell is not       */
+        level--;                        /* smaller than the object           */
+    }
+
+    unsigned int cells_per_side = 1u << level;
+    unsigned int x = std::min(static_cast<unsigned int>(center_x *
+        cells_per_side), cells_per_side - 1);
+    unsigned int y = std::min(static_cast<unsigned int>(center_y *
+        cells_per_side), cells_per_side - 1);
+    return this->level_offsets_[level] + y * cells_per_side + x;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func link
+;
+; @brief
+;   Puts an object at the head of the objects list of a node and increments
+;   the subtree counters of the node and all its ancestors.
+;
+; @params
+;   handle  | Handle of the object.
+;   node    | Node index.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::link(unsigned int handle, unsigned int node)
+{
+    Object& object = this->objects_[handle];
+    object.node = node;
+    object.prev = NONE;
+    object.next = this->nodes_[node].first_object;
+    if (object.next != NONE)
+    {
+        this->objects_[object.next].prev = handle;
+    }
+    this->nodes_[node].first_object = handle;
+
+    unsigned int level = this->get_node_level(node);
+    unsigned int local = node - this->level_offsets_[level];
+    unsigned int x = local & ((1u << level) - 1);
+    unsigned int y = local >> level;
+    for (unsigned int i = 0; i <= level; i++)
+    {
+        unsigned int ancestor_level = level - i;
+        this->nodes_[this->level_offsets_[ancestor_level] + (y >> i) *
+            (1u << ancestor_level) + (x >> i)].subtree_objects_count++;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func unlink
+;
+; @brief
+;   Removes an object from the objects list of its node and decrements the
+;   subtree counters of the node and all its ancestors.
+;
+; @params
+;   handle  | Handle of the object.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::unlink(unsigned int handle)
+{
+    Object& object = this->objects_[handle];
+    unsigned int node = object.node;
+    if (object.prev != NONE)
+    {
+        this->objects_[object.prev].next = object.next;
+    }
+    else
+    {
+        this->nodes_[node].first_object = object.next;
+    }
+    if (object.next != NONE)
+    {
+        this->objects_[object.next].prev = object.prev;
+    }
+    object.node = NONE;
+
+    unsigned int level = this->get_node_level(node);
+    unsigned int local = node - this->level_offsets_[level];
+    unsigned int x = local & ((1u << level) - 1);
+    unsigned int y = local >> level;
+    for (unsigned int i = 0; i <= level; i++)
+    {
+        unsigned int ancestor_level = level - i;
+        this->nodes_[this->level_offsets_[ancestor_level] + (y >> i) *
+            (1u << ancestor_level) + (x >> i)].subtree_objects_count--;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_node_level
+;
+; @brief
+;   Returns the level of a node by its index.
+;
+; @params
+;   node    | Node index.
+;
+; @return
+;   unsigned int    | Level (0 - the root).
+;
+----------------------------------------------------------------------------**/
+unsigned int LooseQuadtree::get_node_level(unsigned int node) const
+{
+    unsigned int level = this->depth_;
+    while (this->level_offsets_[level] > node)
+    {
+        level--;
+    }
+    return level;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func query_node
+;
+; @brief
+;   Collects the objects of a node and its subtree that intersect the
+;   rectangle. Empty subtrees and subtrees whose loose bounds do not intersect
+;   the rectangle are skipped. The root is always visited, since it also
+;   keeps the objects outside the world.
+;
+; @params
+;   level   | Node level.
+;   x       | Node cell column.
+;   y       | Node cell row.
+;   rect    | Query rectangle.
+;   handles | Output.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void LooseQuadtree::query_node(unsigned int level, unsigned int x,
+    unsigned int y, glm::vec4 const& rect,
+    std::vector<unsigned int>& handles) const
+{
+    Node const& node = this->nodes_[this->level_offsets_[level] +
+        y * (1u << level) + x];
+    if (node.subtree_objects_count == 0)
+    {
+        return;
+    }
+    if (level > 0)
+    {
+        glm::vec2 cell_size = this->world_size_ /
+            static_cast<float>(1u << level);
+        float min_x = this->world_bounds_.x + (x - 0.5f) * cell_size.x;
+        float min_y = this->world_bounds_.y + (y - 0.5f) * cell_size.y;
+        float max_x = min_x + 2.0f * cell_size.x;
+        float max_y = min_y + 2.0f * cell_size.y;
+                                        /* The loose bounds                  */
+        if (max_x < rect.x || min_x > rect.z || max_y < rect.y ||
+            min_y > rect.w)
+        {
+            return;
+        }
+    }
+
+    for (unsigned int handle = node.first_object; handle != NONE;
+        handle = this->objects_[handle].next)
+    {
+        glm::vec4 const& bounds = this->objects_[handle].bounds;
+        if (bounds.z >= rect.x && bounds.x <= rect.z &&
+            bounds.w >= rect.y && bounds.y <= rect.w)
+        {
+            handles.push_back(handle);
+        }
+    }
+
+    if (level < this->depth_)
+    {
+        for (unsigned int child = 0; child < 4; child++)
+        {
+            this->query_node(level + 1, 2 * x + (child & 1),
+                2 * y + (child >> 1), rect, handles);
+        }
+    }
+}
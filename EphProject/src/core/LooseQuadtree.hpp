@@ -0,0 +1,92 @@
+/**----------------------------------------------------------------------------
+; @file LooseQuadtree.hpp
+;
+; @brief
+;   This file describes the 'LooseQuadtree' class, a 'SpatialIndex' built as a
+;   loose quadtree of a fixed depth over the given world bounds.
+;
+;   The bounds of a node are its cell expanded by half a cell on each side, so
+;   an object is stored in exactly one node: the deepest one whose cell is not
+;   smaller than the object, at the cell that contains the object's center.
+;   The node is found with arithmetic (no descent), and moving an object
+;   within its cell does not touch the tree at all.
+;
+;   All levels are preallocated as dense grids. The objects of a node are kept
+;   in an intrusive doubly linked list. Each node also counts the objects of
+;   its subtree, so a query skips empty subtrees and visits only the nodes
+;   around the query rectangle: roughly O(visible) for a fixed depth.
+;
+;   Objects whose center is outside the world bounds are kept in the root
+;   node, which is visited by every query.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "SpatialIndex.hpp"
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class LooseQuadtree : public SpatialIndex
+{
+public:
+    LooseQuadtree(glm::vec4 const& world_bounds, unsigned int depth = 8);
+
+    unsigned int insert(glm::vec4 const& bounds) override;
+    void move(unsigned int handle, glm::vec4 const& bounds) override;
+    void remove(unsigned int handle) override;
+    void query(glm::vec4 const& rect,
+        std::vector<unsigned int>& handles) const override;
+    void clear() override;
+
+    std::size_t get_objects_count() const override;
+    glm::vec4 const& get_bounds(unsigned int handle) const override;
+
+private:
+    struct Node
+    {
+        unsigned int first_object;      /* Head of the objects list          */
+        unsigned int subtree_objects_count;
+    };
+
+    struct Object
+    {
+        glm::vec4 bounds;
+        unsigned int node;              /* 'NONE' if the handle is free      */
+        unsigned int prev;
+        unsigned int next;
+    };
+
+    glm::vec4 world_bounds_;
+    glm::vec2 world_size_;
+    unsigned int depth_;
+    std::vector<unsigned int> level_offsets_;
+                                        /* Index of the first node of each   */
+                                        /* level in 'nodes_'                 */
+    std::vector<Node> nodes_;
+    std::vector<Object> objects_;
+    std::vector<unsigned int> free_handles_;
+    std::size_t objects_count_;
+
+    unsigned int find_node(glm::vec4 const& bounds) const;
+    void link(unsigned int handle, unsigned int node);
+    void unlink(unsigned int handle);
+    unsigned int get_node_level(unsigned int node) const;
+    void query_node(unsigned int level, unsigned int x, unsigned int y,
+        glm::vec4 const& rect, std::vector<unsigned int>& handles) const;
+};
@@ -0,0 +1,517 @@
+/**----------------------------------------------------------------------------
+; @file ParticleSystem.cpp
+;
+; @brief
+;   The file implements the functionality of the 'ParticleSystem' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#if defined(__AVX2__)
+    #define PARTICLES_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PARTICLES_SSE2
+#endif
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(PARTICLES_AVX2)
+    #include <immintrin.h>
+#elif defined(PARTICLES_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#include <glad/glad.h>
+#include <glm/common.hpp>
+
+#include "ParticleSystem.hpp"
+#include "FrameStats.hpp"
+#include "IndicesData.hpp"
+#include "Log.hpp"
+#include "SpriteInstance.hpp"
+#include "Texture2dArrayLayer.hpp"
+#include "WorkerPool.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func ParticleSystem
+;
+; @brief
+;   Constructor. Allocates the particle arrays and the ring buffers for the
+;   capacity of the system and builds the unit quad the particles are
+;   instances of.
+;
+; @params
+;   texture_2d_array_ptr    | Texture 2d array all particles are taken from.
+;   capacity                | The maximum number of live particles.
+;   worker_pool_ptr         | Worker pool large systems are updated and
+;                           | written with. nullptr - the calling thread
+;                           | only.
+;
+----------------------------------------------------------------------------**/
+ParticleSystem::ParticleSystem(Texture2dArray const* texture_2d_array_ptr,
+    unsigned int capacity, WorkerPool* worker_pool_ptr)
+    :texture_2d_array_ptr_(texture_2d_array_ptr),
+    worker_pool_ptr_(worker_pool_ptr), capacity_(capacity),
+    particles_count_(0), gravity_(0.0f),
+    txd_rect_(0.0f, 0.0f, 1.0f, 1.0f), pos_x_(capacity), pos_y_(capacity),
+    velocity_x_(capacity), velocity_y_(capacity), life_(capacity),
+    size_(capacity), colors_(capacity), z_offsets_(capacity),
+    unit_quad_indices_ptr_(nullptr),
+    instance_buffer_(GL_ARRAY_BUFFER, capacity * sizeof(SpriteInstance)),
+    color_buffer_(GL_ARRAY_BUFFER, capacity * sizeof(std::uint32_t))
+{
+    this->unit_quad_indices_ptr_ = this->unit_quad_.add_unit_quad();
+    this->unit_quad_.build();           /* Send the unit quad to the GPU     */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~ParticleSystem
+;
+; @brief
+;   Destructor. Deletes the unit quad indices data.
+;
+----------------------------------------------------------------------------**/
+ParticleSystem::~ParticleSystem()
+{
+    delete this->unit_quad_indices_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func emit
+;
+; @brief
+;   Adds a particle to the system.
+;
+; @params
+;   texture_2d_array_layer_ptr  | Texture layer the particle is taken from.
+;                               | Must belong to the texture 2d array of the
+;                               | system.
+;   pos                         | Center of the particle (in pixels).
+;   velocity                    | Velocity (in pixels per second).
+;   life                        | Time to live (in seconds).
+;   size                        | Side of the particle (in pixels).
+;   color                       | Color the texels are multiplied by.
+;                               | White by default.
+;
+; @return
+;   bool    | false if the system is full or the layer belongs to another
+;           | texture 2d array (the particle is not added).
+;
+----------------------------------------------------------------------------**/
+bool ParticleSystem::emit(
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec2 const& pos, glm::vec2 const& velocity, float life, float size,
+    glm::vec4 const& color)
+{
+    if (this->particles_count_ >= this->capacity_)
+    {
+        return false;
+    }
+    if (texture_2d_array_layer_ptr->get_texture_2d_array() !=
+        this->texture_2d_array_ptr_)
+    {
+        LOG_WARNING("The particle layer belongs to another texture 2d array.");
+        return false;
+    }
+
+    glm::vec4 clamped = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    std::size_t i = this->particles_count_++;
+    this->pos_x_[i] = pos.x;
+    this->pos_y_[i] = pos.y;
+    this->velocity_x_[i] = velocity.x;
+    this->velocity_y_[i] = velocity.y;
+    this->life_[i] = life;
+    this->size_[i] = size;
+    this->colors_[i] = static_cast<std::uint32_t>(clamped.r) |
+        static_cast<std::uint32_t>(clamped.g) << 8 |
+        static_cast<std::uint32_t>(clamped.b) << 16 |
+        static_cast<std::uint32_t>(clamped.a) << 24;
+                                        /* R in the lowest byte: the bytes   */
+                                        /* are read as RGBA in memory order  */
+    this->z_offsets_[i] = texture_2d_array_layer_ptr->get_z_offset();
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update
+;
+; @brief
+;   Advances the particles by a time step: applies the gravity to the
+;   velocities, moves the particles and shortens their lives. Then removes
+;   the dead particles. Systems of at least two 'MIN_SLICE_SIZE' particles
+;   are integrated on the worker pool, if any.
+;
+; @params
+;   delta_time  | Time step (in seconds).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::update(float delta_time)
+{
+    if (this->worker_pool_ptr_ != nullptr)
+    {
+        this->worker_pool_ptr_->run(this->particles_count_, MIN_SLICE_SIZE,
+            [this, delta_time](std::size_t begin, std::size_t end)
+        {
+            this->integrate(begin, end, delta_time);
+        });
+    }
+    else
+    {
+        this->integrate(0, this->particles_count_, delta_time);
+    }
+    this->compact();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all particles.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::clear()
+{
+    this->particles_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw
+;
+; @brief
+;   Writes the live particles into the ring buffers (on the worker pool, if
+;   any) and draws them with a single instanced call. Each draw starts a
+;   frame of the ring buffers (see 'RingBuffer::begin_frame'): a region
+;   holds all particles of the system, and is fenced when the next draw
+;   moves on. The texture 2d array of the system and a drawing shader program
+;   must be in use. The unit quad vertex array stays bound after the call.
+;
+; @params
+;   depth   | Clip space z of the particles.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::draw(float depth)
+{
+    std::size_t particles_count = this->particles_count_;
+    if (particles_count == 0)
+    {
+        return;
+    }
+
+    this->instance_buffer_.begin_frame();
+    this->color_buffer_.begin_frame();
+    SpriteInstance* instances_ptr = static_cast<SpriteInstance*>(
+        this->instance_buffer_.acquire(particles_count *
+            sizeof(SpriteInstance), particles_count * sizeof(SpriteInstance)));
+    void* colors_ptr = this->color_buffer_.acquire(particles_count *
+        sizeof(std::uint32_t), particles_count * sizeof(std::uint32_t));
+    if (this->worker_pool_ptr_ != nullptr)
+    {
+        this->worker_pool_ptr_->run(particles_count, MIN_SLICE_SIZE,
+            [this, instances_ptr, depth](std::size_t begin, std::size_t end)
+        {
+            this->write_instances(begin, end, instances_ptr, depth);
+        });
+    }
+    else
+    {
+        this->write_instances(0, particles_count, instances_ptr, depth);
+    }
+    std::memcpy(colors_ptr, this->colors_.data(),
+        particles_count * sizeof(std::uint32_t));
+                                        /* Already in the drawn order        */
+    this->instance_buffer_.commit(particles_count * sizeof(SpriteInstance));
+    this->color_buffer_.commit(particles_count * sizeof(std::uint32_t));
+                                        /* Before the draw reads them        */
+    this->unit_quad_.bind_instance_buffer(this->instance_buffer_.get_id(),
+        this->instance_buffer_.get_acquired_offset());
+    this->unit_quad_.bind_color_buffer(this->color_buffer_.get_id(),
+        this->color_buffer_.get_acquired_offset());
+    glDrawElementsInstanced(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count, GL_UNSIGNED_INT,
+        this->unit_quad_indices_ptr_->offset,
+        static_cast<GLsizei>(particles_count));
+    FRAME_STATS_ADD_DRAW(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count,
+        static_cast<unsigned int>(particles_count));
+    FRAME_STATS_ADD(buffer_bytes, particles_count * (sizeof(SpriteInstance) +
+        sizeof(std::uint32_t)));        /* Instances and colors              */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_gravity
+;
+; @brief
+;   Sets the acceleration applied to all particles. None by default.
+;
+; @params
+;   gravity | Acceleration (in pixels per second squared).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::set_gravity(glm::vec2 const& gravity)
+{
+    this->gravity_ = gravity;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_txd_rect
+;
+; @brief
+;   Sets the region of the layers the particles show. The whole layer by
+;   default.
+;
+; @params
+;   txd_rect    | xy - offset, zw - size of the region (in normalized texture
+;               | coordinates).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::set_txd_rect(glm::vec4 const& txd_rect)
+{
+    this->txd_rect_ = txd_rect;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_texture_2d_array
+;
+; @brief
+;   Returns the texture 2d array all particles are taken from.
+;
+; @params
+;   None
+;
+; @return
+;   Texture2dArray const*   | The texture 2d array.
+;
+----------------------------------------------------------------------------**/
+Texture2dArray const* ParticleSystem::get_texture_2d_array() const
+{
+    return this->texture_2d_array_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_particles_count
+;
+; @brief
+;   Returns the number of live particles.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of live particles.
+;
+----------------------------------------------------------------------------**/
+std::size_t ParticleSystem::get_particles_count() const
+{
+    return this->particles_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_capacity
+;
+; @brief
+;   Returns the maximum number of live particles.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The capacity of the system.
+;
+----------------------------------------------------------------------------**/
+std::size_t ParticleSystem::get_capacity() const
+{
+    return this->capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func integrate
+;
+; @brief
+;   Advances a range of particles by a time step (explicit Euler). Ranges of
+;   different calls must not overlap.
+;
+; @params
+;   begin       | The first particle of the range.
+;   end         | One past the last particle of the range.
+;   delta_time  | Time step (in seconds).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::integrate(std::size_t begin, std::size_t end,
+    float delta_time)
+{
+    std::size_t i = begin;
+    float delta_velocity_x = this->gravity_.x * delta_time;
+    float delta_velocity_y = this->gravity_.y * delta_time;
+
+#if defined(PARTICLES_AVX2)
+    __m256 dt = _mm256_set1_ps(delta_time);
+    __m256 dvx = _mm256_set1_ps(delta_velocity_x);
+    __m256 dvy = _mm256_set1_ps(delta_velocity_y);
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 vx = _mm256_add_ps(_mm256_loadu_ps(&this->velocity_x_[i]),
+            dvx);
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&this->velocity_y_[i]),
+            dvy);
+        _mm256_storeu_ps(&this->velocity_x_[i], vx);
+        _mm256_storeu_ps(&this->velocity_y_[i], vy);
+        _mm256_storeu_ps(&this->pos_x_[i], _mm256_add_ps(
+            _mm256_loadu_ps(&this->pos_x_[i]), _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(&this->pos_y_[i], _mm256_add_ps(
+            _mm256_loadu_ps(&this->pos_y_[i]), _mm256_mul_ps(vy, dt)));
+        _mm256_storeu_ps(&this->life_[i], _mm256_sub_ps(
+            _mm256_loadu_ps(&this->life_[i]), dt));
+    }
+#elif defined(PARTICLES_SSE2)
+    __m128 dt = _mm_set1_ps(delta_time);
+    __m128 dvx = _mm_set1_ps(delta_velocity_x);
+    __m128 dvy = _mm_set1_ps(delta_velocity_y);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(&this->velocity_x_[i]), dvx);
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(&this->velocity_y_[i]), dvy);
+        _mm_storeu_ps(&this->velocity_x_[i], vx);
+        _mm_storeu_ps(&this->velocity_y_[i], vy);
+        _mm_storeu_ps(&this->pos_x_[i], _mm_add_ps(
+            _mm_loadu_ps(&this->pos_x_[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&this->pos_y_[i], _mm_add_ps(
+            _mm_loadu_ps(&this->pos_y_[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&this->life_[i], _mm_sub_ps(
+            _mm_loadu_ps(&this->life_[i]), dt));
+    }
+#endif
+
+    for (; i < end; i++)                /* The tail (or everything if there  */
+    {                                   /* is no SIMD kernel)                */
+        this->velocity_x_[i] += delta_velocity_x;
+        this->velocity_y_[i] += delta_velocity_y;
+        this->pos_x_[i] += this->velocity_x_[i] * delta_time;
+        this->pos_y_[i] += this->velocity_y_[i] * delta_time;
+        this->life_[i] -= delta_time;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func compact
+;
+; @brief
+;   Removes the dead particles: each one is overwritten by the last live
+;   particle, so the live ones stay at the beginning of the arrays. Costs one
+;   pass over the lives and one copy per dead particle; nothing is allocated.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::compact()
+{
+    std::size_t i = 0;
+    while (i < this->particles_count_)
+    {
+        if (this->life_[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+
+        std::size_t last = --this->particles_count_;
+        this->pos_x_[i] = this->pos_x_[last];
+        this->pos_y_[i] = this->pos_y_[last];
+        this->velocity_x_[i] = this->velocity_x_[last];
+        this->velocity_y_[i] = this->velocity_y_[last];
+        this->life_[i] = this->life_[last];
+        this->size_[i] = this->size_[last];
+        this->colors_[i] = this->colors_[last];
+        this->z_offsets_[i] = this->z_offsets_[last];
+                                        /* 'i' is not advanced: the moved    */
+                                        /* particle may be dead too          */
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func write_instances
+;
+; @brief
+;   Writes a range of live particles as sprite instances: squares of their
+;   size centered on their positions.
+;
+; @params
+;   begin           | The first particle of the range.
+;   end             | One past the last particle of the range.
+;   instances_ptr   | Output: the instance array (indexed like the
+;                   | particles).
+;   depth           | Clip space z of the particles.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void ParticleSystem::write_instances(std::size_t begin, std::size_t end,
+    SpriteInstance* instances_ptr, float depth) const
+{
+    for (std::size_t i = begin; i < end; i++)
+    {
+        float size = this->size_[i];
+        float half_size = size * 0.5f;
+        SpriteInstance& instance = instances_ptr[i];
+        instance.transform = glm::vec4(size, 0.0f, 0.0f, size);
+        instance.translation = glm::vec2(this->pos_x_[i] - half_size,
+            this->pos_y_[i] - half_size);
+        instance.txd_rect = this->txd_rect_;
+        instance.z_offset = this->z_offsets_[i];
+        instance.depth = depth;
+    }
+}
@@ -0,0 +1,113 @@
+/**----------------------------------------------------------------------------
+; @file ParticleSystem.hpp
+;
+; @brief
+;   This file describes the 'ParticleSystem' class. This class simulates and
+;   draws a large number of short-lived particles (sparks, smoke, debris)
+;   that share a texture 2d array.
+;
+;   The particles are stored as a structure of arrays (position, velocity,
+;   remaining life, size, color and texture layer), allocated once for the
+;   capacity of the system. 'update' integrates them 8 at a time with AVX2
+;   or 4 at a time with SSE2 (selected at compile time like in
+;   'SpriteTransforms'), then compacts the dead ones away by moving the last
+;   live particle into their place, so the live particles always occupy the
+;   beginning of the arrays and nothing is allocated after the construction.
+;   If a worker pool is given, large systems are split between its threads.
+;
+;   'draw' streams the live particles straight into a ring buffer as
+;   'SpriteInstance' elements plus one packed RGBA8 color each, and draws
+;   them all with a single instanced call against the texture 2d array of
+;   the system. The order of the particles is not kept (see the compaction
+;   above), so they should be blended in an order-independent way (e.g.
+;   additively) or not overlap.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "RingBuffer.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Texture2dArray;
+class Texture2dArrayLayer;
+class WorkerPool;
+struct SpriteInstance;
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class ParticleSystem
+{
+public:
+    ParticleSystem(Texture2dArray const* texture_2d_array_ptr,
+        unsigned int capacity, WorkerPool* worker_pool_ptr = nullptr);
+    ~ParticleSystem();
+
+    bool emit(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec2 const& pos, glm::vec2 const& velocity, float life,
+        float size, glm::vec4 const& color = glm::vec4(1.0f));
+    void update(float delta_time);
+    void clear();
+    void draw(float depth);
+
+    void set_gravity(glm::vec2 const& gravity);
+    void set_txd_rect(glm::vec4 const& txd_rect);
+
+    Texture2dArray const* get_texture_2d_array() const;
+    std::size_t get_particles_count() const;
+    std::size_t get_capacity() const;
+
+    static constexpr std::size_t MIN_SLICE_SIZE = 16384;
+                                        /* Particles per worker thread       */
+
+private:
+    Texture2dArray const* texture_2d_array_ptr_;
+    WorkerPool* worker_pool_ptr_;       /* nullptr if single-threaded        */
+    std::size_t capacity_;
+    std::size_t particles_count_;       /* Live particles: [0, count)        */
+    glm::vec2 gravity_;                 /* In pixels per second squared      */
+    glm::vec4 txd_rect_;                /* The region of the layers drawn    */
+
+    std::vector<float> pos_x_;          /* The particles (in pixels, pixels  */
+    std::vector<float> pos_y_;          /* per second and seconds)           */
+    std::vector<float> velocity_x_;
+    std::vector<float> velocity_y_;
+    std::vector<float> life_;
+    std::vector<float> size_;
+    std::vector<std::uint32_t> colors_; /* RGBA8, as read by the shader      */
+    std::vector<int> z_offsets_;        /* Texture 2d array layer numbers    */
+
+    VertexArray unit_quad_;
+    IndicesData* unit_quad_indices_ptr_;
+    RingBuffer instance_buffer_;
+    RingBuffer color_buffer_;
+
+    void integrate(std::size_t begin, std::size_t end, float delta_time);
+    void compact();
+    void write_instances(std::size_t begin, std::size_t end,
+        SpriteInstance* instances_ptr, float depth) const;
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+};
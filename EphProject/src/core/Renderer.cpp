@@ -16,41 +16,148 @@
 /** @includes  -------------------------------------------------------------**/
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 
 #include "Renderer.hpp"
+#include "CommandBuffer.hpp"
+#include "CpuProfiler.hpp"
+#include "FrameStats.hpp"
+#include "GlyphCache.hpp"
+#include "GpuParticleSystem.hpp"
+#include "GpuProfiler.hpp"
+#include "ParticleSystem.hpp"
 #include "Shader.hpp"
 #include "Sprite.hpp"
+#include "StaticLayer.hpp"
+#include "Tilemap.hpp"
+#include "Texture2dArray.hpp"
 #include "Texture2dArrayLayer.hpp"
 #include "IndicesData.hpp"
+#include "GlState.hpp"
+#include "Log.hpp"
 
 
 
 /** @functions -------------------------------------------------------------**/
 
+/**----------------------------------------------------------------------------
+; @func decode_utf8
+;
+; @brief
+;   Decodes the UTF-8 sequence that starts at an index of a string and moves
+;   the index past it. A malformed sequence decodes to U+FFFD and skips one
+;   byte.
+;
+; @params
+;   text    | UTF-8 string.
+;   index   | Index of the first byte of the sequence. Receives the index of
+;           | the next sequence.
+;
+; @return
+;   unsigned int    | Unicode codepoint.
+;
+----------------------------------------------------------------------------**/
+static unsigned int decode_utf8(std::string const& text, std::size_t& index)
+{
+    unsigned char lead = static_cast<unsigned char>(text[index]);
+    int length = lead < 0x80 ? 1 : (lead >> 5) == 0x06 ? 2 :
+        (lead >> 4) == 0x0E ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || index + length > text.size())
+    {
+        index++;
+        return 0xFFFD;
+    }
+
+    unsigned int codepoint = length == 1 ? lead :
+        lead & (0xFF >> (length + 1));  /* Payload bits of the lead byte     */
+    for (int i = 1; i < length; i++)
+    {
+        unsigned char next = static_cast<unsigned char>(text[index + i]);
+        if ((next & 0xC0) != 0x80)      /* Not a continuation byte           */
+        {
+            index++;
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+    index += length;
+    return codepoint;
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func Renderer
 ;
 ; @brief
 ;   Constructor. Initializes the fields of the class. Generates a projection
-;   matrix based on the size of the scene. Sends it to the shader program as a
-;   uniform variable.
+;   matrix based on the size of the scene and stores it in the view uniform
+;   block. Connects the uniform blocks of the shader program to the shared
+;   uniform buffers. Makes the shader program current.
 ;
 ; @params
-;   shader_ptr  | Pointer to the shader used for rendering.
-;   scene_size  | Scene (window) size.
+;   shader_ptr      | Pointer to the shader used for rendering.
+;   scene_size      | Scene (window) size.
+;   batch_capacity  | The maximum number of sprites (draws) submitted between
+;                   | 'begin' and 'flush' before the batch is flushed
+;                   | implicitly.
 ;
 ----------------------------------------------------------------------------**/
-Renderer::Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size)
-    :shader_ptr_(shader_ptr), scene_size_(scene_size)
+Renderer::Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size,
+    unsigned int batch_capacity)
+    :shader_ptr_(shader_ptr), scene_size_(scene_size), batch_(batch_capacity),
+    indirect_batch_(batch_capacity), mode_(RENDER_MODE_IMMEDIATE),
+    depth_mode_(DEPTH_MODE_NONE),
+    saved_draw_calls_count_(0),
+    frame_uniform_buffer_(sizeof(FrameUniformBlock), UNIFORM_BLOCK_FRAME),
+    view_uniform_buffer_(sizeof(ViewUniformBlock), UNIFORM_BLOCK_VIEW),
+    frame_block_(), is_view_dirty_(true),
+    start_time_(std::chrono::steady_clock::now()),
+    prev_frame_time_(start_time_), cull_rect_(0.0f),
+    visible_sprites_count_(0), culled_sprites_count_(0),
+    gpu_culler_ptr_(nullptr), tint_(1.0f)
 {
-    glm::mat4 projection(1.0);
-    projection = glm::ortho(0.0f, static_cast<GLfloat>(scene_size.x),
+    this->view_block_.projection = glm::ortho(0.0f,
+        static_cast<GLfloat>(scene_size.x),
         static_cast<GLfloat>(scene_size.y), 0.0f, -0.1f, 0.1f);
                                         /* Create a projection matrix based  */
                                         /* on the scene size                 */
+    this->view_block_.view = glm::mat4(1.0f);
+    this->view_block_.viewport = glm::vec4(0.0f, 0.0f,
+        static_cast<GLfloat>(scene_size.x),
+        static_cast<GLfloat>(scene_size.y));
+    this->update_cull_rect();
+    this->view_uniform_buffer_.update(&this->view_block_,
+        sizeof(ViewUniformBlock));      /* Upload it now, so 'draw_sprite'   */
+    this->is_view_dirty_ = false;       /* works before the first 'begin'    */
+    this->frame_uniform_buffer_.update(&this->frame_block_,
+        sizeof(FrameUniformBlock));
+
+    this->add_shader(this->shader_ptr_);
 
-    this->shader_ptr_->set_mat4("uf_projection", projection);
-                                        /* Send it to the shader program     */
+    glVertexAttrib4f(ATTRIB_INSTANCE_TXD_RECT, 0.0f, 0.0f, 1.0f, 1.0f);
+                                        /* Sprites drawn by 'draw_sprite'    */
+                                        /* use their texture vertices as is  */
+    glVertexAttrib1f(ATTRIB_INSTANCE_DEPTH, DrawQueue::get_clip_depth(0));
+    glVertexAttrib4f(ATTRIB_INSTANCE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+                                        /* Only particles are colored per    */
+                                        /* instance                          */
+
+    this->shader_ptr_->use();
+    this->shader_ptr_->set_vec4("uf_tint", this->tint_);
+                                        /* Sprites are not tinted            */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~Renderer
+;
+; @brief
+;   Destructor. Deletes the GPU culler, if any.
+;
+----------------------------------------------------------------------------**/
+Renderer::~Renderer()
+{
+    delete this->gpu_culler_ptr_;
 }
 
 
@@ -61,10 +168,15 @@ Renderer::Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size)
 ;   The function sets some presets for rendering a sprite (binds the texture 2d
 ;   array, sets the texture unit and layer number), and then renders the sprite
 ;   using the indexes.
-;   In fact, setting presets is a CPU->GPU transfer that is time consuming.
-;   For optimization, the last used values(which are already in the GPU) are
-;   stored in static variables. Data is sent to the GPU only if the new values
-;   are not equal to the previous ones.
+;   The vertex array the sprite belongs to must be bound before the call.
+;   The transform (axis-aligned: position and size) and layer number are
+;   passed as the current values of the (disabled) per-instance vertex
+;   attributes, so the same shader is used by both immediate and batched
+;   rendering.
+;   In the 'RENDER_MODE_MULTI_DRAW_INDIRECT' mode the draw is only recorded as
+;   an indirect command and is executed on 'flush'. The vertex array does not
+;   have to be bound in this mode.
+;   A sprite that is entirely outside the view is neither drawn nor recorded.
 ;
 ; @params
 ;   sprite_ptr  | Sprite object pointer.
@@ -76,94 +188,1064 @@ Renderer::Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size)
 ;
 ----------------------------------------------------------------------------**/
 void Renderer::draw_sprite(Sprite* sprite_ptr, glm::vec2 const& pos,
-    glm::vec2 const& size) const
-{
-    // static Texture2dArray* last_texture_2d_array_ = nullptr;
-    // static Texture2dArrayLayer* last_texture_2d_array_layer = nullptr;
-
-
-                                        /* Sending data to the shader and    */
-                                        /* binding OpenGL objects can be     */
-                                        /* time consuming. The following     */
-                                        /* logic prevents unnecessary data   */
-                                        /* transfers to shaders and          */
-                                        /* unnecessary 2d texture array      */
-                                        /* bindings.                         */
-    static unsigned int prev_texture_2d_array_id = 0;
-    static int prev_texture_unit = 0;
-    static int prev_texture_2d_array_z_offset = 0;
-
-                                        /* Get presets for rendering the     */
-                                        /* current sprite:                   */
-    unsigned int cur_texture_2d_array_id = sprite_ptr->
-        texture_2d_array_layer_ptr_->get_texture_2d_array()->get_id();
-                                        /* Get current sprite's texture 2d   */
-                                        /* array id                          */
-
-    int cur_texture_unit = sprite_ptr->texture_2d_array_layer_ptr_->
-        get_texture_2d_array()->get_texture_unit();
-                                        /* Get current sprite's texture unit */
-
-    int cur_texture_2d_array_z_offset = sprite_ptr->
-        texture_2d_array_layer_ptr_->get_z_offset();
-                                        /* Get current sprite's texture 2d   */
-                                        /* array layer number                */
-
-
-    // TODO: Check if the if-statement below makes the function faster.
-    if (prev_texture_2d_array_id != cur_texture_2d_array_id)
-    {                                   /* Compare the current sprite's      */
-                                        /* texture 2d array with the         */
-                                        /* currently bound 2d texture array  */
-
-        sprite_ptr->texture_2d_array_layer_ptr_->get_texture_2d_array()->
-            bind();                      /* Bind the new 2d texture array    */
-                                         /* only if it has changed           */
-
-        prev_texture_2d_array_id = cur_texture_2d_array_id;
-                                        /* Update the current state of the   */
-                                        /* static variable for the next      */
-                                        /* function call                     */
-    }
-
-    // TODO: Check if the if-statement below makes the function faster.
-    if (prev_texture_unit != cur_texture_unit)
-    {                                   /* Compare the current sprite's      */
-                                        /* texture unit with the value       */
-                                        /* currently set in the shader       */
-        shader_ptr_->set_int("uf_txd_unit", cur_texture_unit - GL_TEXTURE0);
-                                        /* Send the new texture unit number  */
-                                        /* to the GPU only if it has changed */ 
-
-        prev_texture_unit = cur_texture_unit;
-                                        /* Update the current state of the   */
-                                        /* static variable for the next      */
-                                        /* function call                     */
-    }
-
-    // TODO: Check if the if-statement below makes the function faster.
-    if (prev_texture_2d_array_z_offset != cur_texture_2d_array_z_offset)
-    {                                   /* Compare the current sprite's      */
-                                        /* texture 2d array layer number     */
-                                        /* with the value currently set in   */
-                                        /* the shader                        */
-
-        shader_ptr_->set_int("uf_txd_array_z_offset",
-            cur_texture_2d_array_z_offset);
-                                        /* Send the new z offset to the GPU  */
-                                        /* only if it has changed            */
-
-        prev_texture_2d_array_z_offset = cur_texture_2d_array_z_offset;
-                                        /* Update the current state of the   */
-                                        /* static variable for the next      */
-                                        /* function call                     */
-    }
-
-    // TODO: 'uf_model_pos' and 'uf_model_size' must be in the same vec4.
-    this->shader_ptr_->set_vec2("uf_model_pos", pos);
-    this->shader_ptr_->set_vec2("uf_model_size", size);
+    glm::vec2 const& size)
+{
+    CPU_PROFILE_SCOPE("Renderer::draw_sprite");
+    if (!SpriteCuller::is_visible(this->cull_rect_, pos, size))
+    {
+        this->culled_sprites_count_++;
+        return;
+    }
+    this->visible_sprites_count_++;
+
+    if (this->mode_ == RENDER_MODE_MULTI_DRAW_INDIRECT)
+    {
+        if (this->indirect_batch_.is_full())
+        {
+            this->flush();
+        }
+        this->indirect_batch_.submit(sprite_ptr->indices_data_ptr_,
+            sprite_ptr->texture_2d_array_layer_ptr_, pos, size,
+            DrawQueue::get_clip_depth(0));
+        return;
+    }
+
+    this->use_texture_2d_array(sprite_ptr->texture_2d_array_layer_ptr_->
+        get_texture_2d_array());
+
+    glVertexAttrib4f(ATTRIB_INSTANCE_TRANSFORM, size.x, 0.0f, 0.0f, size.y);
+    glVertexAttrib2f(ATTRIB_INSTANCE_TRANSLATION, pos.x, pos.y);
+    glVertexAttribI1i(ATTRIB_INSTANCE_Z_OFFSET,
+        sprite_ptr->texture_2d_array_layer_ptr_->get_z_offset());
 
     glDrawElements(sprite_ptr->indices_data_ptr_->mode,
         sprite_ptr->indices_data_ptr_->count,
         GL_UNSIGNED_INT, sprite_ptr->indices_data_ptr_->offset);
-}
\ No newline at end of file
+    FRAME_STATS_ADD_DRAW(sprite_ptr->indices_data_ptr_->mode,
+        sprite_ptr->indices_data_ptr_->count, 1);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin
+;
+; @brief
+;   Starts collecting sprites for deferred rendering. Sprites submitted before
+;   and not flushed are discarded. Resets the saved draw calls counter, the
+;   fence wait time and the culling counters. The batches move to the next
+;   region of their ring buffers, fencing the previous frame's one.
+;   Also starts a new frame: the uniform buffers of the renderer are attached
+;   to the block binding points (another renderer may have taken them), the
+;   frame uniform block (time, delta time, frame index) is uploaded, and the
+;   view uniform block too if it has changed.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::begin()
+{
+    this->queue_.clear();
+    this->culler_.clear();
+    this->transforms_.clear();
+    this->batch_.reset_stats();
+    this->indirect_batch_.reset_stats();
+    this->batch_.begin_frame();         /* Fenced once per frame             */
+    this->indirect_batch_.begin_frame();
+    this->saved_draw_calls_count_ = 0;
+    this->visible_sprites_count_ = 0;
+    this->culled_sprites_count_ = 0;
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    this->frame_block_.time = std::chrono::duration<float>(now -
+        this->start_time_).count();
+    this->frame_block_.delta_time = std::chrono::duration<float>(now -
+        this->prev_frame_time_).count();
+    this->frame_block_.frame_index++;
+    this->prev_frame_time_ = now;
+    this->frame_uniform_buffer_.attach();
+    this->view_uniform_buffer_.attach();
+    this->frame_uniform_buffer_.update(&this->frame_block_,
+        sizeof(FrameUniformBlock));
+
+    if (this->is_view_dirty_)
+    {
+        this->view_uniform_buffer_.update(&this->view_block_,
+            sizeof(ViewUniformBlock));
+        this->is_view_dirty_ = false;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add_shader
+;
+; @brief
+;   Connects the 'FrameBlock' and 'ViewBlock' uniform blocks of a shader
+;   program to the renderer's uniform buffers. The program then reads the
+;   same constants as the renderer's own shader, with no uploads of its own.
+;   A program may declare only one of the blocks.
+;
+; @params
+;   shader_ptr  | Shader program.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::add_shader(Shader const* shader_ptr) const
+{
+    bool has_frame_block = shader_ptr->bind_uniform_block("FrameBlock",
+        UNIFORM_BLOCK_FRAME);
+    bool has_view_block = shader_ptr->bind_uniform_block("ViewBlock",
+        UNIFORM_BLOCK_VIEW);
+    if (!has_frame_block && !has_view_block)
+    {
+        LOG_WARNING("The shader program uses no shared uniform blocks.");
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_view
+;
+; @brief
+;   Sets the view (camera) matrix. The view uniform block is uploaded on the
+;   next 'begin', so changing the view several times per frame costs one
+;   upload.
+;
+; @params
+;   view    | View matrix (world -> scene pixels).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_view(glm::mat4 const& view)
+{
+    this->view_block_.view = view;
+    this->is_view_dirty_ = true;
+    this->update_cull_rect();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_cull_shader
+;
+; @brief
+;   Sets the compute shader program used to cull static layers on the GPU
+;   (see 'GpuCuller'). nullptr turns the GPU culling off: static layers are
+;   drawn entirely.
+;
+; @params
+;   cull_shader_ptr | Compute shader program
+;                   | ('shaders/sprite_cull_compute.shader') or nullptr.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_cull_shader(Shader const* cull_shader_ptr)
+{
+    delete this->gpu_culler_ptr_;
+    this->gpu_culler_ptr_ = nullptr;
+    if (cull_shader_ptr != nullptr)
+    {
+        this->gpu_culler_ptr_ = new GpuCuller(cull_shader_ptr);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func submit_sprite
+;
+; @brief
+;   Adds a sprite to the draw queue. Nothing is drawn until 'flush' is called.
+;   The order of submission is kept only for sprites with the same depth and
+;   rendering state; otherwise sprites are reordered to minimize state changes.
+;   In the 'DEPTH_MODE_TWO_PASS' mode the sprite is classified as opaque or
+;   translucent by the opacity mask of its layer region.
+;
+; @params
+;   texture_2d_array_layer_ptr  | Texture layer the sprite is taken from.
+;   pos                         | Position of the pivot (in pixels).
+;   size                        | Sprite size (in pixels).
+;   txd_rect                    | xy - offset, zw - size of the sprite region
+;                               | on the layer (in normalized texture
+;                               | coordinates). The whole layer by default.
+;   depth                       | Draw layer in [0, 65535]. Sprites with
+;                               | greater depth cover the ones with smaller
+;                               | depth.
+;   rotation                    | Rotation around the pivot (in radians,
+;                               | clockwise on the screen).
+;   pivot                       | The point the sprite is placed and rotated
+;                               | by, relative to its size. The top left
+;                               | corner by default.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::submit_sprite(
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec2 const& pos, glm::vec2 const& size, glm::vec4 const& txd_rect,
+    int depth, float rotation, glm::vec2 const& pivot)
+{
+    if (this->queue_.is_full())
+    {
+        this->flush();
+    }
+    bool is_translucent = this->depth_mode_ != DEPTH_MODE_TWO_PASS ||
+        !texture_2d_array_layer_ptr->is_opaque(txd_rect);
+    this->queue_.push({ texture_2d_array_layer_ptr, txd_rect, depth },
+        is_translucent);
+    this->transforms_.push(pos, size, rotation, pivot);
+                                        /* Same index as in the queue        */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func flush
+;
+; @brief
+;   Draws all sprites submitted since the last 'begin' (or 'flush') call. The
+;   transforms and bounds of the sprites are computed first, the sprites
+;   outside the view are culled and the rest of the draw queue is sorted,
+;   then each run of sprites that share a texture 2d array is drawn with one
+;   instanced draw call. The unit quad vertex array stays bound after the
+;   call.
+;   In the 'RENDER_MODE_MULTI_DRAW_INDIRECT' mode the recorded 'draw_sprite'
+;   draws are submitted first, one 'glMultiDrawElementsIndirect' call per run.
+;   Everything is drawn with a white tint, whatever text was drawn before.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::flush()
+{
+    CPU_PROFILE_SCOPE("Renderer::flush");
+    GpuProfileScope profile_scope("flush");
+    this->set_tint(glm::vec4(1.0f));
+    if (!this->indirect_batch_.is_empty())
+    {
+        unsigned int commands_count = 0;
+        this->indirect_batch_.bind();
+        for (IndirectBatch::Run const& run : this->indirect_batch_.get_runs())
+        {
+            this->use_texture_2d_array(run.texture_2d_array_ptr);
+            this->indirect_batch_.draw_run(run);
+            commands_count += run.commands_count;
+        }
+        this->indirect_batch_.finish();
+        this->saved_draw_calls_count_ += commands_count - static_cast<
+            unsigned int>(this->indirect_batch_.get_runs().size());
+                                        /* One call per run instead of one   */
+                                        /* call per command                  */
+        this->indirect_batch_.begin();
+    }
+
+    this->transforms_.compute();        /* All transforms at once (SIMD)     */
+    for (std::size_t i = 0; i < this->transforms_.get_sprites_count(); i++)
+    {
+        this->culler_.push(this->transforms_.get_bounds(i));
+    }
+    this->culler_.cull(this->cull_rect_);
+    this->queue_.retain(this->culler_.get_visible_indices());
+                                        /* Drop the sprites outside the view */
+    this->visible_sprites_count_ += static_cast<unsigned int>(
+        this->culler_.get_visible_indices().size());
+    this->culled_sprites_count_ += static_cast<unsigned int>(
+        this->culler_.get_sprites_count() -
+        this->culler_.get_visible_indices().size());
+    this->culler_.clear();
+
+    this->queue_.sort();                /* Group the submitted sprites by    */
+                                        /* the rendering state               */
+    for (std::size_t i = 0; i < this->queue_.get_items_count(); i++)
+    {
+        DrawQueue::Item const& item = this->queue_.get_sorted_item(i);
+        std::size_t item_index = this->queue_.get_sorted_item_index(i);
+        bool is_translucent = this->queue_.is_sorted_item_translucent(i);
+        if (i == 0 || is_translucent !=
+            this->queue_.is_sorted_item_translucent(i - 1))
+        {                               /* A pass starts: draw the previous  */
+            this->draw_batch();         /* one with its own state            */
+            this->set_pass_state(is_translucent);
+        }
+        if (this->batch_.is_full())
+        {
+            this->draw_batch();
+        }
+        this->batch_.submit(item.texture_2d_array_layer_ptr,
+            this->transforms_.get_transform(item_index),
+            this->transforms_.get_translation(item_index), item.txd_rect,
+            DrawQueue::get_clip_depth(item.depth));
+    }
+    this->queue_.clear();
+    this->transforms_.clear();
+    this->draw_batch();
+
+    if (this->depth_mode_ == DEPTH_MODE_TWO_PASS)
+    {                                   /* Restore the default state for     */
+        GlState& gl_state = GlState::current();
+        gl_state.set_depth_test(false); /* 'draw_sprite' and 'glClear'       */
+        gl_state.set_depth_mask(true);
+        gl_state.set_blend(true);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_static_layer
+;
+; @brief
+;   Draws a static layer immediately, one instanced draw call per run. The
+;   changes made to the layer since the previous draw are uploaded first.
+;   Like 'draw_sprite' the layer is blended in the painter's order. The unit
+;   quad vertex array of the layer (or of the GPU culler) stays bound after
+;   the call.
+;   If a cull shader is set, the layer is culled on the GPU first and each run
+;   is drawn with an indirect call whose instance count is written by the
+;   cull shader. The visible and culled sprites counters do not include the
+;   sprites of the layer then: the counts never reach the CPU.
+;
+; @params
+;   static_layer_ptr    | Static layer to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_static_layer(StaticLayer* static_layer_ptr)
+{
+    GpuProfileScope profile_scope("static layer");
+    static_layer_ptr->update();         /* Upload the changes, if any        */
+    if (static_layer_ptr->is_empty())
+    {
+        return;
+    }
+
+    std::vector<StaticLayer::Run> const& runs = static_layer_ptr->get_runs();
+    if (this->gpu_culler_ptr_ != nullptr)
+    {
+        this->gpu_culler_ptr_->cull(*static_layer_ptr, this->cull_rect_);
+        this->shader_ptr_->use();       /* Back from the cull shader         */
+        this->gpu_culler_ptr_->bind();
+        for (std::size_t i = 0; i < runs.size(); i++)
+        {
+            this->use_texture_2d_array(runs[i].texture_2d_array_ptr);
+            this->gpu_culler_ptr_->draw_run(static_cast<unsigned int>(i));
+        }
+    }
+    else
+    {
+        static_layer_ptr->bind();
+        for (StaticLayer::Run const& run : runs)
+        {
+            this->use_texture_2d_array(run.texture_2d_array_ptr);
+            static_layer_ptr->draw_run(run);
+        }
+    }
+    this->saved_draw_calls_count_ += static_layer_ptr->get_sprites_count() -
+        static_cast<unsigned int>(runs.size());
+                                        /* One call per run instead of one   */
+                                        /* call per sprite                   */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_tilemap
+;
+; @brief
+;   Lets a tilemap follow the view (see 'Tilemap::update') and draws its
+;   resident chunks that overlap the view immediately, one 'glDrawElements'
+;   call per chunk. Like 'draw_sprite' the map is blended in the painter's
+;   order. The vertex array of the tilemap stays bound after the call.
+;
+; @params
+;   tilemap_ptr | Tilemap to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_tilemap(Tilemap* tilemap_ptr)
+{
+    GpuProfileScope profile_scope("tilemap");
+    tilemap_ptr->update(this->cull_rect_);
+
+    Texture2dArrayLayer const* layer_ptr =
+        tilemap_ptr->get_tileset().texture_2d_array_layer_ptr;
+    glm::vec2 tile_size = tilemap_ptr->get_tile_size();
+    glm::vec2 chunk_pixel_size = tilemap_ptr->get_chunk_pixel_size();
+    unsigned int drawn_tiles_count = 0;
+    unsigned int draw_calls_count = 0;
+
+    tilemap_ptr->bind();
+    this->use_texture_2d_array(layer_ptr->get_texture_2d_array());
+    glVertexAttrib4f(ATTRIB_INSTANCE_TRANSFORM, tile_size.x, 0.0f, 0.0f,
+        tile_size.y);                   /* Chunk vertices are in tile units  */
+    glVertexAttribI1i(ATTRIB_INSTANCE_Z_OFFSET, layer_ptr->get_z_offset());
+    for (Tilemap::Chunk const& chunk : tilemap_ptr->get_chunks())
+    {
+        if (!chunk.is_resident || chunk.tiles_count == 0)
+        {
+            continue;
+        }
+        glm::vec2 origin = tilemap_ptr->get_chunk_origin(chunk);
+        if (!SpriteCuller::is_visible(this->cull_rect_, origin,
+            chunk_pixel_size))
+        {
+            continue;                   /* Kept around the view only         */
+        }
+        glVertexAttrib2f(ATTRIB_INSTANCE_TRANSLATION, origin.x, origin.y);
+        glDrawElements(chunk.indices_data_ptr->mode, chunk.tiles_count * 6,
+            GL_UNSIGNED_INT, chunk.indices_data_ptr->offset);
+        FRAME_STATS_ADD_DRAW(chunk.indices_data_ptr->mode,
+            chunk.tiles_count * 6, 1);
+        drawn_tiles_count += chunk.tiles_count;
+        draw_calls_count++;
+    }
+    this->saved_draw_calls_count_ += drawn_tiles_count - draw_calls_count;
+                                        /* One call per chunk instead of one */
+                                        /* call per tile                     */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_text
+;
+; @brief
+;   Draws a string immediately with one instanced draw call. The glyphs are
+;   looked up in a glyph cache (and rasterized on the first use), placed
+;   along the pen and submitted to the batch; glyphs outside the view are
+;   culled. '\n' starts a new line. Codepoints the font does not have are
+;   drawn as '?'. Like 'draw_sprite' the text is blended in the painter's
+;   order. The unit quad vertex array stays bound after the call.
+;   If the string needs more glyphs than the cache can hold at once, or than
+;   the batch capacity, it is split into several draw calls.
+;
+; @params
+;   glyph_cache_ptr | Glyph cache (the font).
+;   text            | UTF-8 string.
+;   pos             | Top left corner of the first line (in pixels).
+;   pixel_height    | Glyph height (in pixels).
+;   color           | Color of the text. White by default.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_text(GlyphCache* glyph_cache_ptr, std::string const& text,
+    glm::vec2 const& pos, int pixel_height, glm::vec4 const& color)
+{
+    GpuProfileScope profile_scope("text");
+    this->set_tint(color);
+    glm::vec2 pen = pos;
+    std::size_t index = 0;
+    while (index < text.size())
+    {
+        unsigned int codepoint = decode_utf8(text, index);
+        if (codepoint == '\n')
+        {
+            pen.x = pos.x;
+            pen.y += static_cast<float>(
+                glyph_cache_ptr->get_line_height(pixel_height));
+            continue;
+        }
+
+        GlyphCache::Glyph glyph;
+        if (!this->find_glyph(glyph_cache_ptr, codepoint, pixel_height,
+            glyph) && !this->find_glyph(glyph_cache_ptr, '?', pixel_height,
+            glyph))
+        {
+            continue;                   /* Not even a fallback glyph         */
+        }
+        glm::vec2 glyph_pos = pen + glyph.offset;
+        pen.x += glyph.advance;
+        if (glyph.texture_2d_array_layer_ptr == nullptr)
+        {
+            continue;                   /* Blank: only moves the pen         */
+        }
+        if (!SpriteCuller::is_visible(this->cull_rect_, glyph_pos,
+            glyph.size))
+        {
+            this->culled_sprites_count_++;
+            continue;
+        }
+        this->visible_sprites_count_++;
+
+        if (this->batch_.is_full())
+        {
+            this->draw_batch();
+        }
+        this->batch_.submit(glyph.texture_2d_array_layer_ptr,
+            glm::vec4(glyph.size.x, 0.0f, 0.0f, glyph.size.y), glyph_pos,
+            glyph.txd_rect, DrawQueue::get_clip_depth(0));
+    }
+    this->draw_batch();
+    glyph_cache_ptr->release();         /* The draw is issued: the glyphs    */
+                                        /* may be evicted                    */
+    this->set_tint(glm::vec4(1.0f));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_particles
+;
+; @brief
+;   Draws all live particles of a particle system immediately with one
+;   instanced draw call. The particles are not culled one by one: they are
+;   written to the GPU as they are, and the ones outside the view are
+;   clipped. Like 'draw_sprite' the particles are blended in the painter's
+;   order (with each other, in an arbitrary order). The particle vertex
+;   array stays bound after the call.
+;
+; @params
+;   particle_system_ptr | Particle system to be drawn. Should be updated
+;                       | before (see 'ParticleSystem::update').
+;   depth               | Depth of the particles (see 'submit_sprite').
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_particles(ParticleSystem* particle_system_ptr, int depth)
+{
+    GpuProfileScope profile_scope("particles");
+    unsigned int particles_count = static_cast<unsigned int>(
+        particle_system_ptr->get_particles_count());
+    if (particles_count == 0)
+    {
+        return;
+    }
+
+    this->use_texture_2d_array(particle_system_ptr->get_texture_2d_array());
+    particle_system_ptr->draw(DrawQueue::get_clip_depth(depth));
+    this->visible_sprites_count_ += particles_count;
+    this->saved_draw_calls_count_ += particles_count - 1;
+                                        /* One call per system instead of    */
+                                        /* one call per particle             */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_particles
+;
+; @brief
+;   Advances a GPU particle system by the frame time (see 'begin'), creates
+;   its queued particles and draws the live ones immediately with one
+;   indirect draw call (see 'GpuParticleSystem::update'). The number of
+;   particles stays on the GPU, so they are not counted in the statistics.
+;   Like 'draw_sprite' the particles are blended in the painter's order. The
+;   particle vertex array and the indirect buffer stay bound after the call.
+;
+; @params
+;   particle_system_ptr | GPU particle system to be updated and drawn.
+;   depth               | Depth of the particles (see 'submit_sprite').
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_particles(GpuParticleSystem* particle_system_ptr,
+    int depth)
+{
+    GpuProfileScope profile_scope("gpu particles");
+    {
+        GpuProfileScope simulation_scope("gpu particles simulation");
+        particle_system_ptr->update(this->frame_block_.delta_time,
+            DrawQueue::get_clip_depth(depth));
+    }
+    this->shader_ptr_->use();           /* Back from the particle shader     */
+    particle_system_ptr->bind();
+    this->use_texture_2d_array(particle_system_ptr->get_texture_2d_array());
+    particle_system_ptr->draw();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func execute
+;
+; @brief
+;   Replays a command buffer immediately, in recording order. The instances
+;   of each 'COMMAND_DRAW_INSTANCES' command are copied into the batch as
+;   they are, and consecutive runs of the same texture 2d array are drawn
+;   with one instanced draw call. Static layers and tilemaps are drawn in
+;   their place (see 'draw_static_layer', 'draw_tilemap'). Like
+;   'draw_sprite' the sprites are blended in the painter's order. The tint
+;   is white again after the call.
+;   Several buffers (e.g. recorded by different threads) are replayed by
+;   calling this method for each of them, in the order they should be drawn.
+;
+; @params
+;   command_buffer  | Recorded command buffer. Must not be recorded during
+;                   | the call.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::execute(CommandBuffer const& command_buffer)
+{
+    GpuProfileScope profile_scope("commands");
+    Texture2dArray const* texture_2d_array_ptr = nullptr;
+    unsigned int instances_count = 0;
+
+    for (std::size_t i = 0; i < command_buffer.get_blocks_count(); i++)
+    {
+        std::size_t block_size = 0;
+        unsigned char const* block_ptr = command_buffer.get_block(i,
+            block_size);
+        std::size_t offset = 0;
+        while (offset < block_size)
+        {
+            CommandHeader const* header_ptr =
+                reinterpret_cast<CommandHeader const*>(block_ptr + offset);
+            offset += header_ptr->size;
+
+            switch (header_ptr->type)
+            {
+            case COMMAND_BIND_TEXTURE_2D_ARRAY:
+                texture_2d_array_ptr = reinterpret_cast<
+                    BindTexture2dArrayCommand const*>(header_ptr)->
+                    texture_2d_array_ptr;
+                break;
+            case COMMAND_DRAW_INSTANCES:
+            {
+                DrawInstancesCommand const* command_ptr = reinterpret_cast<
+                    DrawInstancesCommand const*>(header_ptr);
+                SpriteInstance const* instances_ptr =
+                    reinterpret_cast<SpriteInstance const*>(command_ptr + 1);
+                unsigned int remaining_count = command_ptr->instances_count;
+                while (remaining_count > 0)
+                {
+                    if (this->batch_.is_full())
+                    {
+                        this->draw_batch();
+                    }
+                    unsigned int submitted_count =
+                        this->batch_.submit_instances(texture_2d_array_ptr,
+                            instances_ptr, remaining_count);
+                    instances_ptr += submitted_count;
+                    remaining_count -= submitted_count;
+                }
+                instances_count += command_ptr->instances_count;
+                break;
+            }
+            case COMMAND_SET_TINT:
+                this->draw_batch();     /* The tint is a uniform             */
+                this->set_tint(reinterpret_cast<SetTintCommand const*>(
+                    header_ptr)->tint);
+                break;
+            case COMMAND_DRAW_STATIC_LAYER:
+                this->draw_batch();     /* Keep the recording order          */
+                this->draw_static_layer(reinterpret_cast<
+                    DrawStaticLayerCommand const*>(header_ptr)->
+                    static_layer_ptr);
+                break;
+            case COMMAND_DRAW_TILEMAP:
+                this->draw_batch();
+                this->draw_tilemap(reinterpret_cast<
+                    DrawTilemapCommand const*>(header_ptr)->tilemap_ptr);
+                break;
+            default:
+                LOG_WARNING("Unknown command in a command buffer.");
+                break;
+            }
+        }
+    }
+    this->draw_batch();
+    this->set_tint(glm::vec4(1.0f));
+
+    this->visible_sprites_count_ += instances_count;
+    this->culled_sprites_count_ += command_buffer.get_culled_sprites_count();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func find_glyph
+;
+; @brief
+;   Looks up a glyph for 'draw_text'. If every slot of the cache is pinned by
+;   the glyphs already submitted, they are drawn first and released, and the
+;   lookup is repeated.
+;
+; @params
+;   glyph_cache_ptr | Glyph cache.
+;   codepoint       | Unicode codepoint of the glyph.
+;   pixel_height    | Glyph height (in pixels).
+;   glyph           | Receives the placement of the glyph on success.
+;
+; @return
+;   bool    | false if the font has no such glyph.
+;
+----------------------------------------------------------------------------**/
+bool Renderer::find_glyph(GlyphCache* glyph_cache_ptr, unsigned int codepoint,
+    int pixel_height, GlyphCache::Glyph& glyph)
+{
+    enGlyphLookup lookup = glyph_cache_ptr->find(codepoint, pixel_height,
+        glyph);
+    if (lookup == GLYPH_LOOKUP_CACHE_BUSY)
+    {
+        this->draw_batch();
+        glyph_cache_ptr->release();
+        lookup = glyph_cache_ptr->find(codepoint, pixel_height, glyph);
+    }
+    return lookup == GLYPH_LOOKUP_FOUND;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_tint
+;
+; @brief
+;   Sets the color the sampled texels are multiplied by. The uniform is
+;   uploaded only if the color changes. Submitted sprites are not flushed:
+;   'flush' draws them with a white tint.
+;
+; @params
+;   tint    | The new tint.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_tint(glm::vec4 const& tint)
+{
+    if (tint != this->tint_)
+    {
+        this->shader_ptr_->set_vec4("uf_tint", tint);
+        this->tint_ = tint;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_pass_state
+;
+; @brief
+;   Sets the OpenGL state of a pass in the 'DEPTH_MODE_TWO_PASS' mode. The
+;   opaque pass writes depth and does not blend. The translucent pass blends
+;   and tests depth without writing it. Does nothing in the
+;   'DEPTH_MODE_NONE' mode.
+;
+; @params
+;   is_translucent  | Whether the translucent pass starts.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_pass_state(bool is_translucent) const
+{
+    if (this->depth_mode_ != DEPTH_MODE_TWO_PASS)
+    {
+        return;
+    }
+    GlState& gl_state = GlState::current();
+    gl_state.set_depth_test(true);
+    gl_state.set_depth_func(GL_LEQUAL); /* A translucent sprite of the same  */
+                                        /* depth is drawn over an opaque one */
+    gl_state.set_depth_mask(!is_translucent);
+    gl_state.set_blend(is_translucent);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_batch
+;
+; @brief
+;   Draws the sprites collected in the batch (one instanced draw call per run)
+;   and starts collecting the next batch. The unit quad vertex array stays
+;   bound after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::draw_batch()
+{
+    if (this->batch_.is_empty())
+    {
+        return;
+    }
+
+    this->batch_.bind();                /* Use the streamed instances        */
+    for (SpriteBatch::Run const& run : this->batch_.get_runs())
+    {
+        this->use_texture_2d_array(run.texture_2d_array_ptr);
+        this->batch_.draw_run(run);
+    }
+    this->batch_.finish();
+    this->batch_.begin();               /* Start collecting the next batch   */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_mode
+;
+; @brief
+;   Sets the way 'draw_sprite' submits draws. Draws recorded in the previous
+;   mode are flushed first.
+;
+; @params
+;   mode    | The new render mode.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_mode(enRenderMode mode)
+{
+    if (this->mode_ != mode)
+    {
+        this->flush();
+        this->mode_ = mode;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_mode
+;
+; @brief
+;   Returns the current render mode.
+;
+; @params
+;   None
+;
+; @return
+;   enRenderMode    | The current render mode.
+;
+----------------------------------------------------------------------------**/
+enRenderMode Renderer::get_mode() const
+{
+    return this->mode_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_depth_mode
+;
+; @brief
+;   Sets the way submitted sprites are split into passes. Sprites submitted
+;   in the previous mode are flushed first. 'DEPTH_MODE_TWO_PASS' requires a
+;   depth buffer.
+;
+; @params
+;   depth_mode  | The new depth mode.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::set_depth_mode(enDepthMode depth_mode)
+{
+    if (this->depth_mode_ != depth_mode)
+    {
+        this->flush();
+        this->depth_mode_ = depth_mode;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_depth_mode
+;
+; @brief
+;   Returns the current depth mode.
+;
+; @params
+;   None
+;
+; @return
+;   enDepthMode | Depth mode.
+;
+----------------------------------------------------------------------------**/
+enDepthMode Renderer::get_depth_mode() const
+{
+    return this->depth_mode_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_saved_draw_calls_count
+;
+; @brief
+;   Returns the number of draw calls saved by the multi-draw-indirect
+;   submission since the last 'begin' call, i.e. the number of recorded draws
+;   minus the number of 'glMultiDrawElementsIndirect' calls issued for them.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of saved draw calls.
+;
+----------------------------------------------------------------------------**/
+unsigned int Renderer::get_saved_draw_calls_count() const
+{
+    return this->saved_draw_calls_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_fence_wait_time
+;
+; @brief
+;   Returns the time the CPU spent waiting for the GPU to release the regions
+;   of the streaming ring buffers since the last 'begin' call.
+;
+; @params
+;   None
+;
+; @return
+;   double  | Fence wait time (in milliseconds).
+;
+----------------------------------------------------------------------------**/
+double Renderer::get_fence_wait_time() const
+{
+    return this->batch_.get_fence_wait_time() +
+        this->indirect_batch_.get_fence_wait_time();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_visible_sprites_count
+;
+; @brief
+;   Returns the number of sprites that passed the view culling since the last
+;   'begin' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of visible sprites.
+;
+----------------------------------------------------------------------------**/
+unsigned int Renderer::get_visible_sprites_count() const
+{
+    return this->visible_sprites_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_culled_sprites_count
+;
+; @brief
+;   Returns the number of sprites dropped by the view culling since the last
+;   'begin' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of culled sprites.
+;
+----------------------------------------------------------------------------**/
+unsigned int Renderer::get_culled_sprites_count() const
+{
+    return this->culled_sprites_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_cull_rect
+;
+; @brief
+;   Returns the view rectangle in world space, e.g. for recording command
+;   buffers (see 'CommandBuffer::begin'). It changes with 'set_view'.
+;
+; @params
+;   None
+;
+; @return
+;   glm::vec4 const&    | min x, min y, max x, max y (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec4 const& Renderer::get_cull_rect() const
+{
+    return this->cull_rect_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update_cull_rect
+;
+; @brief
+;   Computes the view rectangle in world space: the viewport corners are
+;   transformed by the inverse view matrix and the bounding rectangle of the
+;   result is taken.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::update_cull_rect()
+{
+    glm::mat4 inverse_view = glm::inverse(this->view_block_.view);
+    glm::vec4 const& viewport = this->view_block_.viewport;
+    glm::vec2 corners[4] =
+    {
+        { viewport.x, viewport.y },
+        { viewport.x + viewport.z, viewport.y },
+        { viewport.x, viewport.y + viewport.w },
+        { viewport.x + viewport.z, viewport.y + viewport.w }
+    };
+    glm::vec2 min_corner(0.0f);
+    glm::vec2 max_corner(0.0f);
+    for (int i = 0; i < 4; i++)
+    {
+        glm::vec2 corner = glm::vec2(inverse_view *
+            glm::vec4(corners[i], 0.0f, 1.0f));
+        min_corner = i == 0 ? corner : glm::min(min_corner, corner);
+        max_corner = i == 0 ? corner : glm::max(max_corner, corner);
+    }
+    this->cull_rect_ = glm::vec4(min_corner, max_corner);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func use_texture_2d_array
+;
+; @brief
+;   Binds the texture 2d array and passes its texture unit to the shader.
+;   In fact, this is a CPU->GPU transfer that is time consuming. Redundant
+;   binds are filtered by 'GlState' and redundant uniform uploads by 'Shader',
+;   so data is sent to the GPU only if the new values are not equal to the
+;   ones already there.
+;
+; @params
+;   texture_2d_array_ptr    | Texture 2d array to be used for rendering.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Renderer::use_texture_2d_array(
+    Texture2dArray const* texture_2d_array_ptr) const
+{
+    texture_2d_array_ptr->bind();       /* The state cache skips the bind if */
+                                        /* the texture is already bound to   */
+                                        /* its unit                          */
+    this->shader_ptr_->set_int("uf_txd_unit",
+        texture_2d_array_ptr->get_texture_unit() - GL_TEXTURE0);
+                                        /* The shader skips the upload if    */
+                                        /* the unit has not changed          */
+}
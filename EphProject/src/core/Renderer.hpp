@@ -4,12 +4,84 @@
 ; @brief
 ;   This file describes the 'Renderer' class. This class implements the
 ;   rendering logic.
+;
+;   Sprites can be drawn immediately ('draw_sprite') or in a deferred way
+;   ('begin', 'submit_sprite', 'flush'). The deferred way collects sprites into
+;   a 'DrawQueue', sorts them by depth, translucency, texture 2d array and
+;   layer, and then draws each run of sprites that share a texture 2d array
+;   with a single instanced draw call ('SpriteBatch').
+;
+;   In the 'RENDER_MODE_MULTI_DRAW_INDIRECT' mode 'draw_sprite' does not draw
+;   immediately either. The draws are collected into an 'IndirectBatch' and
+;   submitted on 'flush' with one 'glMultiDrawElementsIndirect' call per run
+;   of draws that share a texture 2d array and a vertex array.
+;
+;   The constants shared by all shader programs (projection, view, viewport,
+;   time) live in two std140 uniform blocks ('UniformBlocks.hpp'). The blocks
+;   are uploaded at most once per frame in 'begin', which also attaches the
+;   renderer's buffers to the fixed binding points, so several renderers
+;   can share them.
+;
+;   Submitted sprites can be rotated around a pivot and scaled non-uniformly.
+;   Their 2d affine transforms are computed all at once on 'flush'
+;   ('SpriteTransforms', SIMD) and read by the vertex shader per instance, so
+;   rotated sprites cost no uniform uploads and no per-vertex matrix builds.
+;
+;   Sprites that are entirely outside the view are culled. Submitted sprites
+;   are tested all at once on 'flush' ('SpriteCuller', SIMD), only the visible
+;   ones are sorted and drawn. 'draw_sprite' tests its sprite on the spot.
+;
+;   In the 'DEPTH_MODE_TWO_PASS' mode submitted sprites whose texture region
+;   is fully opaque (see 'Texture2dArrayLayer::is_opaque') are drawn first,
+;   front-to-back, with depth writes on and blending off, so the depth test
+;   rejects the hidden fragments before shading. The translucent sprites are
+;   drawn after them, back-to-front, blended and depth tested against the
+;   opaque ones. Opaque sprites with the same depth should not overlap: the
+;   depth test cannot order them.
+;
+;   Sprites that rarely change live in a 'StaticLayer'. Its instances stay on
+;   the GPU, so 'draw_static_layer' sends nothing but the changed ones and
+;   issues one instanced draw call per run. If a cull shader is set, static
+;   layers are culled on the GPU ('GpuCuller'): one compute dispatch and one
+;   indirect draw call per run, with no CPU work per sprite.
+;
+;   Tiled maps are streamed by a 'Tilemap'. 'draw_tilemap' draws each
+;   resident chunk that overlaps the view with one draw call, whatever the
+;   number of its tiles.
+;
+;   Text is drawn from a 'GlyphCache': the glyphs of a string are looked up
+;   (rasterized and uploaded only the first time), submitted as instances of
+;   the unit quad and drawn with one instanced draw call per string. The
+;   color of the text is a tint uniform multiplied by the sampled texel; it
+;   stays white for sprites.
+;
+;   'draw_text' draws immediately, like 'draw_sprite': it does not flush the
+;   submitted sprites, whatever the color of the text. So the text lands
+;   under the sprites submitted before it and drawn by the next 'flush'
+;   (always with a white tint). Call 'flush' before 'draw_text' to draw the
+;   text over them.
+;
+;   Particles are simulated by a 'ParticleSystem' (SIMD, optionally on a
+;   'WorkerPool') and 'draw_particles' draws all particles of a system with
+;   one instanced draw call. Each particle has its own color: a per-instance
+;   attribute that only the particle vertex array enables, so the shader
+;   reads its generic value (white) for everything else. Larger effects
+;   live in a 'GpuParticleSystem': simulated by compute shaders and drawn
+;   with one indirect draw call, with no particle data on the CPU.
+;
+;   The renderer itself must only be used on the thread that owns the
+;   context. Sprites can still be prepared on other threads: each one
+;   records a 'CommandBuffer' (transforms, culling and instances are
+;   computed while recording), and 'execute' replays the buffers in a fixed
+;   order, copying the instances and issuing one draw call per run.
+;
+;   Each pass ('flush', 'draw_static_layer', 'draw_tilemap', 'draw_text',
+;   'draw_particles', 'execute') is a scope of the 'GpuProfiler' that
+;   measures the frame, if any, so its GPU time can be told apart.
 ;   
 ; @date   May 2021
 ; @author Eph
 ;
-; // TODO: Implement a text rendering logic.
-;
 ----------------------------------------------------------------------------**/
 
 #pragma once
@@ -18,14 +90,54 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <chrono>
+#include <string>
+
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "DrawQueue.hpp"
+#include "GlyphCache.hpp"
+#include "GpuCuller.hpp"
+#include "IndirectBatch.hpp"
+#include "SpriteBatch.hpp"
+#include "SpriteCuller.hpp"
+#include "SpriteTransforms.hpp"
+#include "UniformBlocks.hpp"
+#include "UniformBuffer.hpp"
 
 
 
 /** @type_declarations -----------------------------------------------------**/
 
+class CommandBuffer;
+class GpuParticleSystem;
+class ParticleSystem;
 class Shader;
 class Sprite;
+class StaticLayer;
+class Tilemap;
+class Texture2dArray;
+class Texture2dArrayLayer;
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enRenderMode
+{
+    RENDER_MODE_IMMEDIATE = 0,          /* 'draw_sprite' draws immediately   */
+    RENDER_MODE_MULTI_DRAW_INDIRECT = 1,
+                                        /* 'draw_sprite' draws on 'flush'    */
+};
+
+enum enDepthMode
+{
+    DEPTH_MODE_NONE = 0,                /* Everything is blended in the      */
+                                        /* painter's order                   */
+    DEPTH_MODE_TWO_PASS = 1,            /* Opaque pass, then translucent one */
+};
 
 
 
@@ -34,11 +146,77 @@ class Sprite;
 class Renderer
 {
 public:
-    Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size);
+    Renderer(Shader* shader_ptr, glm::ivec2 const& scene_size,
+        unsigned int batch_capacity = 16384);
+    ~Renderer();
     void draw_sprite(Sprite* sprite_ptr, glm::vec2 const& pos,
-        glm::vec2 const& size) const;
+        glm::vec2 const& size);
+
+    void begin();
+    void submit_sprite(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec2 const& pos, glm::vec2 const& size,
+        glm::vec4 const& txd_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+        int depth = 0, float rotation = 0.0f,
+        glm::vec2 const& pivot = glm::vec2(0.0f));
+    void flush();
+    void draw_static_layer(StaticLayer* static_layer_ptr);
+    void draw_tilemap(Tilemap* tilemap_ptr);
+    void draw_text(GlyphCache* glyph_cache_ptr, std::string const& text,
+        glm::vec2 const& pos, int pixel_height,
+        glm::vec4 const& color = glm::vec4(1.0f));
+    void draw_particles(ParticleSystem* particle_system_ptr, int depth = 0);
+    void draw_particles(GpuParticleSystem* particle_system_ptr,
+        int depth = 0);
+    void execute(CommandBuffer const& command_buffer);
+
+    void add_shader(Shader const* shader_ptr) const;
+    void set_view(glm::mat4 const& view);
+    void set_cull_shader(Shader const* cull_shader_ptr);
+
+    void set_mode(enRenderMode mode);
+    enRenderMode get_mode() const;
+    void set_depth_mode(enDepthMode depth_mode);
+    enDepthMode get_depth_mode() const;
+    unsigned int get_saved_draw_calls_count() const;
+    double get_fence_wait_time() const;
+    unsigned int get_visible_sprites_count() const;
+    unsigned int get_culled_sprites_count() const;
+    glm::vec4 const& get_cull_rect() const;
 
 private:
     Shader* shader_ptr_;
     glm::ivec2 scene_size_;
+    DrawQueue queue_;
+    SpriteCuller culler_;
+    SpriteTransforms transforms_;
+    SpriteBatch batch_;
+    IndirectBatch indirect_batch_;
+    enRenderMode mode_;
+    enDepthMode depth_mode_;
+    unsigned int saved_draw_calls_count_;
+
+    UniformBuffer frame_uniform_buffer_;
+    UniformBuffer view_uniform_buffer_;
+    FrameUniformBlock frame_block_;
+    ViewUniformBlock view_block_;
+    bool is_view_dirty_;                /* 'view_block_' has to be uploaded  */
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point prev_frame_time_;
+
+    glm::vec4 cull_rect_;               /* The view rectangle in world space */
+                                        /* (min x, min y, max x, max y)      */
+    unsigned int visible_sprites_count_;
+    unsigned int culled_sprites_count_;
+    GpuCuller* gpu_culler_ptr_;         /* nullptr if static layers are not  */
+                                        /* culled                            */
+    glm::vec4 tint_;                    /* The value of 'uf_tint'            */
+
+    void draw_batch();
+    void set_pass_state(bool is_translucent) const;
+    void set_tint(glm::vec4 const& tint);
+    bool find_glyph(GlyphCache* glyph_cache_ptr, unsigned int codepoint,
+        int pixel_height, GlyphCache::Glyph& glyph);
+    void update_cull_rect();
+    void use_texture_2d_array(Texture2dArray const* texture_2d_array_ptr)
+        const;
 };
@@ -0,0 +1,420 @@
+/**----------------------------------------------------------------------------
+; @file RingBuffer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'RingBuffer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <chrono>
+
+#include <glad/glad.h>
+
+#include "RingBuffer.hpp"
+#include "GlState.hpp"
+#include "Log.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define REGION_ALIGNMENT 256            /* Satisfies the offset alignment of */
+                                        /* all buffer binding points         */
+#define FENCE_WAIT_TIMEOUT 1000000000   /* 1 second (in nanoseconds)         */
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func RingBuffer
+;
+; @brief
+;   Constructor. Allocates an immutable storage for all regions and maps it
+;   persistently. Falls back to a mutable storage if 'glBufferStorage' is not
+;   supported.
+;
+; @params
+;   target          | Target the buffer is bound to while it is created and
+;                   | mapped (GL_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER, etc.).
+;   region_size     | Size of a region (in bytes), i.e. the space all batches
+;                   | of a frame share. Rounded up to 256 bytes.
+;   regions_count   | Number of regions. 3 allows the CPU to write a frame
+;                   | while the GPU is reading the previous two.
+;
+----------------------------------------------------------------------------**/
+RingBuffer::RingBuffer(unsigned int target, std::size_t region_size,
+    unsigned int regions_count)
+    :id_(0), target_(target), region_size_(0), regions_count_(regions_count),
+    current_region_(0), head_(0), acquired_offset_(0), acquired_size_(0),
+    is_acquired_(false),
+    is_persistent_(GLAD_GL_VERSION_4_4 != 0),
+    mapped_ptr_(nullptr), fences_(regions_count, nullptr),
+    fence_wait_time_(0.0), fence_stalls_count_(0)
+{
+    this->region_size_ = (region_size + REGION_ALIGNMENT - 1) /
+        REGION_ALIGNMENT * REGION_ALIGNMENT;
+    GLsizeiptr storage_size = static_cast<GLsizeiptr>(this->region_size_ *
+        this->regions_count_);
+
+    glGenBuffers(1, &this->id_);
+    GlState::current().bind_buffer(this->target_, this->id_);
+    if (this->is_persistent_)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+            GL_MAP_COHERENT_BIT;        /* Writes are visible to the GPU     */
+                                        /* without explicit flushes          */
+        glBufferStorage(this->target_, storage_size, nullptr, flags);
+        this->mapped_ptr_ = static_cast<unsigned char*>(glMapBufferRange(
+            this->target_, 0, storage_size, flags));
+        if (this->mapped_ptr_ == nullptr)
+        {
+            LOG_ERROR("Unable to map the ring buffer storage.");
+        }
+    }
+    else
+    {
+        glBufferData(this->target_, storage_size, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~RingBuffer
+;
+; @brief
+;   Destructor. Deletes the fences and the buffer object. Deleting a buffer
+;   object unmaps it implicitly.
+;
+----------------------------------------------------------------------------**/
+RingBuffer::~RingBuffer()
+{
+    for (GLsync fence : this->fences_)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    glDeleteBuffers(1, &this->id_);
+    GlState::current().on_buffer_deleted(this->id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin_frame
+;
+; @brief
+;   Starts a new frame. If the previous frame wrote to the current region,
+;   the region is protected by a fence and the ring moves to the next one
+;   (see 'next_region'), which may block. Otherwise the region is kept.
+;   An acquisition that was not committed is dropped.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void RingBuffer::begin_frame()
+{
+    if (this->is_acquired_)
+    {
+        this->commit(0);
+    }
+    if (this->head_ != 0)
+    {
+        this->next_region();
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func acquire
+;
+; @brief
+;   Returns a pointer to the free space of the current frame region: as much
+;   of it as is free, up to 'max_size' bytes (see 'get_acquired_size'). If
+;   less than 'min_size' bytes are free, the frame has outgrown its region
+;   and the ring moves to the next one first (see 'next_region'). The space
+;   stays acquired until 'commit'.
+;
+; @params
+;   min_size    | The least number of bytes needed. At most the region size.
+;   max_size    | The most number of bytes that may be written.
+;
+; @return
+;   void*   | Pointer to 'get_acquired_size()' bytes of write-only memory.
+;
+----------------------------------------------------------------------------**/
+void* RingBuffer::acquire(std::size_t min_size, std::size_t max_size)
+{
+    if (min_size > this->region_size_)
+    {
+        LOG_ERROR("Unable to acquire ring buffer space larger than a region.");
+        return nullptr;
+    }
+    if (this->is_acquired_)
+    {
+        this->commit(0);
+    }
+    if (this->head_ + min_size > this->region_size_)
+    {
+        this->next_region();            /* The frame outgrew its region      */
+    }
+    this->acquired_offset_ = static_cast<std::intptr_t>(
+        this->current_region_ * this->region_size_ + this->head_);
+    this->acquired_size_ = std::min(max_size,
+        this->region_size_ - this->head_);
+    this->is_acquired_ = true;
+
+    if (this->is_persistent_)
+    {
+        return this->mapped_ptr_ + this->acquired_offset_;
+    }
+
+    GlState::current().bind_buffer(this->target_, this->id_);
+    this->mapped_ptr_ = static_cast<unsigned char*>(glMapBufferRange(
+        this->target_, this->acquired_offset_, this->acquired_size_,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+        GL_MAP_UNSYNCHRONIZED_BIT));    /* The fence already guarantees the  */
+                                        /* region is not in use              */
+    return this->mapped_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func commit
+;
+; @brief
+;   Ends the writes to the acquired space and keeps its first 'used_size'
+;   bytes: the next acquisition starts after them. Unmaps the space if it
+;   is mapped by the fallback path, since draw calls must not read a mapped
+;   buffer. Must be called before the first draw call that reads the space.
+;   Does nothing if no space is acquired.
+;
+; @params
+;   used_size   | Number of bytes written (at most 'get_acquired_size()').
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void RingBuffer::commit(std::size_t used_size)
+{
+    if (!this->is_acquired_)
+    {
+        return;
+    }
+    if (!this->is_persistent_ && this->mapped_ptr_ != nullptr)
+    {
+        GlState::current().bind_buffer(this->target_, this->id_);
+        glUnmapBuffer(this->target_);
+        this->mapped_ptr_ = nullptr;
+    }
+    used_size = std::min(used_size, this->acquired_size_);
+    this->head_ += (used_size + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT *
+        REGION_ALIGNMENT;               /* The region size is aligned too,   */
+    this->is_acquired_ = false;         /* so the head stays in the region   */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_id
+;
+; @brief
+;   Returns the buffer object id.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Buffer object id.
+;
+----------------------------------------------------------------------------**/
+unsigned int RingBuffer::get_id() const
+{
+    return this->id_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_acquired_offset
+;
+; @brief
+;   Returns the offset of the last acquired space from the beginning of the
+;   buffer. Stays valid after 'commit', until the next 'acquire'.
+;
+; @params
+;   None
+;
+; @return
+;   std::intptr_t   | Offset of the acquired space (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::intptr_t RingBuffer::get_acquired_offset() const
+{
+    return this->acquired_offset_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_acquired_size
+;
+; @brief
+;   Returns the size of the last acquired space.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | Size of the acquired space (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::size_t RingBuffer::get_acquired_size() const
+{
+    return this->acquired_size_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_region_size
+;
+; @brief
+;   Returns the size of a region.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | Size of a region (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::size_t RingBuffer::get_region_size() const
+{
+    return this->region_size_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_fence_wait_time
+;
+; @brief
+;   Returns the time the CPU spent waiting for the region fences since the
+;   last 'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   double  | Fence wait time (in milliseconds).
+;
+----------------------------------------------------------------------------**/
+double RingBuffer::get_fence_wait_time() const
+{
+    return this->fence_wait_time_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_fence_stalls_count
+;
+; @brief
+;   Returns the number of region changes that had to block since the last
+;   'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of stalls.
+;
+----------------------------------------------------------------------------**/
+unsigned int RingBuffer::get_fence_stalls_count() const
+{
+    return this->fence_stalls_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Zeroes the fence wait time and the stalls counter. Intended to be called
+;   once per frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void RingBuffer::reset_stats()
+{
+    this->fence_wait_time_ = 0.0;
+    this->fence_stalls_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func next_region
+;
+; @brief
+;   Protects the current region with a fence (all draw calls that read it
+;   are issued by now) and moves to the next region. If the GPU may still be
+;   reading that region (its fence is not signaled), the function blocks
+;   until it is done. The time spent blocked is added to the stats.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void RingBuffer::next_region()
+{
+    this->fences_[this->current_region_] = glFenceSync(
+        GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    this->current_region_ = (this->current_region_ + 1) %
+        this->regions_count_;
+    this->head_ = 0;
+    GLsync& fence = this->fences_[this->current_region_];
+    if (fence == nullptr)
+    {
+        return;
+    }
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+                                        /* Poll the fence without waiting    */
+    if (result == GL_TIMEOUT_EXPIRED)
+    {                                   /* The GPU is behind. Block until    */
+                                        /* the region is free                */
+        auto wait_start = std::chrono::steady_clock::now();
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                FENCE_WAIT_TIMEOUT);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        this->fence_wait_time_ += std::chrono::duration<double,
+            std::milli>(std::chrono::steady_clock::now() -
+                wait_start).count();
+        this->fence_stalls_count_++;
+    }
+    if (result == GL_WAIT_FAILED)
+    {
+        LOG_WARNING("Failed to wait for a ring buffer region fence.");
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
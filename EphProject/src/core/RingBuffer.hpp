@@ -0,0 +1,103 @@
+/**----------------------------------------------------------------------------
+; @file RingBuffer.hpp
+;
+; @brief
+;   This file describes the 'RingBuffer' class. This class implements a buffer
+;   object for streaming data that changes every frame (instances, indirect
+;   commands, vertices).
+;
+;   The buffer is split into N frame regions. The region of the current frame
+;   is written by the CPU while the GPU may still read the regions of the
+;   previous frames. The storage is allocated once with 'glBufferStorage'
+;   and stays mapped ('GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT'), so
+;   writing is a plain memory copy: there is no 'glBufferData' reallocation
+;   and no implicit synchronization.
+;
+;   Every batch of a frame gets a part of the frame region: 'acquire' hands
+;   out the free space after the previous batches and 'commit' moves the
+;   free space past the bytes that were written (a bump allocation). The
+;   draw calls that read a batch must be issued before the next 'acquire'.
+;   'begin_frame' protects the region of the previous frame with a single
+;   fence sync object and moves to the next region. Before the region is
+;   written again, the CPU waits for its fence, i.e. with 3 regions the CPU
+;   may run two frames ahead of the GPU. The time spent waiting is
+;   accumulated in the stats.
+;
+;   A frame that outgrows its region moves on to the next region right
+;   away (fencing the full one), which may wait. The region size should
+;   cover the batches a frame actually issues.
+;
+;   If the context does not support 'glBufferStorage' (OpenGL < 4.4), the
+;   space of each batch is mapped with 'GL_MAP_UNSYNCHRONIZED_BIT' on
+;   'acquire' and unmapped on 'commit'. A mapped buffer must not be read by
+;   draw calls, so the users commit after writing and before the draws. The
+;   fences work the same way.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+struct __GLsync;
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class RingBuffer
+{
+public:
+    RingBuffer(unsigned int target, std::size_t region_size,
+        unsigned int regions_count = 3);
+    ~RingBuffer();
+
+    void begin_frame();
+    void* acquire(std::size_t min_size, std::size_t max_size);
+    void commit(std::size_t used_size);
+
+    unsigned int get_id() const;
+    std::intptr_t get_acquired_offset() const;
+    std::size_t get_acquired_size() const;
+    std::size_t get_region_size() const;
+
+    double get_fence_wait_time() const;
+    unsigned int get_fence_stalls_count() const;
+    void reset_stats();
+
+private:
+    unsigned int id_;
+    unsigned int target_;
+    std::size_t region_size_;
+    unsigned int regions_count_;
+    unsigned int current_region_;
+    std::size_t head_;                  /* Free space of the current region  */
+                                        /* (offset in the region)            */
+    std::intptr_t acquired_offset_;     /* Of the last acquisition (from the */
+    std::size_t acquired_size_;         /* beginning of the buffer)          */
+    bool is_acquired_;                  /* Acquired and not yet committed    */
+    bool is_persistent_;
+    unsigned char* mapped_ptr_;
+    std::vector<__GLsync*> fences_;
+
+    double fence_wait_time_;
+    unsigned int fence_stalls_count_;
+
+    void next_region();
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+};
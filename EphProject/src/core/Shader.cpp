@@ -16,6 +16,9 @@
 #include <glad/glad.h>
 
 #include "Shader.hpp"
+#include "CpuProfiler.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
 #include "Log.hpp"
 
 
@@ -37,6 +40,7 @@
 Shader::Shader(const char* vertex_shader_source,
     const char* fragment_shader_source)
 {
+    CPU_PROFILE_SCOPE("Shader::Shader");
     unsigned int vertex_shader = 0;
     unsigned int fragment_shader = 0;
     int result = 0;
@@ -94,6 +98,48 @@ Shader::Shader(const char* vertex_shader_source,
 }
 
 
+/**----------------------------------------------------------------------------
+; @func Shader
+;
+; @brief
+;   Constructor. Creates (i.e. compiles and links) a compute shader program
+;   from the source code of the compute shader. The program is dispatched with
+;   'glDispatchCompute' after 'use'.
+; 
+; @params
+;   compute_shader_source   | Zero-terminated compute shader source string.
+;
+----------------------------------------------------------------------------**/
+Shader::Shader(const char* compute_shader_source)
+{
+    CPU_PROFILE_SCOPE("Shader::Shader (compute)");
+    unsigned int compute_shader = 0;
+    int result = 0;
+    const size_t log_info_len = 512;
+    char log_info[log_info_len];
+
+    compute_shader = glCreateShader(GL_COMPUTE_SHADER);
+                                        /* Create a compute shader object    */
+    glShaderSource(compute_shader, 1, &compute_shader_source, nullptr);
+    glCompileShader(compute_shader);    /* Compile the compute shader        */
+    glGetShaderiv(compute_shader, GL_COMPILE_STATUS, &result);
+    if (!result)
+    {
+        glGetShaderInfoLog(compute_shader, log_info_len, nullptr, log_info);
+        LOG_ERROR(log_info);
+    }
+    this->id_ = glCreateProgram();      /* Create a shader program object    */
+    glAttachShader(this->id_, compute_shader);
+    glLinkProgram(this->id_);           /* Link the shader program           */
+    glGetProgramiv(this->id_, GL_LINK_STATUS, &result);
+    if (!result) {
+        glGetProgramInfoLog(this->id_, log_info_len, nullptr, log_info);
+        LOG_ERROR(log_info);
+    }
+    glDeleteShader(compute_shader);
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func ~Shader
 ;
@@ -111,6 +157,7 @@ Shader::Shader(const char* vertex_shader_source,
 Shader::~Shader()
 {
     glDeleteProgram(this->id_);
+    GlState::current().on_program_deleted(this->id_);
 }
 
 
@@ -119,7 +166,7 @@ Shader::~Shader()
 ;
 ; @brief
 ;   Installs the program object specified by program as part of current
-;   rendering state.
+;   rendering state. Does nothing if it is already installed.
 ; 
 ; @params
 ;   None
@@ -130,7 +177,7 @@ Shader::~Shader()
 ----------------------------------------------------------------------------**/
 void Shader::use() const
 {
-    glUseProgram(this->id_);
+    GlState::current().use_program(this->id_);
 }
 
 
@@ -157,7 +204,8 @@ unsigned int Shader::get_id() const
 ;
 ; @brief
 ;   Specifies the value of a uniform variable of type int for the current
-;   program object.
+;   program object. The value is cached per location, so setting the same
+;   value again (e.g. a sampler unit) does not reach OpenGL.
 ;
 ; @params
 ;   name    | Uniform variable name.
@@ -169,7 +217,16 @@ unsigned int Shader::get_id() const
 ----------------------------------------------------------------------------**/
 void Shader::set_int(std::string const& name, int value) const
 {
-    glUniform1i(this->get_uniform_location(name), value);
+    int location = this->get_uniform_location(name);
+    auto it = this->int_uniform_values_.find(location);
+    if (it != this->int_uniform_values_.end() && it->second == value)
+    {
+        FRAME_STATS_ADD(redundant_state_changes, 1);
+        return;
+    }
+    glUniform1i(location, value);
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_INT);
+    this->int_uniform_values_[location] = value;
 }
 
 
@@ -191,6 +248,7 @@ void Shader::set_int(std::string const& name, int value) const
 void Shader::set_float(std::string const& name, float value) const
 {
     glUniform1f(this->get_uniform_location(name), value);
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_FLOAT);
 }
 
 
@@ -212,6 +270,7 @@ void Shader::set_float(std::string const& name, float value) const
 void Shader::set_vec2(std::string const& name, const glm::vec2& vec2) const
 {
     glUniform2f(this->get_uniform_location(name), vec2.x, vec2.y);
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_VEC2);
 }
 
 
@@ -233,6 +292,7 @@ void Shader::set_vec2(std::string const& name, const glm::vec2& vec2) const
 void Shader::set_ivec2(std::string const& name, const glm::ivec2& ivec2) const
 {
     glUniform2i(this->get_uniform_location(name), ivec2.x, ivec2.y);
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_IVEC2);
 }
 
 
@@ -256,6 +316,7 @@ void Shader::set_vec4(std::string const& name, const glm::vec4& vec4) const
     // TODO: use glUniform4f
     glUniform4f(this->get_uniform_location(name), vec4.x, vec4.y, vec4.z,
         vec4.w);
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_VEC4);
 }
 
 
@@ -278,6 +339,37 @@ void Shader::set_mat4(std::string const& name, const glm::mat4& matrix) const
 {
     glUniformMatrix4fv(this->get_uniform_location(name), 1, GL_FALSE,
         glm::value_ptr(matrix));
+    FRAME_STATS_ADD_UNIFORM(UNIFORM_TYPE_MAT4);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_uniform_block
+;
+; @brief
+;   Connects a uniform block of the program to a uniform buffer binding point
+;   (see 'UniformBlocks.hpp'). The connection is part of the program object,
+;   so it is set up once after linking.
+;
+; @params
+;   name    | Uniform block name (e.g. "ViewBlock").
+;   binding | Uniform buffer binding point ('enUniformBlockBinding').
+;
+; @return
+;   bool    | false if the program has no block with that name.
+;
+----------------------------------------------------------------------------**/
+bool Shader::bind_uniform_block(std::string const& name,
+    unsigned int binding) const
+{
+    unsigned int block_index = glGetUniformBlockIndex(this->id_,
+        name.c_str());
+    if (block_index == GL_INVALID_INDEX)
+    {
+        return false;
+    }
+    glUniformBlockBinding(this->id_, block_index, binding);
+    return true;
 }
 
 
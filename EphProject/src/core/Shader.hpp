@@ -29,6 +29,7 @@ class Shader
 public:
     Shader(const char* vertex_shader_source,
            const char* fragment_shader_source);
+    Shader(const char* compute_shader_source);
     ~Shader();
     void use() const;
     unsigned int get_id() const;
@@ -41,8 +42,12 @@ public:
     void set_vec4(std::string const& name, const glm::vec4& vec4) const;
     void set_mat4(std::string const& name, const glm::mat4& matrix) const;
 
+    bool bind_uniform_block(std::string const& name,
+        unsigned int binding) const;
+
 private:
     unsigned int id_;
     mutable std::unordered_map<std::string, int> uniform_locations_;
+    mutable std::unordered_map<int, int> int_uniform_values_;
     int get_uniform_location(std::string const& name) const;
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**----------------------------------------------------------------------------
+; @file SpatialIndex.hpp
+;
+; @brief
+;   This file describes the 'SpatialIndex' interface. A spatial index keeps
+;   the bounding rectangles of the objects of a scene and answers the question
+;   "which objects intersect this rectangle" (e.g. the view) without visiting
+;   every object. It sits between the user code and the 'Renderer': the user
+;   queries the visible set and submits only it.
+;
+;   Objects are identified by handles returned by 'insert'. A handle stays
+;   valid until 'remove' and may be reused by a later 'insert', so the user
+;   code can keep its objects in an array indexed by the handle.
+;
+;   A bounding rectangle is a 'glm::vec4': x - min x, y - min y, z - max x,
+;   w - max y (the same format as the culling rectangle of 'Renderer').
+;
+;   Implementations:
+;       'LooseQuadtree' | a fixed-depth loose quadtree over given world bounds
+;       'HashedGrid'    | a uniform grid of cells stored in a hash map, not
+;                       | limited by world bounds
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class SpatialIndex
+{
+public:
+    virtual ~SpatialIndex() {}
+
+    virtual unsigned int insert(glm::vec4 const& bounds) = 0;
+    virtual void move(unsigned int handle, glm::vec4 const& bounds) = 0;
+    virtual void remove(unsigned int handle) = 0;
+    virtual void query(glm::vec4 const& rect,
+        std::vector<unsigned int>& handles) const = 0;
+                                        /* Appends the handles of the        */
+                                        /* objects that intersect 'rect'     */
+    virtual void clear() = 0;
+
+    virtual std::size_t get_objects_count() const = 0;
+    virtual glm::vec4 const& get_bounds(unsigned int handle) const = 0;
+};
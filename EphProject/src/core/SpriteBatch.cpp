@@ -0,0 +1,419 @@
+/**----------------------------------------------------------------------------
+; @file SpriteBatch.cpp
+;
+; @brief
+;   The file implements the functionality of the 'SpriteBatch' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "SpriteBatch.hpp"
+#include "FrameStats.hpp"
+#include "IndicesData.hpp"
+#include "Texture2dArray.hpp"
+#include "Texture2dArrayLayer.hpp"
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#define FRAME_BATCHES_COUNT 2           /* Full batches a frame region holds */
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func SpriteBatch
+;
+; @brief
+;   Constructor. Builds the unit quad shared by all instances and allocates
+;   the ring buffer for the per-instance data. A frame region holds two full
+;   batches, so the passes of a frame ('flush', 'draw_text', 'execute')
+;   share it without a fence wait.
+;
+; @params
+;   capacity    | The maximum number of sprites collected before the batch
+;               | must be flushed.
+;
+----------------------------------------------------------------------------**/
+SpriteBatch::SpriteBatch(unsigned int capacity)
+    :capacity_(capacity),
+    instance_buffer_(GL_ARRAY_BUFFER,
+        capacity * sizeof(SpriteInstance) * FRAME_BATCHES_COUNT),
+    unit_quad_indices_ptr_(nullptr), instances_ptr_(nullptr),
+    instances_count_(0), acquired_capacity_(capacity)
+{
+    this->unit_quad_indices_ptr_ = this->unit_quad_.add_unit_quad();
+    this->unit_quad_.build();           /* Send the unit quad to the GPU     */
+
+    this->runs_.reserve(this->capacity_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~SpriteBatch
+;
+; @brief
+;   Destructor. Deletes the unit quad indices data.
+;
+----------------------------------------------------------------------------**/
+SpriteBatch::~SpriteBatch()
+{
+    delete this->unit_quad_indices_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin_frame
+;
+; @brief
+;   Starts a new frame: discards all collected submissions and runs, with
+;   the space acquired for them, and moves the ring buffer to the region of
+;   the frame (see 'RingBuffer::begin_frame').
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::begin_frame()
+{
+    this->begin();
+    this->instances_ptr_ = nullptr;
+    this->acquired_capacity_ = this->capacity_;
+    this->instance_buffer_.begin_frame();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func begin
+;
+; @brief
+;   Discards all collected submissions and runs. Acquired ring buffer space
+;   is kept and reused, so a batch reused every frame does not allocate.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::begin()
+{
+    this->instances_count_ = 0;
+    this->runs_.clear();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func submit
+;
+; @brief
+;   Adds a sprite to the batch. Starts a new run if the texture 2d array of the
+;   sprite differs from the texture 2d array of the previous submission.
+;   The caller must check 'is_full' before the call.
+;
+; @params
+;   texture_2d_array_layer_ptr  | Texture layer the sprite is taken from.
+;   transform                   | xy - the unit quad x axis, zw - its y axis
+;                               | (see 'SpriteTransforms').
+;   translation                 | The unit quad origin (in pixels).
+;   txd_rect                    | xy - offset, zw - size of the sprite region
+;                               | on the layer (in normalized texture
+;                               | coordinates).
+;   depth                       | Clip space z of the sprite.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::submit(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec4 const& transform, glm::vec2 const& translation,
+    glm::vec4 const& txd_rect, float depth)
+{
+    Texture2dArray const* texture_2d_array_ptr =
+        texture_2d_array_layer_ptr->get_texture_2d_array();
+
+    if (this->instances_ptr_ == nullptr)
+    {                                   /* Acquire space on the first        */
+                                        /* submission after a flush          */
+        this->acquire();
+    }
+
+    if (this->runs_.empty() || this->runs_.back().texture_2d_array_ptr !=
+        texture_2d_array_ptr)
+    {                                   /* Start a new run if the texture 2d */
+                                        /* array has changed                 */
+        this->runs_.push_back({ texture_2d_array_ptr,
+            this->instances_count_, 0 });
+    }
+    this->runs_.back().instances_count++;
+
+    SpriteInstance& instance = this->instances_ptr_[this->instances_count_++];
+    instance.transform = transform;     /* Write straight into the mapped    */
+    instance.translation = translation; /* memory                            */
+    instance.txd_rect = txd_rect;
+    instance.z_offset = texture_2d_array_layer_ptr->get_z_offset();
+    instance.depth = depth;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func submit_instances
+;
+; @brief
+;   Adds ready-made instances to the batch (see 'CommandBuffer'), as many as
+;   fit into the rest of its capacity (see 'is_full'), with a single copy.
+;   Continues the last run if its texture 2d array is the same.
+;
+; @params
+;   texture_2d_array_ptr    | Texture 2d array the instances are taken from.
+;   instances_ptr           | The instances.
+;   instances_count         | Number of the instances.
+;
+; @return
+;   unsigned int    | Number of the instances added. Less than
+;                   | 'instances_count' if the batch is full.
+;
+----------------------------------------------------------------------------**/
+unsigned int SpriteBatch::submit_instances(
+    Texture2dArray const* texture_2d_array_ptr,
+    SpriteInstance const* instances_ptr, unsigned int instances_count)
+{
+    if (instances_count == 0)
+    {
+        return 0;
+    }
+    if (this->instances_ptr_ == nullptr)
+    {
+        this->acquire();
+    }
+    instances_count = std::min(instances_count,
+        this->acquired_capacity_ - this->instances_count_);
+    if (instances_count == 0)
+    {
+        return 0;
+    }
+    if (this->runs_.empty() || this->runs_.back().texture_2d_array_ptr !=
+        texture_2d_array_ptr)
+    {
+        this->runs_.push_back({ texture_2d_array_ptr,
+            this->instances_count_, 0 });
+    }
+    this->runs_.back().instances_count += instances_count;
+
+    std::memcpy(this->instances_ptr_ + this->instances_count_, instances_ptr,
+        instances_count * sizeof(SpriteInstance));
+    this->instances_count_ += instances_count;
+    return instances_count;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Commits the submitted instances to the ring buffer (see
+;   'RingBuffer::commit') and binds the unit quad vertex array with them
+;   attached to it as the per-instance buffer. No sprites can be submitted
+;   until 'finish'. The vertex array stays bound after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::bind()
+{
+    this->instance_buffer_.commit(this->instances_count_ *
+        sizeof(SpriteInstance));
+    this->unit_quad_.bind_instance_buffer(this->instance_buffer_.get_id(),
+        this->instance_buffer_.get_acquired_offset());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_run
+;
+; @brief
+;   Draws all instances of the run with a single call. The texture 2d array of
+;   the run must be bound and 'bind' must be called before.
+;
+; @params
+;   run | The run to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::draw_run(Run const& run) const
+{
+    glDrawElementsInstancedBaseInstance(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count, GL_UNSIGNED_INT,
+        this->unit_quad_indices_ptr_->offset, run.instances_count,
+        run.first_instance);
+    FRAME_STATS_ADD_DRAW(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count, run.instances_count);
+    FRAME_STATS_ADD(buffer_bytes, run.instances_count *
+        sizeof(SpriteInstance));        /* Written to the mapped ring buffer */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func finish
+;
+; @brief
+;   Ends the batch. Must be called after all runs are drawn. The next
+;   submission acquires the space after the drawn instances. The instances
+;   are fenced with the rest of the frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::finish()
+{
+    this->instances_ptr_ = nullptr;
+    this->acquired_capacity_ = this->capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_full
+;
+; @brief
+;   Checks whether the batch has reached its capacity, or the free space of
+;   the frame region it has acquired.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if no more sprites can be submitted.
+;
+----------------------------------------------------------------------------**/
+bool SpriteBatch::is_full() const
+{
+    return this->instances_count_ >= this->acquired_capacity_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_empty
+;
+; @brief
+;   Checks whether there are no submitted sprites in the batch.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if nothing was submitted since the last 'begin' call.
+;
+----------------------------------------------------------------------------**/
+bool SpriteBatch::is_empty() const
+{
+    return this->instances_count_ == 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_runs
+;
+; @brief
+;   Returns the runs of the submitted sprites.
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<Run> const& | Runs in the order of submission.
+;
+----------------------------------------------------------------------------**/
+std::vector<SpriteBatch::Run> const& SpriteBatch::get_runs() const
+{
+    return this->runs_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_fence_wait_time
+;
+; @brief
+;   Returns the time spent waiting for the ring buffer fences since the last
+;   'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   double  | Fence wait time (in milliseconds).
+;
+----------------------------------------------------------------------------**/
+double SpriteBatch::get_fence_wait_time() const
+{
+    return this->instance_buffer_.get_fence_wait_time();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the fence wait stats of the ring buffer.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::reset_stats()
+{
+    this->instance_buffer_.reset_stats();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func acquire
+;
+; @brief
+;   Acquires the free space of the frame region for up to 'capacity'
+;   instances (at least one) and limits the batch to what it holds.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteBatch::acquire()
+{
+    this->instances_ptr_ = static_cast<SpriteInstance*>(
+        this->instance_buffer_.acquire(sizeof(SpriteInstance),
+            this->capacity_ * sizeof(SpriteInstance)));
+    this->acquired_capacity_ = static_cast<unsigned int>(
+        this->instance_buffer_.get_acquired_size() / sizeof(SpriteInstance));
+}
@@ -0,0 +1,98 @@
+/**----------------------------------------------------------------------------
+; @file SpriteBatch.hpp
+;
+; @brief
+;   This file describes the 'SpriteBatch' class. This class collects sprite
+;   submissions into a per-instance buffer and draws them as instances of a
+;   shared unit quad.
+;
+;   Submitted sprites are split into runs. A run is a sequence of consecutive
+;   submissions that use the same texture 2d array. Each run is drawn with a
+;   single 'glDrawElementsInstancedBaseInstance' call.
+;
+;   Instances are written straight into a persistently mapped 'RingBuffer'.
+;   All batches of a frame share one region of it: the free space of the
+;   region is acquired on the first submission after a flush and committed
+;   (unmapped, if it is mapped by the fallback path) by 'bind' before the
+;   runs are drawn. A batch holds up to the capacity or up to the free
+;   space, whichever is less. The region is fenced once per frame, when
+;   'begin_frame' starts the next one.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "RingBuffer.hpp"
+#include "SpriteInstance.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Texture2dArray;
+class Texture2dArrayLayer;
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class SpriteBatch
+{
+public:
+    struct Run
+    {
+        Texture2dArray const* texture_2d_array_ptr;
+        unsigned int first_instance;
+        unsigned int instances_count;
+    };
+
+    SpriteBatch(unsigned int capacity);
+    ~SpriteBatch();
+
+    void begin_frame();
+    void begin();
+    void submit(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec4 const& transform, glm::vec2 const& translation,
+        glm::vec4 const& txd_rect, float depth);
+    unsigned int submit_instances(Texture2dArray const* texture_2d_array_ptr,
+        SpriteInstance const* instances_ptr, unsigned int instances_count);
+    void bind();
+    void draw_run(Run const& run) const;
+    void finish();
+
+    bool is_full() const;
+    bool is_empty() const;
+    std::vector<Run> const& get_runs() const;
+    double get_fence_wait_time() const;
+    void reset_stats();
+
+private:
+    unsigned int capacity_;
+    RingBuffer instance_buffer_;
+    VertexArray unit_quad_;
+    IndicesData* unit_quad_indices_ptr_;
+
+    SpriteInstance* instances_ptr_;     /* Mapped memory of the acquired     */
+                                        /* region. nullptr if no region is   */
+                                        /* acquired                          */
+    unsigned int instances_count_;
+    unsigned int acquired_capacity_;    /* Instances that fit into the       */
+                                        /* acquired space                    */
+    std::vector<Run> runs_;
+
+    void acquire();
+};
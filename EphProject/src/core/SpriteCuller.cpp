@@ -0,0 +1,266 @@
+/**----------------------------------------------------------------------------
+; @file SpriteCuller.cpp
+;
+; @brief
+;   The file implements the functionality of the 'SpriteCuller' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#if defined(__AVX2__)
+    #define CULL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CULL_SSE2
+#endif
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#if defined(CULL_AVX2)
+    #include <immintrin.h>
+#elif defined(CULL_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#include "SpriteCuller.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func SpriteCuller
+;
+; @brief
+;   Constructor.
+;
+----------------------------------------------------------------------------**/
+SpriteCuller::SpriteCuller()
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all sprites. The memory is kept for the next frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteCuller::clear()
+{
+    this->min_x_.clear();
+    this->min_y_.clear();
+    this->max_x_.clear();
+    this->max_y_.clear();
+    this->visible_indices_.clear();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func push
+;
+; @brief
+;   Adds the bounds of a sprite. Its index is the number of sprites pushed
+;   before it.
+;
+; @params
+;   pos     | Sprite position (top left corner, in pixels).
+;   size    | Sprite size (in pixels).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteCuller::push(glm::vec2 const& pos, glm::vec2 const& size)
+{
+    this->min_x_.push_back(pos.x);
+    this->min_y_.push_back(pos.y);
+    this->max_x_.push_back(pos.x + size.x);
+    this->max_y_.push_back(pos.y + size.y);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func push
+;
+; @brief
+;   Adds the bounds of a sprite given as a rectangle (e.g. the bounds of a
+;   rotated sprite, see 'SpriteTransforms::get_bounds').
+;
+; @params
+;   bounds  | min x, min y, max x, max y (in pixels).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteCuller::push(glm::vec4 const& bounds)
+{
+    this->min_x_.push_back(bounds.x);
+    this->min_y_.push_back(bounds.y);
+    this->max_x_.push_back(bounds.z);
+    this->max_y_.push_back(bounds.w);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func cull
+;
+; @brief
+;   Tests all pushed sprites against the view rectangle and stores the indices
+;   of the visible ones (in ascending order) in the visible list.
+;   The indices are written without branches: each lane writes its index to
+;   the next free slot, and the slot is kept only if the lane passed the test.
+;
+; @params
+;   view_rect   | x - min x, y - min y, z - max x, w - max y (in pixels).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteCuller::cull(glm::vec4 const& view_rect)
+{
+    std::size_t sprites_count = this->min_x_.size();
+    std::size_t i = 0;
+    std::size_t visible_count = 0;
+
+    this->visible_indices_.resize(sprites_count);
+    unsigned int* out_ptr = this->visible_indices_.data();
+
+#if defined(CULL_AVX2)
+    __m256 view_min_x = _mm256_set1_ps(view_rect.x);
+    __m256 view_min_y = _mm256_set1_ps(view_rect.y);
+    __m256 view_max_x = _mm256_set1_ps(view_rect.z);
+    __m256 view_max_y = _mm256_set1_ps(view_rect.w);
+    for (; i + 8 <= sprites_count; i += 8)
+    {
+        __m256 inside = _mm256_and_ps(
+            _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(&this->max_x_[i]), view_min_x,
+                    _CMP_GE_OQ),
+                _mm256_cmp_ps(_mm256_loadu_ps(&this->min_x_[i]), view_max_x,
+                    _CMP_LE_OQ)),
+            _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(&this->max_y_[i]), view_min_y,
+                    _CMP_GE_OQ),
+                _mm256_cmp_ps(_mm256_loadu_ps(&this->min_y_[i]), view_max_y,
+                    _CMP_LE_OQ)));
+        int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; lane++)
+        {
+            out_ptr[visible_count] = static_cast<unsigned int>(i + lane);
+            visible_count += (mask >> lane) & 1;
+        }
+    }
+#elif defined(CULL_SSE2)
+    __m128 view_min_x = _mm_set1_ps(view_rect.x);
+    __m128 view_min_y = _mm_set1_ps(view_rect.y);
+    __m128 view_max_x = _mm_set1_ps(view_rect.z);
+    __m128 view_max_y = _mm_set1_ps(view_rect.w);
+    for (; i + 4 <= sprites_count; i += 4)
+    {
+        __m128 inside = _mm_and_ps(
+            _mm_and_ps(
+                _mm_cmpge_ps(_mm_loadu_ps(&this->max_x_[i]), view_min_x),
+                _mm_cmple_ps(_mm_loadu_ps(&this->min_x_[i]), view_max_x)),
+            _mm_and_ps(
+                _mm_cmpge_ps(_mm_loadu_ps(&this->max_y_[i]), view_min_y),
+                _mm_cmple_ps(_mm_loadu_ps(&this->min_y_[i]), view_max_y)));
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            out_ptr[visible_count] = static_cast<unsigned int>(i + lane);
+            visible_count += (mask >> lane) & 1;
+        }
+    }
+#endif
+
+    for (; i < sprites_count; i++)      /* The tail (or everything if there  */
+    {                                   /* is no SIMD kernel)                */
+        out_ptr[visible_count] = static_cast<unsigned int>(i);
+        visible_count += this->max_x_[i] >= view_rect.x &&
+            this->min_x_[i] <= view_rect.z &&
+            this->max_y_[i] >= view_rect.y &&
+            this->min_y_[i] <= view_rect.w;
+    }
+
+    this->visible_indices_.resize(visible_count);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_sprites_count
+;
+; @brief
+;   Returns the number of sprites pushed since the last 'clear'.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of sprites.
+;
+----------------------------------------------------------------------------**/
+std::size_t SpriteCuller::get_sprites_count() const
+{
+    return this->min_x_.size();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_visible_indices
+;
+; @brief
+;   Returns the indices of the sprites that passed the last 'cull' call.
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<unsigned int> const&    | Indices in ascending order.
+;
+----------------------------------------------------------------------------**/
+std::vector<unsigned int> const& SpriteCuller::get_visible_indices() const
+{
+    return this->visible_indices_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_visible
+;
+; @brief
+;   Tests a single sprite against the view rectangle. Used where sprites are
+;   drawn one by one and there is nothing to vectorize.
+;
+; @params
+;   view_rect   | x - min x, y - min y, z - max x, w - max y (in pixels).
+;   pos         | Sprite position (top left corner, in pixels).
+;   size        | Sprite size (in pixels).
+;
+; @return
+;   bool    | true if the sprite intersects the view rectangle.
+;
+----------------------------------------------------------------------------**/
+bool SpriteCuller::is_visible(glm::vec4 const& view_rect,
+    glm::vec2 const& pos, glm::vec2 const& size)
+{
+    return pos.x + size.x >= view_rect.x && pos.x <= view_rect.z &&
+        pos.y + size.y >= view_rect.y && pos.y <= view_rect.w;
+}
@@ -0,0 +1,61 @@
+/**----------------------------------------------------------------------------
+; @file SpriteCuller.hpp
+;
+; @brief
+;   This file describes the 'SpriteCuller' class. This class tests the bounds
+;   of submitted sprites against the view rectangle and builds a compacted
+;   list of the indices of the sprites that are at least partially visible.
+;
+;   The bounds are stored as a structure of arrays (min x, min y, max x, max y
+;   in separate float arrays), so the test is done for 8 sprites at once with
+;   AVX2 or for 4 sprites at once with SSE2. The kernel is selected at compile
+;   time: AVX2 if the compiler targets it ('/arch:AVX2', '-mavx2'), otherwise
+;   SSE2 (always available on x64), otherwise plain C++.
+;
+;   A sprite is visible if its rectangle intersects the view rectangle. A
+;   sprite that only touches an edge of the view counts as visible.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class SpriteCuller
+{
+public:
+    SpriteCuller();
+
+    void clear();
+    void push(glm::vec2 const& pos, glm::vec2 const& size);
+    void push(glm::vec4 const& bounds);
+    void cull(glm::vec4 const& view_rect);
+
+    std::size_t get_sprites_count() const;
+    std::vector<unsigned int> const& get_visible_indices() const;
+
+    static bool is_visible(glm::vec4 const& view_rect, glm::vec2 const& pos,
+        glm::vec2 const& size);
+
+private:
+    std::vector<float> min_x_;
+    std::vector<float> min_y_;
+    std::vector<float> max_x_;
+    std::vector<float> max_y_;
+    std::vector<unsigned int> visible_indices_;
+};
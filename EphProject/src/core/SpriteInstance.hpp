@@ -0,0 +1,59 @@
+/**----------------------------------------------------------------------------
+; @file SpriteInstance.hpp
+;
+; @brief
+;   This file describes the 'SpriteInstance' structure. An object of this
+;   structure is a single element of the per-instance vertex buffer used by the
+;   instanced rendering paths. Its memory layout is mirrored by the vertex
+;   attributes 'ATTRIB_INSTANCE_TRANSFORM', 'ATTRIB_INSTANCE_TRANSLATION',
+;   'ATTRIB_INSTANCE_TXD_RECT', 'ATTRIB_INSTANCE_Z_OFFSET' and
+;   'ATTRIB_INSTANCE_DEPTH' (see 'VertexArray::bind_instance_buffer'), and by
+;   the 'SpriteInstance' struct of the cull shader.
+;
+;   The placement of a sprite is a 2d affine transform of the unit quad (see
+;   'SpriteTransforms'). An axis-aligned sprite has the transform
+;   (size.x, 0, 0, size.y) and the translation equal to its position.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct SpriteInstance
+{
+    glm::vec4 transform;                /* xy - the unit quad x axis, zw -   */
+                                        /* its y axis (in pixels)            */
+    glm::vec2 translation;              /* The unit quad origin (in pixels)  */
+    glm::vec4 txd_rect;                 /* xy - offset, zw - size (in        */
+                                        /* normalized texture coordinates)   */
+    int z_offset;                       /* Texture 2d array layer number     */
+    float depth;                        /* Clip space z (see                 */
+                                        /* 'DrawQueue::get_clip_depth')      */
+};
+
+
+
+/** @static_asserts --------------------------------------------------------**/
+
+static_assert(offsetof(SpriteInstance, transform) == 0 &&
+    offsetof(SpriteInstance, translation) == 16 &&
+    offsetof(SpriteInstance, txd_rect) == 24 &&
+    offsetof(SpriteInstance, z_offset) == 40 &&
+    offsetof(SpriteInstance, depth) == 44 &&
+    sizeof(SpriteInstance) == 48,
+    "'SpriteInstance' does not match the std430 layout of the cull shader");
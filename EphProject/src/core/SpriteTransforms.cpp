@@ -0,0 +1,480 @@
+/**----------------------------------------------------------------------------
+; @file SpriteTransforms.cpp
+;
+; @brief
+;   The file implements the functionality of the 'SpriteTransforms' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#if defined(__AVX2__)
+    #define TRANSFORMS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TRANSFORMS_SSE2
+#endif
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(TRANSFORMS_AVX2)
+    #include <immintrin.h>
+#elif defined(TRANSFORMS_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#include "SpriteTransforms.hpp"
+
+
+
+/** @data_definitions ------------------------------------------------------**/
+
+#if defined(TRANSFORMS_AVX2) || defined(TRANSFORMS_SSE2)
+
+static const float TWO_OVER_PI = 0.636619772367581343f;
+static const float HALF_PI_1 = 1.5703125f;
+                                        /* pi / 2 split into three parts, so */
+static const float HALF_PI_2 = 4.837512969970703125e-4f;
+                                        /* that 'x - q * pi / 2' is exact    */
+static const float HALF_PI_3 = 7.54978995489188216e-8f;
+                                        /* enough for |x| up to ~1e4         */
+static const float SIN_C1 = -1.6666654611e-1f;
+static const float SIN_C2 = 8.3321608736e-3f;
+static const float SIN_C3 = -1.9515295891e-4f;
+static const float COS_C1 = 4.166664568298827e-2f;
+static const float COS_C2 = -1.388731625493765e-3f;
+static const float COS_C3 = 2.443315711809948e-5f;
+                                        /* Minimax polynomials on            */
+                                        /* [-pi / 4, pi / 4]                 */
+
+#endif
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+#if defined(TRANSFORMS_AVX2)
+
+/**----------------------------------------------------------------------------
+; @func sincos_avx2
+;
+; @brief
+;   Computes the sine and cosine of 8 angles. The angle is reduced to
+;   [-pi / 4, pi / 4] by subtracting the nearest multiple of pi / 2, then the
+;   polynomials are evaluated and swapped / negated by the quadrant.
+;
+; @params
+;   x           | Angles (in radians).
+;   sin_ptr     | Output: sines.
+;   cos_ptr     | Output: cosines.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void sincos_avx2(__m256 x, __m256* sin_ptr, __m256* cos_ptr)
+{
+    __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x,
+        _mm256_set1_ps(TWO_OVER_PI)));  /* Rounds to the nearest             */
+    __m256 q = _mm256_cvtepi32_ps(quadrant);
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(HALF_PI_1)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(HALF_PI_2)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(HALF_PI_3)));
+    __m256 r2 = _mm256_mul_ps(r, r);
+
+    __m256 s = _mm256_add_ps(_mm256_set1_ps(SIN_C2), _mm256_mul_ps(r2,
+        _mm256_set1_ps(SIN_C3)));
+    s = _mm256_add_ps(_mm256_set1_ps(SIN_C1), _mm256_mul_ps(r2, s));
+    s = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r2, r), s));
+    __m256 c = _mm256_add_ps(_mm256_set1_ps(COS_C2), _mm256_mul_ps(r2,
+        _mm256_set1_ps(COS_C3)));
+    c = _mm256_add_ps(_mm256_set1_ps(COS_C1), _mm256_mul_ps(r2, c));
+    c = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(
+        r2, _mm256_set1_ps(0.5f))), _mm256_mul_ps(_mm256_mul_ps(r2, r2), c));
+
+    __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(
+        quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+    __m256 sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(
+        quadrant, _mm256_set1_epi32(2)), 30));
+    __m256 cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(
+        _mm256_add_epi32(quadrant, _mm256_set1_epi32(1)),
+        _mm256_set1_epi32(2)), 30));
+    *sin_ptr = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sin_sign);
+    *cos_ptr = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cos_sign);
+}
+
+#elif defined(TRANSFORMS_SSE2)
+
+/**----------------------------------------------------------------------------
+; @func sincos_sse2
+;
+; @brief
+;   Computes the sine and cosine of 4 angles. See 'sincos_avx2'.
+;
+; @params
+;   x           | Angles (in radians).
+;   sin_ptr     | Output: sines.
+;   cos_ptr     | Output: cosines.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+static void sincos_sse2(__m128 x, __m128* sin_ptr, __m128* cos_ptr)
+{
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x,
+        _mm_set1_ps(TWO_OVER_PI)));     /* Rounds to the nearest             */
+    __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_2)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_3)));
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_add_ps(_mm_set1_ps(SIN_C2), _mm_mul_ps(r2,
+        _mm_set1_ps(SIN_C3)));
+    s = _mm_add_ps(_mm_set1_ps(SIN_C1), _mm_mul_ps(r2, s));
+    s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r2, r), s));
+    __m128 c = _mm_add_ps(_mm_set1_ps(COS_C2), _mm_mul_ps(r2,
+        _mm_set1_ps(COS_C3)));
+    c = _mm_add_ps(_mm_set1_ps(COS_C1), _mm_mul_ps(r2, c));
+    c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2,
+        _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant,
+        _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(
+        quadrant, _mm_set1_epi32(2)), 30));
+    __m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(
+        _mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    *sin_ptr = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c),
+        _mm_andnot_ps(swap, s)), sin_sign);
+    *cos_ptr = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s),
+        _mm_andnot_ps(swap, c)), cos_sign);
+}
+
+#endif
+
+
+/**----------------------------------------------------------------------------
+; @func SpriteTransforms
+;
+; @brief
+;   Constructor.
+;
+----------------------------------------------------------------------------**/
+SpriteTransforms::SpriteTransforms()
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all sprites. The memory is kept for the next frame.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteTransforms::clear()
+{
+    this->pos_x_.clear();
+    this->pos_y_.clear();
+    this->size_x_.clear();
+    this->size_y_.clear();
+    this->rotation_.clear();
+    this->pivot_x_.clear();
+    this->pivot_y_.clear();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func push
+;
+; @brief
+;   Adds the placement of a sprite. Its index is the number of sprites pushed
+;   before it since the last 'clear'. Nothing is computed until 'compute'.
+;
+; @params
+;   pos         | Position of the pivot of the sprite (in pixels).
+;   size        | Sprite size (in pixels). Different x and y give a
+;               | non-uniform scale.
+;   rotation    | Rotation around the pivot (in radians, clockwise on the
+;               | screen since the y axis points down).
+;   pivot       | The point the sprite is placed and rotated by, relative to
+;               | its size: (0, 0) - top left corner, (0.5, 0.5) - center.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteTransforms::push(glm::vec2 const& pos, glm::vec2 const& size,
+    float rotation, glm::vec2 const& pivot)
+{
+    this->pos_x_.push_back(pos.x);
+    this->pos_y_.push_back(pos.y);
+    this->size_x_.push_back(size.x);
+    this->size_y_.push_back(size.y);
+    this->rotation_.push_back(rotation);
+    this->pivot_x_.push_back(pivot.x);
+    this->pivot_y_.push_back(pivot.y);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func compute
+;
+; @brief
+;   Computes the transforms and the bounds of all pushed sprites.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteTransforms::compute()
+{
+    std::size_t sprites_count = this->pos_x_.size();
+    std::size_t i = 0;
+
+    this->axis_x_x_.resize(sprites_count);
+    this->axis_x_y_.resize(sprites_count);
+    this->axis_y_x_.resize(sprites_count);
+    this->axis_y_y_.resize(sprites_count);
+    this->translation_x_.resize(sprites_count);
+    this->translation_y_.resize(sprites_count);
+    this->min_x_.resize(sprites_count);
+    this->min_y_.resize(sprites_count);
+    this->max_x_.resize(sprites_count);
+    this->max_y_.resize(sprites_count);
+
+#if defined(TRANSFORMS_AVX2)
+    __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= sprites_count; i += 8)
+    {
+        __m256 s;
+        __m256 c;
+        sincos_avx2(_mm256_loadu_ps(&this->rotation_[i]), &s, &c);
+        __m256 size_x = _mm256_loadu_ps(&this->size_x_[i]);
+        __m256 size_y = _mm256_loadu_ps(&this->size_y_[i]);
+        __m256 pivot_x = _mm256_loadu_ps(&this->pivot_x_[i]);
+        __m256 pivot_y = _mm256_loadu_ps(&this->pivot_y_[i]);
+
+        __m256 a = _mm256_mul_ps(c, size_x);
+        __m256 b = _mm256_mul_ps(s, size_x);
+        __m256 cc = _mm256_sub_ps(zero, _mm256_mul_ps(s, size_y));
+        __m256 d = _mm256_mul_ps(c, size_y);
+        __m256 tx = _mm256_sub_ps(_mm256_loadu_ps(&this->pos_x_[i]),
+            _mm256_add_ps(_mm256_mul_ps(a, pivot_x),
+                _mm256_mul_ps(cc, pivot_y)));
+        __m256 ty = _mm256_sub_ps(_mm256_loadu_ps(&this->pos_y_[i]),
+            _mm256_add_ps(_mm256_mul_ps(b, pivot_x),
+                _mm256_mul_ps(d, pivot_y)));
+
+        _mm256_storeu_ps(&this->axis_x_x_[i], a);
+        _mm256_storeu_ps(&this->axis_x_y_[i], b);
+        _mm256_storeu_ps(&this->axis_y_x_[i], cc);
+        _mm256_storeu_ps(&this->axis_y_y_[i], d);
+        _mm256_storeu_ps(&this->translation_x_[i], tx);
+        _mm256_storeu_ps(&this->translation_y_[i], ty);
+        _mm256_storeu_ps(&this->min_x_[i], _mm256_add_ps(tx, _mm256_add_ps(
+            _mm256_min_ps(a, zero), _mm256_min_ps(cc, zero))));
+        _mm256_storeu_ps(&this->min_y_[i], _mm256_add_ps(ty, _mm256_add_ps(
+            _mm256_min_ps(b, zero), _mm256_min_ps(d, zero))));
+        _mm256_storeu_ps(&this->max_x_[i], _mm256_add_ps(tx, _mm256_add_ps(
+            _mm256_max_ps(a, zero), _mm256_max_ps(cc, zero))));
+        _mm256_storeu_ps(&this->max_y_[i], _mm256_add_ps(ty, _mm256_add_ps(
+            _mm256_max_ps(b, zero), _mm256_max_ps(d, zero))));
+    }
+#elif defined(TRANSFORMS_SSE2)
+    __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= sprites_count; i += 4)
+    {
+        __m128 s;
+        __m128 c;
+        sincos_sse2(_mm_loadu_ps(&this->rotation_[i]), &s, &c);
+        __m128 size_x = _mm_loadu_ps(&this->size_x_[i]);
+        __m128 size_y = _mm_loadu_ps(&this->size_y_[i]);
+        __m128 pivot_x = _mm_loadu_ps(&this->pivot_x_[i]);
+        __m128 pivot_y = _mm_loadu_ps(&this->pivot_y_[i]);
+
+        __m128 a = _mm_mul_ps(c, size_x);
+        __m128 b = _mm_mul_ps(s, size_x);
+        __m128 cc = _mm_sub_ps(zero, _mm_mul_ps(s, size_y));
+        __m128 d = _mm_mul_ps(c, size_y);
+        __m128 tx = _mm_sub_ps(_mm_loadu_ps(&this->pos_x_[i]),
+            _mm_add_ps(_mm_mul_ps(a, pivot_x), _mm_mul_ps(cc, pivot_y)));
+        __m128 ty = _mm_sub_ps(_mm_loadu_ps(&this->pos_y_[i]),
+            _mm_add_ps(_mm_mul_ps(b, pivot_x), _mm_mul_ps(d, pivot_y)));
+
+        _mm_storeu_ps(&this->axis_x_x_[i], a);
+        _mm_storeu_ps(&this->axis_x_y_[i], b);
+        _mm_storeu_ps(&this->axis_y_x_[i], cc);
+        _mm_storeu_ps(&this->axis_y_y_[i], d);
+        _mm_storeu_ps(&this->translation_x_[i], tx);
+        _mm_storeu_ps(&this->translation_y_[i], ty);
+        _mm_storeu_ps(&this->min_x_[i], _mm_add_ps(tx, _mm_add_ps(
+            _mm_min_ps(a, zero), _mm_min_ps(cc, zero))));
+        _mm_storeu_ps(&this->min_y_[i], _mm_add_ps(ty, _mm_add_ps(
+            _mm_min_ps(b, zero), _mm_min_ps(d, zero))));
+        _mm_storeu_ps(&this->max_x_[i], _mm_add_ps(tx, _mm_add_ps(
+            _mm_max_ps(a, zero), _mm_max_ps(cc, zero))));
+        _mm_storeu_ps(&this->max_y_[i], _mm_add_ps(ty, _mm_add_ps(
+            _mm_max_ps(b, zero), _mm_max_ps(d, zero))));
+    }
+#endif
+
+    for (; i < sprites_count; i++)      /* The tail (or everything if there  */
+    {                                   /* is no SIMD kernel)                */
+        glm::vec4 transform;
+        glm::vec2 translation;
+        SpriteTransforms::compute_transform(
+            { this->pos_x_[i], this->pos_y_[i] },
+            { this->size_x_[i], this->size_y_[i] }, this->rotation_[i],
+            { this->pivot_x_[i], this->pivot_y_[i] }, transform, translation);
+        this->axis_x_x_[i] = transform.x;
+        this->axis_x_y_[i] = transform.y;
+        this->axis_y_x_[i] = transform.z;
+        this->axis_y_y_[i] = transform.w;
+        this->translation_x_[i] = translation.x;
+        this->translation_y_[i] = translation.y;
+        this->min_x_[i] = translation.x + std::min(transform.x, 0.0f) +
+            std::min(transform.z, 0.0f);
+        this->min_y_[i] = translation.y + std::min(transform.y, 0.0f) +
+            std::min(transform.w, 0.0f);
+        this->max_x_[i] = translation.x + std::max(transform.x, 0.0f) +
+            std::max(transform.z, 0.0f);
+        this->max_y_[i] = translation.y + std::max(transform.y, 0.0f) +
+            std::max(transform.w, 0.0f);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_sprites_count
+;
+; @brief
+;   Returns the number of sprites pushed since the last 'clear'.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | The number of sprites.
+;
+----------------------------------------------------------------------------**/
+std::size_t SpriteTransforms::get_sprites_count() const
+{
+    return this->pos_x_.size();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_transform
+;
+; @brief
+;   Returns the linear part of the transform of a sprite. 'compute' must be
+;   called before.
+;
+; @params
+;   index   | Index of the sprite.
+;
+; @return
+;   glm::vec4   | xy - the unit quad x axis, zw - its y axis (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec4 SpriteTransforms::get_transform(std::size_t index) const
+{
+    return glm::vec4(this->axis_x_x_[index], this->axis_x_y_[index],
+        this->axis_y_x_[index], this->axis_y_y_[index]);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_translation
+;
+; @brief
+;   Returns the translation of the transform of a sprite, i.e. the world
+;   position of the unit quad origin. 'compute' must be called before.
+;
+; @params
+;   index   | Index of the sprite.
+;
+; @return
+;   glm::vec2   | Translation (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec2 SpriteTransforms::get_translation(std::size_t index) const
+{
+    return glm::vec2(this->translation_x_[index],
+        this->translation_y_[index]);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_bounds
+;
+; @brief
+;   Returns the axis-aligned bounding rectangle of a sprite. 'compute' must be
+;   called before.
+;
+; @params
+;   index   | Index of the sprite.
+;
+; @return
+;   glm::vec4   | min x, min y, max x, max y (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec4 SpriteTransforms::get_bounds(std::size_t index) const
+{
+    return glm::vec4(this->min_x_[index], this->min_y_[index],
+        this->max_x_[index], this->max_y_[index]);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func compute_transform
+;
+; @brief
+;   Computes the transform of a single sprite (scalar code). See 'push' for
+;   the meaning of the parameters.
+;
+; @params
+;   pos         | Position of the pivot of the sprite (in pixels).
+;   size        | Sprite size (in pixels).
+;   rotation    | Rotation around the pivot (in radians).
+;   pivot       | The pivot, relative to the size of the sprite.
+;   transform   | Output: xy - the unit quad x axis, zw - its y axis.
+;   translation | Output: the world position of the unit quad origin.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void SpriteTransforms::compute_transform(glm::vec2 const& pos,
+    glm::vec2 const& size, float rotation, glm::vec2 const& pivot,
+    glm::vec4& transform, glm::vec2& translation)
+{
+    float s = std::sin(rotation);
+    float c = std::cos(rotation);
+    transform = glm::vec4(c * size.x, s * size.x, -s * size.y, c * size.y);
+    translation = glm::vec2(
+        pos.x - (transform.x * pivot.x + transform.z * pivot.y),
+        pos.y - (transform.y * pivot.x + transform.w * pivot.y));
+}
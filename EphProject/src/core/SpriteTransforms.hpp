@@ -0,0 +1,83 @@
+/**----------------------------------------------------------------------------
+; @file SpriteTransforms.hpp
+;
+; @brief
+;   This file describes the 'SpriteTransforms' class. This class turns the
+;   placement of submitted sprites (position, size, rotation, pivot) into the
+;   2d affine transforms consumed by the vertex shader, and computes their
+;   bounding rectangles for culling.
+;
+;   The transform of a sprite maps the unit quad to the world:
+;       world = translation + | a c | * local
+;                             | b d |
+;   where (a, b) is the unit quad x axis and (c, d) is its y axis in the world
+;   (i.e. rotated and scaled by the size of the sprite). The shader reads
+;   (a, b, c, d) as one vec4 and the translation as one vec2 per instance, so
+;   a vertex costs two multiply-adds and no matrix is built on the GPU.
+;
+;   The sprites are stored as a structure of arrays, so the transforms are
+;   computed for 8 sprites at once with AVX2 or for 4 sprites at once with
+;   SSE2, including the sine and cosine of the rotation (polynomial
+;   approximation, about 1e-7 absolute error). The kernel is selected at
+;   compile time like in 'SpriteCuller'.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class SpriteTransforms
+{
+public:
+    SpriteTransforms();
+
+    void clear();
+    void push(glm::vec2 const& pos, glm::vec2 const& size, float rotation,
+        glm::vec2 const& pivot);
+    void compute();
+
+    std::size_t get_sprites_count() const;
+    glm::vec4 get_transform(std::size_t index) const;
+    glm::vec2 get_translation(std::size_t index) const;
+    glm::vec4 get_bounds(std::size_t index) const;
+
+    static void compute_transform(glm::vec2 const& pos, glm::vec2 const& size,
+        float rotation, glm::vec2 const& pivot, glm::vec4& transform,
+        glm::vec2& translation);
+
+private:
+    std::vector<float> pos_x_;          /* Input: the placement of the       */
+    std::vector<float> pos_y_;          /* sprites                           */
+    std::vector<float> size_x_;
+    std::vector<float> size_y_;
+    std::vector<float> rotation_;
+    std::vector<float> pivot_x_;
+    std::vector<float> pivot_y_;
+
+    std::vector<float> axis_x_x_;       /* Output: the transforms (a, b, c,  */
+    std::vector<float> axis_x_y_;       /* d, translation) and the bounds    */
+    std::vector<float> axis_y_x_;
+    std::vector<float> axis_y_y_;
+    std::vector<float> translation_x_;
+    std::vector<float> translation_y_;
+    std::vector<float> min_x_;
+    std::vector<float> min_y_;
+    std::vector<float> max_x_;
+    std::vector<float> max_y_;
+};
@@ -0,0 +1,661 @@
+/**----------------------------------------------------------------------------
+; @file StaticLayer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'StaticLayer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <functional>
+
+#include <glad/glad.h>
+
+#include "StaticLayer.hpp"
+#include "DrawQueue.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "IndicesData.hpp"
+#include "SpriteTransforms.hpp"
+#include "Texture2dArray.hpp"
+#include "Texture2dArrayLayer.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func StaticLayer
+;
+; @brief
+;   Constructor. Builds the unit quad shared by all instances and allocates
+;   the instance buffer. The buffer grows on a rebuild if more sprites are
+;   added.
+;
+; @params
+;   capacity    | The initial number of sprites the instance buffer can hold.
+;
+----------------------------------------------------------------------------**/
+StaticLayer::StaticLayer(unsigned int capacity)
+    :buffer_id_(0), buffer_capacity_(std::max(capacity, 1u)),
+    unit_quad_indices_ptr_(nullptr), sprites_count_(0), next_order_(0),
+    is_rebuild_needed_(false), dirty_begin_(0), dirty_end_(0),
+    rebuilds_count_(0), uploads_count_(0), uploaded_bytes_(0)
+{
+    this->unit_quad_indices_ptr_ = this->unit_quad_.add_unit_quad();
+    this->unit_quad_.build();           /* Send the unit quad to the GPU     */
+
+    glGenBuffers(1, &this->buffer_id_);
+    GlState::current().bind_buffer(GL_ARRAY_BUFFER, this->buffer_id_);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(
+        this->buffer_capacity_ * sizeof(SpriteInstance)), nullptr,
+        GL_DYNAMIC_DRAW);               /* Written rarely, drawn every frame */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~StaticLayer
+;
+; @brief
+;   Destructor. Deletes the instance buffer and the unit quad indices data.
+;
+----------------------------------------------------------------------------**/
+StaticLayer::~StaticLayer()
+{
+    glDeleteBuffers(1, &this->buffer_id_);
+    GlState::current().on_buffer_deleted(this->buffer_id_);
+    delete this->unit_quad_indices_ptr_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func add
+;
+; @brief
+;   Adds a sprite to the layer. The layer is rebuilt before the next draw.
+;
+; @params
+;   texture_2d_array_layer_ptr  | Texture layer the sprite is taken from.
+;   pos                         | Position of the pivot (in pixels).
+;   size                        | Sprite size (in pixels).
+;   txd_rect                    | xy - offset, zw - size of the sprite region
+;                               | on the layer (in normalized texture
+;                               | coordinates). The whole layer by default.
+;   depth                       | Draw layer in [0, 65535]. Sprites with
+;                               | greater depth are drawn later.
+;   rotation                    | Rotation around the pivot (in radians).
+;   pivot                       | The pivot, relative to the sprite size
+;                               | (see 'SpriteTransforms::push').
+;
+; @return
+;   unsigned int    | Handle of the sprite. Valid until the sprite is
+;                   | removed.
+;
+----------------------------------------------------------------------------**/
+unsigned int StaticLayer::add(
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec2 const& pos, glm::vec2 const& size, glm::vec4 const& txd_rect,
+    int depth, float rotation, glm::vec2 const& pivot)
+{
+    unsigned int handle;
+    if (!this->free_handles_.empty())
+    {
+        handle = this->free_handles_.back();
+        this->free_handles_.pop_back();
+    }
+    else
+    {
+        handle = static_cast<unsigned int>(this->entries_.size());
+        this->entries_.emplace_back();
+    }
+
+    Entry& entry = this->entries_[handle];
+    entry.texture_2d_array_ptr =
+        texture_2d_array_layer_ptr->get_texture_2d_array();
+    entry.depth = depth;
+    entry.order = this->next_order_++;
+    entry.instance_index = 0;
+    entry.is_alive = true;
+    entry.is_opaque = texture_2d_array_layer_ptr->is_opaque(txd_rect);
+    SpriteTransforms::compute_transform(pos, size, rotation, pivot,
+        entry.instance.transform, entry.instance.translation);
+    entry.instance.txd_rect = txd_rect;
+    entry.instance.z_offset = texture_2d_array_layer_ptr->get_z_offset();
+    entry.instance.depth = DrawQueue::get_clip_depth(depth);
+
+    this->sprites_count_++;
+    this->is_rebuild_needed_ = true;
+    return handle;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func remove
+;
+; @brief
+;   Removes a sprite from the layer. The layer is rebuilt before the next
+;   draw. The handle may be returned by a later 'add' call.
+;
+; @params
+;   handle  | Handle of the sprite.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::remove(unsigned int handle)
+{
+    if (handle >= this->entries_.size() || !this->entries_[handle].is_alive)
+    {
+        LOG_WARNING("Attempt to remove a nonexistent static sprite.");
+        return;
+    }
+    this->entries_[handle].is_alive = false;
+    this->free_handles_.push_back(handle);
+    this->sprites_count_--;
+    this->is_rebuild_needed_ = true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func clear
+;
+; @brief
+;   Removes all sprites from the layer. All handles become invalid.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::clear()
+{
+    this->entries_.clear();
+    this->free_handles_.clear();
+    this->sprites_count_ = 0;
+    this->next_order_ = 0;
+    this->is_rebuild_needed_ = true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_rect
+;
+; @brief
+;   Moves, resizes or rotates a sprite. Only the instance of the sprite is
+;   uploaded before the next draw.
+;
+; @params
+;   handle      | Handle of the sprite.
+;   pos         | Position of the pivot (in pixels).
+;   size        | Sprite size (in pixels).
+;   rotation    | Rotation around the pivot (in radians).
+;   pivot       | The pivot, relative to the sprite size.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::set_rect(unsigned int handle, glm::vec2 const& pos,
+    glm::vec2 const& size, float rotation, glm::vec2 const& pivot)
+{
+    if (handle >= this->entries_.size() || !this->entries_[handle].is_alive)
+    {
+        LOG_WARNING("Attempt to change a nonexistent static sprite.");
+        return;
+    }
+    Entry& entry = this->entries_[handle];
+    SpriteTransforms::compute_transform(pos, size, rotation, pivot,
+        entry.instance.transform, entry.instance.translation);
+    this->mark_dirty(handle);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func set_texture
+;
+; @brief
+;   Changes the texture of a sprite. If the new layer belongs to the same
+;   texture 2d array and the opacity of the region is the same, only the
+;   instance of the sprite is uploaded before the next draw. Otherwise the
+;   layer is rebuilt.
+;
+; @params
+;   handle                      | Handle of the sprite.
+;   texture_2d_array_layer_ptr  | Texture layer the sprite is taken from.
+;   txd_rect                    | xy - offset, zw - size of the sprite region
+;                               | on the layer (in normalized texture
+;                               | coordinates).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::set_texture(unsigned int handle,
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+    glm::vec4 const& txd_rect)
+{
+    if (handle >= this->entries_.size() || !this->entries_[handle].is_alive)
+    {
+        LOG_WARNING("Attempt to change a nonexistent static sprite.");
+        return;
+    }
+    Entry& entry = this->entries_[handle];
+    entry.instance.txd_rect = txd_rect;
+    entry.instance.z_offset = texture_2d_array_layer_ptr->get_z_offset();
+
+    Texture2dArray const* texture_2d_array_ptr =
+        texture_2d_array_layer_ptr->get_texture_2d_array();
+    bool is_opaque = texture_2d_array_layer_ptr->is_opaque(txd_rect);
+    if (entry.texture_2d_array_ptr != texture_2d_array_ptr ||
+        entry.is_opaque != is_opaque)
+    {                                   /* The sprite moves to another run   */
+        entry.texture_2d_array_ptr = texture_2d_array_ptr;
+        entry.is_opaque = is_opaque;
+        this->is_rebuild_needed_ = true;
+        return;
+    }
+    this->mark_dirty(handle);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update
+;
+; @brief
+;   Sends the changes made since the last call to the GPU. Rebuilds the layer
+;   if sprites were added, removed or moved to another run (see
+;   'set_texture'), otherwise uploads the dirty range of instances, if any.
+;   Does nothing if the layer has not changed.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::update()
+{
+    if (this->is_rebuild_needed_)
+    {
+        this->rebuild();
+        return;
+    }
+    if (this->dirty_begin_ >= this->dirty_end_)
+    {
+        return;
+    }
+
+    std::size_t offset = this->dirty_begin_ * sizeof(SpriteInstance);
+    std::size_t size = (this->dirty_end_ - this->dirty_begin_) *
+        sizeof(SpriteInstance);
+    GlState::current().bind_buffer(GL_ARRAY_BUFFER, this->buffer_id_);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size),
+        this->instances_.data() + this->dirty_begin_);
+    this->uploads_count_++;
+    this->uploaded_bytes_ += size;
+    FRAME_STATS_ADD(buffer_bytes, size);
+    this->dirty_begin_ = 0;
+    this->dirty_end_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Binds the unit quad vertex array with the instance buffer of the layer
+;   attached to it. The vertex array stays bound after the call. 'update' must
+;   be called before, otherwise the previous contents are drawn.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::bind() const
+{
+    this->unit_quad_.bind_instance_buffer(this->buffer_id_, 0);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func draw_run
+;
+; @brief
+;   Draws all instances of the run with a single call. The texture 2d array of
+;   the run must be bound and 'bind' must be called before.
+;
+; @params
+;   run | The run to be drawn.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::draw_run(Run const& run) const
+{
+    glDrawElementsInstancedBaseInstance(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count, GL_UNSIGNED_INT,
+        this->unit_quad_indices_ptr_->offset, run.instances_count,
+        run.first_instance);
+    FRAME_STATS_ADD_DRAW(this->unit_quad_indices_ptr_->mode,
+        this->unit_quad_indices_ptr_->count, run.instances_count);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_empty
+;
+; @brief
+;   Checks whether there are no sprites in the layer.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if the layer has no sprites.
+;
+----------------------------------------------------------------------------**/
+bool StaticLayer::is_empty() const
+{
+    return this->sprites_count_ == 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_buffer_id
+;
+; @brief
+;   Returns the instance buffer of the layer. Its first 'get_sprites_count'
+;   elements are the instances in the order of the runs (as of the last
+;   'update' call).
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Buffer object that contains 'SpriteInstance' elements.
+;
+----------------------------------------------------------------------------**/
+unsigned int StaticLayer::get_buffer_id() const
+{
+    return this->buffer_id_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_runs
+;
+; @brief
+;   Returns the runs of the layer as of the last 'update' call.
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<Run> const& | Runs in the drawing order.
+;
+----------------------------------------------------------------------------**/
+std::vector<StaticLayer::Run> const& StaticLayer::get_runs() const
+{
+    return this->runs_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_sprites_count
+;
+; @brief
+;   Returns the number of sprites in the layer.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of sprites.
+;
+----------------------------------------------------------------------------**/
+unsigned int StaticLayer::get_sprites_count() const
+{
+    return this->sprites_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_rebuilds_count
+;
+; @brief
+;   Returns the number of rebuilds (full uploads) since the last
+;   'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of rebuilds.
+;
+----------------------------------------------------------------------------**/
+unsigned int StaticLayer::get_rebuilds_count() const
+{
+    return this->rebuilds_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_uploads_count
+;
+; @brief
+;   Returns the number of dirty range uploads since the last 'reset_stats'
+;   call. Rebuilds are not counted.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of partial uploads.
+;
+----------------------------------------------------------------------------**/
+unsigned int StaticLayer::get_uploads_count() const
+{
+    return this->uploads_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_uploaded_bytes
+;
+; @brief
+;   Returns the amount of instance data sent to the GPU (by rebuilds and
+;   dirty range uploads) since the last 'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   std::size_t | Uploaded data size (in bytes).
+;
+----------------------------------------------------------------------------**/
+std::size_t StaticLayer::get_uploaded_bytes() const
+{
+    return this->uploaded_bytes_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the rebuild and upload counters.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::reset_stats()
+{
+    this->rebuilds_count_ = 0;
+    this->uploads_count_ = 0;
+    this->uploaded_bytes_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func rebuild
+;
+; @brief
+;   Orders the sprites by depth and order of addition, groups each span of
+;   consecutive opaque sprites of one depth by texture 2d array, splits the
+;   sprites into runs and uploads all instances. The instance buffer is
+;   reallocated if it is too small.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::rebuild()
+{
+    std::vector<unsigned int> handles;
+    handles.reserve(this->sprites_count_);
+    for (unsigned int handle = 0; handle < this->entries_.size(); handle++)
+    {
+        if (this->entries_[handle].is_alive)
+        {
+            handles.push_back(handle);
+        }
+    }
+    std::sort(handles.begin(), handles.end(),
+        [this](unsigned int a, unsigned int b)
+        {
+            Entry const& entry_a = this->entries_[a];
+            Entry const& entry_b = this->entries_[b];
+            if (entry_a.depth != entry_b.depth)
+            {
+                return entry_a.depth < entry_b.depth;
+            }
+            return entry_a.order < entry_b.order;
+        });                             /* Painter's order                   */
+
+    std::size_t span_begin = 0;
+    while (span_begin < handles.size())
+    {                                   /* Group the spans of opaque sprites */
+                                        /* by texture 2d array               */
+        Entry const& first_entry = this->entries_[handles[span_begin]];
+        std::size_t span_end = span_begin + 1;
+        while (first_entry.is_opaque && span_end < handles.size() &&
+            this->entries_[handles[span_end]].is_opaque &&
+            this->entries_[handles[span_end]].depth == first_entry.depth)
+        {
+            span_end++;
+        }
+        if (span_end - span_begin > 1)
+        {
+            std::stable_sort(handles.begin() + span_begin,
+                handles.begin() + span_end,
+                [this](unsigned int a, unsigned int b)
+                {
+                    return std::less<Texture2dArray const*>()(
+                        this->entries_[a].texture_2d_array_ptr,
+                        this->entries_[b].texture_2d_array_ptr);
+                });
+        }
+        span_begin = span_end;
+    }
+
+    this->instances_.clear();
+    this->runs_.clear();
+    for (unsigned int handle : handles)
+    {
+        Entry& entry = this->entries_[handle];
+        unsigned int index = static_cast<unsigned int>(
+            this->instances_.size());
+        if (this->runs_.empty() || this->runs_.back().texture_2d_array_ptr !=
+            entry.texture_2d_array_ptr)
+        {                               /* Start a new run if the texture 2d */
+                                        /* array has changed                 */
+            this->runs_.push_back({ entry.texture_2d_array_ptr, index, 0 });
+        }
+        this->runs_.back().instances_count++;
+        entry.instance_index = index;
+        this->instances_.push_back(entry.instance);
+    }
+
+    std::size_t size = this->instances_.size() * sizeof(SpriteInstance);
+    GlState::current().bind_buffer(GL_ARRAY_BUFFER, this->buffer_id_);
+    if (this->instances_.size() > this->buffer_capacity_)
+    {                                   /* Grow the buffer geometrically     */
+        while (this->buffer_capacity_ < this->instances_.size())
+        {
+            this->buffer_capacity_ *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(
+            this->buffer_capacity_ * sizeof(SpriteInstance)), nullptr,
+            GL_DYNAMIC_DRAW);
+    }
+    if (size != 0)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size),
+            this->instances_.data());
+        FRAME_STATS_ADD(buffer_bytes, size);
+    }
+
+    this->rebuilds_count_++;
+    this->uploaded_bytes_ += size;
+    this->is_rebuild_needed_ = false;
+    this->dirty_begin_ = 0;
+    this->dirty_end_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func mark_dirty
+;
+; @brief
+;   Copies the instance of a sprite to the CPU copy of the buffer and extends
+;   the dirty range to cover it. Does nothing if a rebuild is pending: the
+;   rebuild uploads everything anyway.
+;
+; @params
+;   handle  | Handle of the sprite.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void StaticLayer::mark_dirty(unsigned int handle)
+{
+    if (this->is_rebuild_needed_)
+    {
+        return;
+    }
+    Entry const& entry = this->entries_[handle];
+    this->instances_[entry.instance_index] = entry.instance;
+    if (this->dirty_begin_ >= this->dirty_end_)
+    {
+        this->dirty_begin_ = entry.instance_index;
+        this->dirty_end_ = entry.instance_index + 1;
+        return;
+    }
+    this->dirty_begin_ = std::min(this->dirty_begin_, entry.instance_index);
+    this->dirty_end_ = std::max(this->dirty_end_, entry.instance_index + 1);
+}
@@ -0,0 +1,136 @@
+/**----------------------------------------------------------------------------
+; @file StaticLayer.hpp
+;
+; @brief
+;   This file describes the 'StaticLayer' class. This class keeps sprites that
+;   rarely change (backgrounds, UI frames) in a GPU buffer of 'SpriteInstance'
+;   elements. The sprites are uploaded once and then redrawn every frame with
+;   one instanced draw call per run of sprites that share a texture 2d array,
+;   without sending anything to the GPU.
+;
+;   Sprites are addressed by handles returned from 'add'. Changing the
+;   position, size, rotation or texture region of a sprite only marks its instance as
+;   dirty; the dirty range is uploaded with a single 'glBufferSubData' call
+;   before the next draw. Adding or removing sprites, or moving a sprite to
+;   another texture 2d array (or between opaque and translucent texture
+;   regions), changes the runs: the layer is rebuilt, i.e. the instances are
+;   regrouped and the whole buffer is uploaded again.
+;
+;   The layer is blended, so the instances are ordered by depth, then by the
+;   order of addition (painter's order). Only opaque sprites (see
+;   'Texture2dArrayLayer::is_opaque') that follow each other in this order
+;   are regrouped by texture 2d array, like in 'DrawQueue'. So a layer of
+;   opaque sprites that share one depth is drawn with exactly one call per
+;   texture 2d array.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "SpriteInstance.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Texture2dArray;
+class Texture2dArrayLayer;
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class StaticLayer
+{
+public:
+    struct Run
+    {
+        Texture2dArray const* texture_2d_array_ptr;
+        unsigned int first_instance;
+        unsigned int instances_count;
+    };
+
+    StaticLayer(unsigned int capacity = 1024);
+    ~StaticLayer();
+
+    unsigned int add(Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec2 const& pos, glm::vec2 const& size,
+        glm::vec4 const& txd_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+        int depth = 0, float rotation = 0.0f,
+        glm::vec2 const& pivot = glm::vec2(0.0f));
+    void remove(unsigned int handle);
+    void clear();
+    void set_rect(unsigned int handle, glm::vec2 const& pos,
+        glm::vec2 const& size, float rotation = 0.0f,
+        glm::vec2 const& pivot = glm::vec2(0.0f));
+    void set_texture(unsigned int handle,
+        Texture2dArrayLayer const* texture_2d_array_layer_ptr,
+        glm::vec4 const& txd_rect);
+
+    void update();
+    void bind() const;
+    void draw_run(Run const& run) const;
+
+    bool is_empty() const;
+    unsigned int get_buffer_id() const;
+    std::vector<Run> const& get_runs() const;
+    unsigned int get_sprites_count() const;
+    unsigned int get_rebuilds_count() const;
+    unsigned int get_uploads_count() const;
+    std::size_t get_uploaded_bytes() const;
+    void reset_stats();
+
+private:
+    struct Entry
+    {
+        Texture2dArray const* texture_2d_array_ptr;
+        int depth;
+        unsigned int order;             /* Order of addition                 */
+        unsigned int instance_index;    /* Index in 'instances_'             */
+        bool is_alive;
+        bool is_opaque;                 /* Its texture region                */
+        SpriteInstance instance;
+    };
+
+    unsigned int buffer_id_;
+    unsigned int buffer_capacity_;      /* In instances                      */
+    VertexArray unit_quad_;
+    IndicesData* unit_quad_indices_ptr_;
+
+    std::vector<Entry> entries_;        /* Indexed by handle                 */
+    std::vector<unsigned int> free_handles_;
+    unsigned int sprites_count_;
+    unsigned int next_order_;
+
+    std::vector<SpriteInstance> instances_;
+                                        /* CPU copy of the buffer contents   */
+    std::vector<Run> runs_;
+    bool is_rebuild_needed_;
+    unsigned int dirty_begin_;          /* Dirty range of 'instances_'       */
+    unsigned int dirty_end_;            /* (empty if begin >= end)           */
+
+    unsigned int rebuilds_count_;
+    unsigned int uploads_count_;
+    std::size_t uploaded_bytes_;
+
+    void rebuild();
+    void mark_dirty(unsigned int handle);
+
+    StaticLayer(const StaticLayer&) = delete;
+    StaticLayer& operator=(const StaticLayer&) = delete;
+};
@@ -16,6 +16,7 @@
 #include <glad/glad.h>
 
 #include "Texture2dArray.hpp"
+#include "GlState.hpp"
 #include "Log.hpp"
 
 
@@ -38,38 +39,32 @@ unsigned int Texture2dArray::free_texture_images_unit_ = GL_TEXTURE0;
 ;   width   | Width of the 2d texture array.
 ;   height  | Heigh of the 2d texture array.
 ;   depth   | Depth of the 2d texture array.
+;   format  | Texel format. RGBA by default.
 ;
 ----------------------------------------------------------------------------**/
-Texture2dArray::Texture2dArray(int width, int height, int depth)
-    :width_(width), height_(height), depth_(depth)
+Texture2dArray::Texture2dArray(int width, int height, int depth,
+    enTextureFormat format)
+    :width_(width), height_(height), depth_(depth), format_(format)
 {
-    int dest = 0;
-    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &dest);
-                                        /* Get the maximum supported texture */
-                                        /* image units that can be used to   */
-                                        /* access texture maps from the      */
-                                        /* fragment shader                   */
+    GlState& gl_state = GlState::current();
+                                        /* The limits are queried once by    */
+                                        /* the state cache                   */
     if (Texture2dArray::free_texture_images_unit_ - GL_TEXTURE0 >=
-        static_cast<unsigned int>(dest))
+        static_cast<unsigned int>(gl_state.get_max_texture_image_units()))
     {                                   /* Compare this with the number of   */
                                         /* the free texture unit             */
         LOG_ERROR("Unable to create texture 2d array. All texture units are \
 used.");                                /* Log an error if all texture       */
     }                                   /* units are used                    */
 
-    glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &dest);
-                                        /* Get the maximum supported texture */
-                                        /* image size                        */
-    if (width > dest || height > dest)
+    if (width > gl_state.get_max_3d_texture_size() ||
+        height > gl_state.get_max_3d_texture_size())
     {
         LOG_ERROR("Unable to create texture 2d array. The maximum supported \
 texture image size has been exceeded.")
     }
 
-    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &dest);
-                                        /* Get the maximum supported texture */
-                                        /* 2d array depth                    */
-    if (depth > dest)
+    if (depth > gl_state.get_max_array_texture_layers())
     {
         LOG_ERROR("Unable to create texture 2d array. The maximum number of \
 texture layers has been exceeded.")
@@ -77,34 +72,36 @@ texture layers has been exceeded.")
 
     this->texture_unit_ = Texture2dArray::free_texture_images_unit_;
 
-    glActiveTexture(this->texture_unit_);
     glGenTextures(1, &this->id_);       /* Generate a 2d texture array       */
                                         /* object                            */
-    glBindTexture(GL_TEXTURE_2D_ARRAY, this->id_);
-                                        /* Set 'texture_2d_array' as the     */
-                                        /* current vertex array object       */
+    this->bind();                       /* Bind it to its own texture unit   */
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    if (this->format_ == TEXTURE_FORMAT_R8)
+    {
+        GLint swizzle[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+        glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA,
+            swizzle);                   /* Coverage goes to alpha            */
+    }
     glTexImage3D(
         GL_TEXTURE_2D_ARRAY,            /* target to which the texture is    */
                                         /* bound                             */
         0,                              /* level                             */
-        GL_RGBA8,                       /* Internal format                   */
+        this->format_ == TEXTURE_FORMAT_R8 ? GL_R8 : GL_RGBA8,
+                                        /* Internal format                   */
         (this->width_),                 /* Width of the 2d texture array     */
         this->height_,                  /* Heigh of the 2d texture array     */
         this->depth_,                   /* Depth of the 2d texture array     */
         0,                              /* Border, must be 0                 */
-        GL_RGBA,                        /* Format of the pixel data          */
+        this->format_ == TEXTURE_FORMAT_R8 ? GL_RED : GL_RGBA,
+                                        /* Format of the pixel data          */
         GL_UNSIGNED_BYTE,               /* Data type of the pixel data       */
         nullptr);                       /* A pointer to the image data       */
 
-    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-                                        /* Unbind the texture 2d array       */
-
-    // TODO: Restore GL_TEXTURE_2D_ARRAY to the state it was in before calling
-    //       the constructor.
+                                        /* The texture stays bound: the unit */
+                                        /* belongs to this texture only      */
 
     Texture2dArray::free_texture_images_unit_++;
                                         /* Increase the number of used texture
@@ -129,6 +126,7 @@ texture layers has been exceeded.")
 Texture2dArray::~Texture2dArray()
 {
     glDeleteTextures(1, &this->id_);
+    GlState::current().on_texture_deleted(this->id_);
 }
 
 
@@ -136,7 +134,8 @@ Texture2dArray::~Texture2dArray()
 ; @func bind
 ;
 ; @brief
-;   Binds this texture 2d array to GL_TEXTURE_2D_ARRAY.
+;   Binds this texture 2d array to GL_TEXTURE_2D_ARRAY of its texture unit.
+;   Does nothing if it is already bound there.
 ;
 ; @params
 ;   None
@@ -147,7 +146,8 @@ Texture2dArray::~Texture2dArray()
 ----------------------------------------------------------------------------**/
 void Texture2dArray::bind() const
 {
-    glBindTexture(GL_TEXTURE_2D_ARRAY, this->id_);
+    GlState::current().bind_texture(this->texture_unit_, GL_TEXTURE_2D_ARRAY,
+        this->id_);
 }
 
 
@@ -224,4 +224,23 @@ int Texture2dArray::get_height() const
 int Texture2dArray::get_texture_unit() const
 {
     return this->texture_unit_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_format
+;
+; @brief
+;   Returns the texel format of this texture 2d array.
+;
+; @params
+;   None
+;
+; @return
+;   enTextureFormat | Texel format.
+;
+----------------------------------------------------------------------------**/
+enTextureFormat Texture2dArray::get_format() const
+{
+    return this->format_;
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 ;   The file describes the 'Texture2dArray' class that implements the logic
 ;   for creating arrays of 2d textures.
 ;
+;   A texture 2d array is either RGBA (images) or single-channel (coverage
+;   masks, e.g. glyphs). A single-channel array is swizzled to (1, 1, 1, r),
+;   so the shaders sample it as white with the coverage as alpha and need no
+;   separate path for it.
+;
 ; @date   April 2021
 ; @author Eph
 ;
@@ -14,12 +19,24 @@
 
 
 
+/** @enums -----------------------------------------------------------------**/
+
+enum enTextureFormat
+{
+    TEXTURE_FORMAT_RGBA8 = 0,           /* 4 bytes per texel                 */
+    TEXTURE_FORMAT_R8 = 1,              /* 1 byte per texel, sampled as      */
+                                        /* (1, 1, 1, r)                      */
+};
+
+
+
 /** @classes ---------------------------------------------------------------**/
 
 class Texture2dArray
 {
 public:
-    Texture2dArray(int width, int height, int depth);
+    Texture2dArray(int width, int height, int depth,
+        enTextureFormat format = TEXTURE_FORMAT_RGBA8);
     ~Texture2dArray();
 
     void bind() const;
@@ -28,11 +45,13 @@ public:
     int get_width() const;
     int get_height() const;
     int get_texture_unit() const;
+    enTextureFormat get_format() const;
 private:
     unsigned int id_;
     int width_;
     int height_;
     int depth_;
+    enTextureFormat format_;
     unsigned int texture_unit_;
     static unsigned int free_texture_images_unit_;
 };
\ No newline at end of file
@@ -13,21 +13,34 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <algorithm>
+#include <cmath>
+
 #include <glad/glad.h>
 
 #include "Texture2dArrayLayer.hpp"
 #include "Texture2dArray.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "GpuProfiler.hpp"
 #include "Log.hpp"
 
 
 
+/** @defines ---------------------------------------------------------------**/
+
+#define OPACITY_BLOCK_SIZE 16           /* Texels per side of a mask block   */
+
+
+
 /** @functions  ------------------------------------------------------------**/
 
 /**----------------------------------------------------------------------------
 ; @func Texture2dArrayLayer
 ;
 ; @brief
-;   Constructor.
+;   Constructor. The opacity mask starts empty: the contents of the layer are
+;   undefined until something is uploaded.
 ;
 ; @params
 ;   texture_2d_array_ptr    | Pointer to the 2d texture array this layer
@@ -39,6 +52,12 @@ Texture2dArrayLayer::Texture2dArrayLayer(Texture2dArray* texture_2d_array_ptr,
     int z_offset)
     :texture_2d_array_ptr_(texture_2d_array_ptr), z_offset_(z_offset)
 {
+    this->opacity_blocks_per_row_ = (texture_2d_array_ptr->get_width() +
+        OPACITY_BLOCK_SIZE - 1) / OPACITY_BLOCK_SIZE;
+    this->opacity_blocks_per_column_ = (texture_2d_array_ptr->get_height() +
+        OPACITY_BLOCK_SIZE - 1) / OPACITY_BLOCK_SIZE;
+    this->opaque_blocks_.resize(static_cast<std::size_t>(
+        this->opacity_blocks_per_row_ * this->opacity_blocks_per_column_), 0);
 }
 
 
@@ -46,7 +65,9 @@ Texture2dArrayLayer::Texture2dArrayLayer(Texture2dArray* texture_2d_array_ptr,
 ; @func add_subimage
 ;
 ; @brief
-;   Loads an image (or subimage) onto a 2d texture array layer
+;   Loads an image (or subimage) onto a 2d texture array layer and updates
+;   the opacity mask of the covered blocks. The upload is measured as a
+;   'texture upload' scope if a frame is profiled (see 'GpuProfiler').
 ;
 ; @params
 ;   subtexture_x_offset | X-offset from the beginning of the layer.
@@ -94,20 +115,28 @@ void Texture2dArrayLayer::add_subimage(int subtexture_x_offset,
     case 3:                             /* if 3 bytes per pixel              */
         format = GL_RGB;                /* it's RGB                          */
         break;
+    case 1:                             /* If 1 byte per pixel               */
+        format = GL_RED;                /* it's a single channel (e.g. glyph */
+        break;                          /* coverage)                         */
     default:                            /* Otherwise, log an error           */
         LOG_ERROR("Undefined image format.");
         break;
         // TODO: Provide functionality for other formats.
     }
+    GpuProfileScope profile_scope("texture upload");
+    GlState& gl_state = GlState::current();
     this->texture_2d_array_ptr_->bind();
-    glActiveTexture(this->texture_2d_array_ptr_->get_texture_unit());
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, img_width);
+    gl_state.active_texture(this->texture_2d_array_ptr_->get_texture_unit());
+    gl_state.set_pixel_store(GL_UNPACK_ALIGNMENT, 1);
+                                        /* Rows of RGB and single-channel    */
+                                        /* images are tightly packed         */
+    gl_state.set_pixel_store(GL_UNPACK_ROW_LENGTH, img_width);
                                         /* The full width of the image from  */
                                         /* which the texture is created      */
-    glPixelStorei(GL_UNPACK_SKIP_PIXELS, img_x_offset);
+    gl_state.set_pixel_store(GL_UNPACK_SKIP_PIXELS, img_x_offset);
                                         /* Subimage x-offset (from the       */
                                         /* beginning of the image).          */
-    glPixelStorei(GL_UNPACK_SKIP_ROWS, img_height - img_y_offset
+    gl_state.set_pixel_store(GL_UNPACK_SKIP_ROWS, img_height - img_y_offset
         - subtexture_hight);            /* Subimage y-offset (from the       */
                                         /* beginning of the image).          */
     glTexSubImage3D(
@@ -134,11 +163,67 @@ void Texture2dArrayLayer::add_subimage(int subtexture_x_offset,
         GL_UNSIGNED_BYTE,               /* Data type of the pixel data       */
         static_cast<const void*>(img_bytes));
                                         /* Image pixels data pointer         */
-    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-                                        /* Unbind the texture 2d array       */
+    FRAME_STATS_ADD(texture_bytes, static_cast<unsigned long long>(
+        subtexture_width) * subtexture_hight * img_channels_count_);
 
-    // TODO: Restore GL_TEXTURE_2D_ARRAY to the state it was in before calling
-    //       the constructor.
+    this->update_opacity(subtexture_x_offset, subtexture_y_offset,
+        subtexture_width, subtexture_hight, img_bytes +
+        (static_cast<std::size_t>(img_height - img_y_offset -
+            subtexture_hight) * img_width + img_x_offset) *
+        img_channels_count_, img_width, img_channels_count_);
+                                        /* Pass the first uploaded pixel,    */
+                                        /* the same one GL_UNPACK_SKIP_*     */
+                                        /* point to                          */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_opaque
+;
+; @brief
+;   Returns whether all texels of a region of the layer are known to be fully
+;   opaque. The check is conservative: a block that is only partially covered
+;   by opaque uploads counts as translucent.
+;
+; @params
+;   txd_rect    | xy - offset, zw - size of the region (in normalized texture
+;               | coordinates).
+;
+; @return
+;   bool    | true if the region can be drawn without blending.
+;
+----------------------------------------------------------------------------**/
+bool Texture2dArrayLayer::is_opaque(glm::vec4 const& txd_rect) const
+{
+    float width = static_cast<float>(this->texture_2d_array_ptr_->get_width());
+    float height = static_cast<float>(
+        this->texture_2d_array_ptr_->get_height());
+    int min_x = static_cast<int>(std::floor(txd_rect.x * width));
+    int min_y = static_cast<int>(std::floor(txd_rect.y * height));
+    int max_x = static_cast<int>(std::ceil((txd_rect.x + txd_rect.z) *
+        width)) - 1;                    /* Inclusive texel range             */
+    int max_y = static_cast<int>(std::ceil((txd_rect.y + txd_rect.w) *
+        height)) - 1;
+    if (min_x < 0 || min_y < 0 || max_x >= static_cast<int>(width) ||
+        max_y >= static_cast<int>(height) || min_x > max_x || min_y > max_y)
+    {
+        return false;                   /* Wraps or is empty: let it blend   */
+    }
+
+    for (int y = min_y / OPACITY_BLOCK_SIZE; y <= max_y / OPACITY_BLOCK_SIZE;
+        y++)
+    {
+        for (int x = min_x / OPACITY_BLOCK_SIZE;
+            x <= max_x / OPACITY_BLOCK_SIZE; x++)
+        {
+            if (this->opaque_blocks_[y * this->opacity_blocks_per_row_ + x] ==
+                0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 
@@ -179,3 +264,78 @@ Texture2dArray* Texture2dArrayLayer::get_texture_2d_array() const
 {
     return this->texture_2d_array_ptr_;
 }
+
+
+/**----------------------------------------------------------------------------
+; @func update_opacity
+;
+; @brief
+;   Updates the opacity mask after an upload. A block that is entirely
+;   covered by the upload becomes opaque if all its new texels have alpha 255
+;   (or the pixels have no alpha). A block that is covered only partially
+;   becomes translucent, since the rest of it is not checked. The pixels of a
+;   single-channel texture 2d array are coverage: their only channel is the
+;   alpha.
+;
+; @params
+;   subtexture_x_offset | X-offset of the upload on the layer.
+;   subtexture_y_offset | Y-offset of the upload on the layer.
+;   subtexture_width    | Width of the upload.
+;   subtexture_hight    | Height of the upload.
+;   subimage_bytes      | The first uploaded pixel.
+;   img_width           | Width of the full image (row length).
+;   img_channels_count_ | Bytes per pixel in the image data.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Texture2dArrayLayer::update_opacity(int subtexture_x_offset,
+    int subtexture_y_offset, int subtexture_width, int subtexture_hight,
+    unsigned char const* subimage_bytes, int img_width,
+    int img_channels_count_)
+{
+    int max_x = subtexture_x_offset + subtexture_width - 1;
+    int max_y = subtexture_y_offset + subtexture_hight - 1;
+    bool has_alpha = img_channels_count_ == 2 || img_channels_count_ == 4 ||
+        (img_channels_count_ == 1 &&
+            this->texture_2d_array_ptr_->get_format() == TEXTURE_FORMAT_R8);
+
+    for (int block_y = subtexture_y_offset / OPACITY_BLOCK_SIZE;
+        block_y <= max_y / OPACITY_BLOCK_SIZE; block_y++)
+    {
+        for (int block_x = subtexture_x_offset / OPACITY_BLOCK_SIZE;
+            block_x <= max_x / OPACITY_BLOCK_SIZE; block_x++)
+        {
+            int block_min_x = block_x * OPACITY_BLOCK_SIZE;
+            int block_min_y = block_y * OPACITY_BLOCK_SIZE;
+            int block_max_x = std::min(block_min_x + OPACITY_BLOCK_SIZE,
+                this->texture_2d_array_ptr_->get_width()) - 1;
+            int block_max_y = std::min(block_min_y + OPACITY_BLOCK_SIZE,
+                this->texture_2d_array_ptr_->get_height()) - 1;
+            bool is_covered = block_min_x >= subtexture_x_offset &&
+                block_min_y >= subtexture_y_offset &&
+                block_max_x <= max_x && block_max_y <= max_y;
+
+            bool is_opaque = is_covered;
+            for (int y = block_min_y; is_opaque && has_alpha &&
+                y <= block_max_y; y++)
+            {
+                unsigned char const* row_ptr = subimage_bytes +
+                    (static_cast<std::size_t>(y - subtexture_y_offset) *
+                        img_width + (block_min_x - subtexture_x_offset)) *
+                    img_channels_count_;
+                for (int x = 0; x <= block_max_x - block_min_x; x++)
+                {
+                    if (row_ptr[(x + 1) * img_channels_count_ - 1] != 0xFF)
+                    {
+                        is_opaque = false;
+                        break;
+                    }
+                }
+            }
+            this->opaque_blocks_[block_y * this->opacity_blocks_per_row_ +
+                block_x] = is_opaque ? 1 : 0;
+        }
+    }
+}
@@ -5,6 +5,11 @@
 ;   This file describes the 'Texture2dArrayLayer' class that implements logic
 ;   for loading images (or subimages) onto layers of a 2D texture array.
 ;
+;   The layer also keeps a coarse opacity mask: one flag per 16x16 texels
+;   block, set if every texel of the block is known to be fully opaque. The
+;   mask is updated from the alpha channel of the uploaded pixels and lets
+;   the 'Renderer' draw opaque sprites without blending.
+;
 ; @date   April 2021
 ; @author Eph
 ;
@@ -16,6 +21,10 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <vector>
+
+#include <glm/vec4.hpp>
+
 #include "Texture2dArray.hpp"
 
 
@@ -39,9 +48,19 @@ public:
         unsigned char const* img_bytes, int img_width, int img_height,
         int img_channels_count_);
 
+    bool is_opaque(glm::vec4 const& txd_rect) const;
+
     int get_z_offset() const;
     Texture2dArray* get_texture_2d_array() const;
 private:
     int z_offset_;
     Texture2dArray* texture_2d_array_ptr_;
+    int opacity_blocks_per_row_;
+    int opacity_blocks_per_column_;
+    std::vector<unsigned char> opaque_blocks_;
+
+    void update_opacity(int subtexture_x_offset, int subtexture_y_offset,
+        int subtexture_width, int subtexture_hight,
+        unsigned char const* subimage_bytes, int img_width,
+        int img_channels_count_);
 };
\ No newline at end of file
@@ -0,0 +1,581 @@
+/**----------------------------------------------------------------------------
+; @file Tilemap.cpp
+;
+; @brief
+;   The file implements the functionality of the 'Tilemap' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+#include "Tilemap.hpp"
+#include "IndicesData.hpp"
+#include "Log.hpp"
+#include "VertexPacking.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func Tilemap
+;
+; @brief
+;   Constructor. Opens the tilemap file, builds the vertex array with all
+;   chunk slots (empty) and starts the loader thread. Nothing is loaded
+;   until the first 'update' call.
+;
+; @params
+;   file_path       | Path to the tilemap file.
+;   tileset         | Tiles of the map.
+;   tile_size       | Size of a tile in the world (in pixels).
+;   max_view_size   | The largest view the map is drawn in (in pixels).
+;
+----------------------------------------------------------------------------**/
+Tilemap::Tilemap(char const* file_path, Tileset const& tileset,
+    glm::vec2 const& tile_size, glm::vec2 const& max_view_size)
+    :chunks_count_(0), chunk_size_(0), tileset_(tileset),
+    tile_size_(tile_size),
+    vertex_array_(get_vertex_layout_info<TileVertexLayout>()),
+    keep_range_(0, 0, -1, -1), is_stopping_(false),
+    loads_count_(0)
+{
+    if (this->file_.open(file_path))
+    {
+        this->chunks_count_ = this->file_.get_chunks_count();
+        this->chunk_size_ = this->file_.get_chunk_size();
+    }
+
+    glm::vec2 chunk_pixel_size = this->get_chunk_pixel_size();
+    glm::ivec2 slots_count(3);          /* One chunk the view straddles and  */
+    if (this->chunk_size_ > 0)          /* the ring on both sides            */
+    {
+        slots_count += glm::ivec2(glm::ceil(max_view_size /
+            chunk_pixel_size));
+    }
+    std::size_t rects_count = static_cast<std::size_t>(this->chunk_size_) *
+        this->chunk_size_;
+    std::vector<TileVertexLayout::Vertex> empty_rects(rects_count * 4);
+    this->chunks_.resize(static_cast<std::size_t>(slots_count.x) *
+        slots_count.y);
+    for (std::size_t i = 0; i < this->chunks_.size(); i++)
+    {
+        this->chunks_[i] = { glm::ivec2(0), this->vertex_array_.
+            add_rects<TileVertexLayout>(empty_rects), 0, false };
+        this->free_chunks_.push_back(static_cast<unsigned int>(
+            this->chunks_.size() - 1 - i));
+    }
+    this->vertex_array_.build(true);    /* The slots are rewritten as chunks */
+                                        /* come and go                       */
+
+    this->loader_thread_ = std::thread(&Tilemap::load_chunks, this);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~Tilemap
+;
+; @brief
+;   Destructor. Stops the loader thread and deletes the indices data of the
+;   slots.
+;
+----------------------------------------------------------------------------**/
+Tilemap::~Tilemap()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->is_stopping_ = true;
+    }
+    this->condition_.notify_all();
+    this->loader_thread_.join();
+
+    for (Chunk& chunk : this->chunks_)
+    {
+        delete chunk.indices_data_ptr;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update
+;
+; @brief
+;   Follows the view: drops the chunks that are no longer around it,
+;   requests the missing ones from the loader thread (nearest to the view
+;   center first) and uploads up to 'MAX_UPLOADS_PER_UPDATE' loaded chunks.
+;   Never waits for the loader thread.
+;
+; @params
+;   view_rect   | The view rectangle in world space (min x, min y, max x,
+;               | max y).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Tilemap::update(glm::vec4 const& view_rect)
+{
+    if (this->chunks_count_.x == 0 || this->chunks_count_.y == 0)
+    {
+        return;
+    }
+
+    glm::vec2 chunk_pixel_size = this->get_chunk_pixel_size();
+    glm::ivec2 view_min = glm::ivec2(glm::floor(glm::vec2(view_rect.x,
+        view_rect.y) / chunk_pixel_size));
+    glm::ivec2 view_max = glm::ivec2(glm::floor(glm::vec2(view_rect.z,
+        view_rect.w) / chunk_pixel_size));
+    this->keep_range_ = glm::ivec4(glm::max(view_min - 1, glm::ivec2(0)),
+        glm::min(view_max + 1, this->chunks_count_ - 1));
+
+    for (std::unordered_map<std::uint64_t, unsigned int>::iterator it =
+        this->resident_chunks_.begin(); it != this->resident_chunks_.end();)
+    {                                   /* Drop the chunks left behind       */
+        Chunk& chunk = this->chunks_[it->second];
+        if (this->is_kept(chunk.coords))
+        {
+            ++it;
+            continue;
+        }
+        chunk.is_resident = false;
+        this->free_chunks_.push_back(it->second);
+        it = this->resident_chunks_.erase(it);
+    }
+
+    std::vector<glm::ivec2> missing_chunks;
+    for (int y = this->keep_range_.y; y <= this->keep_range_.w; y++)
+    {
+        for (int x = this->keep_range_.x; x <= this->keep_range_.z; x++)
+        {
+            std::uint64_t key = Tilemap::get_key(glm::ivec2(x, y));
+            if (this->resident_chunks_.count(key) == 0 &&
+                this->requested_chunks_.count(key) == 0)
+            {
+                missing_chunks.push_back(glm::ivec2(x, y));
+            }
+        }
+    }
+    glm::vec2 view_center = glm::vec2(view_rect.x + view_rect.z,
+        view_rect.y + view_rect.w) * 0.5f / chunk_pixel_size - 0.5f;
+    std::sort(missing_chunks.begin(), missing_chunks.end(),
+        [&view_center](glm::ivec2 const& a, glm::ivec2 const& b)
+        {
+            glm::vec2 delta_a = glm::vec2(a) - view_center;
+            glm::vec2 delta_b = glm::vec2(b) - view_center;
+            return glm::dot(delta_a, delta_a) < glm::dot(delta_b, delta_b);
+        });
+
+    std::vector<LoadedChunk> loaded_chunks;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        for (std::deque<glm::ivec2>::iterator it = this->requests_.begin();
+            it != this->requests_.end();)
+        {                               /* Cancel the queued requests that   */
+            if (this->is_kept(*it))     /* are not needed any more           */
+            {
+                ++it;
+                continue;
+            }
+            this->requested_chunks_.erase(Tilemap::get_key(*it));
+            it = this->requests_.erase(it);
+        }
+
+        std::size_t capacity = this->chunks_.size() -
+            this->resident_chunks_.size() - this->requested_chunks_.size();
+                                        /* Every request must find a slot    */
+        for (std::size_t i = 0; i < missing_chunks.size() && i < capacity;
+            i++)
+        {
+            this->requests_.push_back(missing_chunks[i]);
+            this->requested_chunks_.insert(Tilemap::get_key(
+                missing_chunks[i]));
+        }
+
+        while (!this->results_.empty() &&
+            loaded_chunks.size() < MAX_UPLOADS_PER_UPDATE)
+        {
+            loaded_chunks.push_back(std::move(this->results_.front()));
+            this->results_.pop_front();
+        }
+    }
+    this->condition_.notify_one();
+
+    for (LoadedChunk const& loaded_chunk : loaded_chunks)
+    {
+        std::uint64_t key = Tilemap::get_key(loaded_chunk.coords);
+        this->requested_chunks_.erase(key);
+        if (!this->is_kept(loaded_chunk.coords) ||
+            this->free_chunks_.empty())
+        {
+            continue;                   /* Left behind while being loaded    */
+        }
+
+        unsigned int slot = this->free_chunks_.back();
+        this->free_chunks_.pop_back();
+        Chunk& chunk = this->chunks_[slot];
+        this->vertex_array_.update_rects<TileVertexLayout>(
+            chunk.indices_data_ptr, loaded_chunk.vertices);
+        chunk.coords = loaded_chunk.coords;
+        chunk.tiles_count = loaded_chunk.tiles_count;
+        chunk.is_resident = true;
+        this->resident_chunks_[key] = slot;
+        this->loads_count_++;
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind
+;
+; @brief
+;   Binds the vertex array of the chunk slots.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Tilemap::bind() const
+{
+    this->vertex_array_.bind();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_chunks
+;
+; @brief
+;   Returns the chunk slots. Only the resident ones hold chunks.
+;
+; @params
+;   None
+;
+; @return
+;   std::vector<Chunk> const &  | Chunk slots.
+;
+----------------------------------------------------------------------------**/
+std::vector<Tilemap::Chunk> const& Tilemap::get_chunks() const
+{
+    return this->chunks_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_chunk_origin
+;
+; @brief
+;   Returns the top left corner of a chunk in the world.
+;
+; @params
+;   chunk   | Resident chunk.
+;
+; @return
+;   glm::vec2   | Position of the chunk (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec2 Tilemap::get_chunk_origin(Chunk const& chunk) const
+{
+    return glm::vec2(chunk.coords) * this->get_chunk_pixel_size();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_chunk_pixel_size
+;
+; @brief
+;   Returns the size of a chunk in the world.
+;
+; @params
+;   None
+;
+; @return
+;   glm::vec2   | Size of a chunk (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec2 Tilemap::get_chunk_pixel_size() const
+{
+    return this->tile_size_ * static_cast<float>(this->chunk_size_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_tileset
+;
+; @brief
+;   Returns the tileset of the map.
+;
+; @params
+;   None
+;
+; @return
+;   Tileset const & | Tileset.
+;
+----------------------------------------------------------------------------**/
+Tileset const& Tilemap::get_tileset() const
+{
+    return this->tileset_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_tile_size
+;
+; @brief
+;   Returns the size of a tile in the world.
+;
+; @params
+;   None
+;
+; @return
+;   glm::vec2   | Size of a tile (in pixels).
+;
+----------------------------------------------------------------------------**/
+glm::vec2 Tilemap::get_tile_size() const
+{
+    return this->tile_size_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_resident_chunks_count
+;
+; @brief
+;   Returns the number of chunks on the GPU.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of resident chunks.
+;
+----------------------------------------------------------------------------**/
+unsigned int Tilemap::get_resident_chunks_count() const
+{
+    return static_cast<unsigned int>(this->resident_chunks_.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_loads_count
+;
+; @brief
+;   Returns the number of chunks uploaded since the last 'reset_stats' call.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of chunk uploads.
+;
+----------------------------------------------------------------------------**/
+unsigned int Tilemap::get_loads_count() const
+{
+    return this->loads_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the loads counter.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Tilemap::reset_stats()
+{
+    this->loads_count_ = 0;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func load_chunks
+;
+; @brief
+;   The loader thread. Takes the requested chunks one by one, reads them
+;   from the file and turns them into vertices, until the tilemap is
+;   destroyed. A chunk that cannot be read is loaded empty.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Tilemap::load_chunks()
+{
+    std::vector<std::uint16_t> tiles;
+    for (;;)
+    {
+        LoadedChunk loaded_chunk;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->condition_.wait(lock, [this]
+                {
+                    return this->is_stopping_ || !this->requests_.empty();
+                });
+            if (this->is_stopping_)
+            {
+                return;
+            }
+            loaded_chunk.coords = this->requests_.front();
+            this->requests_.pop_front();
+        }
+
+        if (!this->file_.read_chunk(loaded_chunk.coords, tiles))
+        {
+            tiles.assign(static_cast<std::size_t>(this->chunk_size_) *
+                this->chunk_size_, 0);
+        }
+        this->build_chunk(tiles, loaded_chunk);
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->results_.push_back(std::move(loaded_chunk));
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func build_chunk
+;
+; @brief
+;   Builds the vertices (positions and texture vertices) of the non-empty
+;   tiles of a chunk, in the order of 'VertexArray::add_rects'. The vertices
+;   are in tile units, relative to the top left corner of the chunk. Tiles
+;   out of the tileset are skipped. The vertices are computed as floats,
+;   then packed all at once.
+;
+; @params
+;   tiles           | Tiles of the chunk, row by row from the top left.
+;   loaded_chunk    | Receives the vertices and the number of tiles.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void Tilemap::build_chunk(std::vector<std::uint16_t> const& tiles,
+    LoadedChunk& loaded_chunk) const
+{
+    glm::ivec2 const& tiles_count = this->tileset_.tiles_count;
+    glm::vec4 const& txd_rect = this->tileset_.txd_rect;
+    glm::vec2 tile_txd_size = glm::vec2(txd_rect.z, txd_rect.w) /
+        glm::vec2(tiles_count);
+    unsigned int last_tile = static_cast<unsigned int>(tiles_count.x *
+        tiles_count.y);
+
+    std::vector<glm::vec2> positions;
+    std::vector<glm::vec2> txd_positions;
+    loaded_chunk.tiles_count = 0;
+    for (int y = 0; y < this->chunk_size_; y++)
+    {
+        for (int x = 0; x < this->chunk_size_; x++)
+        {
+            unsigned int tile = tiles[static_cast<std::size_t>(y) *
+                this->chunk_size_ + x];
+            if (tile == 0 || tile > last_tile)
+            {
+                continue;
+            }
+            int column = static_cast<int>(tile - 1) % tiles_count.x;
+            int row = static_cast<int>(tile - 1) / tiles_count.x;
+            float u0 = txd_rect.x + column * tile_txd_size.x;
+            float v0 = txd_rect.y + (tiles_count.y - 1 - row) *
+                tile_txd_size.y;        /* The top row is at the top of the  */
+                                        /* region                            */
+            float u1 = u0 + tile_txd_size.x;
+            float v1 = v0 + tile_txd_size.y;
+            float x0 = static_cast<float>(x);
+            float y0 = static_cast<float>(y);
+
+            positions.insert(positions.end(),
+            {
+                { x0 + 1.0f, y0 },      /* Top right                         */
+                { x0 + 1.0f, y0 + 1.0f },
+                                        /* Bottom right                      */
+                { x0, y0 + 1.0f },      /* Bottom left                       */
+                { x0, y0 }              /* Top left                          */
+            });
+            txd_positions.insert(txd_positions.end(),
+            {
+                { u1, v1 },
+                { u1, v0 },
+                { u0, v0 },
+                { u0, v1 }
+            });
+            loaded_chunk.tiles_count++;
+        }
+    }
+
+    std::size_t vertices_count = positions.size();
+    std::vector<Half2> packed_positions(vertices_count);
+    std::vector<Unorm16x2> packed_txd_positions(vertices_count);
+    pack_half2(positions.data(), vertices_count, packed_positions.data());
+    pack_unorm16x2(txd_positions.data(), vertices_count,
+        packed_txd_positions.data());
+
+    loaded_chunk.vertices.resize(vertices_count);
+    for (std::size_t i = 0; i < vertices_count; i++)
+    {
+        loaded_chunk.vertices[i] = TileVertexLayout::Vertex(
+            packed_positions[i], packed_txd_positions[i]);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_kept
+;
+; @brief
+;   Returns whether a chunk is in the range of chunks to keep.
+;
+; @params
+;   coords  | Chunk coordinates (in chunks).
+;
+; @return
+;   bool    | true if the chunk is around the view.
+;
+----------------------------------------------------------------------------**/
+bool Tilemap::is_kept(glm::ivec2 const& coords) const
+{
+    return coords.x >= this->keep_range_.x &&
+        coords.y >= this->keep_range_.y && coords.x <= this->keep_range_.z &&
+        coords.y <= this->keep_range_.w;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_key
+;
+; @brief
+;   Packs chunk coordinates into a key of the chunk maps.
+;
+; @params
+;   coords  | Chunk coordinates (in chunks).
+;
+; @return
+;   std::uint64_t   | Key.
+;
+----------------------------------------------------------------------------**/
+std::uint64_t Tilemap::get_key(glm::ivec2 const& coords)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(coords.y))
+        << 32) | static_cast<std::uint32_t>(coords.x);
+}
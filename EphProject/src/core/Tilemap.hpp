@@ -0,0 +1,158 @@
+/**----------------------------------------------------------------------------
+; @file Tilemap.hpp
+;
+; @brief
+;   This file describes the 'Tilemap' class. This class streams a large
+;   tiled map from a tilemap file ('TilemapFile') and keeps only the chunks
+;   around the view on the GPU, so the memory and the per-frame work do not
+;   depend on the size of the map.
+;
+;   All chunks live in one 'VertexArray' built once with a fixed number of
+;   chunk slots. Each slot is an index range of chunk_size x chunk_size
+;   rectangles. A loaded chunk writes the vertices of its non-empty tiles
+;   (in tile units, relative to the chunk) and their texture vertices (the
+;   tile regions of the tileset layer), interleaved ('TileVertexLayout', both
+;   are read for every vertex) and quantized to 16 bits per component (see
+;   'VertexPacking.hpp'), to the beginning of its slot, and is drawn with
+;   one 'glDrawElements' call of just these tiles. The chunk
+;   position and the tile size are passed as the generic transform
+;   attributes, like for 'Renderer::draw_sprite'.
+;
+;   The chunks that overlap the view, plus a ring of one chunk around it,
+;   are kept. Missing ones are read and turned into vertices by a loader
+;   thread, nearest to the view first; the ones that leave the ring are
+;   dropped and their slots reused. At most 'MAX_UPLOADS_PER_UPDATE' loaded
+;   chunks are uploaded per 'update' call, which bounds the frame time spent
+;   on streaming. The number of slots is computed from the largest view
+;   size: a larger view shows missing chunks.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "TilemapFile.hpp"
+#include "VertexArray.hpp"
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+class IndicesData;
+class Texture2dArrayLayer;
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct Tileset
+{
+    Texture2dArrayLayer const* texture_2d_array_layer_ptr;
+    glm::vec4 txd_rect;                 /* Region of the tiles on the layer  */
+                                        /* (in normalized texture coords)    */
+    glm::ivec2 tiles_count;             /* Tiles per row and per column of   */
+                                        /* the region. Tile 1 is the top     */
+                                        /* left one                          */
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class Tilemap
+{
+public:
+    struct Chunk                        /* A chunk slot                      */
+    {
+        glm::ivec2 coords;              /* In chunks                         */
+        IndicesData* indices_data_ptr;  /* The index range of the slot       */
+        unsigned int tiles_count;       /* Non-empty tiles, at the beginning */
+                                        /* of the range                      */
+        bool is_resident;               /* Holds a loaded chunk              */
+    };
+
+    Tilemap(char const* file_path, Tileset const& tileset,
+        glm::vec2 const& tile_size, glm::vec2 const& max_view_size);
+    ~Tilemap();
+
+    void update(glm::vec4 const& view_rect);
+    void bind() const;
+
+    std::vector<Chunk> const& get_chunks() const;
+    glm::vec2 get_chunk_origin(Chunk const& chunk) const;
+    glm::vec2 get_chunk_pixel_size() const;
+    Tileset const& get_tileset() const;
+    glm::vec2 get_tile_size() const;
+    unsigned int get_resident_chunks_count() const;
+    unsigned int get_loads_count() const;
+    void reset_stats();
+
+    static constexpr unsigned int MAX_UPLOADS_PER_UPDATE = 4;
+
+private:
+    using TileVertexLayout = InterleavedLayout<
+        VertexAttrib<ATTRIB_POSITION, Half2>,
+        VertexAttrib<ATTRIB_TXD_POSITION, Unorm16x2>>;
+                                        /* 8 bytes per vertex: positions are */
+                                        /* small integers, texture vertices  */
+                                        /* are in [0, 1]                     */
+
+    struct LoadedChunk
+    {
+        glm::ivec2 coords;
+        unsigned int tiles_count;
+        std::vector<TileVertexLayout::Vertex> vertices;
+    };
+
+    TilemapFile file_;                  /* Read by the loader thread only    */
+    glm::ivec2 chunks_count_;
+    int chunk_size_;                    /* In tiles                          */
+    Tileset tileset_;
+    glm::vec2 tile_size_;               /* In pixels                         */
+
+    VertexArray vertex_array_;
+    std::vector<Chunk> chunks_;
+    std::vector<unsigned int> free_chunks_;
+    std::unordered_map<std::uint64_t, unsigned int> resident_chunks_;
+                                        /* Chunk key -> slot                 */
+    std::unordered_set<std::uint64_t> requested_chunks_;
+                                        /* Queued or being loaded            */
+    glm::ivec4 keep_range_;             /* Chunks to keep: min x, min y,     */
+                                        /* max x, max y (inclusive)          */
+
+    std::thread loader_thread_;
+    std::mutex mutex_;                  /* Guards the members below          */
+    std::condition_variable condition_;
+    std::deque<glm::ivec2> requests_;
+    std::deque<LoadedChunk> results_;
+    bool is_stopping_;
+
+    unsigned int loads_count_;
+
+    void load_chunks();
+    void build_chunk(std::vector<std::uint16_t> const& tiles,
+        LoadedChunk& loaded_chunk) const;
+    bool is_kept(glm::ivec2 const& coords) const;
+    static std::uint64_t get_key(glm::ivec2 const& coords);
+
+    Tilemap(const Tilemap&) = delete;
+    Tilemap& operator=(const Tilemap&) = delete;
+};
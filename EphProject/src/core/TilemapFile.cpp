@@ -0,0 +1,478 @@
+/**----------------------------------------------------------------------------
+; @file TilemapFile.cpp
+;
+; @brief
+;   The file implements the functionality of the 'TilemapFile' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "TilemapFile.hpp"
+#include "Log.hpp"
+
+
+
+/** @static_asserts  -------------------------------------------------------**/
+
+static_assert(sizeof(TilemapFileHeader) == 24,
+    "The header must have no padding: it is read and written as is.");
+static_assert(sizeof(TilemapChunkRecord) == 16,
+    "The chunk record must have no padding: it is read and written as is.");
+static_assert(sizeof(TileRun) == 4,
+    "The tile run must have no padding: it is read and written as is.");
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func TilemapFile
+;
+; @brief
+;   Constructor. No file is open.
+;
+----------------------------------------------------------------------------**/
+TilemapFile::TilemapFile()
+    :is_writing_(false), header_()
+{
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~TilemapFile
+;
+; @brief
+;   Destructor. Closes the file (see 'close').
+;
+----------------------------------------------------------------------------**/
+TilemapFile::~TilemapFile()
+{
+    this->close();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func create
+;
+; @brief
+;   Creates (or truncates) a tilemap file for writing. All chunks are empty
+;   until they are written.
+;
+; @params
+;   file_path   | Path to the file.
+;   size        | Map size (in tiles).
+;   chunk_size  | Chunk side (in tiles), 1 to 'MAX_CHUNK_SIZE'.
+;
+; @return
+;   bool    | false if the file cannot be created.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::create(char const* file_path, glm::ivec2 const& size,
+    int chunk_size)
+{
+    this->close();
+    if (size.x < 0 || size.y < 0 || chunk_size <= 0 ||
+        static_cast<std::uint32_t>(chunk_size) > TilemapFile::MAX_CHUNK_SIZE)
+    {
+        LOG_ERROR("Unable to create the tilemap file. Invalid sizes.");
+        return false;
+    }
+    this->file_.open(file_path, std::ios::in | std::ios::out |
+        std::ios::binary | std::ios::trunc);
+    if (!this->file_.is_open())
+    {
+        LOG_ERROR("Unable to create the tilemap file.");
+        return false;
+    }
+
+    std::memcpy(this->header_.magic, "EPHT", 4);
+    this->header_.version = TilemapFile::VERSION;
+    this->header_.width = static_cast<std::uint32_t>(size.x);
+    this->header_.height = static_cast<std::uint32_t>(size.y);
+    this->header_.chunk_size = static_cast<std::uint32_t>(chunk_size);
+    this->header_.reserved = 0;
+    glm::ivec2 chunks_count = this->get_chunks_count();
+    this->records_.assign(static_cast<std::size_t>(chunks_count.x) *
+        chunks_count.y, { 0, 0, 0 });
+    this->file_.write(reinterpret_cast<char const*>(&this->header_),
+        sizeof(TilemapFileHeader));
+    this->file_.write(reinterpret_cast<char const*>(this->records_.data()),
+        static_cast<std::streamsize>(this->records_.size() *
+            sizeof(TilemapChunkRecord)));
+                                        /* Reserve the table, it is written  */
+                                        /* again on 'close'                  */
+    this->is_writing_ = true;
+    return this->file_.good();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func write_chunk
+;
+; @brief
+;   Encodes the tiles of a chunk and appends them to the file. A chunk with
+;   no tiles takes no space. A chunk must be written at most once.
+;
+; @params
+;   chunk   | Chunk coordinates (in chunks).
+;   tiles   | chunk_size x chunk_size tiles, row by row from the top left.
+;
+; @return
+;   bool    | false if the chunk is out of the map or cannot be written.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::write_chunk(glm::ivec2 const& chunk,
+    std::vector<std::uint16_t> const& tiles)
+{
+    std::size_t record_index = 0;
+    if (!this->is_writing_ || !this->get_record_index(chunk, record_index) ||
+        tiles.size() != static_cast<std::size_t>(this->header_.chunk_size) *
+            this->header_.chunk_size)
+    {
+        LOG_ERROR("Unable to write the tilemap chunk.");
+        return false;
+    }
+
+    this->runs_.clear();
+    bool is_empty = true;
+    for (std::uint16_t tile : tiles)
+    {
+        is_empty = is_empty && tile == 0;
+        if (!this->runs_.empty() && this->runs_.back().tile == tile &&
+            this->runs_.back().length < 0xFFFF)
+        {
+            this->runs_.back().length++;
+            continue;
+        }
+        this->runs_.push_back({ 1, tile });
+    }
+    if (is_empty)
+    {
+        this->records_[record_index] = { 0, 0, 0 };
+        return true;
+    }
+
+    this->file_.seekp(0, std::ios::end);
+    this->records_[record_index] = { static_cast<std::uint64_t>(
+        this->file_.tellp()), static_cast<std::uint32_t>(this->runs_.size()),
+        0 };
+    this->file_.write(reinterpret_cast<char const*>(this->runs_.data()),
+        static_cast<std::streamsize>(this->runs_.size() * sizeof(TileRun)));
+    return this->file_.good();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func open
+;
+; @brief
+;   Opens a tilemap file for reading and loads its chunk table. The header
+;   and the table are checked against sane bounds and the file size before
+;   anything is allocated or read (see 'TilemapFile.hpp').
+;
+; @params
+;   file_path   | Path to the file.
+;
+; @return
+;   bool    | false if the file cannot be read, is not a tilemap file or is
+;           | corrupt.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::open(char const* file_path)
+{
+    this->close();
+    this->file_.open(file_path, std::ios::in | std::ios::binary);
+    if (!this->file_.is_open())
+    {
+        LOG_ERROR("Unable to open the tilemap file.");
+        return false;
+    }
+
+    this->file_.seekg(0, std::ios::end);
+    std::uint64_t file_size = static_cast<std::uint64_t>(
+        this->file_.tellg());
+    this->file_.seekg(0, std::ios::beg);
+
+    this->file_.read(reinterpret_cast<char*>(&this->header_),
+        sizeof(TilemapFileHeader));
+    if (!this->file_.good() ||
+        std::memcmp(this->header_.magic, "EPHT", 4) != 0 ||
+        this->header_.version != TilemapFile::VERSION)
+    {
+        LOG_ERROR("Unable to open the tilemap file. Unknown format.");
+        this->file_.close();
+        return false;
+    }
+
+    std::uint32_t chunk_size = this->header_.chunk_size;
+    if (chunk_size == 0 || chunk_size > TilemapFile::MAX_CHUNK_SIZE ||
+        this->header_.width > static_cast<std::uint32_t>(INT32_MAX) ||
+        this->header_.height > static_cast<std::uint32_t>(INT32_MAX))
+    {
+        LOG_ERROR("Unable to open the tilemap file. Invalid sizes.");
+        this->file_.close();
+        return false;
+    }
+    std::uint64_t records_count =
+        (static_cast<std::uint64_t>(this->header_.width) + chunk_size - 1) /
+        chunk_size *
+        ((static_cast<std::uint64_t>(this->header_.height) + chunk_size -
+            1) / chunk_size);           /* At most 2^46, no overflow         */
+    std::uint64_t table_end = sizeof(TilemapFileHeader) +
+        records_count * sizeof(TilemapChunkRecord);
+    if (table_end > file_size)
+    {
+        LOG_ERROR("Unable to open the tilemap file. The file is truncated.");
+        this->file_.close();
+        return false;
+    }
+
+    this->records_.resize(static_cast<std::size_t>(records_count));
+    this->file_.read(reinterpret_cast<char*>(this->records_.data()),
+        static_cast<std::streamsize>(this->records_.size() *
+            sizeof(TilemapChunkRecord)));
+    if (!this->file_.good())
+    {
+        LOG_ERROR("Unable to open the tilemap file. The file is truncated.");
+        this->file_.close();
+        this->records_.clear();
+        return false;
+    }
+
+    std::uint64_t tiles_count = static_cast<std::uint64_t>(chunk_size) *
+        chunk_size;
+    for (TilemapChunkRecord const& record : this->records_)
+    {
+        if (record.offset == 0)
+        {
+            continue;                   /* Empty chunk                       */
+        }
+        if (record.runs_count == 0 || record.runs_count > tiles_count ||
+            record.offset < table_end || record.offset > file_size ||
+            record.runs_count * sizeof(TileRun) > file_size - record.offset)
+        {                               /* A run has at least one tile       */
+            LOG_ERROR("Unable to open the tilemap file. Invalid chunk "
+                "record.");
+            this->file_.close();
+            this->records_.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func read_chunk
+;
+; @brief
+;   Reads and decodes the tiles of a chunk.
+;
+; @params
+;   chunk   | Chunk coordinates (in chunks).
+;   tiles   | Receives chunk_size x chunk_size tiles, row by row from the
+;           | top left.
+;
+; @return
+;   bool    | false if the chunk is out of the map or cannot be read.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::read_chunk(glm::ivec2 const& chunk,
+    std::vector<std::uint16_t>& tiles)
+{
+    std::size_t record_index = 0;
+    if (this->is_writing_ || !this->get_record_index(chunk, record_index))
+    {
+        LOG_ERROR("Unable to read the tilemap chunk.");
+        return false;
+    }
+
+    std::size_t tiles_count = static_cast<std::size_t>(
+        this->header_.chunk_size) * this->header_.chunk_size;
+    tiles.assign(tiles_count, 0);
+    TilemapChunkRecord const& record = this->records_[record_index];
+    if (record.offset == 0)
+    {
+        return true;                    /* Empty chunk                       */
+    }
+
+    this->runs_.resize(record.runs_count);
+    this->file_.seekg(static_cast<std::streamoff>(record.offset));
+    this->file_.read(reinterpret_cast<char*>(this->runs_.data()),
+        static_cast<std::streamsize>(this->runs_.size() * sizeof(TileRun)));
+    if (!this->file_.good())
+    {
+        LOG_ERROR("Unable to read the tilemap chunk. The file is truncated.");
+        this->file_.clear();
+        return false;
+    }
+
+    std::size_t tile_index = 0;
+    for (TileRun const& run : this->runs_)
+    {
+        std::size_t length = std::min<std::size_t>(run.length,
+            tiles_count - tile_index);  /* Ignore runs past the chunk        */
+        std::fill_n(tiles.begin() + static_cast<std::ptrdiff_t>(tile_index),
+            length, run.tile);
+        tile_index += length;
+    }
+    return true;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func close
+;
+; @brief
+;   Closes the file. If it was created, the chunk table is written first.
+;   Does nothing if no file is open.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void TilemapFile::close()
+{
+    if (!this->file_.is_open())
+    {
+        return;
+    }
+    if (this->is_writing_)
+    {
+        this->file_.seekp(sizeof(TilemapFileHeader));
+        this->file_.write(reinterpret_cast<char const*>(
+            this->records_.data()), static_cast<std::streamsize>(
+                this->records_.size() * sizeof(TilemapChunkRecord)));
+        if (!this->file_.good())
+        {
+            LOG_ERROR("Unable to write the tilemap chunk table.");
+        }
+    }
+    this->file_.close();
+    this->is_writing_ = false;
+    this->records_.clear();
+    this->records_.shrink_to_fit();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func is_open
+;
+; @brief
+;   Returns whether a file is open.
+;
+; @params
+;   None
+;
+; @return
+;   bool    | true if a file is open.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::is_open() const
+{
+    return this->file_.is_open();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_size
+;
+; @brief
+;   Returns the map size.
+;
+; @params
+;   None
+;
+; @return
+;   glm::ivec2  | Map size (in tiles).
+;
+----------------------------------------------------------------------------**/
+glm::ivec2 TilemapFile::get_size() const
+{
+    return glm::ivec2(static_cast<int>(this->header_.width),
+        static_cast<int>(this->header_.height));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_chunk_size
+;
+; @brief
+;   Returns the chunk side.
+;
+; @params
+;   None
+;
+; @return
+;   int | Chunk side (in tiles).
+;
+----------------------------------------------------------------------------**/
+int TilemapFile::get_chunk_size() const
+{
+    return static_cast<int>(this->header_.chunk_size);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_chunks_count
+;
+; @brief
+;   Returns the number of chunks along each side of the map.
+;
+; @params
+;   None
+;
+; @return
+;   glm::ivec2  | Number of chunks per row and per column.
+;
+----------------------------------------------------------------------------**/
+glm::ivec2 TilemapFile::get_chunks_count() const
+{
+    if (this->header_.chunk_size == 0)
+    {
+        return glm::ivec2(0);
+    }
+    int chunk_size = static_cast<int>(this->header_.chunk_size);
+    return (this->get_size() + chunk_size - 1) / chunk_size;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_record_index
+;
+; @brief
+;   Returns the index of a chunk in the chunk table.
+;
+; @params
+;   chunk   | Chunk coordinates (in chunks).
+;   index   | Receives the index.
+;
+; @return
+;   bool    | false if the chunk is out of the map.
+;
+----------------------------------------------------------------------------**/
+bool TilemapFile::get_record_index(glm::ivec2 const& chunk,
+    std::size_t& index) const
+{
+    glm::ivec2 chunks_count = this->get_chunks_count();
+    if (chunk.x < 0 || chunk.y < 0 || chunk.x >= chunks_count.x ||
+        chunk.y >= chunks_count.y)
+    {
+        return false;
+    }
+    index = static_cast<std::size_t>(chunk.y) * chunks_count.x + chunk.x;
+    return true;
+}
@@ -0,0 +1,117 @@
+/**----------------------------------------------------------------------------
+; @file TilemapFile.hpp
+;
+; @brief
+;   This file describes the 'TilemapFile' class. This class reads and writes
+;   the on-disk tilemap format streamed by 'Tilemap'.
+;
+;   The map is cut into square chunks of tiles. Every chunk is stored on its
+;   own, run-length encoded, so a chunk is read with one seek and one read
+;   no matter how large the map is, and uniform areas (water, sky, empty
+;   space) take a few bytes:
+;
+;       TilemapFileHeader                   magic, version, sizes
+;       TilemapChunkRecord[chunks count]    offset and runs count of every
+;                                           chunk, row by row
+;       TileRun[]                           runs of the chunks
+;
+;   A tile is a 16-bit index into the tileset; 0 is an empty tile. The tiles
+;   of a chunk are run-length encoded row by row, from the top left tile.
+;   Tiles of the edge chunks that lie outside the map are empty. All values
+;   are little-endian.
+;
+;   The chunk table is kept in memory while the file is open (16 bytes per
+;   chunk). Chunks can be written in any order: the table is written on
+;   'close'.
+;
+;   'open' does not trust the file: the chunk side must be at most
+;   'MAX_CHUNK_SIZE', the chunk table must fit in the file, and every chunk
+;   must lie after the table, within the file, with no more runs than it
+;   has tiles. A file that breaks any of these is rejected as a whole, so
+;   a corrupt header or record never turns into a huge allocation or a
+;   read past the end.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct TilemapFileHeader
+{
+    char magic[4];                      /* "EPHT"                            */
+    std::uint32_t version;
+    std::uint32_t width;                /* Map size (in tiles)               */
+    std::uint32_t height;
+    std::uint32_t chunk_size;           /* Chunk side (in tiles)             */
+    std::uint32_t reserved;
+};
+
+struct TilemapChunkRecord
+{
+    std::uint64_t offset;               /* From the beginning of the file.   */
+                                        /* 0 - the chunk is empty            */
+    std::uint32_t runs_count;
+    std::uint32_t reserved;
+};
+
+struct TileRun
+{
+    std::uint16_t length;               /* Number of tiles, at least 1       */
+    std::uint16_t tile;
+};
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class TilemapFile
+{
+public:
+    TilemapFile();
+    ~TilemapFile();
+
+    bool create(char const* file_path, glm::ivec2 const& size,
+        int chunk_size);
+    bool write_chunk(glm::ivec2 const& chunk,
+        std::vector<std::uint16_t> const& tiles);
+    bool open(char const* file_path);
+    bool read_chunk(glm::ivec2 const& chunk,
+        std::vector<std::uint16_t>& tiles);
+    void close();
+
+    bool is_open() const;
+    glm::ivec2 get_size() const;
+    int get_chunk_size() const;
+    glm::ivec2 get_chunks_count() const;
+
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t MAX_CHUNK_SIZE = 256;
+
+private:
+    std::fstream file_;
+    bool is_writing_;
+    TilemapFileHeader header_;
+    std::vector<TilemapChunkRecord> records_;
+    std::vector<TileRun> runs_;         /* Scratch buffer                    */
+
+    bool get_record_index(glm::ivec2 const& chunk, std::size_t& index) const;
+
+    TilemapFile(const TilemapFile&) = delete;
+    TilemapFile& operator=(const TilemapFile&) = delete;
+};
@@ -0,0 +1,77 @@
+/**----------------------------------------------------------------------------
+; @file UniformBlocks.hpp
+;
+; @brief
+;   This file describes the uniform blocks shared by all shader programs. Each
+;   structure mirrors a 'layout(std140)' block declared in the shaders. The
+;   std140 offsets are checked at compile time, so a change that breaks the
+;   layout fails the build instead of producing garbage on the GPU.
+;
+;   Each block has a fixed binding point ('enUniformBlockBinding'), owned by
+;   this module and shared by all renderers. A program is connected to a
+;   block with 'Shader::bind_uniform_block', a buffer is attached to the
+;   binding point by 'UniformBuffer'. After that, every program reads the
+;   same constants without any per-program upload.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enUniformBlockBinding              /* Uniform buffer binding points     */
+{
+    UNIFORM_BLOCK_FRAME = 0,
+    UNIFORM_BLOCK_VIEW = 1,
+};
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct FrameUniformBlock                /* GLSL: 'FrameBlock'                */
+{
+    float time;                         /* Seconds since the renderer was    */
+                                        /* created                           */
+    float delta_time;                   /* Seconds since the previous frame  */
+    unsigned int frame_index;
+    float padding;                      /* std140 rounds a block up to vec4  */
+};
+
+struct ViewUniformBlock                 /* GLSL: 'ViewBlock'                 */
+{
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec4 viewport;                 /* xy - offset, zw - size (in        */
+                                        /* pixels)                           */
+};
+
+
+
+/** @static_asserts --------------------------------------------------------**/
+
+static_assert(offsetof(FrameUniformBlock, time) == 0 &&
+    offsetof(FrameUniformBlock, delta_time) == 4 &&
+    offsetof(FrameUniformBlock, frame_index) == 8 &&
+    sizeof(FrameUniformBlock) == 16,
+    "'FrameUniformBlock' does not match the std140 layout of 'FrameBlock'");
+
+static_assert(offsetof(ViewUniformBlock, projection) == 0 &&
+    offsetof(ViewUniformBlock, view) == 64 &&
+    offsetof(ViewUniformBlock, viewport) == 128 &&
+    sizeof(ViewUniformBlock) == 144,
+    "'ViewUniformBlock' does not match the std140 layout of 'ViewBlock'");
@@ -0,0 +1,199 @@
+/**----------------------------------------------------------------------------
+; @file UniformBuffer.cpp
+;
+; @brief
+;   The file implements the functionality of the 'UniformBuffer' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "UniformBuffer.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
+#include "Log.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func UniformBuffer
+;
+; @brief
+;   Constructor. Allocates the buffer storage and attaches the buffer to the
+;   uniform buffer binding point.
+;
+; @params
+;   size    | Size of the buffer (in bytes). Usually the size of a block
+;           | structure from 'UniformBlocks.hpp'.
+;   binding | Uniform buffer binding point ('enUniformBlockBinding').
+;
+----------------------------------------------------------------------------**/
+UniformBuffer::UniformBuffer(std::size_t size, unsigned int binding)
+    :id_(0), size_(size), binding_(binding), updates_count_(0)
+{
+    glGenBuffers(1, &this->id_);
+    GlState::current().bind_buffer(GL_UNIFORM_BUFFER, this->id_);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr,
+        GL_DYNAMIC_DRAW);
+    this->attach();
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~UniformBuffer
+;
+; @brief
+;   Destructor. Releases the binding point if the buffer is still attached
+;   to it and deletes the buffer object.
+;
+----------------------------------------------------------------------------**/
+UniformBuffer::~UniformBuffer()
+{
+    GlState& gl_state = GlState::current();
+    if (gl_state.get_buffer_base(GL_UNIFORM_BUFFER, this->binding_) ==
+        this->id_)
+    {
+        gl_state.bind_buffer_base(GL_UNIFORM_BUFFER, this->binding_, 0);
+    }
+    glDeleteBuffers(1, &this->id_);
+    GlState::current().on_buffer_deleted(this->id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func attach
+;
+; @brief
+;   Attaches the buffer to its binding point, so the programs read this
+;   buffer instead of another buffer of the same block. Costs nothing if the
+;   buffer is still attached.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void UniformBuffer::attach() const
+{
+    GlState::current().bind_buffer_base(GL_UNIFORM_BUFFER, this->binding_,
+        this->id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update
+;
+; @brief
+;   Replaces a part of the buffer contents. All programs whose blocks are
+;   connected to the binding point see the new values.
+;
+; @params
+;   data_ptr    | The new data.
+;   size        | Size of the data (in bytes).
+;   offset      | Offset in the buffer (in bytes).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void UniformBuffer::update(void const* data_ptr, std::size_t size,
+    std::size_t offset)
+{
+    if (offset + size > this->size_)
+    {
+        LOG_ERROR("Uniform buffer update is out of range.");
+        return;
+    }
+    GlState::current().bind_buffer(GL_UNIFORM_BUFFER, this->id_);
+    glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size), data_ptr);
+    FRAME_STATS_ADD(buffer_bytes, size);
+    this->updates_count_++;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_id
+;
+; @brief
+;   Returns the buffer object id.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Buffer object id.
+;
+----------------------------------------------------------------------------**/
+unsigned int UniformBuffer::get_id() const
+{
+    return this->id_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_binding
+;
+; @brief
+;   Returns the uniform buffer binding point the buffer is attached to.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Binding point.
+;
+----------------------------------------------------------------------------**/
+unsigned int UniformBuffer::get_binding() const
+{
+    return this->binding_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_updates_count
+;
+; @brief
+;   Returns the number of 'update' calls since the last 'reset_stats'.
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | The number of uploads.
+;
+----------------------------------------------------------------------------**/
+unsigned int UniformBuffer::get_updates_count() const
+{
+    return this->updates_count_;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func reset_stats
+;
+; @brief
+;   Resets the updates counter.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void UniformBuffer::reset_stats()
+{
+    this->updates_count_ = 0;
+}
@@ -0,0 +1,54 @@
+/**----------------------------------------------------------------------------
+; @file UniformBuffer.hpp
+;
+; @brief
+;   This file describes the 'UniformBuffer' class. This class owns a uniform
+;   buffer object attached to a fixed binding point (see 'UniformBlocks.hpp').
+;   The contents are replaced with 'glBufferSubData', normally once per frame.
+;
+;   The binding points are shared by all buffers of a block: the buffer
+;   attached last is the one the programs read. A buffer is attached on
+;   construction and again with 'attach' (a no-op if it still is), and the
+;   destructor releases the binding point if the buffer still holds it.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class UniformBuffer
+{
+public:
+    UniformBuffer(std::size_t size, unsigned int binding);
+    ~UniformBuffer();
+
+    void attach() const;
+    void update(void const* data_ptr, std::size_t size,
+        std::size_t offset = 0);
+
+    unsigned int get_id() const;
+    unsigned int get_binding() const;
+    unsigned int get_updates_count() const;
+    void reset_stats();
+
+private:
+    unsigned int id_;
+    std::size_t size_;
+    unsigned int binding_;
+    unsigned int updates_count_;
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+};
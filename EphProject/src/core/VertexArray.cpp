@@ -13,10 +13,17 @@
 
 /** @includes --------------------------------------------------------------**/
 
+#include <cstddef>
+
 #include <glad/glad.h>
 
 #include "VertexArray.hpp"
+#include "CpuProfiler.hpp"
+#include "FrameStats.hpp"
+#include "GlState.hpp"
 #include "IndicesData.hpp"
+#include "SpriteInstance.hpp"
+#include "Log.hpp"
 
 
 
@@ -27,23 +34,24 @@
 ;
 ; @brief
 ;   Constructor. Generates vertex array objec and related buffer objects needed
-;   to store renderable data (vertex buffer, texture vertices buffer, indices
-;   buffer).
+;   to store renderable data (a vertex buffer per buffer of the layout,
+;   indices buffer).
+;
+; @params
+;   layout_info | The vertex layout ('get_vertex_layout_info'). Positions
+;               | and texture vertices in two buffers by default.
 ;
 ----------------------------------------------------------------------------**/
-VertexArray::VertexArray()
-    :id_(0), vbo_vertices_(0), vbo_texture_vertices_(0), ibo_(0), 
-    next_free_index_number_(0)
+VertexArray::VertexArray(VertexLayoutInfo const& layout_info)
+    :layout_info_(layout_info), id_(0), vbos_(), ibo_(0),
+    next_free_index_number_(0), instance_buffer_id_(0),
+    instance_buffer_offset_(0), color_buffer_id_(0), color_buffer_offset_(0)
 {
     glGenVertexArrays(1, &this->id_);   /* Generate a verex array object     */
 
-    glGenBuffers(1, &this->vbo_vertices_);
-                                        /* Generate a buffer object to store */
-                                        /* positions of the vertices         */
-
-    glGenBuffers(1, &this->vbo_texture_vertices_);
-                                        /* Generate a buffer object to store */
-                                        /* texture coordinates               */
+    glGenBuffers(this->layout_info_.buffers_count, this->vbos_);
+                                        /* Generate buffer objects to store  */
+                                        /* the vertices                      */
 
     glGenBuffers(1, &this->ibo_);       /* Generate a buffer object to store */
                                         /* the vertex indices                */
@@ -55,7 +63,7 @@ VertexArray::VertexArray()
 ;
 ; @brief
 ;   Destructor. Deletes vertex array object and related buffer objects (vertex
-;   buffer object, texture vertices buffer object, indices buffer object).
+;   buffer objects, indices buffer object).
 ;
 ;   Note: According to the OpenGL documentation, deleting a currently bound
 ;   buffer unbinds it implicitly.
@@ -64,9 +72,16 @@ VertexArray::VertexArray()
 VertexArray::~VertexArray()
 {
     glDeleteVertexArrays(1, &this->id_);
-    glDeleteBuffers(1, &vbo_vertices_);
-    glDeleteBuffers(1, &this->vbo_texture_vertices_);
+    glDeleteBuffers(this->layout_info_.buffers_count, this->vbos_);
     glDeleteBuffers(1, &this->ibo_);
+
+    GlState& gl_state = GlState::current();
+    gl_state.on_vertex_array_deleted(this->id_);
+    for (unsigned int i = 0; i < this->layout_info_.buffers_count; i++)
+    {
+        gl_state.on_buffer_deleted(this->vbos_[i]);
+    }
+    gl_state.on_buffer_deleted(this->ibo_);
 }
 
 
@@ -78,7 +93,8 @@ VertexArray::~VertexArray()
 ;   from which the vertex array will be constructed. Generates an array of
 ;   indices corresponding to the received vertices. Creates an object of
 ;   'IndicesData' class that contains the data needed to draw the added
-;   rectangle.
+;   rectangle. The vertex array must have the default layout
+;   ('TexturedVertexLayout'), see 'add_rects' for the others.
 ;   For each textured rect, there are:
 ;    - 8 elements of a vertex array (i.e. 4 vertices of the rectangle, 2
 ;      coordinates (x, y) for each);
@@ -90,55 +106,63 @@ VertexArray::~VertexArray()
 ; @params
 ;   vertices           | Local coordinates of the vertices of the rectangle(s).
 ;   texture_vertices   | The coordinates of the vertices of the texture.
+;                      | Must have the same size as 'vertices', a multiple
+;                      | of eight.
 ;
 ; @return
 ;   IndicesData*    | Data for drawing the added rectangle(s) (using the
 ;                   | 'glDrawElements' function).
 ;
-; // TODO: Add a check of the sizes of incoming vectors for a multiple of
-;          eight.
-;
 ----------------------------------------------------------------------------**/
 IndicesData* VertexArray::add_textured_rects(
     std::vector<float> const& vertices,
     std::vector<float> const& texture_vertices)
 {
-    int rects_number = vertices.size() / 8;
-                                        /* 4 points in 2d space (i.e. 8      */
-                                        /* values) are used to describe one  */
-                                        /* rectangle.                        */
-    int used_indices_items_number = rects_number * 6;
-                                        /* The number of elements used in    */
-                                        /* the 'indices_' array. 6 elements  */
-                                        /* per rectangle.                    */
-
-    int indices_offset = this->indices_.size() * sizeof(unsigned int);
-                                        /* Offset (in bytes) to the first    */
-                                        /* unused element of the 'indices_'  */
-                                        /* array.                            */
-
-    this->vertices_.insert(this->vertices_.end(), vertices.begin(),
-        vertices.end());                /* Store the received vertices       */
+    if (texture_vertices.size() != vertices.size() ||
+        vertices.size() % 8 != 0)
+    {
+        LOG_ERROR("Unable to add textured rects. The vertices do not make \
+whole rects.");
+        return nullptr;
+    }
+    void const* vertices_ptrs[] = { vertices.data(), texture_vertices.data() };
+                                        /* Already the buffers of the layout */
+    return this->append_rects(&TexturedVertexLayout::specify_formats,
+        vertices_ptrs, vertices.size() / 2);
+}
 
-    this->texture_vertices_.insert(this->texture_vertices_.end(),
-        texture_vertices.begin(), texture_vertices.end());
-                                        /* Store the received texture        */
-                                        /* vertices                          */
 
-    for (int i = 0; i < rects_number; i++)
-    {                                   /* For each rectangle...             */
-                                        /* Build indices                     */
-        this->indices_.push_back(this->next_free_index_number_ + 0);
-        this->indices_.push_back(this->next_free_index_number_ + 1);
-        this->indices_.push_back(this->next_free_index_number_ + 3);
-        this->indices_.push_back(this->next_free_index_number_ + 1);
-        this->indices_.push_back(this->next_free_index_number_ + 2);
-        this->indices_.push_back(this->next_free_index_number_ + 3);
-        this->next_free_index_number_ += 4;
-    }
-                                        
-    return new IndicesData(GL_TRIANGLES, used_indices_items_number,
-        reinterpret_cast<void*>(indices_offset));
+/**----------------------------------------------------------------------------
+; @func add_unit_quad
+;
+; @brief
+;   Adds the unit quad: a rectangle from (0, 0) to (1, 1) with the whole
+;   texture mapped onto it. Instanced draws ('SpriteBatch', 'StaticLayer',
+;   particle systems, etc.) scale and move it per instance. The vertex array
+;   must have the default layout (see 'add_textured_rects').
+;
+; @params
+;   None
+;
+; @return
+;   IndicesData*    | Data for drawing the unit quad.
+;
+----------------------------------------------------------------------------**/
+IndicesData* VertexArray::add_unit_quad()
+{
+    return this->add_textured_rects(
+    {
+         1.0f, 0.0f,                    /* Top right                         */
+         1.0f, 1.0f,                    /* Bottom right                      */
+         0.0f, 1.0f,                    /* Bottom left                       */
+         0.0f, 0.0f                     /* Top left                          */
+    },
+    {
+         1.0f, 1.0f,                    /* Top right                         */
+         1.0f, 0.0f,                    /* Bottom right                      */
+         0.0f, 0.0f,                    /* Bottom left                       */
+         0.0f, 1.0f                     /* Top left                          */
+    });
 }
 
 
@@ -146,58 +170,50 @@ IndicesData* VertexArray::add_textured_rects(
 ; @func build
 ;
 ; @brief
-;   Fills OpenGL buffer objects (vertices, texture vertices and indices) with
-;   data (i.e., sends this data to the GPU). Binds these buffer objects to a
-;   vertex array. Removes data that was sent to the GPU from RAM.
+;   Fills OpenGL buffer objects (vertices and indices) with data (i.e., sends
+;   this data to the GPU). Binds these buffer objects to a vertex array and
+;   specifies the attribute formats of the layout. Removes data that was sent
+;   to the GPU from RAM.
 ;
 ; @params
-;   None
+;   is_dynamic  | Whether the vertices will be rewritten with
+;               | 'update_rects'. false by default.
 ;
 ; @return
 ;   None
 ;
-; // TODO: Create and use constants as attribute indices (0 for vertices, 1 for
-;          texture coordinates).
-;
 ----------------------------------------------------------------------------**/
-void VertexArray::build()
+void VertexArray::build(bool is_dynamic)
 {
-    int bound_vertex_array_object;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &bound_vertex_array_object);
+    CPU_PROFILE_SCOPE("VertexArray::build");
+    GLenum vertices_usage = is_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+
+    GlState& gl_state = GlState::current();
+    unsigned int bound_vertex_array_object = gl_state.get_vertex_array();
                                         /* Save the current vertex array     */
                                         /* object name to restore it after   */
                                         /* the function has been processed   */
+                                        /* (cached, no pipeline sync)        */
 
     this->bind();                       /* Bind a vertex array object        */
                                         /* related to this class object      */
 
-    glBindBuffer(GL_ARRAY_BUFFER, this->vbo_vertices_);
-                                        /* Bind 'vbo_vertices_' to           */
-                                        /* GL_ARRAY_BUFFER. All following    */
-                                        /* calls to GL_ARRAY_BUFFER will     */
-                                        /* refer to this 'vbo_vertices_'     */
-                                        /* object.                           */
-
-    glBufferData(GL_ARRAY_BUFFER, this->vertices_.size() * sizeof(float),
-        this->vertices_.data(), GL_STATIC_DRAW);
-                                        /* Put data from 'vertices_' into    */
-                                        /* GL_ARRAY_BUFFER (i.e. into        */
-                                        /* 'vbo_vertices_')                  */
-
-    glBindBuffer(GL_ARRAY_BUFFER, this->vbo_texture_vertices_);
-                                        /* Bind 'vbo_texture_vertices_' to   */
-                                        /* GL_ARRAY_BUFFER. All following    */
-                                        /* calls to GL_ARRAY_BUFFER will     */
-                                        /* refer to this                     */
-                                        /* 'vbo_texture_vertices_' object.   */
-
-    glBufferData(GL_ARRAY_BUFFER, this->texture_vertices_.size() *
-        sizeof(float), this->texture_vertices_.data(), GL_STATIC_DRAW);
-                                        /* Put data from 'txd_vertices' into */
-                                        /* GL_ARRAY_BUFFER (i.e. into        */
-                                        /* 'vbo_texture_vertices_')          */
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ibo_);
+    unsigned long long uploaded_size = 0;
+    for (unsigned int i = 0; i < this->layout_info_.buffers_count; i++)
+    {
+        gl_state.bind_buffer(GL_ARRAY_BUFFER, this->vbos_[i]);
+        glBufferData(GL_ARRAY_BUFFER, this->vertices_[i].size(),
+            this->vertices_[i].data(), vertices_usage);
+                                        /* Put the vertices of the i-th      */
+                                        /* buffer of the layout into it      */
+        glBindVertexBuffer(BINDING_VERTICES + i, this->vbos_[i], 0,
+            static_cast<GLsizei>(this->layout_info_.strides[i]));
+                                        /* Bind it to vertex array 'id_' at  */
+                                        /* index 'BINDING_VERTICES + i'      */
+        uploaded_size += this->vertices_[i].size();
+    }
+
+    gl_state.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, this->ibo_);
                                         /* Bind 'ibo_' to                    */
                                         /* GL_ELEMENT_ARRAY_BUFFER. All      */
                                         /* following calls to                */
@@ -209,18 +225,16 @@ void VertexArray::build()
                                         /* Put data from 'indices_' into     */
                                         /* GL_ELEMENT_ARRAY_BUFFER (i.e.     */
                                         /* into 'ibo_')                      */
+    FRAME_STATS_ADD(buffer_bytes, uploaded_size + this->indices_.size() *
+        sizeof(unsigned int));
 
-    glBindVertexBuffer(0, this->vbo_vertices_, 0, sizeof(GLfloat) * 2);
-                                        /* Bind 'vbo_vertices_' to vertex    */
-                                        /* array 'id_' at index 0.           */
-
-    glBindVertexBuffer(1, this->vbo_texture_vertices_, 0, sizeof(GLfloat) * 2);
-                                        /* Bind 'vbo_texture_vertices_' to   */
-                                        /* vertex array 'id_' at index 1.    */
+    this->layout_info_.specify_formats_func(BINDING_VERTICES);
+                                        /* Describe the layout of the        */
+                                        /* attributes (generated from the    */
+                                        /* layout type)                      */
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);   /* Buffers can be unbound from       */
+    gl_state.bind_buffer(GL_ARRAY_BUFFER, 0);
+                                        /* Buffers can be unbound from       */
                                         /* 'GL_ARRAY_BUFFER', since their    */
                                         /* contents are already sent to the  */
                                         /* GPU (as vertex array elements)    */
@@ -234,21 +248,61 @@ void VertexArray::build()
                                         /* vertex array 'id_' is bound       */
 
 
-    glBindVertexArray(bound_vertex_array_object);  
+    gl_state.bind_vertex_array(bound_vertex_array_object);
                                         /* Restore the vertex array that was */
                                         /* bound before the function call    */
-    
-    this->vertices_.clear();            /* All this data is already in the   */
-    this->texture_vertices_.clear();    /* GPU. Remove it from RAM           */
+
+    for (unsigned int i = 0; i < this->layout_info_.buffers_count; i++)
+    {                                   /* All this data is already in the   */
+        this->vertices_[i].clear();     /* GPU. Remove it from RAM           */
+    }
     this->indices_.clear();
 }
 
 
+/**----------------------------------------------------------------------------
+; @func update_textured_rects
+;
+; @brief
+;   Rewrites the vertices and texture vertices of rectangles that are already
+;   on the GPU, starting with the first rectangle of an index range. The
+;   indices are not changed, so the new rectangles are drawn by the same
+;   'IndicesData' (or by a part of it). Fewer rectangles than the range has
+;   may be written: the rest keep their old vertices. The vertex array must
+;   have the default layout ('TexturedVertexLayout'), see 'update_rects' for
+;   the others.
+;
+; @params
+;   indices_data_ptr    | Index range returned by 'add_textured_rects' before
+;                       | the build.
+;   vertices            | New vertices (8 values per rectangle).
+;   texture_vertices    | New texture vertices (8 values per rectangle).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void VertexArray::update_textured_rects(IndicesData const* indices_data_ptr,
+    std::vector<float> const& vertices,
+    std::vector<float> const& texture_vertices) const
+{
+    if (texture_vertices.size() != vertices.size())
+    {
+        LOG_ERROR("Unable to update textured rects. The rects do not match \
+the index range.");
+        return;
+    }
+    void const* vertices_ptrs[] = { vertices.data(), texture_vertices.data() };
+    this->write_rects(&TexturedVertexLayout::specify_formats,
+        indices_data_ptr, vertices_ptrs, vertices.size() / 2);
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func bind
 ;
 ; @brief
-;   Binds this vertex array object.
+;   Binds this vertex array object. Does nothing if it is already bound.
 ;
 ; @params
 ;   None
@@ -259,5 +313,290 @@ void VertexArray::build()
 ----------------------------------------------------------------------------**/
 void VertexArray::bind() const
 {
-    glBindVertexArray(this->id_);
+    GlState::current().bind_vertex_array(this->id_);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_instance_buffer
+;
+; @brief
+;   Binds this vertex array object and attaches a buffer of 'SpriteInstance'
+;   elements to it. The per-instance attributes ('ATTRIB_INSTANCE_TRANSFORM',
+;   'ATTRIB_INSTANCE_TRANSLATION', 'ATTRIB_INSTANCE_TXD_RECT',
+;   'ATTRIB_INSTANCE_Z_OFFSET', 'ATTRIB_INSTANCE_DEPTH') advance once per
+;   instance. The vertex array stays bound after the call.
+;
+;   The attribute formats are specified once, on the first attachment. The
+;   buffer binding is only updated when the buffer or the offset changes.
+;
+;   If no instance buffer is attached, these attributes are disabled and the
+;   shader reads their current generic values (see 'glVertexAttrib*'). This is
+;   how 'Renderer::draw_sprite' passes the per-draw data. A vertex array that
+;   is drawn both ways must be detached after the instanced draws (see
+;   'detach_instance_buffer'), since the generic values are ignored while the
+;   arrays are enabled.
+;
+; @params
+;   buffer_id   | Buffer object that contains 'SpriteInstance' elements.
+;   offset      | Offset (in bytes) to the first element in the buffer.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void VertexArray::bind_instance_buffer(unsigned int buffer_id,
+    std::intptr_t offset) const
+{
+    this->bind();
+
+    if (this->instance_buffer_id_ == buffer_id &&
+        this->instance_buffer_offset_ == offset)
+    {
+        return;
+    }
+    glBindVertexBuffer(BINDING_INSTANCES, buffer_id, offset,
+        sizeof(SpriteInstance));
+    if (this->instance_buffer_id_ != 0)
+    {                                   /* The formats are already specified */
+        this->instance_buffer_id_ = buffer_id;
+        this->instance_buffer_offset_ = offset;
+        return;
+    }
+    this->instance_buffer_id_ = buffer_id;
+    this->instance_buffer_offset_ = offset;
+
+    glVertexBindingDivisor(BINDING_INSTANCES, 1);
+                                        /* Advance once per instance         */
+
+    glVertexAttribFormat(ATTRIB_INSTANCE_TRANSFORM, 4, GL_FLOAT, GL_FALSE,
+        offsetof(SpriteInstance, transform));
+    glVertexAttribFormat(ATTRIB_INSTANCE_TRANSLATION, 2, GL_FLOAT, GL_FALSE,
+        offsetof(SpriteInstance, translation));
+    glVertexAttribFormat(ATTRIB_INSTANCE_TXD_RECT, 4, GL_FLOAT, GL_FALSE,
+        offsetof(SpriteInstance, txd_rect));
+    glVertexAttribIFormat(ATTRIB_INSTANCE_Z_OFFSET, 1, GL_INT,
+        offsetof(SpriteInstance, z_offset));
+    glVertexAttribFormat(ATTRIB_INSTANCE_DEPTH, 1, GL_FLOAT, GL_FALSE,
+        offsetof(SpriteInstance, depth));
+
+    glVertexAttribBinding(ATTRIB_INSTANCE_TRANSFORM, BINDING_INSTANCES);
+    glVertexAttribBinding(ATTRIB_INSTANCE_TRANSLATION, BINDING_INSTANCES);
+    glVertexAttribBinding(ATTRIB_INSTANCE_TXD_RECT, BINDING_INSTANCES);
+    glVertexAttribBinding(ATTRIB_INSTANCE_Z_OFFSET, BINDING_INSTANCES);
+    glVertexAttribBinding(ATTRIB_INSTANCE_DEPTH, BINDING_INSTANCES);
+
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_TRANSFORM);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_TRANSLATION);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_TXD_RECT);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_Z_OFFSET);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_DEPTH);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func detach_instance_buffer
+;
+; @brief
+;   Binds this vertex array object and disables the per-instance attributes
+;   attached by 'bind_instance_buffer', so the shader reads their generic
+;   values again. The next 'bind_instance_buffer' call enables them. The
+;   vertex array stays bound after the call.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void VertexArray::detach_instance_buffer() const
+{
+    this->bind();
+
+    if (this->instance_buffer_id_ == 0)
+    {
+        return;
+    }
+    this->instance_buffer_id_ = 0;
+    this->instance_buffer_offset_ = 0;
+
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_TRANSFORM);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_TRANSLATION);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_TXD_RECT);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_Z_OFFSET);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_DEPTH);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func bind_color_buffer
+;
+; @brief
+;   Binds this vertex array object and attaches a buffer of per-instance
+;   colors to it (4 unsigned bytes per instance, RGBA, normalized). The
+;   'ATTRIB_INSTANCE_COLOR' attribute advances once per instance. The vertex
+;   array stays bound after the call.
+;
+;   Like in 'bind_instance_buffer', the format is specified on the first
+;   attachment and the binding is only updated when it changes. Without a
+;   color buffer the shader reads the generic value of the attribute, which
+;   the renderer keeps white.
+;
+; @params
+;   buffer_id   | Buffer object that contains the colors.
+;   offset      | Offset (in bytes) to the first color in the buffer.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void VertexArray::bind_color_buffer(unsigned int buffer_id,
+    std::intptr_t offset) const
+{
+    this->bind();
+
+    if (this->color_buffer_id_ == buffer_id &&
+        this->color_buffer_offset_ == offset)
+    {
+        return;
+    }
+    glBindVertexBuffer(BINDING_INSTANCE_COLORS, buffer_id, offset, 4);
+    bool is_first_attachment = this->color_buffer_id_ == 0;
+    this->color_buffer_id_ = buffer_id;
+    this->color_buffer_offset_ = offset;
+    if (!is_first_attachment)
+    {                                   /* The format is already specified   */
+        return;
+    }
+
+    glVertexBindingDivisor(BINDING_INSTANCE_COLORS, 1);
+                                        /* Advance once per instance         */
+    glVertexAttribFormat(ATTRIB_INSTANCE_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+        0);
+    glVertexAttribBinding(ATTRIB_INSTANCE_COLOR, BINDING_INSTANCE_COLORS);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_COLOR);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func append_rects
+;
+; @brief
+;   Appends the vertices of rectangles, already in the buffers of the layout,
+;   to the data the vertex array will be built from, and generates their
+;   indices (see 'add_textured_rects').
+;
+; @params
+;   specify_formats_func    | 'specify_formats' of the layout of the
+;                           | vertices, must be the layout of the array.
+;   vertices_ptrs           | The vertices of each buffer of the layout.
+;   vertices_count          | Number of vertices (4 per rectangle).
+;
+; @return
+;   IndicesData*    | Data for drawing the added rectangle(s), nullptr if
+;                   | the layout does not match.
+;
+----------------------------------------------------------------------------**/
+IndicesData* VertexArray::append_rects(
+    void(*specify_formats_func)(unsigned int),
+    void const* const* vertices_ptrs, std::size_t vertices_count)
+{
+    if (specify_formats_func != this->layout_info_.specify_formats_func)
+    {
+        LOG_ERROR("Unable to add rects. The vertex layout does not match \
+the layout of the vertex array.");
+        return nullptr;
+    }
+
+    int rects_number = static_cast<int>(vertices_count / 4);
+                                        /* 4 vertices are used to describe   */
+                                        /* one rectangle.                    */
+    int used_indices_items_number = rects_number * 6;
+                                        /* The number of elements used in    */
+                                        /* the 'indices_' array. 6 elements  */
+                                        /* per rectangle.                    */
+
+    int indices_offset = this->indices_.size() * sizeof(unsigned int);
+                                        /* Offset (in bytes) to the first    */
+                                        /* unused element of the 'indices_'  */
+                                        /* array.                            */
+
+    for (unsigned int i = 0; i < this->layout_info_.buffers_count; i++)
+    {                                   /* Store the received vertices       */
+        unsigned char const* data_ptr =
+            static_cast<unsigned char const*>(vertices_ptrs[i]);
+        this->vertices_[i].insert(this->vertices_[i].end(), data_ptr,
+            data_ptr + vertices_count * this->layout_info_.strides[i]);
+    }
+
+    for (int i = 0; i < rects_number; i++)
+    {                                   /* For each rectangle...             */
+                                        /* Build indices                     */
+        this->indices_.push_back(this->next_free_index_number_ + 0);
+        this->indices_.push_back(this->next_free_index_number_ + 1);
+        this->indices_.push_back(this->next_free_index_number_ + 3);
+        this->indices_.push_back(this->next_free_index_number_ + 1);
+        this->indices_.push_back(this->next_free_index_number_ + 2);
+        this->indices_.push_back(this->next_free_index_number_ + 3);
+        this->next_free_index_number_ += 4;
+    }
+
+    return new IndicesData(GL_TRIANGLES, used_indices_items_number,
+        reinterpret_cast<void*>(indices_offset), this);
+}
+
+
+/**----------------------------------------------------------------------------
+; @func write_rects
+;
+; @brief
+;   Rewrites the vertices of rectangles of an index range on the GPU, one
+;   'glBufferSubData' call per buffer of the layout (see
+;   'update_textured_rects').
+;
+; @params
+;   specify_formats_func    | 'specify_formats' of the layout of the
+;                           | vertices, must be the layout of the array.
+;   indices_data_ptr        | Index range returned by 'add_rects'.
+;   vertices_ptrs           | The vertices of each buffer of the layout.
+;   vertices_count          | Number of vertices (4 per rectangle), at most
+;                           | as many as the range holds.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void VertexArray::write_rects(void(*specify_formats_func)(unsigned int),
+    IndicesData const* indices_data_ptr, void const* const* vertices_ptrs,
+    std::size_t vertices_count) const
+{
+    if (specify_formats_func != this->layout_info_.specify_formats_func)
+    {
+        LOG_ERROR("Unable to update rects. The vertex layout does not match \
+the layout of the vertex array.");
+        return;
+    }
+    if (vertices_count > indices_data_ptr->count / 6 * 4)
+    {
+        LOG_ERROR("Unable to update rects. The rects do not match the index \
+range.");
+        return;
+    }
+
+    std::size_t first_vertex =
+        reinterpret_cast<std::uintptr_t>(indices_data_ptr->offset) /
+        sizeof(unsigned int) / 6 * 4;   /* 6 indices and 4 vertices per     */
+                                        /* rectangle                         */
+    GlState& gl_state = GlState::current();
+    for (unsigned int i = 0; i < this->layout_info_.buffers_count; i++)
+    {
+        std::size_t stride = this->layout_info_.strides[i];
+        gl_state.bind_buffer(GL_ARRAY_BUFFER, this->vbos_[i]);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first_vertex *
+            stride), static_cast<GLsizeiptr>(vertices_count * stride),
+            vertices_ptrs[i]);
+        FRAME_STATS_ADD(buffer_bytes, vertices_count * stride);
+    }
+    gl_state.bind_buffer(GL_ARRAY_BUFFER, 0);
 }
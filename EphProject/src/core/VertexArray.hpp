@@ -7,23 +7,33 @@
 ;
 ;   Creation of a vertex array is implemented in the constructor of the
 ;   class and consists in generating a vertex array object and related buffer
-;   objects needed to store renderable data (vertex buffer, texture vertices
-;   buffer, indices buffer).
+;   objects needed to store renderable data (a vertex buffer per buffer of
+;   the vertex layout, see 'VertexLayout.hpp', and an indices buffer). The
+;   layout is 'TexturedVertexLayout' (positions and texture vertices in two
+;   buffers) by default. Layouts of static geometry can store quantized
+;   attributes (half floats, normalized shorts, 10_10_10_2) to save memory.
 ;
-;   Filling a vertex array with data is implemented in the 'add_textured_rects'
-;   method and consists in adding vertices to the data required to build the
+;   Filling a vertex array with data is implemented in the 'add_rects'
+;   method (any layout) and the 'add_textured_rects' method (the default
+;   layout, 'add_unit_quad' for the quad all instanced draws share) and
+;   consists in adding vertices to the data required to build the
 ;   vertex array, generating an array of indices corresponding to this
 ;   vertices and creating an object of 'IndicesData' class that contains the
 ;   data needed to draw the added rectangle.
 ;
 ;   Building of a vertex array is:
-;       - filling in OpenGL buffer objects (vertices, texture vertices and)
-;         indices with data (i.e., sending this data to the GPU)
-;       - binding these buffer objects to a vertex array.
+;       - filling in OpenGL buffer objects (vertices and indices) with data
+;         (i.e., sending this data to the GPU)
+;       - binding these buffer objects to a vertex array and specifying the
+;         attribute formats of the layout.
 ;
 ;   Freeing a vertex array consists in unbinding and deleting the vertex array
 ;   object and related buffers.
 ;
+;   The vertices of rectangles added before the build can be rewritten later
+;   ('update_rects', 'update_textured_rects'), e.g. to reuse an index range
+;   for other contents. Such a vertex array should be built as dynamic.
+;
 ; @date   May 2021
 ; @author Eph
 ;
@@ -35,8 +45,11 @@
 
 /** @includes --------------------------------------------------------------**/
 
+#include <cstdint>
 #include <vector>
 
+#include "VertexLayout.hpp"
+
 
 
 /** @type_declarations -----------------------------------------------------**/
@@ -50,23 +63,122 @@ class IndicesData;
 class VertexArray
 {
 public:
-    VertexArray();
+    VertexArray(VertexLayoutInfo const& layout_info =
+        get_vertex_layout_info<TexturedVertexLayout>());
     ~VertexArray();
     IndicesData* add_textured_rects(std::vector<float> const& vertices,
                            std::vector<float> const& texture_vertices);
-
-    void build();
+    IndicesData* add_unit_quad();
+    template <typename Layout>
+    IndicesData* add_rects(
+        std::vector<typename Layout::Vertex> const& vertices);
+
+    void build(bool is_dynamic = false);
+    void update_textured_rects(IndicesData const* indices_data_ptr,
+        std::vector<float> const& vertices,
+        std::vector<float> const& texture_vertices) const;
+    template <typename Layout>
+    void update_rects(IndicesData const* indices_data_ptr,
+        std::vector<typename Layout::Vertex> const& vertices) const;
     void bind() const;
+    void bind_instance_buffer(unsigned int buffer_id,
+        std::intptr_t offset) const;
+    void detach_instance_buffer() const;
+    void bind_color_buffer(unsigned int buffer_id,
+        std::intptr_t offset) const;
 
 private:
+    VertexLayoutInfo layout_info_;
     unsigned int id_;
-    unsigned int vbo_vertices_;
-    unsigned int vbo_texture_vertices_;
+    unsigned int vbos_[VertexLayoutInfo::MAX_BUFFERS_COUNT];
+                                        /* One per buffer of the layout      */
     unsigned int ibo_;
 
-    std::vector<float> vertices_;
-    std::vector<float> texture_vertices_;
+    std::vector<unsigned char> vertices_[VertexLayoutInfo::MAX_BUFFERS_COUNT];
     std::vector<unsigned int> indices_;
 
     unsigned int next_free_index_number_;
+
+    mutable unsigned int instance_buffer_id_;
+    mutable std::intptr_t instance_buffer_offset_;
+    mutable unsigned int color_buffer_id_;
+    mutable std::intptr_t color_buffer_offset_;
+
+    IndicesData* append_rects(void(*specify_formats_func)(unsigned int),
+        void const* const* vertices_ptrs, std::size_t vertices_count);
+    void write_rects(void(*specify_formats_func)(unsigned int),
+        IndicesData const* indices_data_ptr, void const* const* vertices_ptrs,
+        std::size_t vertices_count) const;
+
+    VertexArray(const VertexArray&) = delete;
+    VertexArray& operator=(const VertexArray&) = delete;
 };
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func add_rects
+;
+; @brief
+;   Adds the vertices of rectangles in any layout, 4 vertices per rectangle
+;   in the order of 'add_textured_rects'. The layout must be the one the
+;   vertex array was created with.
+;
+; @params
+;   Layout      | Vertex layout of the vertex array.
+;   vertices    | The vertices (4 per rectangle).
+;
+; @return
+;   IndicesData*    | Data for drawing the added rectangle(s).
+;
+----------------------------------------------------------------------------**/
+template <typename Layout>
+IndicesData* VertexArray::add_rects(
+    std::vector<typename Layout::Vertex> const& vertices)
+{
+    std::vector<unsigned char> buffers[Layout::BUFFERS_COUNT];
+    void const* vertices_ptrs[Layout::BUFFERS_COUNT];
+    Layout::pack(vertices.data(), vertices.size(), buffers);
+    for (unsigned int i = 0; i < Layout::BUFFERS_COUNT; i++)
+    {
+        vertices_ptrs[i] = buffers[i].data();
+    }
+    return this->append_rects(&Layout::specify_formats, vertices_ptrs,
+        vertices.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func update_rects
+;
+; @brief
+;   Rewrites the vertices of rectangles added before the build, like
+;   'update_textured_rects', in any layout. The layout must be the one the
+;   vertex array was created with.
+;
+; @params
+;   Layout              | Vertex layout of the vertex array.
+;   indices_data_ptr    | Index range returned by 'add_rects'.
+;   vertices            | New vertices (4 per rectangle), at most as many
+;                       | as the range holds.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+template <typename Layout>
+void VertexArray::update_rects(IndicesData const* indices_data_ptr,
+    std::vector<typename Layout::Vertex> const& vertices) const
+{
+    std::vector<unsigned char> buffers[Layout::BUFFERS_COUNT];
+    void const* vertices_ptrs[Layout::BUFFERS_COUNT];
+    Layout::pack(vertices.data(), vertices.size(), buffers);
+    for (unsigned int i = 0; i < Layout::BUFFERS_COUNT; i++)
+    {
+        vertices_ptrs[i] = buffers[i].data();
+    }
+    this->write_rects(&Layout::specify_formats, indices_data_ptr,
+        vertices_ptrs, vertices.size());
+}
@@ -0,0 +1,84 @@
+/**----------------------------------------------------------------------------
+; @file VertexLayout.cpp
+;
+; @brief
+;   The file implements the OpenGL part of the vertex layouts.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <glad/glad.h>
+
+#include "VertexLayout.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func specify_vertex_attrib_format
+;
+; @brief
+;   Specifies the format of a vertex attribute of the bound vertex array,
+;   attaches the attribute to a vertex buffer binding and enables it. Called
+;   by the layouts with constant arguments (see 'specify_vertex_attrib').
+;
+; @params
+;   index               | Attribute index ('enVertexAttribute').
+;   components_count    | Number of components (1 - 4).
+;   component_type      | Type of a component in the buffer.
+;   is_normalized       | Whether integer components are mapped to [0, 1].
+;   is_integer          | Whether the shader reads the attribute as integer.
+;   binding             | Vertex buffer binding index.
+;   offset              | Offset of the attribute in a vertex (in bytes).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void specify_vertex_attrib_format(unsigned int index, int components_count,
+    enVertexComponentType component_type, bool is_normalized,
+    bool is_integer, unsigned int binding, std::size_t offset)
+{
+    GLenum type = GL_FLOAT;
+    switch (component_type)
+    {
+    case VERTEX_COMPONENT_FLOAT:
+        type = GL_FLOAT;
+        break;
+    case VERTEX_COMPONENT_INT:
+        type = GL_INT;
+        break;
+    case VERTEX_COMPONENT_UNSIGNED_BYTE:
+        type = GL_UNSIGNED_BYTE;
+        break;
+    case VERTEX_COMPONENT_HALF_FLOAT:
+        type = GL_HALF_FLOAT;
+        break;
+    case VERTEX_COMPONENT_UNSIGNED_SHORT:
+        type = GL_UNSIGNED_SHORT;
+        break;
+    case VERTEX_COMPONENT_UNSIGNED_INT_2_10_10_10_REV:
+        type = GL_UNSIGNED_INT_2_10_10_10_REV;
+        break;
+    }
+
+    GLuint relative_offset = static_cast<GLuint>(offset);
+    if (is_integer)
+    {
+        glVertexAttribIFormat(index, components_count, type, relative_offset);
+    }
+    else
+    {
+        glVertexAttribFormat(index, components_count, type,
+            is_normalized ? GL_TRUE : GL_FALSE, relative_offset);
+    }
+    glVertexAttribBinding(index, binding);
+    glEnableVertexAttribArray(index);
+}
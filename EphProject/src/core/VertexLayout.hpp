@@ -0,0 +1,435 @@
+/**----------------------------------------------------------------------------
+; @file VertexLayout.hpp
+;
+; @brief
+;   This file describes the vertex layouts of 'VertexArray'. A layout is a
+;   type: a list of attributes, each an attribute index ('enVertexAttribute')
+;   and the C++ type of its value, e.g.
+;
+;       using TileVertexLayout = InterleavedLayout<
+;           VertexAttrib<ATTRIB_POSITION, glm::vec2>,
+;           VertexAttrib<ATTRIB_TXD_POSITION, glm::vec2>>;
+;
+;   The number of components, the component type and the normalization of an
+;   attribute come from its value type ('VertexAttribTraits'). The strides
+;   and offsets are computed at compile time, and 'specify_formats' expands
+;   to one 'glVertexAttribFormat' call per attribute with constant
+;   arguments, so a layout costs no more than the hand-written calls.
+;
+;   Two arrangements of the same attributes are available:
+;       - 'InterleavedLayout' - one buffer, all attributes of a vertex next
+;         to each other. A vertex is fetched from one place, which suits
+;         meshes whose attributes are read together
+;       - 'SplitLayout' - one buffer per attribute. An attribute can be
+;         rewritten, or left out of a pass, without touching the others
+;   Buffer i of a layout is attached to the binding 'BINDING_VERTICES + i'.
+;
+;   A vertex is passed as 'Layout::Vertex', a tuple of the attribute values
+;   in the order of the attributes. 'Layout::pack' writes vertices into the
+;   buffers of the layout.
+;
+;   New value types (e.g. a color or a layer number) are supported by a
+;   specialization of 'VertexAttribTraits'.
+;
+;   Besides 32-bit floats, attributes can be stored quantized, read by the
+;   shader as floats all the same:
+;       - 'Half2' - two 16-bit floats, for positions in pixels or tiles
+;         (integers are exact up to 2048)
+;       - 'Unorm16x2' - two normalized 16-bit unsigned integers, for values
+;         in [0, 1] such as texture vertices (1 / 65535 steps)
+;       - 'Unorm1010102' - normalized 10-bit x, y, z and 2-bit w in 32 bits,
+;         for directions, colors or weights
+;   They are filled from floats by the functions of 'VertexPacking.hpp'.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
+
+
+
+/** @enums -----------------------------------------------------------------**/
+
+enum enVertexAttribute                  /* Vertex attribute indices used by  */
+{                                       /* the shaders                       */
+    ATTRIB_POSITION = 0,
+    ATTRIB_TXD_POSITION = 1,
+    ATTRIB_INSTANCE_TRANSFORM = 2,
+    ATTRIB_INSTANCE_TXD_RECT = 3,
+    ATTRIB_INSTANCE_Z_OFFSET = 4,
+    ATTRIB_INSTANCE_DEPTH = 5,
+    ATTRIB_INSTANCE_TRANSLATION = 6,
+    ATTRIB_INSTANCE_COLOR = 7,
+};
+
+enum enVertexBinding                    /* Vertex buffer binding indices     */
+{
+    BINDING_INSTANCES = 0,
+    BINDING_INSTANCE_COLORS = 1,
+    BINDING_VERTICES = 2,               /* The first buffer of a layout, the */
+                                        /* next ones follow                  */
+};
+
+enum enVertexComponentType
+{
+    VERTEX_COMPONENT_FLOAT = 0,
+    VERTEX_COMPONENT_INT = 1,
+    VERTEX_COMPONENT_UNSIGNED_BYTE = 2,
+    VERTEX_COMPONENT_HALF_FLOAT = 3,
+    VERTEX_COMPONENT_UNSIGNED_SHORT = 4,
+    VERTEX_COMPONENT_UNSIGNED_INT_2_10_10_10_REV = 5,
+};
+
+
+
+/** @structs ---------------------------------------------------------------**/
+
+struct Half2                            /* IEEE 754 half floats              */
+{
+    std::uint16_t x;
+    std::uint16_t y;
+};
+
+struct Unorm16x2                        /* value * 65535                     */
+{
+    std::uint16_t x;
+    std::uint16_t y;
+};
+
+struct Unorm1010102                     /* x in bits 0 - 9, y in 10 - 19,    */
+{                                       /* z in 20 - 29, w in 30 - 31        */
+    std::uint32_t xyzw;
+};
+
+template <typename T>
+struct VertexAttribTraits;              /* Specialized per value type        */
+
+template <>
+struct VertexAttribTraits<float>
+{
+    static constexpr int COMPONENTS_COUNT = 1;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_FLOAT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<glm::vec2>
+{
+    static constexpr int COMPONENTS_COUNT = 2;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_FLOAT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<glm::vec3>
+{
+    static constexpr int COMPONENTS_COUNT = 3;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_FLOAT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<glm::vec4>
+{
+    static constexpr int COMPONENTS_COUNT = 4;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_FLOAT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<int>          /* Read as 'int' by the shader, e.g. */
+{                                       /* a texture 2d array layer          */
+    static constexpr int COMPONENTS_COUNT = 1;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_INT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = true;
+};
+
+template <>
+struct VertexAttribTraits<glm::u8vec4>  /* RGBA8 color, read as 'vec4' in    */
+{                                       /* [0, 1]                            */
+    static constexpr int COMPONENTS_COUNT = 4;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_UNSIGNED_BYTE;
+    static constexpr bool IS_NORMALIZED = true;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<Half2>
+{
+    static constexpr int COMPONENTS_COUNT = 2;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_HALF_FLOAT;
+    static constexpr bool IS_NORMALIZED = false;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<Unorm16x2>
+{
+    static constexpr int COMPONENTS_COUNT = 2;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_UNSIGNED_SHORT;
+    static constexpr bool IS_NORMALIZED = true;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <>
+struct VertexAttribTraits<Unorm1010102>
+{
+    static constexpr int COMPONENTS_COUNT = 4;
+    static constexpr enVertexComponentType COMPONENT_TYPE =
+        VERTEX_COMPONENT_UNSIGNED_INT_2_10_10_10_REV;
+    static constexpr bool IS_NORMALIZED = true;
+    static constexpr bool IS_INTEGER = false;
+};
+
+template <enVertexAttribute Index, typename T>
+struct VertexAttrib
+{
+    using Type = T;
+    using Traits = VertexAttribTraits<T>;
+
+    static constexpr enVertexAttribute INDEX = Index;
+    static constexpr std::size_t SIZE = sizeof(T);
+};
+
+struct VertexLayoutInfo                 /* What 'VertexArray' keeps of a     */
+{                                       /* layout                            */
+    static constexpr unsigned int MAX_BUFFERS_COUNT = 4;
+
+    unsigned int buffers_count;
+    std::size_t strides[MAX_BUFFERS_COUNT];
+                                        /* Vertex size in each buffer        */
+    void(*specify_formats_func)(unsigned int first_binding);
+                                        /* Identifies the layout too         */
+};
+
+
+
+/** @static_asserts --------------------------------------------------------**/
+
+static_assert(sizeof(Half2) == 4 && sizeof(Unorm16x2) == 4 &&
+    sizeof(Unorm1010102) == 4, "Packed vertex values must not be padded");
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void specify_vertex_attrib_format(unsigned int index, int components_count,
+    enVertexComponentType component_type, bool is_normalized,
+    bool is_integer, unsigned int binding, std::size_t offset);
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func specify_vertex_attrib
+;
+; @brief
+;   Specifies the format of an attribute, attaches it to a binding and
+;   enables it. The vertex array must be bound.
+;
+; @params
+;   Attrib      | The attribute ('VertexAttrib').
+;   Offset      | Offset of the attribute in a vertex (in bytes).
+;   binding     | Vertex buffer binding index the attribute is read from.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+template <typename Attrib, std::size_t Offset>
+inline void specify_vertex_attrib(unsigned int binding)
+{
+    specify_vertex_attrib_format(Attrib::INDEX,
+        Attrib::Traits::COMPONENTS_COUNT, Attrib::Traits::COMPONENT_TYPE,
+        Attrib::Traits::IS_NORMALIZED, Attrib::Traits::IS_INTEGER, binding,
+        Offset);
+}
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+template <typename... Attribs>
+class InterleavedLayout
+{
+public:
+    using Vertex = std::tuple<typename Attribs::Type...>;
+
+    static constexpr unsigned int BUFFERS_COUNT = 1;
+    static constexpr std::size_t VERTEX_SIZE = (Attribs::SIZE + ...);
+
+    static constexpr std::size_t get_stride(unsigned int)
+    {
+        return VERTEX_SIZE;
+    }
+
+    static constexpr std::size_t get_offset(std::size_t attrib_number)
+    {
+        std::size_t const sizes[] = { Attribs::SIZE... };
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < attrib_number; i++)
+        {
+            offset += sizes[i];
+        }
+        return offset;
+    }
+
+    static void specify_formats(unsigned int first_binding)
+    {
+        specify_attrib_formats(first_binding,
+            std::index_sequence_for<Attribs...>());
+    }
+
+    static void pack(Vertex const* vertices_ptr, std::size_t vertices_count,
+        std::vector<unsigned char>* buffers_ptr)
+    {
+        buffers_ptr[0].resize(vertices_count * VERTEX_SIZE);
+        unsigned char* data_ptr = buffers_ptr[0].data();
+        for (std::size_t i = 0; i < vertices_count; i++)
+        {
+            pack_vertex(vertices_ptr[i], data_ptr + i * VERTEX_SIZE,
+                std::index_sequence_for<Attribs...>());
+        }
+    }
+
+private:
+    template <std::size_t... I>
+    static void specify_attrib_formats(unsigned int first_binding,
+        std::index_sequence<I...>)
+    {
+        (specify_vertex_attrib<Attribs, get_offset(I)>(first_binding), ...);
+    }
+
+    template <std::size_t... I>
+    static void pack_vertex(Vertex const& vertex, unsigned char* data_ptr,
+        std::index_sequence<I...>)
+    {
+        (std::memcpy(data_ptr + get_offset(I), &std::get<I>(vertex),
+            Attribs::SIZE), ...);
+    }
+};
+
+template <typename... Attribs>
+class SplitLayout
+{
+public:
+    using Vertex = std::tuple<typename Attribs::Type...>;
+
+    static constexpr unsigned int BUFFERS_COUNT = sizeof...(Attribs);
+    static constexpr std::size_t VERTEX_SIZE = (Attribs::SIZE + ...);
+
+    static_assert(BUFFERS_COUNT <= VertexLayoutInfo::MAX_BUFFERS_COUNT,
+        "Too many attributes for a split vertex layout");
+
+    static constexpr std::size_t get_stride(unsigned int buffer)
+    {
+        std::size_t const sizes[] = { Attribs::SIZE... };
+        return sizes[buffer];
+    }
+
+    static void specify_formats(unsigned int first_binding)
+    {
+        specify_attrib_formats(first_binding,
+            std::index_sequence_for<Attribs...>());
+    }
+
+    static void pack(Vertex const* vertices_ptr, std::size_t vertices_count,
+        std::vector<unsigned char>* buffers_ptr)
+    {
+        pack_attribs(vertices_ptr, vertices_count, buffers_ptr,
+            std::index_sequence_for<Attribs...>());
+    }
+
+private:
+    template <std::size_t... I>
+    static void specify_attrib_formats(unsigned int first_binding,
+        std::index_sequence<I...>)
+    {
+        (specify_vertex_attrib<Attribs, 0>(first_binding +
+            static_cast<unsigned int>(I)), ...);
+    }
+
+    template <std::size_t... I>
+    static void pack_attribs(Vertex const* vertices_ptr,
+        std::size_t vertices_count, std::vector<unsigned char>* buffers_ptr,
+        std::index_sequence<I...>)
+    {
+        (buffers_ptr[I].resize(vertices_count * Attribs::SIZE), ...);
+        for (std::size_t i = 0; i < vertices_count; i++)
+        {
+            (std::memcpy(buffers_ptr[I].data() + i * Attribs::SIZE,
+                &std::get<I>(vertices_ptr[i]), Attribs::SIZE), ...);
+        }
+    }
+};
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func get_vertex_layout_info
+;
+; @brief
+;   Returns the description of a layout that 'VertexArray' keeps.
+;
+; @params
+;   Layout  | 'InterleavedLayout' or 'SplitLayout'.
+;
+; @return
+;   VertexLayoutInfo    | The buffers count, the strides and the function
+;                       | that specifies the attribute formats.
+;
+----------------------------------------------------------------------------**/
+template <typename Layout>
+constexpr VertexLayoutInfo get_vertex_layout_info()
+{
+    VertexLayoutInfo layout_info = { Layout::BUFFERS_COUNT, {},
+        &Layout::specify_formats };
+    for (unsigned int i = 0; i < Layout::BUFFERS_COUNT; i++)
+    {
+        layout_info.strides[i] = Layout::get_stride(i);
+    }
+    return layout_info;
+}
+
+
+
+/** @type_declarations -----------------------------------------------------**/
+
+using TexturedVertexLayout = SplitLayout<
+    VertexAttrib<ATTRIB_POSITION, glm::vec2>,
+    VertexAttrib<ATTRIB_TXD_POSITION, glm::vec2>>;
+                                        /* See 'add_textured_rects'          */
@@ -0,0 +1,414 @@
+/**----------------------------------------------------------------------------
+; @file VertexPacking.cpp
+;
+; @brief
+;   The file implements the vertex packing functions.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @defines ---------------------------------------------------------------**/
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PACKING_SSE2
+#endif
+
+#if defined(PACKING_SSE2) && (defined(__F16C__) || \
+    (defined(_MSC_VER) && defined(__AVX2__)))
+    #define PACKING_F16C                /* MSVC has no F16C macro, but every */
+#endif                                  /* AVX2 CPU has the instructions     */
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(PACKING_F16C)
+    #include <immintrin.h>
+#elif defined(PACKING_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#include "VertexPacking.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func float_to_half
+;
+; @brief
+;   Converts a float to a half float, rounding to nearest even. Normal
+;   results are rounded by adding the bias of the dropped mantissa bits,
+;   subnormal ones by letting the FPU align the mantissa to a magic number.
+;
+; @params
+;   value   | The float.
+;
+; @return
+;   std::uint16_t   | Bits of the half float.
+;
+----------------------------------------------------------------------------**/
+static std::uint16_t float_to_half(float value)
+{
+    std::uint32_t const F32_INFINITY = 255u << 23;
+    std::uint32_t const F16_MAX = (127u + 16u) << 23;
+                                        /* Smallest float that overflows     */
+    std::uint32_t const F16_MIN_NORMAL = (127u - 14u) << 23;
+    std::uint32_t const SUBNORMAL_MAGIC = ((127u - 15u) + (23u - 10u) + 1u)
+        << 23;
+
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    std::uint32_t half = 0;
+    if (bits >= F16_MAX)
+    {
+        half = bits > F32_INFINITY ? 0x7e00u : 0x7c00u;
+                                        /* NaN or infinity                   */
+    }
+    else if (bits < F16_MIN_NORMAL)
+    {
+        float magic = 0.0f;
+        float abs_value = 0.0f;
+        std::memcpy(&magic, &SUBNORMAL_MAGIC, sizeof(magic));
+        std::memcpy(&abs_value, &bits, sizeof(abs_value));
+        abs_value += magic;
+        std::memcpy(&half, &abs_value, sizeof(half));
+        half -= SUBNORMAL_MAGIC;
+    }
+    else
+    {
+        std::uint32_t mantissa_odd = (bits >> 13) & 1u;
+        bits += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xfffu;
+        bits += mantissa_odd;
+        half = bits >> 13;
+    }
+    return static_cast<std::uint16_t>(half | (sign >> 16));
+}
+
+
+/**----------------------------------------------------------------------------
+; @func float_to_unorm
+;
+; @brief
+;   Converts a float to a normalized unsigned integer, rounding to nearest
+;   even like the SIMD conversions do.
+;
+; @params
+;   value   | The float, clamped to [0, 1] (NaN gives 0).
+;   max     | The largest integer (e.g. 65535 for 16 bits).
+;
+; @return
+;   std::uint32_t   | The integer.
+;
+----------------------------------------------------------------------------**/
+static std::uint32_t float_to_unorm(float value, float max)
+{
+    if (!(value > 0.0f))
+    {
+        value = 0.0f;
+    }
+    else if (value > 1.0f)
+    {
+        value = 1.0f;
+    }
+    return static_cast<std::uint32_t>(std::nearbyint(value * max));
+}
+
+
+#if defined(PACKING_SSE2) && !defined(PACKING_F16C)
+
+/**----------------------------------------------------------------------------
+; @func float_to_half_sse2
+;
+; @brief
+;   Converts 4 floats to half floats, like 'float_to_half' with both branches
+;   computed and selected by masks.
+;
+; @params
+;   values  | The floats.
+;
+; @return
+;   __m128i | Bits of the half floats in the low 16 bits of each lane, sign
+;           | extended, ready for '_mm_packs_epi32'.
+;
+----------------------------------------------------------------------------**/
+static __m128i float_to_half_sse2(__m128 values)
+{
+    __m128i const subnormal_magic = _mm_set1_epi32(
+        ((127 - 15) + (23 - 10) + 1) << 23);
+
+    __m128 sign = _mm_and_ps(values, _mm_castsi128_ps(
+        _mm_set1_epi32(static_cast<int>(0x80000000u))));
+    __m128 abs_values = _mm_xor_ps(values, sign);
+    __m128i bits = _mm_castps_si128(abs_values);
+
+    __m128i is_regular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23),
+        bits);
+    __m128i is_subnormal = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23),
+        bits);
+    __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(
+        _mm_castps_si128(_mm_cmpunord_ps(abs_values, abs_values)),
+        _mm_set1_epi32(0x200)));        /* Infinity, or NaN                  */
+
+    __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(abs_values,
+        _mm_castsi128_ps(subnormal_magic))), subnormal_magic);
+    __m128i mantissa_odd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+                                        /* -1 if odd                         */
+    __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits,
+        _mm_set1_epi32(0xfff - ((127 - 15) << 23))), mantissa_odd), 13);
+
+    __m128i half = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+        _mm_andnot_si128(is_subnormal, normal));
+    half = _mm_or_si128(_mm_and_si128(is_regular, half),
+        _mm_andnot_si128(is_regular, special));
+    return _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+#endif
+
+
+#if defined(PACKING_SSE2)
+
+/**----------------------------------------------------------------------------
+; @func float_to_unorm_sse2
+;
+; @brief
+;   Converts 4 floats to normalized unsigned integers, like
+;   'float_to_unorm'.
+;
+; @params
+;   values  | The floats.
+;   max     | The largest integer in every lane.
+;
+; @return
+;   __m128i | The integers.
+;
+----------------------------------------------------------------------------**/
+static __m128i float_to_unorm_sse2(__m128 values, __m128 max)
+{
+    values = _mm_min_ps(_mm_max_ps(values, _mm_setzero_ps()),
+        _mm_set1_ps(1.0f));             /* 'maxps' returns 0 for NaN         */
+    return _mm_cvtps_epi32(_mm_mul_ps(values, max));
+}
+
+#endif
+
+
+/**----------------------------------------------------------------------------
+; @func pack_half2
+;
+; @brief
+;   Converts an array of 2d vectors to half floats.
+;
+; @params
+;   values_ptr      | The vectors.
+;   values_count    | Number of vectors.
+;   packed_ptr      | Output: 'values_count' packed vectors.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void pack_half2(glm::vec2 const* values_ptr, std::size_t values_count,
+    Half2* packed_ptr)
+{
+    float const* floats_ptr = &values_ptr->x;
+    std::uint16_t* halves_ptr = &packed_ptr->x;
+    std::size_t floats_count = values_count * 2;
+    std::size_t i = 0;
+
+#if defined(PACKING_F16C)
+    for (; i + 8 <= floats_count; i += 8)
+    {
+        __m128i low = _mm_cvtps_ph(_mm_loadu_ps(floats_ptr + i),
+            _MM_FROUND_TO_NEAREST_INT);
+        __m128i high = _mm_cvtps_ph(_mm_loadu_ps(floats_ptr + i + 4),
+            _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(halves_ptr + i),
+            _mm_unpacklo_epi64(low, high));
+    }
+#elif defined(PACKING_SSE2)
+    for (; i + 8 <= floats_count; i += 8)
+    {
+        __m128i low = float_to_half_sse2(_mm_loadu_ps(floats_ptr + i));
+        __m128i high = float_to_half_sse2(_mm_loadu_ps(floats_ptr + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(halves_ptr + i),
+            _mm_packs_epi32(low, high));
+    }
+#endif
+
+    for (; i < floats_count; i++)       /* The tail (or everything if there  */
+    {                                   /* is no SIMD kernel)                */
+        halves_ptr[i] = float_to_half(floats_ptr[i]);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func pack_unorm16x2
+;
+; @brief
+;   Converts an array of 2d vectors in [0, 1] to normalized 16-bit integers.
+;
+; @params
+;   values_ptr      | The vectors.
+;   values_count    | Number of vectors.
+;   packed_ptr      | Output: 'values_count' packed vectors.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void pack_unorm16x2(glm::vec2 const* values_ptr, std::size_t values_count,
+    Unorm16x2* packed_ptr)
+{
+    float const* floats_ptr = &values_ptr->x;
+    std::uint16_t* integers_ptr = &packed_ptr->x;
+    std::size_t floats_count = values_count * 2;
+    std::size_t i = 0;
+
+#if defined(PACKING_SSE2)
+    __m128 max = _mm_set1_ps(65535.0f);
+    __m128i bias = _mm_set1_epi32(32768);
+    for (; i + 8 <= floats_count; i += 8)
+    {
+        __m128i low = _mm_sub_epi32(float_to_unorm_sse2(
+            _mm_loadu_ps(floats_ptr + i), max), bias);
+        __m128i high = _mm_sub_epi32(float_to_unorm_sse2(
+            _mm_loadu_ps(floats_ptr + i + 4), max), bias);
+                                        /* SSE2 only packs to signed 16 bits */
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(integers_ptr + i),
+            _mm_xor_si128(_mm_packs_epi32(low, high), _mm_set1_epi16(
+                static_cast<short>(0x8000))));
+    }
+#endif
+
+    for (; i < floats_count; i++)
+    {
+        integers_ptr[i] = static_cast<std::uint16_t>(float_to_unorm(
+            floats_ptr[i], 65535.0f));
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func pack_unorm1010102
+;
+; @brief
+;   Converts an array of 4d vectors in [0, 1] to normalized 10-bit x, y, z
+;   and 2-bit w.
+;
+; @params
+;   values_ptr      | The vectors.
+;   values_count    | Number of vectors.
+;   packed_ptr      | Output: 'values_count' packed vectors.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void pack_unorm1010102(glm::vec4 const* values_ptr, std::size_t values_count,
+    Unorm1010102* packed_ptr)
+{
+    std::size_t i = 0;
+
+#if defined(PACKING_SSE2)
+    __m128 max_xyz = _mm_set1_ps(1023.0f);
+    __m128 max_w = _mm_set1_ps(3.0f);
+    for (; i + 4 <= values_count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&values_ptr[i].x);
+        __m128 y = _mm_loadu_ps(&values_ptr[i + 1].x);
+        __m128 z = _mm_loadu_ps(&values_ptr[i + 2].x);
+        __m128 w = _mm_loadu_ps(&values_ptr[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);  /* One component of 4 vectors each   */
+
+        __m128i xyzw = _mm_or_si128(
+            _mm_or_si128(float_to_unorm_sse2(x, max_xyz),
+                _mm_slli_epi32(float_to_unorm_sse2(y, max_xyz), 10)),
+            _mm_or_si128(_mm_slli_epi32(float_to_unorm_sse2(z, max_xyz), 20),
+                _mm_slli_epi32(float_to_unorm_sse2(w, max_w), 30)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&packed_ptr[i].xyzw),
+            xyzw);
+    }
+#endif
+
+    for (; i < values_count; i++)
+    {
+        packed_ptr[i] = pack_unorm1010102(values_ptr[i]);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func pack_half2
+;
+; @brief
+;   Converts a 2d vector to half floats.
+;
+; @params
+;   value   | The vector.
+;
+; @return
+;   Half2   | The packed vector.
+;
+----------------------------------------------------------------------------**/
+Half2 pack_half2(glm::vec2 const& value)
+{
+    return { float_to_half(value.x), float_to_half(value.y) };
+}
+
+
+/**----------------------------------------------------------------------------
+; @func pack_unorm16x2
+;
+; @brief
+;   Converts a 2d vector in [0, 1] to normalized 16-bit integers.
+;
+; @params
+;   value   | The vector.
+;
+; @return
+;   Unorm16x2   | The packed vector.
+;
+----------------------------------------------------------------------------**/
+Unorm16x2 pack_unorm16x2(glm::vec2 const& value)
+{
+    return { static_cast<std::uint16_t>(float_to_unorm(value.x, 65535.0f)),
+        static_cast<std::uint16_t>(float_to_unorm(value.y, 65535.0f)) };
+}
+
+
+/**----------------------------------------------------------------------------
+; @func pack_unorm1010102
+;
+; @brief
+;   Converts a 4d vector in [0, 1] to normalized 10-bit x, y, z and 2-bit w.
+;
+; @params
+;   value   | The vector.
+;
+; @return
+;   Unorm1010102    | The packed vector.
+;
+----------------------------------------------------------------------------**/
+Unorm1010102 pack_unorm1010102(glm::vec4 const& value)
+{
+    return { float_to_unorm(value.x, 1023.0f) |
+        float_to_unorm(value.y, 1023.0f) << 10 |
+        float_to_unorm(value.z, 1023.0f) << 20 |
+        float_to_unorm(value.w, 3.0f) << 30 };
+}
@@ -0,0 +1,50 @@
+/**----------------------------------------------------------------------------
+; @file VertexPacking.hpp
+;
+; @brief
+;   This file describes the functions that quantize float vertex values into
+;   the packed attribute types of 'VertexLayout.hpp' ('Half2', 'Unorm16x2',
+;   'Unorm1010102'), so static geometry takes half the memory (or less) on
+;   the GPU and in the vertex fetch.
+;
+;   The array functions convert 4 vectors per step with SSE2, or with the
+;   F16C conversion instruction for halves when it is available; the
+;   kernel is selected at compile time like in 'SpriteCuller'. The
+;   rounding is to nearest even in all paths, so the SIMD and the scalar
+;   results are the same:
+;       - halves: overflow gives infinity, tiny values give subnormals, NaN
+;         stays NaN (F16C keeps more of its payload bits)
+;       - normalized values: clamped to [0, 1] first, NaN gives 0
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <cstddef>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "VertexLayout.hpp"
+
+
+
+/** @function_prototypes ---------------------------------------------------**/
+
+void pack_half2(glm::vec2 const* values_ptr, std::size_t values_count,
+    Half2* packed_ptr);
+void pack_unorm16x2(glm::vec2 const* values_ptr, std::size_t values_count,
+    Unorm16x2* packed_ptr);
+void pack_unorm1010102(glm::vec4 const* values_ptr, std::size_t values_count,
+    Unorm1010102* packed_ptr);
+
+Half2 pack_half2(glm::vec2 const& value);
+Unorm16x2 pack_unorm16x2(glm::vec2 const& value);
+Unorm1010102 pack_unorm1010102(glm::vec4 const& value);
@@ -0,0 +1,222 @@
+/**----------------------------------------------------------------------------
+; @file WorkerPool.cpp
+;
+; @brief
+;   The file implements the functionality of the 'WorkerPool' class.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <algorithm>
+
+#include "WorkerPool.hpp"
+#include "CpuProfiler.hpp"
+
+
+
+/** @functions  ------------------------------------------------------------**/
+
+/**----------------------------------------------------------------------------
+; @func WorkerPool
+;
+; @brief
+;   Constructor. Starts the worker threads.
+;
+; @params
+;   threads_count   | Number of worker threads. 0 - one less than the number
+;                   | of hardware threads (the caller is the last one).
+;
+----------------------------------------------------------------------------**/
+WorkerPool::WorkerPool(unsigned int threads_count)
+    :job_ptr_(nullptr), items_count_(0), slices_count_(0),
+    next_slice_(0), pending_slices_count_(0), generation_(0),
+    is_stopping_(false)
+{
+    if (threads_count == 0)
+    {
+        unsigned int hardware_threads_count =
+            std::thread::hardware_concurrency();
+        threads_count = hardware_threads_count > 1 ?
+            hardware_threads_count - 1 : 0;
+    }
+    for (unsigned int i = 0; i < threads_count; i++)
+    {
+        this->threads_.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func ~WorkerPool
+;
+; @brief
+;   Destructor. Stops and joins the worker threads.
+;
+----------------------------------------------------------------------------**/
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->is_stopping_ = true;
+    }
+    this->start_condition_.notify_all();
+    for (std::thread& thread : this->threads_)
+    {
+        thread.join();
+    }
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run
+;
+; @brief
+;   Calls the job for consecutive slices of [0, items_count) on the worker
+;   threads and the calling thread, and returns when all slices are done.
+;   The slices do not overlap, so the job may write to its slice of shared
+;   arrays without locking.
+;
+; @params
+;   items_count     | Number of items to be processed.
+;   min_slice_size  | The smallest number of items worth a thread. The range
+;                   | is not split into slices smaller than that.
+;   job             | Function called with the first and one past the last
+;                   | item of a slice.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void WorkerPool::run(std::size_t items_count, std::size_t min_slice_size,
+    std::function<void(std::size_t, std::size_t)> const& job)
+{
+    std::size_t slices_count = std::min<std::size_t>(
+        this->threads_.size() + 1, items_count / std::max<std::size_t>(
+            min_slice_size, 1));
+    if (slices_count <= 1)
+    {                                   /* Not worth waking anybody up       */
+        job(0, items_count);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->job_ptr_ = &job;
+    this->items_count_ = items_count;
+    this->slices_count_ = static_cast<unsigned int>(slices_count);
+    this->next_slice_ = 0;
+    this->pending_slices_count_ = this->slices_count_;
+    this->generation_++;
+    this->start_condition_.notify_all();
+
+    this->run_slices(lock);             /* Take part in the run              */
+    this->done_condition_.wait(lock, [this]
+    {
+        return this->pending_slices_count_ == 0;
+    });
+    this->job_ptr_ = nullptr;
+}
+
+
+/**----------------------------------------------------------------------------
+; @func get_threads_count
+;
+; @brief
+;   Returns the number of worker threads (not counting the caller of 'run').
+;
+; @params
+;   None
+;
+; @return
+;   unsigned int    | Number of worker threads.
+;
+----------------------------------------------------------------------------**/
+unsigned int WorkerPool::get_threads_count() const
+{
+    return static_cast<unsigned int>(this->threads_.size());
+}
+
+
+/**----------------------------------------------------------------------------
+; @func work
+;
+; @brief
+;   Worker thread body. Sleeps until a run is started, takes part in it and
+;   sleeps again, until the pool is destroyed.
+;
+; @params
+;   None
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void WorkerPool::work()
+{
+    CPU_PROFILE_THREAD("worker");
+    unsigned long long seen_generation = 0;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+
+    while (true)
+    {
+        this->start_condition_.wait(lock, [this, seen_generation]
+        {
+            return this->is_stopping_ ||
+                this->generation_ != seen_generation;
+        });
+        if (this->is_stopping_)
+        {
+            return;
+        }
+        seen_generation = this->generation_;
+        this->run_slices(lock);         /* Nothing left if the thread woke   */
+    }                                   /* up late                           */
+}
+
+
+/**----------------------------------------------------------------------------
+; @func run_slices
+;
+; @brief
+;   Takes the slices of the current run one by one and calls the job for
+;   them with the mutex unlocked. Signals the caller of 'run' when the last
+;   slice is done.
+;
+; @params
+;   lock    | Lock of 'mutex_', held on entry and on return.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void WorkerPool::run_slices(std::unique_lock<std::mutex>& lock)
+{
+    while (this->next_slice_ < this->slices_count_)
+    {
+        std::size_t slice = this->next_slice_++;
+        std::size_t begin = this->items_count_ * slice / this->slices_count_;
+        std::size_t end = this->items_count_ * (slice + 1) /
+            this->slices_count_;        /* Sizes differ by one at most, and  */
+                                        /* none is empty: there are no more  */
+                                        /* slices than items                 */
+        std::function<void(std::size_t, std::size_t)> const* job_ptr =
+            this->job_ptr_;
+
+        lock.unlock();
+        {
+            CPU_PROFILE_SCOPE("WorkerPool slice");
+            (*job_ptr)(begin, end);
+        }
+        lock.lock();
+
+        if (--this->pending_slices_count_ == 0)
+        {
+            this->done_condition_.notify_one();
+        }
+    }
+}
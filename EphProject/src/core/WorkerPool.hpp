@@ -0,0 +1,69 @@
+/**----------------------------------------------------------------------------
+; @file WorkerPool.hpp
+;
+; @brief
+;   This file describes the 'WorkerPool' class. This class keeps a fixed set
+;   of worker threads and splits a range of items between them and the
+;   calling thread ('run'), i.e. a blocking parallel for.
+;
+;   The threads are created once and sleep on a condition variable between
+;   the runs, so a run costs a wake-up and no thread creation. The range is
+;   cut into at most one slice per thread (workers and the caller); a range
+;   too small to be worth the wake-up is processed by the caller alone.
+;
+;   One run at a time: 'run' must not be called concurrently or from inside
+;   a job.
+;
+; @date   October 2026
+; @author Eph
+;
+----------------------------------------------------------------------------**/
+
+#pragma once
+
+
+
+/** @includes  -------------------------------------------------------------**/
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+/** @classes ---------------------------------------------------------------**/
+
+class WorkerPool
+{
+public:
+    WorkerPool(unsigned int threads_count = 0);
+    ~WorkerPool();
+
+    void run(std::size_t items_count, std::size_t min_slice_size,
+        std::function<void(std::size_t, std::size_t)> const& job);
+
+    unsigned int get_threads_count() const;
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_condition_;
+    std::condition_variable done_condition_;
+
+    std::function<void(std::size_t, std::size_t)> const* job_ptr_;
+    std::size_t items_count_;           /* The current run (guarded by       */
+    unsigned int slices_count_;         /* 'mutex_')                         */
+    unsigned int next_slice_;
+    unsigned int pending_slices_count_;
+    unsigned long long generation_;     /* Incremented by each run           */
+    bool is_stopping_;
+
+    void work();
+    void run_slices(std::unique_lock<std::mutex>& lock);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+};
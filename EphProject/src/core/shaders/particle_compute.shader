@@ -0,0 +1,143 @@
+#version 430 core
+
+layout(local_size_x = 64) in;           /* 'GpuParticleSystem::GROUP_SIZE'   */
+
+struct Particle                         /* See 'GpuParticle' in              */
+{                                       /* 'GpuParticleSystem.hpp'           */
+    vec2 pos;
+    vec2 velocity;
+    float life;
+    float size;
+    int z_offset;
+    uint color;                         /* RGBA8, R in the lowest byte       */
+};
+
+struct SpriteInstance                   /* See 'SpriteInstance.hpp'          */
+{
+    vec2 axis_x;
+    vec2 axis_y;
+    vec2 translation;
+    vec2 txd_offset;
+    vec2 txd_size;
+    int z_offset;
+    float depth;
+};
+
+struct DrawCommand                      /* DrawElementsIndirectCommand       */
+{
+    uint count;
+    uint instance_count;
+    uint first_index;
+    int base_vertex;
+    uint base_instance;
+};
+
+layout(std430, binding = 0) readonly buffer SourceParticles
+{
+    Particle src_particles[];
+};
+
+layout(std430, binding = 1) writeonly buffer TargetParticles
+{
+    Particle dst_particles[];
+};
+
+layout(std430, binding = 2) buffer DrawCommands
+{
+    DrawCommand commands[];             /* One per particle buffer: its      */
+};                                      /* live particles                    */
+
+layout(std430, binding = 3) writeonly buffer Instances
+{
+    SpriteInstance instances[];
+};
+
+layout(std430, binding = 4) writeonly buffer Colors
+{
+    uint colors[];
+};
+
+uniform int uf_pass;                    /* 0 - simulate, 1 - emit            */
+uniform int uf_source;                  /* Index of the source buffer        */
+uniform int uf_capacity;
+uniform float uf_delta_time;
+uniform vec2 uf_gravity;
+uniform vec4 uf_txd_rect;               /* xy - offset, zw - size            */
+uniform float uf_depth;
+
+uniform int uf_emit_count;              /* The emitter (emit pass only)      */
+uniform int uf_seed;
+uniform vec2 uf_emit_pos;
+uniform vec2 uf_emit_spread;
+uniform vec2 uf_velocity_min;
+uniform vec2 uf_velocity_max;
+uniform vec2 uf_life_range;
+uniform vec2 uf_size_range;
+uniform vec4 uf_color;
+uniform int uf_z_offset;
+
+uint random_state;
+
+float get_random()                      /* PCG hash, [0, 1)                  */
+{
+    random_state = random_state * 747796405u + 2891336453u;
+    uint word = ((random_state >> ((random_state >> 28u) + 4u)) ^
+        random_state) * 277803737u;
+    return float((word >> 22u) ^ word) * (1.0 / 4294967296.0);
+}
+
+void append(Particle particle)
+{
+    uint target = uint(1 - uf_source);
+    uint slot = atomicAdd(commands[target].instance_count, 1u);
+    if (slot >= uint(uf_capacity))
+    {                                   /* Full: the particle is dropped     */
+        atomicAdd(commands[target].instance_count, 0xFFFFFFFFu);
+        return;
+    }
+
+    dst_particles[slot] = particle;
+    float half_size = particle.size * 0.5;
+    instances[slot] = SpriteInstance(vec2(particle.size, 0.0),
+        vec2(0.0, particle.size), particle.pos - half_size, uf_txd_rect.xy,
+        uf_txd_rect.zw, particle.z_offset, uf_depth);
+    colors[slot] = particle.color;      /* Drawn straight from these buffers */
+}
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+
+    if (uf_pass == 0)
+    {
+        if (index >= commands[uf_source].instance_count)
+        {
+            return;
+        }
+        Particle particle = src_particles[index];
+        particle.velocity += uf_gravity * uf_delta_time;
+        particle.pos += particle.velocity * uf_delta_time;
+        particle.life -= uf_delta_time;
+        if (particle.life > 0.0)
+        {                               /* Compact the survivors to the      */
+            append(particle);           /* beginning of the target buffer    */
+        }
+        return;
+    }
+
+    if (index >= uint(uf_emit_count))
+    {
+        return;
+    }
+    random_state = index * 1664525u + uint(uf_seed) * 1013904223u;
+    Particle particle;
+    particle.pos = uf_emit_pos + (vec2(get_random(), get_random()) * 2.0 -
+        1.0) * uf_emit_spread;
+    particle.velocity = mix(uf_velocity_min, uf_velocity_max,
+        vec2(get_random(), get_random()));
+    particle.life = mix(uf_life_range.x, uf_life_range.y, get_random());
+    particle.size = mix(uf_size_range.x, uf_size_range.y, get_random());
+    particle.z_offset = uf_z_offset;
+    particle.color = packUnorm4x8(uf_color);
+    append(particle);
+}
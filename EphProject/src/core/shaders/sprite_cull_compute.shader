@@ -0,0 +1,83 @@
+#version 430 core
+
+layout(local_size_x = 64) in;           /* See 'GpuCuller::GROUP_SIZE'       */
+
+struct SpriteInstance                   /* See 'SpriteInstance.hpp'. vec2    */
+{                                       /* members keep the std430 stride    */
+    vec2 axis_x;                        /* equal to the C++ size (48 bytes)  */
+    vec2 axis_y;
+    vec2 translation;
+    vec2 txd_offset;
+    vec2 txd_size;
+    int z_offset;
+    float depth;
+};
+
+struct DrawCommand                      /* DrawElementsIndirectCommand       */
+{
+    uint count;
+    uint instance_count;
+    uint first_index;
+    int base_vertex;
+    uint base_instance;
+};
+
+layout(std430, binding = 0) readonly buffer InputInstances
+{
+    SpriteInstance in_instances[];
+};
+
+layout(std430, binding = 1) writeonly buffer OutputInstances
+{
+    SpriteInstance out_instances[];
+};
+
+layout(std430, binding = 2) buffer DrawCommands
+{
+    DrawCommand commands[];             /* One per run, sorted by            */
+};                                      /* 'base_instance'                   */
+
+uniform vec4 uf_cull_rect;              /* min x, min y, max x, max y        */
+uniform int uf_instances_count;
+uniform int uf_runs_count;
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uint(uf_instances_count))
+    {
+        return;
+    }
+
+    SpriteInstance instance = in_instances[index];
+    vec2 bounds_min = instance.translation +
+        min(instance.axis_x, vec2(0.0)) + min(instance.axis_y, vec2(0.0));
+    vec2 bounds_max = instance.translation +
+        max(instance.axis_x, vec2(0.0)) + max(instance.axis_y, vec2(0.0));
+                                        /* Bounds of the transformed quad    */
+    if (bounds_max.x < uf_cull_rect.x || bounds_min.x > uf_cull_rect.z ||
+        bounds_max.y < uf_cull_rect.y || bounds_min.y > uf_cull_rect.w)
+    {                                   /* Same test as                      */
+        return;                         /* 'SpriteCuller::cull'              */
+    }
+
+    uint low = 0u;                      /* Find the run of the instance: the */
+    uint high = uint(uf_runs_count) - 1u;
+    while (low < high)                  /* last one that starts before it    */
+    {
+        uint middle = (low + high + 1u) / 2u;
+        if (commands[middle].base_instance <= index)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1u;
+        }
+    }
+
+    uint slot = atomicAdd(commands[low].instance_count, 1u);
+    out_instances[commands[low].base_instance + slot] = instance;
+                                        /* Compact the survivors to the      */
+                                        /* beginning of the run's range      */
+}
@@ -3,11 +3,14 @@
 out vec4 fs_out_color;
 
 in vec2 vs_out_txd_pos;
+flat in int vs_out_txd_array_z_offset;
+flat in vec4 vs_out_color;
 
 uniform sampler2DArray uf_txd_unit;
-uniform int uf_txd_array_z_offset;
+uniform vec4 uf_tint;                   /* White unless text is drawn        */
 
 void main()
 {
-    fs_out_color = texture(uf_txd_unit, vec3(vs_out_txd_pos, uf_txd_array_z_offset));
+    fs_out_color = uf_tint * vs_out_color *
+        texture(uf_txd_unit, vec3(vs_out_txd_pos, vs_out_txd_array_z_offset));
 }
\ No newline at end of file
@@ -2,28 +2,51 @@
 
 layout(location = 0) in vec2 in_pos;    /* Local space                       */
 layout(location = 1) in vec2 in_txd_pos;
+layout(location = 2) in vec4 in_inst_transform;
+                                        /* xy - x axis, zw - y axis          */
+layout(location = 3) in vec4 in_inst_txd_rect;
+                                        /* xy - offset, zw - size            */
+layout(location = 4) in int in_inst_txd_array_z_offset;
+layout(location = 5) in float in_inst_depth;
+                                        /* Clip space z                      */
+layout(location = 6) in vec2 in_inst_translation;
+layout(location = 7) in vec4 in_inst_color;
+                                        /* White unless particles are drawn  */
+                                        /* Per-instance attributes. For      */
+                                        /* non-instanced draws they hold the */
+                                        /* current generic attribute values  */
 
-uniform mat4 uf_projection;
-uniform vec2 uf_model_pos;
-uniform vec2 uf_model_size;
-// TODO: Use vec4 to pass position and size to the shader to reduce the number
-//       of calls to the GPU.
+layout(std140) uniform FrameBlock       /* See 'UniformBlocks.hpp'           */
+{
+    float time;
+    float delta_time;
+    uint frame_index;
+} ub_frame;
+
+layout(std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewport;                      /* xy - offset, zw - size            */
+} ub_view;
 
 out vec2 vs_out_txd_pos;
+flat out int vs_out_txd_array_z_offset;
+flat out vec4 vs_out_color;
 
 void main()
 {
-    mat4 model;
-                                        /* Scaling                           */
-    model[0][0] = uf_model_size.x;      /* x                                 */
-    model[1][1] = uf_model_size.y;      /* y                                 */
-    model[2][2] = 1.0f;
-    model[3][3] = 1.0f;
-
-                                        /* Translation                       */
-    model[3][0] = uf_model_pos.x;       /* x                                 */
-    model[3][1] = uf_model_pos.y;       /* y                                 */
+    vec2 world_pos = in_inst_translation +
+        mat2(in_inst_transform.xy, in_inst_transform.zw) * in_pos;
+                                        /* Precomputed 2d affine transform   */
+                                        /* (see 'SpriteTransforms')          */
 
-    gl_Position = uf_projection * model * vec4(in_pos, 0.0, 1.0);
-    vs_out_txd_pos = in_txd_pos;
+    gl_Position = ub_view.projection * ub_view.view *
+        vec4(world_pos, 0.0, 1.0);
+    gl_Position.z = in_inst_depth * gl_Position.w;
+                                        /* The depth does not depend on the  */
+                                        /* projection                        */
+    vs_out_txd_pos = in_inst_txd_rect.xy + in_txd_pos * in_inst_txd_rect.zw;
+    vs_out_txd_array_z_offset = in_inst_txd_array_z_offset;
+    vs_out_color = in_inst_color;
 }
\ No newline at end of file
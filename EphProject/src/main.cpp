@@ -13,17 +13,53 @@
 
 /** @includes  -------------------------------------------------------------**/
 
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <glm/vec2.hpp>
+
 #include "core/Core.hpp"
+#include "core/Log.hpp"
+#include "bench/CommandBench.hpp"
+#include "bench/DrawPathCheck.hpp"
+#include "bench/ParticleBench.hpp"
+#include "bench/SpatialIndexBench.hpp"
+#include "bench/SpriteBench.hpp"
+#include "bench/TextBench.hpp"
+#include "bench/TilemapBench.hpp"
 
 
 
 /** @functions  ------------------------------------------------------------**/
 
+/**----------------------------------------------------------------------------
+; @func fixed_update
+;
+; @brief
+;   Fixed-rate simulation step.
+;
+; @params
+;   step_time   | Simulated time (in seconds).
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void fixed_update(float /*step_time*/)
+{
+
+}
+
+
 /**----------------------------------------------------------------------------
 ; @func main_loop_iteration
 ;
 ; @brief
-;   Main loop iteration logic.
+;   Main loop iteration logic. Reports the frame time statistics once per
+;   window of the frame timer if the window had hitches, with the render
+;   statistics of the previous frame, as a log message.
 ;
 ; @params
 ;   None
@@ -34,7 +70,61 @@
 ----------------------------------------------------------------------------**/
 void main_loop_iteration()
 {
+    FrameTimer const& frame_timer = Core::instance().get_frame_timer();
+    if (frame_timer.get_total_frames_count() %
+        FrameTimer::DEFAULT_WINDOW_SIZE != 0)
+    {
+        return;
+    }
+    FrameTimeStats stats = frame_timer.get_stats();
+    if (stats.hitches_count == 0)
+    {
+        return;
+    }
+    char message[512];
+    int length = std::snprintf(message, sizeof(message), "Frame time: p50 "
+        "%.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms, hitches %u/%u.",
+        stats.p50, stats.p95, stats.p99, stats.max, stats.hitches_count,
+        stats.frames_count);
+    FrameStats const& frame_stats = Core::instance().get_frame_stats();
+    if (FrameStats::IS_ENABLED && length > 0 &&
+        static_cast<std::size_t>(length) < sizeof(message))
+    {
+        std::snprintf(message + length, sizeof(message) - length, " Last "
+            "frame: %u draw calls, %llu instances, %llu triangles, %u "
+            "texture binds, %u program switches, %u uniform uploads, %llu "
+            "buffer bytes, %llu texture bytes, %u redundant state changes "
+            "avoided.", frame_stats.draw_calls, frame_stats.instances,
+            frame_stats.triangles, frame_stats.texture_binds,
+            frame_stats.program_switches,
+            frame_stats.get_uniform_uploads_count(),
+            frame_stats.buffer_bytes, frame_stats.texture_bytes,
+            frame_stats.redundant_state_changes);
+    }
+    LOG_MESSAGE(message);
+}
+
 
+/**----------------------------------------------------------------------------
+; @func print_frame_stats
+;
+; @brief
+;   Prints the statistics of a frame timer to stdout.
+;
+; @params
+;   name        | Name of the timer to print.
+;   frame_timer | The timer.
+;
+; @return
+;   None
+;
+----------------------------------------------------------------------------**/
+void print_frame_stats(char const* name, FrameTimer const& frame_timer)
+{
+    FrameTimeStats stats = frame_timer.get_stats();
+    std::printf("%-5s | %5u frames | avg %7.3f | p50 %7.3f | p95 %7.3f | "
+        "p99 %7.3f | max %7.3f ms\n", name, stats.frames_count,
+        stats.average, stats.p50, stats.p95, stats.p99, stats.max);
 }
 
 
@@ -42,14 +132,126 @@ void main_loop_iteration()
 ; @func main
 ;
 ; @brief
-;   Entry point.
+;   Entry point. Options:
+;       --bench <name>      runs a benchmark instead of the window.
+;                           Available benchmarks: spatial_index, text,
+;                           tilemap, particles, commands, sprites.
+;       --check <name>      runs a regression check instead of the window
+;                           and returns 0 if it passes. Available checks:
+;                           draw_paths.
+;       --headless          renders offscreen into a hidden window (see
+;                           'Core::set_headless'), benchmarks and checks
+;                           included.
+;                           The demo then runs a fixed number of frames
+;                           and prints the frame times.
+;       --frames <count>    number of frames of the demo (600 by default
+;                           in the headless mode, unlimited otherwise).
+;       --size <w>x<h>      size of the window or of the offscreen frame
+;                           (800x600 by default).
 ;
 ----------------------------------------------------------------------------**/
 int main(int argc, char** argv)
 {
-    Core::instance().init_window("Eph Project", { 800,600 }, false, 0);
+    char const* bench_name = nullptr;
+    char const* check_name = nullptr;
+    bool is_headless = false;
+    unsigned int frames_count = 0;
+    glm::ivec2 size(800, 600);
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc)
+        {
+            bench_name = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc)
+        {
+            check_name = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            is_headless = true;
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames_count = static_cast<unsigned int>(std::strtoul(argv[++i],
+                nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc &&
+            std::sscanf(argv[i + 1], "%dx%d", &size.x, &size.y) == 2 &&
+            size.x > 0 && size.y > 0)
+        {
+            i++;
+        }
+        else
+        {
+            std::fprintf(stderr, "Invalid argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    Core::instance().set_headless(is_headless);
+
+    if (bench_name != nullptr)
+    {
+        if (std::strcmp(bench_name, "spatial_index") == 0)
+        {
+            run_spatial_index_bench();
+            return 0;
+        }
+        if (std::strcmp(bench_name, "text") == 0)
+        {
+            run_text_bench();
+            return 0;
+        }
+        if (std::strcmp(bench_name, "tilemap") == 0)
+        {
+            run_tilemap_bench();
+            return 0;
+        }
+        if (std::strcmp(bench_name, "particles") == 0)
+        {
+            run_particle_bench();
+            return 0;
+        }
+        if (std::strcmp(bench_name, "commands") == 0)
+        {
+            run_command_bench();
+            return 0;
+        }
+        if (std::strcmp(bench_name, "sprites") == 0)
+        {
+            run_sprite_bench();
+            return 0;
+        }
+        std::fprintf(stderr, "Unknown benchmark: %s\n", bench_name);
+        return 1;
+    }
+
+    if (check_name != nullptr)
+    {
+        if (std::strcmp(check_name, "draw_paths") == 0)
+        {
+            return run_draw_path_check() ? 0 : 1;
+        }
+        std::fprintf(stderr, "Unknown check: %s\n", check_name);
+        return 1;
+    }
+
+    if (is_headless && frames_count == 0)
+    {
+        frames_count = 600;
+    }
+    Core::instance().init_window("Eph Project", size, false, 0);
     Core::instance().init_shaders("src/core/shaders/txd_array_vertex.shader",
         "src/core/shaders/txd_array_fragment.shader");
+    Core::instance().init_cull_shader(
+        "src/core/shaders/sprite_cull_compute.shader");
+    Core::instance().set_fixed_update(fixed_update, 1.0f / 60.0f);
+    Core::instance().set_frames_limit(frames_count);
     Core::instance().start_main_loop(main_loop_iteration);
+    if (is_headless)
+    {
+        print_frame_stats("frame", Core::instance().get_frame_timer());
+        print_frame_stats("cpu", Core::instance().get_cpu_frame_timer());
+    }
     return 0;
 }